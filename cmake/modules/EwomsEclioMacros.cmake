@@ -32,3 +32,28 @@ find_package(StdVariant REQUIRED)
 find_package(Boost REQUIRED)
 dune_register_package_flags(
   INCLUDE_DIRS "${Boost_INCLUDE_DIRS}")
+
+# the asynchronous log backend runs its own writer thread
+find_package(Threads REQUIRED)
+dune_register_package_flags(
+  LIBRARIES "${CMAKE_THREAD_LIBS_INIT}")
+
+# optional codecs for compressed result files; an in-tree codec is used
+# if neither is available
+find_path(ZSTD_INCLUDE_DIR zstd.h)
+find_library(ZSTD_LIBRARY zstd)
+if(ZSTD_INCLUDE_DIR AND ZSTD_LIBRARY)
+  set(HAVE_ZSTD 1)
+  dune_register_package_flags(
+    INCLUDE_DIRS "${ZSTD_INCLUDE_DIR}"
+    LIBRARIES "${ZSTD_LIBRARY}")
+endif()
+
+find_path(LZ4_INCLUDE_DIR lz4.h)
+find_library(LZ4_LIBRARY lz4)
+if(LZ4_INCLUDE_DIR AND LZ4_LIBRARY)
+  set(HAVE_LZ4 1)
+  dune_register_package_flags(
+    INCLUDE_DIRS "${LZ4_INCLUDE_DIR}"
+    LIBRARIES "${LZ4_LIBRARY}")
+endif()
@@ -72,6 +72,12 @@
 /* Define whether boost::variant is available */
 #cmakedefine HAVE_BOOST_VARIANT 1
 
+/* Define whether the Zstandard library is available */
+#cmakedefine HAVE_ZSTD 1
+
+/* Define whether the LZ4 library is available */
+#cmakedefine HAVE_LZ4 1
+
 /* begin bottom */
 
 /* end bottom */
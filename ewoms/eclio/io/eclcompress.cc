@@ -0,0 +1,774 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/io/eclcompress.hh>
+
+#include <ewoms/eclio/errormacros.hh>
+#include <ewoms/common/filesystem.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#if HAVE_LZ4
+#include <lz4.h>
+#endif
+
+namespace {
+
+    const std::array<char, 8> fileMagic = { 'E', 'C', 'L', 'Z', '\r', '\n', '\x1a', '\n' };
+    const std::array<char, 8> indexMagic = { 'E', 'C', 'L', 'Z', 'I', 'D', 'X', '\n' };
+    const uint32_t formatVersion = 1;
+
+    const std::size_t fileHeaderSize = Ewoms::EclIO::compressedHeaderSize;
+    const std::size_t indexEntrySize = 48;
+    const std::size_t trailerSize = 24;
+
+    void putLE(char* dst, uint64_t value, int numBytes)
+    {
+        for (int i = 0; i < numBytes; ++i)
+            dst[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+
+    uint64_t getLE(const char* src, int numBytes)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < numBytes; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(src[i])) << (8 * i);
+
+        return value;
+    }
+
+    [[noreturn]] void damagedFrame()
+    {
+        EWOMS_THROW(std::runtime_error, "Damaged frame in compressed Eclipse file");
+    }
+
+    unsigned char shuffleStride(Ewoms::EclIO::eclArrType type)
+    {
+        switch (type) {
+        case Ewoms::EclIO::INTE:
+        case Ewoms::EclIO::REAL:
+        case Ewoms::EclIO::LOGI:
+            return 4;
+        case Ewoms::EclIO::DOUB:
+            return 8;
+        default:
+            return 1;
+        }
+    }
+
+    /*
+      Byte shuffle: byte j of element k is moved to position j*n + k, where
+      n is the number of whole elements. Bytes after the last whole element
+      are left in place. The record markers and the header are shuffled
+      along with the data; they are multiples of the stride, so they do not
+      break the alignment of the elements.
+    */
+    std::vector<char> shuffle(const char* src, std::size_t size, std::size_t stride)
+    {
+        std::vector<char> dst(size);
+        const std::size_t n = size / stride;
+
+        for (std::size_t k = 0; k < n; ++k)
+            for (std::size_t j = 0; j < stride; ++j)
+                dst[j*n + k] = src[k*stride + j];
+
+        std::copy(src + n*stride, src + size, dst.data() + n*stride);
+        return dst;
+    }
+
+    void unshuffle(std::vector<char>& data, std::size_t stride)
+    {
+        std::vector<char> tmp(data.size());
+        const std::size_t n = data.size() / stride;
+
+        for (std::size_t k = 0; k < n; ++k)
+            for (std::size_t j = 0; j < stride; ++j)
+                tmp[k*stride + j] = data[j*n + k];
+
+        std::copy(data.begin() + n*stride, data.end(), tmp.begin() + n*stride);
+        data.swap(tmp);
+    }
+
+    // ---------------------------------------------------------------------
+    // In-tree LZ77 codec.
+    //
+    // The compressed data is a sequence of
+    //
+    //     literal length | literals | match offset | match length - 4
+    //
+    // with all numbers as LEB128 varints. The last sequence has no match
+    // part; it ends the data, possibly with zero literals.
+
+    const std::size_t lzMinMatch = 4;
+    const int lzHashBits = 16;
+
+    void putVarint(std::vector<char>& out, uint64_t value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    uint64_t getVarint(const char*& src, const char* end)
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (src == end)
+                damagedFrame();
+
+            const auto byte = static_cast<unsigned char>(*src++);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+
+        damagedFrame();
+    }
+
+    uint32_t lzHash(const char* src)
+    {
+        uint32_t seq;
+        std::memcpy(&seq, src, sizeof seq);
+        return (seq * 2654435761u) >> (32 - lzHashBits);
+    }
+
+    std::vector<char> lzCompress(const char* src, std::size_t size)
+    {
+        std::vector<char> out;
+        out.reserve(size / 2 + 16);
+
+        // Positions are stored plus one, zero marks an empty slot.
+        std::vector<std::size_t> table(std::size_t(1) << lzHashBits, 0);
+
+        std::size_t anchor = 0;
+        std::size_t pos = 0;
+        while (pos + lzMinMatch <= size) {
+            const auto hash = lzHash(src + pos);
+            const std::size_t candidate = table[hash];
+            table[hash] = pos + 1;
+
+            if (candidate > 0 && std::memcmp(src + candidate - 1, src + pos, lzMinMatch) == 0) {
+                const std::size_t match = candidate - 1;
+                std::size_t length = lzMinMatch;
+                while (pos + length < size && src[match + length] == src[pos + length])
+                    ++length;
+
+                putVarint(out, pos - anchor);
+                out.insert(out.end(), src + anchor, src + pos);
+                putVarint(out, pos - match);
+                putVarint(out, length - lzMinMatch);
+
+                pos += length;
+                anchor = pos;
+            } else {
+                // Skip faster through data which does not compress.
+                pos += 1 + ((pos - anchor) >> 6);
+            }
+        }
+
+        putVarint(out, size - anchor);
+        out.insert(out.end(), src + anchor, src + size);
+
+        return out;
+    }
+
+    void lzDecompress(const char* src, std::size_t size, char* dst, std::size_t rawSize)
+    {
+        const char* end = src + size;
+        std::size_t pos = 0;
+
+        while (true) {
+            const uint64_t literals = getVarint(src, end);
+            if (literals > static_cast<uint64_t>(end - src) || literals > rawSize - pos)
+                damagedFrame();
+
+            std::copy(src, src + literals, dst + pos);
+            src += literals;
+            pos += literals;
+
+            if (src == end)
+                break;
+
+            const uint64_t offset = getVarint(src, end);
+            const uint64_t length = getVarint(src, end) + lzMinMatch;
+            if (offset == 0 || offset > pos || length > rawSize - pos)
+                damagedFrame();
+
+            // The match may overlap the bytes being written.
+            for (uint64_t i = 0; i < length; ++i, ++pos)
+                dst[pos] = dst[pos - offset];
+        }
+
+        if (pos != rawSize)
+            damagedFrame();
+    }
+
+    // ---------------------------------------------------------------------
+
+    std::vector<char> compressFrame(Ewoms::EclIO::CompressionCodec& codec,
+                                    const std::vector<char>& data)
+    {
+        using Ewoms::EclIO::CompressionCodec;
+
+        std::vector<char> frame;
+
+        switch (codec) {
+#if HAVE_ZSTD
+        case CompressionCodec::Zstd: {
+            frame.resize(ZSTD_compressBound(data.size()));
+            const auto size = ZSTD_compress(frame.data(), frame.size(), data.data(), data.size(), 3);
+            if (ZSTD_isError(size))
+                EWOMS_THROW(std::runtime_error, std::string("Zstd compression failed: ") + ZSTD_getErrorName(size));
+
+            frame.resize(size);
+            break;
+        }
+#endif
+#if HAVE_LZ4
+        case CompressionCodec::LZ4:
+            if (data.size() <= static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+                frame.resize(LZ4_compressBound(static_cast<int>(data.size())));
+                const int size = LZ4_compress_default(data.data(), frame.data(),
+                                                      static_cast<int>(data.size()),
+                                                      static_cast<int>(frame.size()));
+                if (size <= 0)
+                    EWOMS_THROW(std::runtime_error, "LZ4 compression failed");
+
+                frame.resize(size);
+                break;
+            }
+
+            codec = CompressionCodec::Lz;
+            frame = lzCompress(data.data(), data.size());
+            break;
+#endif
+        case CompressionCodec::Lz:
+            frame = lzCompress(data.data(), data.size());
+            break;
+
+        default:
+            codec = CompressionCodec::None;
+            return data;
+        }
+
+        if (frame.size() >= data.size()) {
+            codec = CompressionCodec::None;
+            return data;
+        }
+
+        return frame;
+    }
+
+    void decompressFrame(Ewoms::EclIO::CompressionCodec codec,
+                         const std::vector<char>& frame,
+                         std::vector<char>& data)
+    {
+        using Ewoms::EclIO::CompressionCodec;
+
+        switch (codec) {
+        case CompressionCodec::None:
+            if (frame.size() != data.size())
+                damagedFrame();
+
+            data = frame;
+            break;
+
+        case CompressionCodec::Lz:
+            lzDecompress(frame.data(), frame.size(), data.data(), data.size());
+            break;
+
+#if HAVE_ZSTD
+        case CompressionCodec::Zstd: {
+            const auto size = ZSTD_decompress(data.data(), data.size(), frame.data(), frame.size());
+            if (ZSTD_isError(size) || size != data.size())
+                damagedFrame();
+            break;
+        }
+#endif
+#if HAVE_LZ4
+        case CompressionCodec::LZ4: {
+            const int size = LZ4_decompress_safe(frame.data(), data.data(),
+                                                 static_cast<int>(frame.size()),
+                                                 static_cast<int>(data.size()));
+            if (size < 0 || static_cast<std::size_t>(size) != data.size())
+                damagedFrame();
+            break;
+        }
+#endif
+        default:
+            EWOMS_THROW(std::runtime_error, "Compressed Eclipse file uses a codec which is not "
+                        "available in this build");
+        }
+    }
+
+    void encodeEntry(const Ewoms::EclIO::CompressedArray& entry, char* dst)
+    {
+        std::string name = entry.name;
+        name.resize(8, ' ');
+
+        std::memcpy(dst, name.data(), 8);
+        dst[8] = static_cast<char>(entry.type);
+        dst[9] = static_cast<char>(entry.codec);
+        dst[10] = static_cast<char>(entry.shuffle);
+        dst[11] = 0;
+        putLE(dst + 12, static_cast<uint32_t>(entry.elementSize), 4);
+        putLE(dst + 16, static_cast<uint64_t>(entry.size), 8);
+        putLE(dst + 24, entry.offset, 8);
+        putLE(dst + 32, entry.compressedSize, 8);
+        putLE(dst + 40, entry.rawSize, 8);
+    }
+
+    Ewoms::EclIO::CompressedArray decodeEntry(const char* src)
+    {
+        Ewoms::EclIO::CompressedArray entry;
+
+        entry.name = std::string(src, 8);
+        entry.name.erase(entry.name.find_last_not_of(' ') + 1);
+
+        if (static_cast<unsigned char>(src[8]) > Ewoms::EclIO::C0NN ||
+            static_cast<unsigned char>(src[9]) > static_cast<unsigned char>(Ewoms::EclIO::CompressionCodec::Zstd) ||
+            src[10] == 0)
+            EWOMS_THROW(std::runtime_error, "Damaged index in compressed Eclipse file");
+
+        entry.type = static_cast<Ewoms::EclIO::eclArrType>(src[8]);
+        entry.codec = static_cast<Ewoms::EclIO::CompressionCodec>(src[9]);
+        entry.shuffle = static_cast<unsigned char>(src[10]);
+        entry.elementSize = static_cast<int>(getLE(src + 12, 4));
+        entry.size = static_cast<int64_t>(getLE(src + 16, 8));
+        entry.offset = getLE(src + 24, 8);
+        entry.compressedSize = getLE(src + 32, 8);
+        entry.rawSize = getLE(src + 40, 8);
+
+        return entry;
+    }
+
+} // Anonymous namespace
+
+namespace Ewoms { namespace EclIO {
+
+bool compressionCodecAvailable(CompressionCodec codec)
+{
+    switch (codec) {
+    case CompressionCodec::None:
+    case CompressionCodec::Lz:
+        return true;
+    case CompressionCodec::LZ4:
+#if HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case CompressionCodec::Zstd:
+#if HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+CompressionCodec defaultCompressionCodec()
+{
+    if (compressionCodecAvailable(CompressionCodec::Zstd))
+        return CompressionCodec::Zstd;
+
+    if (compressionCodecAvailable(CompressionCodec::LZ4))
+        return CompressionCodec::LZ4;
+
+    return CompressionCodec::Lz;
+}
+
+bool isCompressedEclFile(const std::string& filename)
+{
+    std::ifstream input(filename, std::ios::binary);
+
+    std::array<char, 8> magic;
+    if (!input.read(magic.data(), magic.size()))
+        return false;
+
+    return magic == fileMagic;
+}
+
+std::vector<CompressedArray> readCompressedIndex(std::istream& input)
+{
+    input.seekg(0, std::ios_base::end);
+    const uint64_t fileSize = static_cast<uint64_t>(input.tellg());
+
+    if (fileSize < fileHeaderSize + trailerSize)
+        EWOMS_THROW(std::runtime_error, "Compressed Eclipse file is truncated");
+
+    std::array<char, fileHeaderSize> header;
+    input.seekg(0);
+    input.read(header.data(), header.size());
+    if (!std::equal(fileMagic.begin(), fileMagic.end(), header.begin()))
+        EWOMS_THROW(std::runtime_error, "Not a compressed Eclipse file");
+
+    if (getLE(header.data() + 8, 4) != formatVersion)
+        EWOMS_THROW(std::runtime_error, "Unsupported version of compressed Eclipse file");
+
+    std::array<char, trailerSize> trailer;
+    input.seekg(fileSize - trailerSize);
+    input.read(trailer.data(), trailer.size());
+
+    const uint64_t indexOffset = getLE(trailer.data(), 8);
+    const uint64_t numEntries = getLE(trailer.data() + 8, 8);
+
+    if (!input || !std::equal(indexMagic.begin(), indexMagic.end(), trailer.begin() + 16) ||
+        indexOffset < fileHeaderSize || numEntries > fileSize / indexEntrySize ||
+        indexOffset + numEntries * indexEntrySize + trailerSize != fileSize)
+        EWOMS_THROW(std::runtime_error, "Compressed Eclipse file has no valid index");
+
+    std::vector<char> buffer(numEntries * indexEntrySize);
+    input.seekg(indexOffset);
+    input.read(buffer.data(), buffer.size());
+    if (!input)
+        EWOMS_THROW(std::runtime_error, "Could not read index of compressed Eclipse file");
+
+    std::vector<CompressedArray> index;
+    index.reserve(numEntries);
+    for (uint64_t i = 0; i < numEntries; ++i) {
+        index.push_back(decodeEntry(buffer.data() + i * indexEntrySize));
+
+        const auto& entry = index.back();
+        if (entry.offset < fileHeaderSize || entry.offset + entry.compressedSize > indexOffset)
+            EWOMS_THROW(std::runtime_error, "Damaged index in compressed Eclipse file");
+    }
+
+    return index;
+}
+
+std::vector<char> readCompressedArray(std::istream& input, const CompressedArray& entry)
+{
+    std::vector<char> frame(entry.compressedSize);
+
+    input.clear();
+    input.seekg(entry.offset);
+    input.read(frame.data(), frame.size());
+    if (!input)
+        EWOMS_THROW(std::runtime_error, "Could not read array " + entry.name + " of compressed Eclipse file");
+
+    std::vector<char> data(entry.rawSize);
+    decompressFrame(entry.codec, frame, data);
+
+    if (entry.shuffle > 1)
+        unshuffle(data, entry.shuffle);
+
+    return data;
+}
+
+CompressedArrayStream::Buffer::Buffer(std::vector<char>&& data_arg)
+    : data(std::move(data_arg))
+{
+    this->setg(this->data.data(), this->data.data(), this->data.data() + this->data.size());
+}
+
+CompressedArrayStream::Buffer::pos_type
+CompressedArrayStream::Buffer::seekoff(off_type off, std::ios_base::seekdir dir,
+                                       std::ios_base::openmode which)
+{
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+        base = this->gptr() - this->eback();
+    else if (dir == std::ios_base::end)
+        base = this->egptr() - this->eback();
+
+    return this->seekpos(pos_type(base + off), which);
+}
+
+CompressedArrayStream::Buffer::pos_type
+CompressedArrayStream::Buffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    const off_type offset = pos;
+    if (!(which & std::ios_base::in) || offset < 0 || offset > static_cast<off_type>(this->data.size()))
+        return pos_type(off_type(-1));
+
+    this->setg(this->eback(), this->eback() + offset, this->egptr());
+    return pos;
+}
+
+CompressedArrayStream::CompressedArrayStream(std::istream& input, const CompressedArray& entry)
+    : std::istream(nullptr),
+      buffer(readCompressedArray(input, entry))
+{
+    this->rdbuf(&this->buffer);
+}
+
+// =====================================================================
+
+CompressedOutputFile::CompressedOutputFile(const std::string& filename_arg,
+                                           bool append,
+                                           const CompressionOptions& options_arg)
+    : filename(filename_arg),
+      options(options_arg)
+{
+    if (!compressionCodecAvailable(this->options.codec))
+        EWOMS_THROW(std::invalid_argument, "Requested compression codec is not available in this build");
+
+    if (append && isCompressedEclFile(filename)) {
+        this->file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+        if (!this->file)
+            EWOMS_THROW(std::runtime_error, "Could not open file: " + filename);
+
+        this->index = readCompressedIndex(this->file);
+        this->endOfFrames = this->index.empty()
+            ? fileHeaderSize
+            : this->index.back().offset + this->index.back().compressedSize;
+    } else {
+        this->file.open(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!this->file)
+            EWOMS_THROW(std::runtime_error, "Could not open file: " + filename);
+
+        std::array<char, fileHeaderSize> header {};
+        std::copy(fileMagic.begin(), fileMagic.end(), header.begin());
+        putLE(header.data() + 8, formatVersion, 4);
+        this->file.write(header.data(), header.size());
+
+        this->endOfFrames = fileHeaderSize;
+        this->writeIndex();
+    }
+
+    for (unsigned int i = 0; i < this->options.numThreads; ++i)
+        this->workers.emplace_back([this]() { this->workerLoop(); });
+}
+
+CompressedOutputFile::~CompressedOutputFile()
+{
+    try {
+        this->close();
+    }
+    catch (...) {
+        // Destructors must not throw; call flush() to see write errors.
+    }
+}
+
+bool CompressedOutputFile::is_open() const
+{
+    return this->file.is_open();
+}
+
+void CompressedOutputFile::add(const std::string& name, eclArrType type, int64_t size,
+                               int elementSize, std::vector<char>&& records)
+{
+    Job job;
+    job.entry.name = name;
+    job.entry.type = type;
+    job.entry.size = size;
+    job.entry.elementSize = elementSize;
+    job.entry.rawSize = records.size();
+    job.entry.codec = this->options.codec;
+    job.entry.shuffle = shuffleStride(type);
+    job.records = std::move(records);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->frameWritten.wait(lock, [this]() {
+        return this->pendingBytes <= this->options.maxPendingBytes || this->error;
+    });
+
+    if (this->error) {
+        auto err = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(err);
+    }
+
+    job.sequence = this->nextSequence++;
+    this->pendingBytes += job.records.size();
+
+    if (this->workers.empty()) {
+        lock.unlock();
+        this->process(job);
+
+        lock.lock();
+        if (this->error) {
+            auto err = this->error;
+            this->error = nullptr;
+            std::rethrow_exception(err);
+        }
+        return;
+    }
+
+    this->jobs.push_back(std::move(job));
+    this->jobAdded.notify_one();
+}
+
+void CompressedOutputFile::workerLoop()
+{
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->jobAdded.wait(lock, [this]() { return this->stop || !this->jobs.empty(); });
+            if (this->jobs.empty())
+                return;
+
+            job = std::move(this->jobs.front());
+            this->jobs.pop_front();
+        }
+
+        this->process(job);
+    }
+}
+
+void CompressedOutputFile::process(Job& job)
+{
+    std::vector<char> frame;
+    std::exception_ptr compressError;
+
+    try {
+        if (job.entry.shuffle > 1) {
+            const auto shuffled = shuffle(job.records.data(), job.records.size(), job.entry.shuffle);
+            frame = compressFrame(job.entry.codec, shuffled);
+        } else
+            frame = compressFrame(job.entry.codec, job.records);
+    }
+    catch (...) {
+        compressError = std::current_exception();
+    }
+
+    // Frames are written in the order the arrays were added.
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->frameWritten.wait(lock, [this, &job]() { return this->nextToWrite == job.sequence; });
+
+    if (compressError && !this->error)
+        this->error = compressError;
+
+    if (!this->error) {
+        try {
+            this->writeFrame(job.entry, frame);
+        }
+        catch (...) {
+            this->error = std::current_exception();
+        }
+    }
+
+    ++this->nextToWrite;
+    this->pendingBytes -= job.records.size();
+    this->frameWritten.notify_all();
+}
+
+void CompressedOutputFile::writeFrame(CompressedArray& entry, const std::vector<char>& frame)
+{
+    entry.offset = this->endOfFrames;
+    entry.compressedSize = frame.size();
+
+    this->file.seekp(this->endOfFrames);
+    this->file.write(frame.data(), frame.size());
+    if (!this->file)
+        EWOMS_THROW(std::runtime_error, "Could not write to file: " + this->filename);
+
+    this->endOfFrames += frame.size();
+    this->index.push_back(entry);
+}
+
+void CompressedOutputFile::writeIndex()
+{
+    std::vector<char> buffer(this->index.size() * indexEntrySize + trailerSize);
+
+    char* dst = buffer.data();
+    for (const auto& entry : this->index) {
+        encodeEntry(entry, dst);
+        dst += indexEntrySize;
+    }
+
+    putLE(dst, this->endOfFrames, 8);
+    putLE(dst + 8, this->index.size(), 8);
+    std::copy(indexMagic.begin(), indexMagic.end(), dst + 16);
+
+    this->file.seekp(this->endOfFrames);
+    this->file.write(buffer.data(), buffer.size());
+    this->file.flush();
+    if (!this->file)
+        EWOMS_THROW(std::runtime_error, "Could not write to file: " + this->filename);
+}
+
+void CompressedOutputFile::flush()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->frameWritten.wait(lock, [this]() { return this->nextToWrite == this->nextSequence; });
+
+    if (this->error) {
+        auto err = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(err);
+    }
+
+    this->writeIndex();
+}
+
+void CompressedOutputFile::truncate(uint64_t offset)
+{
+    this->flush();
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (offset >= this->endOfFrames)
+        return;
+
+    auto first = std::find_if(this->index.begin(), this->index.end(),
+                              [offset](const CompressedArray& entry) { return entry.offset >= offset; });
+
+    this->endOfFrames = (first == this->index.end()) ? this->endOfFrames : first->offset;
+    this->index.erase(first, this->index.end());
+    this->writeIndex();
+
+    Ewoms::filesystem::resize_file(this->filename,
+                                   this->endOfFrames + this->index.size() * indexEntrySize + trailerSize);
+}
+
+void CompressedOutputFile::close()
+{
+    if (!this->file.is_open())
+        return;
+
+    std::exception_ptr flushError;
+    try {
+        this->flush();
+    }
+    catch (...) {
+        flushError = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->jobAdded.notify_all();
+
+    for (auto& worker : this->workers)
+        worker.join();
+
+    this->workers.clear();
+    this->file.close();
+
+    if (flushError)
+        std::rethrow_exception(flushError);
+}
+
+}} // namespace Ewoms::EclIO
@@ -0,0 +1,215 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_IO_ECLCOMPRESS_H
+#define EWOMS_IO_ECLCOMPRESS_H
+
+#include <ewoms/eclio/io/ecliodata.hh>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ewoms { namespace EclIO {
+
+/*
+  Block compressed container for binary Eclipse output files.
+
+  The container holds the same arrays as a binary file, but every array -
+  the header record and all data records, exactly as they appear in a
+  binary file - is compressed separately into a frame. An index at the end
+  of the file gives name, type, size and the location of the frame for
+  every array, so single arrays can be read without touching the rest of
+  the file:
+
+      magic (8 bytes) | version (4 bytes) | reserved (4 bytes)
+      frame 0 | frame 1 | ...
+      index entry 0 | index entry 1 | ...    (48 bytes per entry)
+      index offset (8 bytes) | number of entries (8 bytes) | magic (8 bytes)
+
+  All integers in the container itself are little endian; the array data
+  inside the frames keeps the big endian representation of binary files.
+  Before compression the bytes of the data are grouped by their position
+  in the elements (byte shuffle), which makes floating point data much
+  more compressible.
+
+  EclFile and the classes built on it recognize the container by the magic
+  at the start of the file, independent of the file name.
+*/
+
+enum class CompressionCodec : unsigned char {
+    None = 0,   //!< Frame is stored uncompressed.
+    Lz = 1,     //!< In-tree LZ77 codec, always available.
+    LZ4 = 2,
+    Zstd = 3
+};
+
+/// Size of the file header; the first frame starts here.
+const uint64_t compressedHeaderSize = 16;
+
+/// Whether frames using \p codec can be written and read by this build.
+bool compressionCodecAvailable(CompressionCodec codec);
+
+/// Zstd if available, otherwise LZ4 if available, otherwise Lz.
+CompressionCodec defaultCompressionCodec();
+
+struct CompressionOptions
+{
+    CompressionCodec codec = defaultCompressionCodec();
+
+    /// Number of worker threads compressing and writing frames. With
+    /// zero threads all work is done by the thread adding the arrays.
+    unsigned int numThreads = 2;
+
+    /// Adding an array blocks while the uncompressed size of the arrays
+    /// which have not been written yet exceeds this number of bytes.
+    std::size_t maxPendingBytes = std::size_t(256) << 20;
+};
+
+/// Index entry of an array in a compressed file.
+struct CompressedArray
+{
+    std::string name;
+    eclArrType type;
+    int64_t size;
+    int elementSize;
+
+    uint64_t offset;            //!< Position of the frame in the file.
+    uint64_t compressedSize;    //!< Size of the frame.
+    uint64_t rawSize;           //!< Size of the records in a binary file.
+    CompressionCodec codec;
+    unsigned char shuffle;      //!< Stride of the byte shuffle, 1 for none.
+};
+
+bool isCompressedEclFile(const std::string& filename);
+
+/// Read the index of a compressed file; throws std::runtime_error if the
+/// index is missing or damaged, e.g. when the writer was killed.
+std::vector<CompressedArray> readCompressedIndex(std::istream& input);
+
+/// Read and decompress the binary records of one array.
+std::vector<char> readCompressedArray(std::istream& input, const CompressedArray& entry);
+
+/*
+  Input stream over the binary records of one array of a compressed file,
+  for use with the readers in eclutil.hh.
+*/
+class CompressedArrayStream : public std::istream
+{
+public:
+    CompressedArrayStream(std::istream& input, const CompressedArray& entry);
+
+private:
+    class Buffer : public std::streambuf
+    {
+    public:
+        explicit Buffer(std::vector<char>&& data);
+
+    protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+    private:
+        std::vector<char> data;
+    };
+
+    Buffer buffer;
+};
+
+/*
+  Writer for compressed files. The binary records of each array are handed
+  over by EclOutput; the arrays are compressed by a pool of worker threads
+  and written in the order they were added.
+
+  The index is written by flush() and when the file is closed, and is
+  overwritten by the frames added afterwards. A file is therefore complete
+  and readable after every flush.
+*/
+class CompressedOutputFile
+{
+public:
+    /// Create \p filename, or with \p append add to an existing compressed
+    /// file; an existing file which is not compressed is replaced.
+    CompressedOutputFile(const std::string& filename, bool append,
+                         const CompressionOptions& options);
+
+    /// Write the pending arrays and the index and stop the workers.
+    ~CompressedOutputFile();
+
+    CompressedOutputFile(const CompressedOutputFile&) = delete;
+    CompressedOutputFile& operator=(const CompressedOutputFile&) = delete;
+
+    bool is_open() const;
+
+    void add(const std::string& name, eclArrType type, int64_t size,
+             int elementSize, std::vector<char>&& records);
+
+    /// Wait until all arrays are written, then write the index. Errors of
+    /// the workers are rethrown here.
+    void flush();
+
+    /// Drop all arrays whose frames start at or after \p offset; new
+    /// arrays are written from that point.
+    void truncate(uint64_t offset);
+
+private:
+    struct Job
+    {
+        std::size_t sequence;
+        CompressedArray entry;
+        std::vector<char> records;
+    };
+
+    void workerLoop();
+    void process(Job& job);
+    void writeFrame(CompressedArray& entry, const std::vector<char>& frame);
+    void writeIndex();
+    void close();
+
+    std::string filename;
+    CompressionOptions options;
+    std::fstream file;
+
+    std::vector<CompressedArray> index;
+    uint64_t endOfFrames;
+
+    std::mutex mutex;
+    std::condition_variable jobAdded;
+    std::condition_variable frameWritten;
+    std::deque<Job> jobs;
+    std::size_t nextSequence = 0;
+    std::size_t nextToWrite = 0;
+    std::size_t pendingBytes = 0;
+    bool stop = false;
+    std::exception_ptr error;
+    std::vector<std::thread> workers;
+};
+
+}} // namespace Ewoms::EclIO
+
+#endif // EWOMS_IO_ECLCOMPRESS_H
@@ -0,0 +1,274 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/io/eclconverter.hh>
+#include <ewoms/eclio/io/eclcompress.hh>
+#include <ewoms/eclio/io/ecloutput.hh>
+#include <ewoms/eclio/io/eclutil.hh>
+#include <ewoms/eclio/errormacros.hh>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Ewoms { namespace EclIO {
+
+namespace {
+
+    void readBinaryValues(std::istream& input, eclArrType, int64_t num, int, std::vector<int>& data)
+    {
+        data = readBinaryInteArray(input, num);
+    }
+
+    void readBinaryValues(std::istream& input, eclArrType, int64_t num, int, std::vector<float>& data)
+    {
+        data = readBinaryRealArray(input, num);
+    }
+
+    void readBinaryValues(std::istream& input, eclArrType, int64_t num, int, std::vector<double>& data)
+    {
+        data = readBinaryDoubArray(input, num);
+    }
+
+    void readBinaryValues(std::istream& input, eclArrType, int64_t num, int, std::vector<bool>& data)
+    {
+        data = readBinaryLogiArray(input, num);
+    }
+
+    void readBinaryValues(std::istream& input, eclArrType arrType, int64_t num, int elementSize, std::vector<std::string>& data)
+    {
+        if (arrType == C0NN)
+            data = readBinaryC0nnArray(input, num, elementSize);
+        else
+            data = readBinaryCharArray(input, num);
+    }
+
+    void readFormattedValues(const std::string& text, eclArrType, int64_t num, int, std::vector<int>& data)
+    {
+        data = readFormattedInteArray(text, num, 0);
+    }
+
+    void readFormattedValues(const std::string& text, eclArrType, int64_t num, int, std::vector<float>& data)
+    {
+        data = readFormattedRealArray(text, num, 0);
+    }
+
+    void readFormattedValues(const std::string& text, eclArrType, int64_t num, int, std::vector<double>& data)
+    {
+        data = readFormattedDoubArray(text, num, 0);
+    }
+
+    void readFormattedValues(const std::string& text, eclArrType, int64_t num, int, std::vector<bool>& data)
+    {
+        data = readFormattedLogiArray(text, num, 0);
+    }
+
+    void readFormattedValues(const std::string& text, eclArrType arrType, int64_t num, int elementSize, std::vector<std::string>& data)
+    {
+        data = readFormattedCharArray(text, num, 0, arrType == C0NN ? elementSize : sizeOfChar);
+    }
+}
+
+EclConverter::EclConverter(const std::string& filename)
+    : EclFile(filename)
+{
+}
+
+void EclConverter::selectReportSteps(const std::vector<int>& reportStepNumbers)
+{
+    if (std::find(array_name.begin(), array_name.end(), "SEQNUM") == array_name.end())
+        EWOMS_THROW(std::invalid_argument, "Report steps can only be selected in unified restart files, '"
+                    + inputFilename + "' has no SEQNUM arrays");
+
+    this->selectedReportSteps = reportStepNumbers;
+}
+
+void EclConverter::selectArrays(const std::vector<std::string>& arrayNames)
+{
+    this->selectedNames = arrayNames;
+}
+
+void EclConverter::setChunkSize(std::size_t numBlocks)
+{
+    this->chunkSize = std::max(numBlocks, std::size_t(1));
+}
+
+std::vector<int> EclConverter::selectedArrays()
+{
+    std::vector<int> arrIndices;
+    int reportStep = -1;
+
+    for (std::size_t arrIndex = 0; arrIndex < array_name.size(); arrIndex++) {
+        // In unified restart files every report step starts with SEQNUM.
+        if (!selectedReportSteps.empty() && array_name[arrIndex] == "SEQNUM") {
+            const auto& seqnum = this->get<int>(arrIndex);
+            reportStep = seqnum.empty() ? -1 : seqnum[0];
+        }
+
+        if (!selectedReportSteps.empty() &&
+            std::find(selectedReportSteps.begin(), selectedReportSteps.end(), reportStep) == selectedReportSteps.end())
+            continue;
+
+        if (!selectedNames.empty() &&
+            std::find(selectedNames.begin(), selectedNames.end(), array_name[arrIndex]) == selectedNames.end())
+            continue;
+
+        arrIndices.push_back(arrIndex);
+    }
+
+    return arrIndices;
+}
+
+void EclConverter::convert(EclOutput& output)
+{
+    std::fstream input;
+    input.open(inputFilename, formatted ? std::ios::in : std::ios::in | std::ios::binary);
+
+    if (!input) {
+        std::string message="Could not open file: '" + inputFilename +"'";
+        EWOMS_THROW(std::runtime_error, message);
+    }
+
+    for (int arrIndex : this->selectedArrays()) {
+        switch (array_type[arrIndex]) {
+        case INTE:
+            this->convertArray<int>(arrIndex, input, output);
+            break;
+        case REAL:
+            this->convertArray<float>(arrIndex, input, output);
+            break;
+        case DOUB:
+            this->convertArray<double>(arrIndex, input, output);
+            break;
+        case LOGI:
+            this->convertArray<bool>(arrIndex, input, output);
+            break;
+        case CHAR:
+        case C0NN:
+            this->convertArray<std::string>(arrIndex, input, output);
+            break;
+        case MESS:
+            output.message(array_name[arrIndex]);
+            break;
+        default:
+            EWOMS_THROW(std::runtime_error, "Asked to convert unexpected array type");
+            break;
+        }
+    }
+}
+
+template <typename T>
+void EclConverter::convertArray(int arrIndex, std::istream& input, EclOutput& output)
+{
+    const eclArrType arrType = array_type[arrIndex];
+    const int64_t size = array_size[arrIndex];
+
+    // C0NN arrays are written with an element size of at least eight
+    // characters, as done by EclOutput::write().
+    int elementSize = array_element_size[arrIndex];
+    if (arrType == CHAR || (arrType == C0NN && elementSize < sizeOfChar))
+        elementSize = sizeOfChar;
+
+    if (output.isFormatted)
+        output.writeFormattedHeader(array_name[arrIndex], size, arrType, elementSize);
+    else
+        output.writeBinaryHeader(array_name[arrIndex], size, arrType, elementSize);
+
+    // Binary and formatted files use the same number of elements per
+    // block, so chunks of whole blocks are transferred without changing
+    // the layout of the output.
+    const int64_t blockSize = std::get<0>(block_size_data_formatted(arrType));
+    const int64_t maxChunk = static_cast<int64_t>(chunkSize) * blockSize;
+
+    std::vector<T> data;
+
+    if (compressed) {
+        // The array is decompressed as a whole, its records are read from
+        // memory after the header.
+        CompressedArrayStream arrayInput(input, compressedArrays[arrIndex]);
+        std::string name;
+        int64_t num;
+        eclArrType type;
+        int sizeOfElement;
+        readBinaryHeader(arrayInput, name, num, type, sizeOfElement);
+
+        uint64_t filePos = arrayInput.tellg();
+        for (int64_t offset = 0; offset < size; offset += maxChunk) {
+            const int64_t chunk = std::min(maxChunk, size - offset);
+            this->readChunk(arrIndex, arrayInput, filePos, chunk, data);
+            this->writeChunk(output, data, elementSize);
+        }
+    } else {
+        uint64_t filePos = ifStreamPos[arrIndex];
+        for (int64_t offset = 0; offset < size; offset += maxChunk) {
+            const int64_t num = std::min(maxChunk, size - offset);
+            this->readChunk(arrIndex, input, filePos, num, data);
+            this->writeChunk(output, data, elementSize);
+        }
+    }
+
+    if (!output.isFormatted)
+        output.finishBinaryArray();
+}
+
+template <typename T>
+void EclConverter::readChunk(int arrIndex, std::istream& input, uint64_t& filePos,
+                             int64_t num, std::vector<T>& data)
+{
+    const eclArrType arrType = array_type[arrIndex];
+    const int elementSize = array_element_size[arrIndex];
+
+    if (formatted) {
+        const uint64_t numBytes = sizeOnDiskFormatted(num, arrType, elementSize);
+
+        chunkText.resize(numBytes);
+        input.seekg(filePos);
+        input.read(&chunkText[0], numBytes);
+
+        if (static_cast<uint64_t>(input.gcount()) != numBytes)
+            EWOMS_THROW(std::runtime_error, "Unexpected end of file while reading array '"
+                        + array_name[arrIndex] + "' from '" + inputFilename + "'");
+
+        readFormattedValues(chunkText, arrType, num, elementSize, data);
+        filePos += numBytes;
+    } else {
+        input.seekg(filePos);
+        readBinaryValues(input, arrType, num, elementSize, data);
+        filePos = input.tellg();
+    }
+}
+
+template <typename T>
+void EclConverter::writeChunk(EclOutput& output, const std::vector<T>& data, int)
+{
+    if (output.isFormatted)
+        output.writeFormattedArray(data);
+    else
+        output.writeBinaryArray(data);
+}
+
+void EclConverter::writeChunk(EclOutput& output, const std::vector<std::string>& data, int elementSize)
+{
+    if (output.isFormatted)
+        output.writeFormattedCharArray(data, elementSize);
+    else
+        output.writeBinaryCharArray(data, elementSize);
+}
+
+}} // namespace Ewoms::EclIO
@@ -0,0 +1,85 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_IO_ECLCONVERTER_H
+#define EWOMS_IO_ECLCONVERTER_H
+
+#include <ewoms/eclio/io/eclfile.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Ewoms { namespace EclIO {
+
+class EclOutput;
+
+/*
+  Conversion of an Eclipse output file between the binary and the formatted
+  representation. The arrays are transferred in chunks of whole blocks from
+  the input file to the output file, so the memory use is bounded by the
+  chunk size and not by the size of the arrays; the formatting of large
+  chunks is spread over several threads by EclOutput.
+
+  By default all arrays are converted. For unified restart files the
+  conversion can be restricted to a set of report steps, and for all files
+  to a set of array names. The name selection is applied literally; to get
+  a valid unified restart file from a name selection the SEQNUM array must
+  be included.
+*/
+class EclConverter : public EclFile
+{
+public:
+    explicit EclConverter(const std::string& filename);
+
+    void selectReportSteps(const std::vector<int>& reportStepNumbers);
+    void selectArrays(const std::vector<std::string>& arrayNames);
+
+    /// Number of blocks read and written at a time.
+    void setChunkSize(std::size_t numBlocks);
+
+    /// Indices of the arrays which will be converted, in file order.
+    std::vector<int> selectedArrays();
+
+    void convert(EclOutput& output);
+
+private:
+    template <typename T>
+    void convertArray(int arrIndex, std::istream& input, EclOutput& output);
+
+    template <typename T>
+    void readChunk(int arrIndex, std::istream& input, uint64_t& filePos,
+                   int64_t num, std::vector<T>& data);
+
+    template <typename T>
+    void writeChunk(EclOutput& output, const std::vector<T>& data, int elementSize);
+    void writeChunk(EclOutput& output, const std::vector<std::string>& data, int elementSize);
+
+    std::vector<int> selectedReportSteps;
+    std::vector<std::string> selectedNames;
+    std::size_t chunkSize = 256;
+
+    // Text of the current chunk when reading formatted files.
+    std::string chunkText;
+};
+
+}} // namespace Ewoms::EclIO
+
+#endif // EWOMS_IO_ECLCONVERTER_H
@@ -22,6 +22,8 @@
 #include <ewoms/eclio/io/eclutil.hh>
 #include <ewoms/eclio/errormacros.hh>
 
+#include <ewoms/common/filesystem.hh>
+
 #include <algorithm>
 #include <array>
 #include <cstring>
@@ -31,6 +33,7 @@
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <numeric>
 #include <cmath>
 
@@ -40,6 +43,25 @@ namespace Ewoms { namespace EclIO {
 
 EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(filename)
 {
+    this->openFile(Ewoms::nullopt);
+
+    if (preload)
+        this->loadData();
+}
+
+EclFile::EclFile(const std::string& filename, const std::vector<int>& reportSteps) : inputFilename(filename)
+{
+    if (reportSteps.empty())
+        EWOMS_THROW(std::invalid_argument, "No report steps selected in " + filename);
+
+    this->openFile(*std::max_element(reportSteps.begin(), reportSteps.end()));
+    this->selectReportSteps(reportSteps);
+}
+
+void EclFile::openFile(Ewoms::optional<int> lastReportStep)
+{
+    const auto& filename = this->inputFilename;
+
     if (!fileExists(filename)){
         std::string message="Could not open EclFile: " + filename;
         EWOMS_THROW(std::invalid_argument, message);
@@ -47,8 +69,43 @@ EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(file
 
     std::fstream fileH;
 
+    if (isCompressedEclFile(filename)) {
+        formatted = false;
+        compressed = true;
+
+        fileH.open(filename, std::ios::in |  std::ios::binary);
+        compressedArrays = readCompressedIndex(fileH);
+
+        for (const auto& entry : compressedArrays)
+            this->addArray(entry.name, entry.type, entry.size, entry.elementSize, entry.offset);
+
+        // New arrays are written in place of the index.
+        const uint64_t endOfFrames = compressedArrays.empty()
+            ? compressedHeaderSize : compressedArrays.back().offset + compressedArrays.back().compressedSize;
+        this->ifStreamPos.push_back(endOfFrames);
+        return;
+    }
+
     formatted = isFormatted(filename);
 
+    // Binary files are opened from their seek index if they have a valid
+    // one. Without an index, only the headers up to the first report step
+    // after 'lastReportStep' are read.
+    if (!formatted) {
+        auto index = SeekIndex::load(filename);
+        if (!index && lastReportStep)
+            index = SeekIndex::build(filename, *lastReportStep);
+
+        if (index) {
+            for (const auto& array : index->arrays())
+                this->addArray(array.name, array.type, array.size, array.elementSize, array.position);
+
+            this->reportStepIndex = index->reportSteps();
+            this->ifStreamPos.push_back(Ewoms::filesystem::file_size(filename));
+            return;
+        }
+    }
+
     if (formatted) {
         fileH.open(filename, std::ios::in);
     } else {
@@ -60,7 +117,6 @@ EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(file
         EWOMS_THROW(std::runtime_error, message);
     }
 
-    int n = 0;
     while (!isEOF(&fileH)) {
         std::string arrName(8,' ');
         eclArrType arrType;
@@ -73,17 +129,8 @@ EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(file
             readBinaryHeader(fileH,arrName,num, arrType, sizeOfElement);
         }
 
-        array_size.push_back(num);
-        array_type.push_back(arrType);
-        array_name.push_back(trimr(arrName));
-        array_element_size.push_back(sizeOfElement);
-
-        array_index[array_name[n]] = n;
-
         uint64_t pos = fileH.tellg();
-        ifStreamPos.push_back(pos);
-
-        arrayLoaded.push_back(false);
+        this->addArray(trimr(arrName), arrType, num, sizeOfElement, pos);
 
         if (num > 0){
             if (formatted) {
@@ -94,40 +141,129 @@ EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(file
                 fileH.seekg(static_cast<std::streamoff>(sizeOfNextArray), std::ios_base::cur);
             }
         }
-
-        n++;
     };
 
     fileH.seekg(0, std::ios_base::end);
     this->ifStreamPos.push_back(static_cast<uint64_t>(fileH.tellg()));
     fileH.close();
+}
 
-    if (preload)
-        this->loadData();
+void EclFile::addArray(const std::string& name, eclArrType type, int64_t size,
+                       int elementSize, uint64_t position)
+{
+    array_index[name] = array_name.size();
+
+    array_name.push_back(name);
+    array_type.push_back(type);
+    array_size.push_back(size);
+    array_element_size.push_back(elementSize);
+    ifStreamPos.push_back(position);
+    arrayLoaded.push_back(false);
+}
+
+void EclFile::selectReportSteps(const std::vector<int>& reportSteps)
+{
+    // Files opened without an index: the report steps are found from the
+    // SEQNUM arrays.
+    if (this->reportStepIndex.empty()) {
+        for (std::size_t i = 0; i < array_name.size(); i++)
+            if (array_name[i] == "SEQNUM" && array_type[i] == INTE && array_size[i] > 0)
+                this->reportStepIndex.push_back({ this->getImpl(i, INTE, inte_array, "integer")[0], i });
+
+        this->clearData();
+        std::fill(arrayLoaded.begin(), arrayLoaded.end(), false);
+    }
+
+    // Not a unified restart file, nothing to select.
+    if (this->reportStepIndex.empty())
+        return;
+
+    std::vector<std::size_t> keep;
+    std::vector<SeekIndex::ReportStep> keptSteps;
+
+    for (std::size_t step = 0; step < this->reportStepIndex.size(); step++) {
+        const auto& first = this->reportStepIndex[step];
+        if (std::find(reportSteps.begin(), reportSteps.end(), first.seqnum) == reportSteps.end())
+            continue;
+
+        const std::size_t last = (step + 1 < this->reportStepIndex.size())
+            ? this->reportStepIndex[step + 1].firstArray : array_name.size();
+
+        keptSteps.push_back({ first.seqnum, keep.size() });
+        for (std::size_t i = first.firstArray; i < last; i++)
+            keep.push_back(i);
+    }
+
+    auto select = [&keep](auto& values)
+    {
+        typename std::remove_reference<decltype(values)>::type kept;
+        kept.reserve(keep.size());
+        for (auto i : keep)
+            kept.push_back(values[i]);
+
+        values.swap(kept);
+    };
+
+    const uint64_t endPos = ifStreamPos.back();
+    ifStreamPos.pop_back();
+
+    select(array_name);
+    select(array_type);
+    select(array_size);
+    select(array_element_size);
+    select(ifStreamPos);
+    if (compressed)
+        select(compressedArrays);
+
+    ifStreamPos.push_back(endPos);
+    arrayLoaded.assign(array_name.size(), false);
+
+    array_index.clear();
+    for (std::size_t i = 0; i < array_name.size(); i++)
+        array_index[array_name[i]] = i;
+
+    this->reportStepIndex = keptSteps;
 }
 
 void EclFile::loadBinaryArray(std::fstream& fileH, std::size_t arrIndex)
 {
-    fileH.seekg (ifStreamPos[arrIndex], fileH.beg);
+    if (compressed) {
+        // The frame holds the records of the array including the header.
+        CompressedArrayStream arrayStream(fileH, compressedArrays[arrIndex]);
+
+        std::string arrName;
+        int64_t num;
+        eclArrType arrType;
+        int sizeOfElement;
+        readBinaryHeader(arrayStream, arrName, num, arrType, sizeOfElement);
+
+        loadBinaryArrayData(arrayStream, arrIndex);
+    } else {
+        fileH.seekg (ifStreamPos[arrIndex], fileH.beg);
+        loadBinaryArrayData(fileH, arrIndex);
+    }
+}
 
+void EclFile::loadBinaryArrayData(std::istream& input, std::size_t arrIndex)
+{
     switch (array_type[arrIndex]) {
     case INTE:
-        inte_array[arrIndex] = readBinaryInteArray(fileH, array_size[arrIndex]);
+        inte_array[arrIndex] = readBinaryInteArray(input, array_size[arrIndex]);
         break;
     case REAL:
-        real_array[arrIndex] = readBinaryRealArray(fileH, array_size[arrIndex]);
+        real_array[arrIndex] = readBinaryRealArray(input, array_size[arrIndex]);
         break;
     case DOUB:
-        doub_array[arrIndex] = readBinaryDoubArray(fileH, array_size[arrIndex]);
+        doub_array[arrIndex] = readBinaryDoubArray(input, array_size[arrIndex]);
         break;
     case LOGI:
-        logi_array[arrIndex] = readBinaryLogiArray(fileH, array_size[arrIndex]);
+        logi_array[arrIndex] = readBinaryLogiArray(input, array_size[arrIndex]);
         break;
     case CHAR:
-        char_array[arrIndex] = readBinaryCharArray(fileH, array_size[arrIndex]);
+        char_array[arrIndex] = readBinaryCharArray(input, array_size[arrIndex]);
         break;
     case C0NN:
-        char_array[arrIndex] = readBinaryC0nnArray(fileH, array_size[arrIndex], array_element_size[arrIndex]);
+        char_array[arrIndex] = readBinaryC0nnArray(input, array_size[arrIndex], array_element_size[arrIndex]);
         break;
     case MESS:
         break;
@@ -383,6 +519,18 @@ std::vector<unsigned int> EclFile::get_bin_logi_raw_values(int arrIndex) const
         EWOMS_THROW(std::runtime_error, message);
     }
 
+    if (compressed) {
+        CompressedArrayStream arrayStream(fileH, compressedArrays[arrIndex]);
+
+        std::string arrName;
+        int64_t num;
+        eclArrType arrType;
+        int sizeOfElement;
+        readBinaryHeader(arrayStream, arrName, num, arrType, sizeOfElement);
+
+        return readBinaryRawLogiArray(arrayStream, array_size[arrIndex]);
+    }
+
     fileH.seekg (ifStreamPos[arrIndex], fileH.beg);
 
     std::vector<unsigned int> raw_logi = readBinaryRawLogiArray(fileH, array_size[arrIndex]);
@@ -421,6 +569,74 @@ std::vector<std::string> EclFile::get_fmt_real_raw_str_values(int arrIndex) cons
     return real_vect_str;
 }
 
+namespace {
+
+    template <typename T>
+    void convertToDouble(const std::vector<T>& src, double scale, double offset, std::vector<double>& dst)
+    {
+        if ((scale == 1.0) && (offset == 0.0)) {
+            std::copy(src.begin(), src.end(), dst.begin());
+        } else {
+            std::transform(src.begin(), src.end(), dst.begin(),
+                           [scale, offset](const T x) { return static_cast<double>(x) * scale + offset; });
+        }
+    }
+
+}
+
+std::vector<double> EclFile::readAsDouble(int arrIndex, double scale, double offset) const
+{
+    const auto type = array_type[arrIndex];
+    if ((type != REAL) && (type != DOUB)) {
+        std::string message = "Array with index " + std::to_string(arrIndex) + " is not of type float or double";
+        EWOMS_THROW(std::runtime_error, message);
+    }
+
+    std::vector<double> data(array_size[arrIndex]);
+
+    if (arrayLoaded[arrIndex]) {
+        if (type == REAL)
+            convertToDouble(real_array.at(arrIndex), scale, offset, data);
+        else
+            convertToDouble(doub_array.at(arrIndex), scale, offset, data);
+
+        return data;
+    }
+
+    std::ifstream fileH(inputFilename, std::ios::in | std::ios::binary);
+    if (!fileH) {
+        std::string message="Could not open file: '" + inputFilename +"'";
+        EWOMS_THROW(std::runtime_error, message);
+    }
+
+    if (formatted) {
+        fileH.seekg(ifStreamPos[arrIndex]);
+
+        std::string fileStr(sizeOnDiskFormatted(array_size[arrIndex], type, array_element_size[arrIndex]) + 1, ' ');
+        fileH.read(&fileStr[0], fileStr.size());
+
+        if (type == REAL)
+            convertToDouble(readFormattedRealArray(fileStr, array_size[arrIndex], 0), scale, offset, data);
+        else
+            convertToDouble(readFormattedDoubArray(fileStr, array_size[arrIndex], 0), scale, offset, data);
+    } else if (compressed) {
+        CompressedArrayStream arrayStream(fileH, compressedArrays[arrIndex]);
+
+        std::string arrName;
+        int64_t num;
+        eclArrType arrType;
+        int sizeOfElement;
+        readBinaryHeader(arrayStream, arrName, num, arrType, sizeOfElement);
+
+        readBinaryArrayAsDouble(arrayStream, array_size[arrIndex], type, scale, offset, data.data());
+    } else {
+        fileH.seekg(ifStreamPos[arrIndex]);
+        readBinaryArrayAsDouble(fileH, array_size[arrIndex], type, scale, offset, data.data());
+    }
+
+    return data;
+}
+
 std::vector<EclFile::EclEntry> EclFile::getList() const
 {
     std::vector<EclEntry> list;
@@ -487,6 +703,10 @@ EclFile::seekPosition(const std::vector<std::string>::size_type arrIndex) const
         return { static_cast<std::streamoff>(this->ifStreamPos.back()) };
     }
 
+    // The frames of compressed files start with the header.
+    if (this->compressed)
+        return { static_cast<std::streamoff>(this->ifStreamPos[arrIndex]) };
+
     // StreamPos is file position of start of data vector's control
     // character (unformatted) or data items (formatted).  We need
     // file position of start of header, because that's where we're
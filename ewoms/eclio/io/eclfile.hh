@@ -21,7 +21,11 @@
 
 #include <ewoms/eclio/errormacros.hh>
 
+#include <ewoms/eclio/io/eclcompress.hh>
 #include <ewoms/eclio/io/ecliodata.hh>
+#include <ewoms/eclio/io/eclseekindex.hh>
+
+#include <ewoms/common/optional.hh>
 
 #include <ios>
 #include <string>
@@ -38,6 +42,9 @@ public:
     explicit EclFile(const std::string& filename, bool preload = false);
     bool formattedInput() const { return formatted; }
 
+    /// Whether the file is a block compressed container, see eclcompress.hh.
+    bool compressedInput() const { return compressed; }
+
     void loadData();                            // load all data
     void loadData(const std::string& arrName);         // load all arrays with array name equal to arrName
     void loadData(int arrIndex);                // load data based on array indices in vector arrIndex
@@ -63,6 +70,12 @@ public:
     template <typename T>
     const std::vector<T>& get(const std::string& name);
 
+    // Read REAL or DOUB array as scale*x + offset in double precision.
+    // Binary arrays are decoded straight from the file without being
+    // kept in the object, so concurrent calls are safe as long as no
+    // arrays are loaded at the same time.
+    std::vector<double> readAsDouble(int arrIndex, double scale = 1.0, double offset = 0.0) const;
+
     bool hasKey(const std::string &name) const;
     std::size_t count(const std::string& name) const;
 
@@ -71,7 +84,14 @@ public:
     bool is_ix() const;
 
 protected:
+    // Open a unified restart file with only the arrays of the given
+    // report steps. Without a seek index the headers are only read up to
+    // the first report step after the selected ones. Files without SEQNUM
+    // arrays are opened completely.
+    EclFile(const std::string& filename, const std::vector<int>& reportSteps);
+
     bool formatted;
+    bool compressed = false;
     std::string inputFilename;
 
     std::unordered_map<int, std::vector<int>> inte_array;
@@ -87,6 +107,14 @@ protected:
 
     std::vector<uint64_t> ifStreamPos;
 
+    // Index of compressed files; the stream positions are the positions
+    // of the frames.
+    std::vector<CompressedArray> compressedArrays;
+
+    // SEQNUM value and first array of the report steps, if known without
+    // loading the SEQNUM arrays.
+    std::vector<SeekIndex::ReportStep> reportStepIndex;
+
     std::map<std::string, int> array_index;
 
     template<class T>
@@ -112,7 +140,13 @@ protected:
 private:
     std::vector<bool> arrayLoaded;
 
+    void openFile(Ewoms::optional<int> lastReportStep);
+    void addArray(const std::string& name, eclArrType type, int64_t size,
+                  int elementSize, uint64_t position);
+    void selectReportSteps(const std::vector<int>& reportSteps);
+
     void loadBinaryArray(std::fstream& fileH, std::size_t arrIndex);
+    void loadBinaryArrayData(std::istream& input, std::size_t arrIndex);
     void loadFormattedArray(const std::string& fileStr, std::size_t arrIndex, int64_t fromPos);
 
     std::vector<unsigned int> get_bin_logi_raw_values(int arrIndex) const;
@@ -22,11 +22,15 @@
 #include <ewoms/eclio/io/eclutil.hh>
 
 #include <ewoms/eclio/errormacros.hh>
+#include <ewoms/eclio/utility/taskgraph.hh>
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstdio>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include <iomanip>
 #include <iostream>
@@ -48,6 +52,22 @@ EclOutput::EclOutput(const std::string&            filename,
     this->ofileH.open(filename, this->isFormatted ? mode : binmode);
 }
 
+EclOutput::EclOutput(const std::string&            filename,
+                     const bool                    formatted,
+                     const std::ios_base::openmode mode,
+                     const CompressionOptions&     compression)
+    : isFormatted{formatted}
+{
+    ix_standard = false;
+
+    if (this->isFormatted)
+        this->ofileH.open(filename, mode);
+    else
+        this->compressedFile.reset(new CompressedOutputFile {
+            filename, (mode & std::ios_base::app) != 0, compression
+        });
+}
+
 template<>
 void EclOutput::write<std::string>(const std::string& name,
                                    const std::vector<std::string>& data)
@@ -87,6 +107,8 @@ void EclOutput::write<std::string>(const std::string& name,
             writeBinaryHeader(name, data.size(), CHAR, sizeOfChar);
             writeBinaryCharArray(data, sizeOfChar);
        }
+
+        finishBinaryArray();
     }
 }
 
@@ -124,6 +146,8 @@ void EclOutput::write(const std::string& name, const std::vector<std::string>& d
             writeBinaryHeader(name, data.size(), C0NN, sizeOfChar);
             writeBinaryCharArray(data, sizeOfChar);
         }
+
+        finishBinaryArray();
     }
 }
 
@@ -139,6 +163,7 @@ void EclOutput::write<PaddedOutputString<8>>
     else {
         writeBinaryHeader(name, data.size(), CHAR, sizeOfChar);
         writeBinaryCharArray(data);
+        finishBinaryArray();
     }
 }
 
@@ -153,7 +178,33 @@ void EclOutput::message(const std::string& msg)
 
 void EclOutput::flushStream()
 {
-    this->ofileH.flush();
+    if (this->compressedFile)
+        this->compressedFile->flush();
+    else
+        this->ofileH.flush();
+}
+
+bool EclOutput::isOpen() const
+{
+    return this->compressedFile ? this->compressedFile->is_open() : this->ofileH.is_open();
+}
+
+void EclOutput::writeBinaryData(const char* data, std::size_t size)
+{
+    if (this->compressedFile)
+        this->compressedRecords.insert(this->compressedRecords.end(), data, data + size);
+    else
+        this->ofileH.write(data, size);
+}
+
+void EclOutput::finishBinaryArray()
+{
+    if (!this->compressedFile)
+        return;
+
+    this->compressedFile->add(this->compressedName, this->compressedType, this->compressedSize,
+                              this->compressedElementSize, std::move(this->compressedRecords));
+    this->compressedRecords.clear();
 }
 
 void EclOutput::writeBinaryHeader(const std::string&arrName, int64_t size, eclArrType arrType, int element_size)
@@ -161,6 +212,16 @@ void EclOutput::writeBinaryHeader(const std::string&arrName, int64_t size, eclAr
     int bhead = flipEndianInt(16);
     std::string name = arrName + std::string(8 - arrName.size(),' ');
 
+    const int64_t arraySize = size;
+
+    if (this->compressedFile) {
+        this->compressedName = arrName;
+        this->compressedType = arrType;
+        this->compressedSize = size;
+        this->compressedElementSize = element_size;
+        this->compressedRecords.clear();
+    }
+
     // write X231 header if size larger that limits for 4 byte integers
     if (size > std::numeric_limits<int>::max()) {
         int64_t val231 = std::pow(2,31);
@@ -168,21 +229,21 @@ void EclOutput::writeBinaryHeader(const std::string&arrName, int64_t size, eclAr
 
         int flippedx231 = flipEndianInt(static_cast<int>( (-1)*x231 ));
 
-        ofileH.write(reinterpret_cast<char*>(&bhead), sizeof(bhead));
-        ofileH.write(name.c_str(), 8);
-        ofileH.write(reinterpret_cast<char*>(&flippedx231), sizeof(flippedx231));
-        ofileH.write("X231", 4);
-        ofileH.write(reinterpret_cast<char*>(&bhead), sizeof(bhead));
+        writeBinaryData(reinterpret_cast<char*>(&bhead), sizeof(bhead));
+        writeBinaryData(name.c_str(), 8);
+        writeBinaryData(reinterpret_cast<char*>(&flippedx231), sizeof(flippedx231));
+        writeBinaryData("X231", 4);
+        writeBinaryData(reinterpret_cast<char*>(&bhead), sizeof(bhead));
 
         size = size - (x231 * val231);
     }
 
     int flippedSize = flipEndianInt(size);
 
-    ofileH.write(reinterpret_cast<char*>(&bhead), sizeof(bhead));
+    writeBinaryData(reinterpret_cast<char*>(&bhead), sizeof(bhead));
 
-    ofileH.write(name.c_str(), 8);
-    ofileH.write(reinterpret_cast<char*>(&flippedSize), sizeof(flippedSize));
+    writeBinaryData(name.c_str(), 8);
+    writeBinaryData(reinterpret_cast<char*>(&flippedSize), sizeof(flippedSize));
 
     std::string c0nn_str;
 
@@ -194,104 +255,154 @@ void EclOutput::writeBinaryHeader(const std::string&arrName, int64_t size, eclAr
 
     switch(arrType) {
     case INTE:
-        ofileH.write("INTE", 4);
+        writeBinaryData("INTE", 4);
         break;
     case REAL:
-        ofileH.write("REAL", 4);
+        writeBinaryData("REAL", 4);
         break;
     case DOUB:
-        ofileH.write("DOUB", 4);
+        writeBinaryData("DOUB", 4);
         break;
     case LOGI:
-        ofileH.write("LOGI", 4);
+        writeBinaryData("LOGI", 4);
         break;
     case CHAR:
-        ofileH.write("CHAR", 4);
+        writeBinaryData("CHAR", 4);
         break;
     case C0NN:
-        ofileH.write(c0nn_str.c_str(), 4);
+        writeBinaryData(c0nn_str.c_str(), 4);
         break;
     case MESS:
-        ofileH.write("MESS", 4);
+        writeBinaryData("MESS", 4);
         break;
     }
 
-    ofileH.write(reinterpret_cast<char *>(&bhead), sizeof(bhead));
+    writeBinaryData(reinterpret_cast<char *>(&bhead), sizeof(bhead));
+
+    if (this->seekIndex && !this->compressedFile)
+        this->seekIndex->addArray(trimr(arrName), arrType, arraySize, element_size,
+                                  static_cast<uint64_t>(this->ofileH.tellp()));
 }
 
-template <typename T>
-void EclOutput::writeBinaryArray(const std::vector<T>& data)
+void EclOutput::recordSeekIndex(SeekIndex* index)
 {
-    int num, rval;
-    int64_t rest;
-    int dhead;
-    float value_f;
-    double value_d;
-    int intVal;
+    this->seekIndex = index;
 
-    int64_t n = 0;
-    int64_t size = data.size();
+    // Positions are taken from the put pointer, which is not at the end
+    // of files opened for appending before the first write.
+    if (index && !this->compressedFile)
+        this->ofileH.seekp(0, std::ios_base::end);
+}
 
-    eclArrType arrType = MESS;
+namespace {
+
+    template <typename T>
+    eclArrType eclArrayType();
+
+    template <> eclArrType eclArrayType<int>()    { return INTE; }
+    template <> eclArrType eclArrayType<float>()  { return REAL; }
+    template <> eclArrType eclArrayType<double>() { return DOUB; }
+    template <> eclArrType eclArrayType<bool>()   { return LOGI; }
+    template <> eclArrType eclArrayType<char>()   { return MESS; }
+
+    /*
+      Store num elements, starting at data[first], in big endian byte order
+      at dst. The loops only move fixed size integers through memcpy() and
+      __builtin_bswap, which the compiler turns into vectorized byte
+      shuffles.
+    */
+    template <typename T, typename Word>
+    void storeBigEndian(const T* src, std::size_t num, char* dst)
+    {
+        static_assert(sizeof(T) == sizeof(Word), "Element and word size must be equal");
 
-    if (typeid(std::vector<T>) == typeid(std::vector<int>)) {
-        arrType = INTE;
-    } else if (typeid(std::vector<T>) == typeid(std::vector<float>)) {
-        arrType = REAL;
-    } else if (typeid(std::vector<T>) == typeid(std::vector<double>)) {
-        arrType = DOUB;
-    } else if (typeid(std::vector<T>) == typeid(std::vector<bool>)) {
-        arrType = LOGI;
+        for (std::size_t i = 0; i < num; i++) {
+            Word word;
+            std::memcpy(&word, src + i, sizeof word);
+            if (sizeof(Word) == 4)
+                word = __builtin_bswap32(word);
+            else
+                word = __builtin_bswap64(word);
+            std::memcpy(dst + i*sizeof word, &word, sizeof word);
+        }
     }
 
-    auto sizeData = block_size_data_binary(arrType);
+    void storeBlock(const std::vector<int>& data, std::size_t first, std::size_t num, char* dst, unsigned int)
+    {
+        storeBigEndian<int, std::uint32_t>(data.data() + first, num, dst);
+    }
 
-    int sizeOfElement = std::get<0>(sizeData);
-    int maxBlockSize = std::get<1>(sizeData);
-    int maxNumberOfElements = maxBlockSize / sizeOfElement;
+    void storeBlock(const std::vector<float>& data, std::size_t first, std::size_t num, char* dst, unsigned int)
+    {
+        storeBigEndian<float, std::uint32_t>(data.data() + first, num, dst);
+    }
+
+    void storeBlock(const std::vector<double>& data, std::size_t first, std::size_t num, char* dst, unsigned int)
+    {
+        storeBigEndian<double, std::uint64_t>(data.data() + first, num, dst);
+    }
+
+    void storeBlock(const std::vector<bool>& data, std::size_t first, std::size_t num, char* dst, unsigned int true_value)
+    {
+        // The true and false values are endian-neutral or already stored
+        // in file byte order.
+        for (std::size_t i = 0; i < num; i++) {
+            const unsigned int value = data[first + i] ? true_value : false_value;
+            std::memcpy(dst + i*sizeOfLogi, &value, sizeOfLogi);
+        }
+    }
+
+    void storeBlock(const std::vector<char>&, std::size_t, std::size_t, char*, unsigned int)
+    {
+        EWOMS_THROW(std::invalid_argument, "Type 'MESS' have no associated data");
+    }
+}
+
+void EclOutput::setWriteBufferSize(std::size_t bytes)
+{
+    this->writeBufferSize = bytes;
+}
 
-    if (!ofileH.is_open()) {
+template <typename T>
+void EclOutput::writeBinaryArray(const std::vector<T>& data)
+{
+    if (!isOpen()) {
         EWOMS_THROW(std::runtime_error, "fstream fileH not open for writing");
     }
 
-    int logi_true_val = ix_standard ? true_value_ix : true_value_ecl;
+    const auto sizeData = block_size_data_binary(eclArrayType<T>());
 
-    rest = size * static_cast<int64_t>(sizeOfElement);
-    while (rest > 0) {
-        if (rest > maxBlockSize) {
-            rest -= maxBlockSize;
-            num = maxNumberOfElements;
-        } else {
-            num = static_cast<int>(rest) / sizeOfElement;
-            rest = 0;
-        }
+    const std::size_t sizeOfElement = std::get<0>(sizeData);
+    const std::size_t maxNumberOfElements = std::get<1>(sizeData) / sizeOfElement;
+    const std::size_t maxRecordSize = maxNumberOfElements * sizeOfElement + 2 * sizeof(int);
 
-        dhead = flipEndianInt(num * sizeOfElement);
+    // Whole Fortran records are assembled in the staging buffer, and the
+    // buffer is written when it can not hold another record.
+    const std::size_t bufferSize = std::max(this->writeBufferSize, maxRecordSize);
+    const unsigned int logi_true_val = ix_standard ? true_value_ix : true_value_ecl;
+    const std::size_t size = data.size();
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+    std::size_t n = 0;
+    while (n < size) {
+        std::size_t used = 0;
+        while (n < size && (used == 0 || used + maxRecordSize <= bufferSize)) {
+            const std::size_t num = std::min(maxNumberOfElements, size - n);
+            const std::size_t recordSize = num * sizeOfElement;
+            const int dhead = flipEndianInt(static_cast<int>(recordSize));
 
-        for (int i = 0; i < num; i++) {
-            if (arrType == INTE) {
-                rval = flipEndianInt(data[n]);
-                ofileH.write(reinterpret_cast<char*>(&rval), sizeof(rval));
-            } else if (arrType == REAL) {
-                value_f = flipEndianFloat(data[n]);
-                ofileH.write(reinterpret_cast<char*>(&value_f), sizeof(value_f));
-            } else if (arrType == DOUB) {
-                value_d = flipEndianDouble(data[n]);
-                ofileH.write(reinterpret_cast<char*>(&value_d), sizeof(value_d));
-            } else if (arrType == LOGI) {
-                intVal = data[n] ? logi_true_val : false_value;
-                ofileH.write(reinterpret_cast<char*>(&intVal), sizeOfElement);
-            } else {
-                std::cerr << "type not supported in write binaryarray\n";
-                std::exit(EXIT_FAILURE);
-            }
+            if (this->writeBuffer.size() < used + recordSize + 2 * sizeof dhead)
+                this->writeBuffer.resize(used + recordSize + 2 * sizeof dhead);
 
-            n++;
+            char* record = this->writeBuffer.data() + used;
+            std::memcpy(record, &dhead, sizeof dhead);
+            storeBlock(data, n, num, record + sizeof dhead, logi_true_val);
+            std::memcpy(record + sizeof dhead + recordSize, &dhead, sizeof dhead);
+
+            used += recordSize + 2 * sizeof dhead;
+            n += num;
         }
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        writeBinaryData(this->writeBuffer.data(), used);
     }
 }
 
@@ -321,7 +432,7 @@ void EclOutput::writeBinaryCharArray(const std::vector<std::string>& data, int e
 
     int rest = size * sizeOfElement;
 
-    if (!ofileH.is_open()) {
+    if (!isOpen()) {
         EWOMS_THROW(std::runtime_error,"fstream fileH not open for writing");
     }
 
@@ -336,15 +447,20 @@ void EclOutput::writeBinaryCharArray(const std::vector<std::string>& data, int e
 
         dhead = flipEndianInt(num * sizeOfElement);
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        const std::size_t recordSize = num * sizeOfElement + 2 * sizeof(dhead);
+        if (this->writeBuffer.size() < recordSize)
+            this->writeBuffer.resize(recordSize);
 
+        char* record = this->writeBuffer.data();
+        std::memcpy(record, &dhead, sizeof(dhead));
+        std::fill(record + sizeof(dhead), record + sizeof(dhead) + num * sizeOfElement, ' ');
         for (int i = 0; i < num; i++) {
-            std::string tmpStr = data[n] + std::string(sizeOfElement - data[n].size(),' ');
-            ofileH.write(tmpStr.c_str(), sizeOfElement);
+            data[n].copy(record + sizeof(dhead) + i * sizeOfElement, sizeOfElement);
             n++;
         }
+        std::memcpy(record + sizeof(dhead) + num * sizeOfElement, &dhead, sizeof(dhead));
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        writeBinaryData(record, recordSize);
     }
 }
 
@@ -360,7 +476,7 @@ void EclOutput::writeBinaryCharArray(const std::vector<PaddedOutputString<8>>& d
 
     int rest = size * sizeOfElement;
 
-    if (!ofileH.is_open()) {
+    if (!isOpen()) {
         EWOMS_THROW(std::runtime_error,"fstream fileH not open for writing");
     }
 
@@ -374,13 +490,13 @@ void EclOutput::writeBinaryCharArray(const std::vector<PaddedOutputString<8>>& d
 
         auto dhead = flipEndianInt(numElm * sizeOfElement);
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        writeBinaryData(reinterpret_cast<char*>(&dhead), sizeof(dhead));
 
         for (auto i = 0*numElm; i < numElm; ++i, ++elm) {
-            ofileH.write(elm->c_str(), sizeOfElement);
+            writeBinaryData(elm->c_str(), sizeOfElement);
         }
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        writeBinaryData(reinterpret_cast<char*>(&dhead), sizeof(dhead));
     }
 }
 
@@ -425,193 +541,124 @@ void EclOutput::writeFormattedHeader(const std::string& arrName, int size, eclAr
 
 std::string EclOutput::make_real_string_ecl(float value) const
 {
-    char buffer [15];
-    std::sprintf (buffer, "%10.7E", value);
-
-    if (value == 0.0) {
-        return "0.00000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-
-        int exp =  value < 0.0 ? std::stoi(tmpstr.substr(11, 3)) :  std::stoi(tmpstr.substr(10, 3));
-
-        if (value < 0.0) {
-            tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 7) + "E";
-        } else {
-            tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 7) +"E";
-        }
-
-        std::sprintf (buffer, "%+03i", exp+1);
-        tmpstr = tmpstr+buffer;
-
-        return tmpstr;
-    }
+    char buffer[maxFormattedValueLength];
+    return std::string(buffer, formatRealEcl(value, buffer));
 }
 
 std::string EclOutput::make_real_string_ix(float value) const
 {
-    char buffer [15];
-    std::sprintf (buffer, "%10.7E", value);
-
-    if (value == 0.0) {
-        return " 0.0000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-
-        return tmpstr;
-    }
+    char buffer[maxFormattedValueLength];
+    return std::string(buffer, formatRealIx(value, buffer));
 }
 
 std::string EclOutput::make_doub_string_ecl(double value) const
 {
-    char buffer [21 + 1];
-    std::snprintf (buffer, sizeof buffer, "%19.13E", value);
-
-    if (value == 0.0) {
-        return "0.00000000000000D+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-        int exp = value < 0.0 ? std::stoi(tmpstr.substr(17, 4)) : std::stoi(tmpstr.substr(16, 4));
-        const bool use_exp_char = (exp >= -100) && (exp < 99);
-
-        if (value < 0.0) {
-            if (use_exp_char) {
-                tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13) + "D";
-            } else {
-                tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13);
-            }
-        } else {
-            if (use_exp_char) {
-                tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13) + "D";
-            } else {
-                tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13);
-            }
-        }
-
-        std::snprintf(buffer, sizeof buffer, "%+03i", exp + 1);
-        tmpstr = tmpstr + buffer;
-        return tmpstr;
-    }
+    char buffer[maxFormattedValueLength];
+    return std::string(buffer, formatDoubEcl(value, buffer));
 }
 
 std::string EclOutput::make_doub_string_ix(double value) const
 {
-    char buffer [21];
-    std::sprintf (buffer, "%19.13E", value);
-
-    if (value == 0.0) {
-        return " 0.0000000000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
+    char buffer[maxFormattedValueLength];
+    return std::string(buffer, formatDoubIx(value, buffer));
+}
+
+namespace {
 
-        std::string tmpstr(buffer);
+    // Number of blocks formatted by a single task for large arrays.
+    const std::size_t formattedChunkBlocks = 64;
 
-        return tmpstr;
+    int formatValue(int value, bool, char* dst)
+    {
+        return static_cast<int>(std::to_chars(dst, dst + maxFormattedValueLength, value).ptr - dst);
     }
-}
 
-template <typename T>
-void EclOutput::writeFormattedArray(const std::vector<T>& data)
-{
-    int size = data.size();
-    int n = 0;
+    int formatValue(float value, bool ix_standard, char* dst)
+    {
+        return ix_standard ? formatRealIx(value, dst) : formatRealEcl(value, dst);
+    }
 
-    eclArrType arrType = MESS;
-    if (typeid(T) == typeid(int)) {
-        arrType = INTE;
-    } else if (typeid(T) == typeid(float)) {
-        arrType = REAL;
-    } else if (typeid(T) == typeid(double)) {
-        arrType = DOUB;
-    } else if (typeid(T) == typeid(bool)) {
-        arrType = LOGI;
+    int formatValue(double value, bool ix_standard, char* dst)
+    {
+        return ix_standard ? formatDoubIx(value, dst) : formatDoubEcl(value, dst);
     }
 
-    auto sizeData = block_size_data_formatted(arrType);
+    int formatValue(bool value, bool, char* dst)
+    {
+        dst[0] = value ? 'T' : 'F';
+        return 1;
+    }
 
-    int maxBlockSize = std::get<0>(sizeData);
-    int nColumns = std::get<1>(sizeData);
-    int columnWidth = std::get<2>(sizeData);
-
-    for (int i = 0; i < size; i++) {
-        n++;
-
-        switch (arrType) {
-        case INTE:
-            ofileH << std::setw(columnWidth) << data[i];
-            break;
-        case REAL:
-            if (ix_standard)
-                ofileH << std::setw(columnWidth) << make_real_string_ix(data[i]);
-            else
-                ofileH << std::setw(columnWidth) << make_real_string_ecl(data[i]);
-            break;
-        case DOUB:
-            if (ix_standard)
-                ofileH << std::setw(columnWidth) << make_doub_string_ix(data[i]);
-            else
-                ofileH << std::setw(columnWidth) << make_doub_string_ecl(data[i]);
-            break;
-        case LOGI:
-            if (data[i]) {
-                ofileH << "  T";
-            } else {
-                ofileH << "  F";
-            }
-            break;
-        default:
-            break;
-        }
+    int formatValue(char, bool, char*)
+    {
+        EWOMS_THROW(std::invalid_argument, "Type 'MESS' have no associated data");
+    }
+
+    /*
+      Append the values data[begin, end) to out, each right aligned in a
+      column of width columnWidth. A line ends after nColumns values and
+      at the end of every block of maxBlockSize values; begin must
+      therefore be at the start of a block.
+    */
+    template <typename T>
+    void formatArrayRange(const std::vector<T>& data, std::size_t begin, std::size_t end,
+                          std::size_t maxBlockSize, std::size_t nColumns, int columnWidth,
+                          bool ix_standard, std::string& out)
+    {
+        out.clear();
+
+        char value[maxFormattedValueLength];
+        for (std::size_t i = begin; i < end; i++) {
+            const int length = formatValue(static_cast<T>(data[i]), ix_standard, value);
+            if (length < columnWidth)
+                out.append(columnWidth - length, ' ');
 
-        if ((n % nColumns) == 0 || (n % maxBlockSize) == 0) {
-            ofileH << std::endl;
+            out.append(value, length);
+
+            const std::size_t n = i % maxBlockSize + 1;
+            if ((n % nColumns) == 0 || n == maxBlockSize)
+                out.push_back('\n');
         }
+    }
+}
 
-        if ((n % maxBlockSize) == 0) {
-            n=0;
+template <typename T>
+void EclOutput::writeFormattedArray(const std::vector<T>& data)
+{
+    const auto sizeData = block_size_data_formatted(eclArrayType<T>());
+
+    const std::size_t maxBlockSize = std::get<0>(sizeData);
+    const std::size_t nColumns = std::get<1>(sizeData);
+    const int columnWidth = std::get<2>(sizeData);
+    const bool ix = this->ix_standard;
+
+    // Large arrays are formatted in chunks of whole blocks on several
+    // threads; the chunks are written in order once a batch of them is
+    // complete.
+    const std::size_t chunkSize = formattedChunkBlocks * maxBlockSize;
+    const std::size_t numThreads = (data.size() > chunkSize) ? TaskGraph::hardwareThreads() : 1;
+    std::vector<std::string> chunks(numThreads);
+
+    for (std::size_t batchBegin = 0; batchBegin < data.size(); batchBegin += numThreads * chunkSize) {
+        TaskGraph formatTasks;
+        for (std::size_t c = 0; c < numThreads; c++) {
+            const std::size_t begin = std::min(batchBegin + c * chunkSize, data.size());
+            const std::size_t end = std::min(begin + chunkSize, data.size());
+            formatTasks.addTask([&data, &chunks, c, begin, end, maxBlockSize, nColumns, columnWidth, ix]()
+                                {
+                                    formatArrayRange(data, begin, end, maxBlockSize, nColumns,
+                                                     columnWidth, ix, chunks[c]);
+                                });
         }
+        formatTasks.run(numThreads);
+
+        for (const auto& chunk : chunks)
+            ofileH.write(chunk.data(), chunk.size());
     }
 
-    if ((n % nColumns) != 0 && (n % maxBlockSize) != 0) {
-        ofileH << std::endl;
+    const std::size_t n = data.size() % maxBlockSize;
+    if ((n % nColumns) != 0) {
+        ofileH << '\n';
     }
 }
 
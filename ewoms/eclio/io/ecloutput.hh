@@ -19,13 +19,17 @@
 #ifndef EWOMS_IO_ECLOUTPUT_H
 #define EWOMS_IO_ECLOUTPUT_H
 
+#include <cstddef>
 #include <fstream>
 #include <ios>
+#include <memory>
 #include <string>
 #include <typeinfo>
 #include <vector>
 
+#include <ewoms/eclio/io/eclcompress.hh>
 #include <ewoms/eclio/io/ecliodata.hh>
+#include <ewoms/eclio/io/eclseekindex.hh>
 #include <ewoms/eclio/io/paddedoutputstring.hh>
 #include <iostream>
 
@@ -43,6 +47,14 @@ public:
               const bool                    formatted,
               const std::ios_base::openmode mode = std::ios::out);
 
+    // Write a block compressed file instead of a binary file, see
+    // eclcompress.hh. With mode std::ios::app the arrays are added to an
+    // existing compressed file. Formatted files are never compressed.
+    EclOutput(const std::string&            filename,
+              const bool                    formatted,
+              const std::ios_base::openmode mode,
+              const CompressionOptions&     compression);
+
     template<typename T>
     void write(const std::string& name,
                const std::vector<T>& data)
@@ -73,6 +85,8 @@ public:
             writeBinaryHeader(name, data.size(), arrType, element_size);
             if (arrType != MESS)
                 writeBinaryArray(data);
+
+            finishBinaryArray();
         }
     }
 
@@ -82,15 +96,36 @@ public:
     void write(const std::string& name, const std::vector<std::string>& data, int element_size);
 
     void message(const std::string& msg);
+
+    // For compressed files this waits until all arrays are written and
+    // updates the index.
     void flushStream();
 
+    bool compressedOutput() const { return static_cast<bool>(compressedFile); }
+
     void set_ix() { ix_standard = true; }
 
+    // Binary arrays are converted to file byte order in a staging buffer
+    // holding this many bytes of complete records, which is written with a
+    // single call; a large buffer reduces the number of write calls for
+    // large arrays.
+    void setWriteBufferSize(std::size_t bytes);
+
+    friend class EclConverter;
     friend class OutputStream::Restart;
     friend class OutputStream::SummarySpecification;
 
 private:
     void writeBinaryHeader(const std::string& arrName, int64_t size, eclArrType arrType, int element_size);
+    void writeBinaryData(const char* data, std::size_t size);
+
+    // Pass the records of the array written last to the compressed file.
+    void finishBinaryArray();
+    bool isOpen() const;
+
+    // Add the data positions of binary arrays written from now on to
+    // 'index'.
+    void recordSeekIndex(SeekIndex* index);
 
     template <typename T>
     void writeBinaryArray(const std::vector<T>& data);
@@ -114,6 +149,18 @@ private:
 
     bool isFormatted, ix_standard;
     std::ofstream ofileH;
+
+    std::size_t writeBufferSize = 64 * 1024;
+    std::vector<char> writeBuffer;
+
+    std::unique_ptr<CompressedOutputFile> compressedFile;
+    std::vector<char> compressedRecords;
+    std::string compressedName;
+    eclArrType compressedType = MESS;
+    int64_t compressedSize = 0;
+    int compressedElementSize = 0;
+
+    SeekIndex* seekIndex = nullptr;
 };
 
 template<>
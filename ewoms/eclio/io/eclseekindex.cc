@@ -0,0 +1,367 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/io/eclseekindex.hh>
+
+#include <ewoms/eclio/io/eclcompress.hh>
+#include <ewoms/eclio/io/eclutil.hh>
+#include <ewoms/eclio/errormacros.hh>
+#include <ewoms/common/filesystem.hh>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+
+    /*
+      Layout of the sidecar file, all integers little endian:
+
+          magic (8) | version (4) | reserved (4)
+          records of 32 bytes, in the order of the data file:
+            array:       name (8) | type (4) | element size (4) | size (8) | position (8)
+            report step: blank (8) | 0xffffffff (4) | seqnum (4) | reserved (16)
+
+      A report step record precedes the first array of the step. The file
+      holds no counts, so the arrays of a new report step are appended to
+      it without rewriting the existing records.
+    */
+    const std::array<char, 8> indexMagic = { 'E', 'C', 'L', 'S', 'I', 'D', 'X', '\n' };
+    const uint32_t formatVersion = 2;
+
+    const std::size_t headerSize = 16;
+    const std::size_t recordSize = 32;
+    const uint64_t stepRecord = 0xffffffff;
+
+    // Size of the header record of an array in a binary file.
+    const uint64_t binaryHeaderSize = 24;
+
+    void putLE(std::string& dst, uint64_t value, int numBytes)
+    {
+        for (int i = 0; i < numBytes; ++i)
+            dst.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    uint64_t getLE(const char* src, int numBytes)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < numBytes; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(src[i])) << (8 * i);
+
+        return value;
+    }
+
+    bool headerMatches(std::ifstream& dataFile, const Ewoms::EclIO::SeekIndex::Array& array)
+    {
+        if (array.position < binaryHeaderSize)
+            return false;
+
+        dataFile.seekg(array.position - binaryHeaderSize);
+
+        std::string name;
+        int64_t size;
+        Ewoms::EclIO::eclArrType type;
+        int elementSize;
+
+        try {
+            Ewoms::EclIO::readBinaryHeader(dataFile, name, size, type, elementSize);
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+
+        // X231 headers of very large arrays are not read back here, only
+        // the part of the size below 2^31 is compared.
+        return dataFile
+            && (Ewoms::EclIO::trimr(name) == array.name)
+            && (type == array.type)
+            && (size == (array.size & 0x7fffffff));
+    }
+
+
+    void putArray(std::string& dst, const Ewoms::EclIO::SeekIndex::Array& array)
+    {
+        dst.append(array.name.substr(0, 8));
+        dst.append(8 - std::min(array.name.size(), std::size_t(8)), ' ');
+        putLE(dst, static_cast<uint64_t>(array.type), 4);
+        putLE(dst, static_cast<uint32_t>(array.elementSize), 4);
+        putLE(dst, static_cast<uint64_t>(array.size), 8);
+        putLE(dst, array.position, 8);
+    }
+
+    void putStep(std::string& dst, const Ewoms::EclIO::SeekIndex::ReportStep& step)
+    {
+        dst.append(8, ' ');
+        putLE(dst, stepRecord, 4);
+        putLE(dst, static_cast<uint32_t>(step.seqnum), 4);
+        putLE(dst, 0, 16);
+    }
+
+    std::string records(const Ewoms::EclIO::SeekIndex& index)
+    {
+        const auto& arrays = index.arrays();
+        const auto& steps = index.reportSteps();
+
+        std::string content;
+        content.reserve((arrays.size() + steps.size()) * recordSize);
+
+        auto step = steps.begin();
+        for (std::size_t n = 0; n < arrays.size(); ++n) {
+            for (; (step != steps.end()) && (step->firstArray == n); ++step)
+                putStep(content, *step);
+
+            putArray(content, arrays[n]);
+        }
+
+        return content;
+    }
+
+    bool isStep(const char* record)
+    {
+        return getLE(record + 8, 4) == stepRecord;
+    }
+
+    Ewoms::optional<Ewoms::EclIO::SeekIndex::Array> getArray(const char* record)
+    {
+        const auto type = getLE(record + 8, 4);
+        if (type > static_cast<uint64_t>(Ewoms::EclIO::C0NN))
+            return Ewoms::nullopt;
+
+        return Ewoms::EclIO::SeekIndex::Array {
+            Ewoms::EclIO::trimr(std::string(record, 8)),
+            static_cast<Ewoms::EclIO::eclArrType>(type),
+            static_cast<int64_t>(getLE(record + 16, 8)),
+            static_cast<int>(getLE(record + 12, 4)),
+            getLE(record + 24, 8)
+        };
+    }
+
+    bool validHeader(const char* header)
+    {
+        return std::equal(indexMagic.begin(), indexMagic.end(), header)
+            && (getLE(header + 8, 4) == formatVersion);
+    }
+
+    // The last array must end at the end of the data file, and the first
+    // and last array headers must be where the index has them.
+    bool matchesDataFile(const std::string& dataFile,
+                         const Ewoms::EclIO::SeekIndex::Array* first,
+                         const Ewoms::EclIO::SeekIndex::Array* last)
+    {
+        std::error_code ec;
+        const auto dataFileSize = Ewoms::filesystem::file_size(dataFile, ec);
+        if (ec)
+            return false;
+
+        if (last == nullptr)
+            return dataFileSize == 0;
+
+        if (last->position + Ewoms::EclIO::sizeOnDiskBinary(last->size, last->type, last->elementSize) != dataFileSize)
+            return false;
+
+        std::ifstream data(dataFile, std::ios::binary);
+        return headerMatches(data, *first) && headerMatches(data, *last);
+    }
+
+}
+
+namespace Ewoms { namespace EclIO {
+
+std::string SeekIndex::fileName(const std::string& dataFile)
+{
+    return dataFile + ".IDX";
+}
+
+Ewoms::optional<SeekIndex> SeekIndex::load(const std::string& dataFile)
+{
+    std::ifstream input(fileName(dataFile), std::ios::binary);
+    if (!input)
+        return Ewoms::nullopt;
+
+    const std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (content.size() < headerSize || !validHeader(content.data())
+        || (content.size() - headerSize) % recordSize != 0)
+        return Ewoms::nullopt;
+
+    SeekIndex index;
+    for (const char* p = content.data() + headerSize; p != content.data() + content.size(); p += recordSize) {
+        if (isStep(p)) {
+            index.addReportStep(static_cast<int>(static_cast<int32_t>(getLE(p + 12, 4))));
+            continue;
+        }
+
+        const auto array = getArray(p);
+        if (!array.has_value())
+            return Ewoms::nullopt;
+
+        index.arrayList.push_back(*array);
+    }
+
+    if (!index.stepList.empty() && index.stepList.back().firstArray >= index.arrayList.size())
+        return Ewoms::nullopt;
+
+    const auto* first = index.arrayList.empty() ? nullptr : &index.arrayList.front();
+    const auto* last = index.arrayList.empty() ? nullptr : &index.arrayList.back();
+    if (!matchesDataFile(dataFile, first, last))
+        return Ewoms::nullopt;
+
+    return index;
+}
+
+bool SeekIndex::isCurrent(const std::string& dataFile)
+{
+    std::ifstream input(fileName(dataFile), std::ios::binary | std::ios::ate);
+    if (!input)
+        return false;
+
+    const auto fileSize = static_cast<uint64_t>(std::streamoff(input.tellg()));
+    if (fileSize < headerSize || (fileSize - headerSize) % recordSize != 0)
+        return false;
+
+    std::array<char, headerSize> header;
+    input.seekg(0);
+    if (!input.read(header.data(), header.size()) || !validHeader(header.data()))
+        return false;
+
+    const auto numRecords = (fileSize - headerSize) / recordSize;
+    if (numRecords == 0)
+        return matchesDataFile(dataFile, nullptr, nullptr);
+
+    // Only the first and the last array records are read, the first array
+    // follows at most one report step record.
+    std::array<char, 2 * recordSize> head;
+    const auto headRecords = std::min(numRecords, uint64_t(2));
+    if (!input.read(head.data(), headRecords * recordSize))
+        return false;
+
+    const char* firstRecord = isStep(head.data()) ? head.data() + recordSize : head.data();
+    if (firstRecord == head.data() + headRecords * recordSize || isStep(firstRecord))
+        return false;
+
+    std::array<char, recordSize> lastRecord;
+    input.seekg(static_cast<std::streamoff>(fileSize - recordSize));
+    if (!input.read(lastRecord.data(), lastRecord.size()) || isStep(lastRecord.data()))
+        return false;
+
+    const auto first = getArray(firstRecord);
+    const auto last = getArray(lastRecord.data());
+
+    return first.has_value() && last.has_value()
+        && matchesDataFile(dataFile, &*first, &*last);
+}
+
+SeekIndex SeekIndex::build(const std::string& dataFile, int lastReportStep)
+{
+    if (isCompressedEclFile(dataFile) || isFormatted(dataFile))
+        EWOMS_THROW(std::invalid_argument, "Seek indices are only built for binary files, not for '" + dataFile + "'");
+
+    std::fstream input(dataFile, std::ios::in | std::ios::binary);
+    if (!input)
+        EWOMS_THROW(std::runtime_error, "Could not open file: '" + dataFile + "'");
+
+    SeekIndex index;
+    while (!isEOF(&input)) {
+        std::string name;
+        int64_t size;
+        eclArrType type;
+        int elementSize;
+        readBinaryHeader(input, name, size, type, elementSize);
+        name = trimr(name);
+
+        const uint64_t position = input.tellg();
+        if (name == "SEQNUM" && type == INTE && size > 0) {
+            const int seqnum = readBinaryInteArray(input, size)[0];
+            if (seqnum > lastReportStep)
+                break;
+
+            index.addReportStep(seqnum);
+            input.seekg(position);
+        }
+
+        index.addArray(name, type, size, elementSize, position);
+        input.seekg(static_cast<std::streamoff>(position + sizeOnDiskBinary(size, type, elementSize)));
+    }
+
+    return index;
+}
+
+void SeekIndex::remove(const std::string& dataFile)
+{
+    std::error_code ec;
+    Ewoms::filesystem::remove(fileName(dataFile), ec);
+}
+
+void SeekIndex::save(const std::string& dataFile) const
+{
+    std::string content;
+    content.append(indexMagic.begin(), indexMagic.end());
+    putLE(content, formatVersion, 4);
+    putLE(content, 0, 4);
+    content += records(*this);
+
+    // Readers must never see a partially written index.
+    const auto tmpName = fileName(dataFile) + ".tmp";
+    {
+        std::ofstream output(tmpName, std::ios::binary | std::ios::trunc);
+        output.write(content.data(), content.size());
+        if (!output)
+            EWOMS_THROW(std::runtime_error, "Could not write seek index '" + tmpName + "'");
+    }
+
+    Ewoms::filesystem::rename(tmpName, fileName(dataFile));
+}
+
+void SeekIndex::append(const std::string& dataFile) const
+{
+    // A reader seeing a partially appended index rejects it, since its
+    // last array does not end at the end of the data file.
+    const auto content = records(*this);
+
+    std::ofstream output(fileName(dataFile), std::ios::binary | std::ios::app);
+    output.write(content.data(), content.size());
+    if (!output)
+        EWOMS_THROW(std::runtime_error, "Could not append to seek index '" + fileName(dataFile) + "'");
+}
+
+void SeekIndex::addArray(const std::string& name, eclArrType type, int64_t size,
+                         int elementSize, uint64_t position)
+{
+    arrayList.push_back({ name, type, size, elementSize, position });
+}
+
+void SeekIndex::addReportStep(int seqnum)
+{
+    stepList.push_back({ seqnum, arrayList.size() });
+}
+
+void SeekIndex::truncate(uint64_t offset)
+{
+    const auto keep = std::find_if(arrayList.begin(), arrayList.end(),
+                                   [offset](const Array& array) { return array.position > offset; });
+    arrayList.erase(keep, arrayList.end());
+
+    while (!stepList.empty() && stepList.back().firstArray >= arrayList.size())
+        stepList.pop_back();
+}
+
+}} // namespace Ewoms::EclIO
@@ -0,0 +1,111 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_IO_ECLSEEKINDEX_H
+#define EWOMS_IO_ECLSEEKINDEX_H
+
+#include <ewoms/eclio/io/ecliodata.hh>
+
+#include <ewoms/common/optional.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Ewoms { namespace EclIO {
+
+/*
+  Sidecar index of a binary Eclipse file, stored next to the file as
+  <filename>.IDX. It holds name, type, size and data position of every
+  array, and the SEQNUM value and first array of every report step, so
+  that a file can be opened without walking all its array headers.
+
+  The index is only used if it matches the data file: the last array must
+  end at the end of the file, and the headers of the first and the last
+  array must be found at the recorded positions. Unified restart files
+  written through OutputStream::Restart get an index at output time, to
+  which every report step appends its own arrays; for other files it can
+  be built once with build() and save().
+*/
+class SeekIndex
+{
+public:
+    struct Array
+    {
+        std::string name;
+        eclArrType type;
+        int64_t size;
+        int elementSize;
+        uint64_t position;   // first byte after the header
+    };
+
+    struct ReportStep
+    {
+        int seqnum;
+        std::size_t firstArray;
+    };
+
+    static std::string fileName(const std::string& dataFile);
+
+    /// Index of \p dataFile, if it has a sidecar file matching its
+    /// current content.
+    static Ewoms::optional<SeekIndex> load(const std::string& dataFile);
+
+    /// Index of \p dataFile built by walking its array headers. With
+    /// \p lastReportStep the walk stops at the first SEQNUM larger than
+    /// it; such partial indices must not be saved.
+    static SeekIndex build(const std::string& dataFile,
+                           int lastReportStep = std::numeric_limits<int>::max());
+
+    /// Whether \p dataFile has a sidecar file matching its current
+    /// content.  Unlike load() this only reads the first and the last
+    /// records of the sidecar file.
+    static bool isCurrent(const std::string& dataFile);
+
+    /// Remove the sidecar file of \p dataFile, if any.
+    static void remove(const std::string& dataFile);
+
+    /// Write the sidecar file of \p dataFile, which must be complete.
+    void save(const std::string& dataFile) const;
+
+    /// Append the arrays and report steps of this index to the sidecar
+    /// file of \p dataFile, which must be current up to the first of them.
+    void append(const std::string& dataFile) const;
+
+    void addArray(const std::string& name, eclArrType type, int64_t size,
+                  int elementSize, uint64_t position);
+
+    /// Start a new report step with the next array added.
+    void addReportStep(int seqnum);
+
+    /// Drop all arrays whose header starts at or after \p offset.
+    void truncate(uint64_t offset);
+
+    const std::vector<Array>& arrays() const { return arrayList; }
+    const std::vector<ReportStep>& reportSteps() const { return stepList; }
+
+private:
+    std::vector<Array> arrayList;
+    std::vector<ReportStep> stepList;
+};
+
+}} // namespace Ewoms::EclIO
+
+#endif // EWOMS_IO_ECLSEEKINDEX_H
@@ -24,8 +24,12 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
 #include <stdexcept>
 #include <cmath>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
 #include <fstream>
 #include <cstring>
 #include <type_traits>
@@ -259,7 +263,7 @@ uint64_t Ewoms::EclIO::sizeOnDiskFormatted(const int64_t num, Ewoms::EclIO::eclA
     return size;
 }
 
-void Ewoms::EclIO::readBinaryHeader(std::fstream& fileH, std::string& tmpStrName,
+void Ewoms::EclIO::readBinaryHeader(std::istream& fileH, std::string& tmpStrName,
                       int& tmpSize, std::string& tmpStrType)
 {
     int bhead;
@@ -288,7 +292,7 @@ void Ewoms::EclIO::readBinaryHeader(std::fstream& fileH, std::string& tmpStrName
     }
 }
 
-void Ewoms::EclIO::readBinaryHeader(std::fstream& fileH, std::string& arrName,
+void Ewoms::EclIO::readBinaryHeader(std::istream& fileH, std::string& arrName,
                       int64_t& size, Ewoms::EclIO::eclArrType &arrType, int& elementSize)
 {
     std::string tmpStrName(8,' ');
@@ -393,19 +397,19 @@ void Ewoms::EclIO::readFormattedHeader(std::fstream& fileH, std::string& arrName
 }
 
 template <class T>
-void readFileHValue_(std::fstream& fileH, T& value, int sizeOfElement)
+void readFileHValue_(std::istream& fileH, T& value, int sizeOfElement)
 {
     fileH.read(reinterpret_cast<char*>(&value), sizeOfElement);
 }
 
-void readFileHValue_(std::fstream& fileH, std::string& value, int sizeOfElement)
+void readFileHValue_(std::istream& fileH, std::string& value, int sizeOfElement)
 {
     value.resize(sizeOfElement);
     fileH.read(&value[0], sizeOfElement);
 }
 
 template<typename T, typename T2>
-std::vector<T> Ewoms::EclIO::readBinaryArray(std::fstream& fileH, const int64_t size, Ewoms::EclIO::eclArrType type,
+std::vector<T> Ewoms::EclIO::readBinaryArray(std::istream& fileH, const int64_t size, Ewoms::EclIO::eclArrType type,
                                std::function<T(T2)>& flip, int elementSize)
 {
     std::vector<T> arr;
@@ -462,25 +466,116 @@ std::vector<T> Ewoms::EclIO::readBinaryArray(std::fstream& fileH, const int64_t
     return arr;
 }
 
-std::vector<int> Ewoms::EclIO::readBinaryInteArray(std::fstream &fileH, const int64_t size)
+namespace {
+
+    inline uint32_t byteSwap(uint32_t value) { return __builtin_bswap32(value); }
+    inline uint64_t byteSwap(uint64_t value) { return __builtin_bswap64(value); }
+
+    template <typename T, typename Bits, bool Scaled>
+    void decodeRecord(const char* src, int num, double scale, double offset, double* dst)
+    {
+        static_assert(sizeof(T) == sizeof(Bits), "Size of value and its bits must match");
+
+        for (int i = 0; i < num; i++) {
+            Bits bits;
+            std::memcpy(&bits, src + i * sizeof(Bits), sizeof(Bits));
+            bits = byteSwap(bits);
+
+            T value;
+            std::memcpy(&value, &bits, sizeof(T));
+
+            dst[i] = Scaled ? static_cast<double>(value) * scale + offset : static_cast<double>(value);
+        }
+    }
+
+}
+
+void Ewoms::EclIO::readBinaryArrayAsDouble(std::istream& fileH, const int64_t size, Ewoms::EclIO::eclArrType type,
+                                           double scale, double offset, double* dst)
+{
+    if ((type != Ewoms::EclIO::REAL) && (type != Ewoms::EclIO::DOUB)) {
+        EWOMS_THROW(std::invalid_argument, "Only REAL and DOUB arrays can be read as double precision values");
+    }
+
+    const auto sizeData = block_size_data_binary(type);
+    const int sizeOfElement = std::get<0>(sizeData);
+    const int maxNumberOfElements = std::get<1>(sizeData) / sizeOfElement;
+
+    // Without scaling the values are only widened, so that they are
+    // identical to the ones from readBinaryRealArray/readBinaryDoubArray.
+    const bool scaled = (scale != 1.0) || (offset != 0.0);
+
+    std::vector<char> record(std::get<1>(sizeData));
+    int64_t rest = size;
+
+    while (rest > 0) {
+        int dhead;
+        fileH.read(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        dhead = Ewoms::EclIO::flipEndianInt(dhead);
+        int num = dhead / sizeOfElement;
+
+        if ((num > maxNumberOfElements) || (num < 0)) {
+            EWOMS_THROW(std::runtime_error, "Error reading binary data, inconsistent header data or incorrect number of elements");
+        }
+
+        // The record must not run past the end of the destination.
+        if (num > rest) {
+            EWOMS_THROW(std::runtime_error, "Error reading binary data, incorrect number of elements");
+        }
+
+        fileH.read(record.data(), static_cast<std::streamsize>(num) * sizeOfElement);
+        if (!fileH) {
+            EWOMS_THROW(std::runtime_error, "Error reading binary data, unexpected end of file");
+        }
+
+        if (type == Ewoms::EclIO::REAL) {
+            if (scaled)
+                decodeRecord<float, uint32_t, true>(record.data(), num, scale, offset, dst);
+            else
+                decodeRecord<float, uint32_t, false>(record.data(), num, scale, offset, dst);
+        } else {
+            if (scaled)
+                decodeRecord<double, uint64_t, true>(record.data(), num, scale, offset, dst);
+            else
+                decodeRecord<double, uint64_t, false>(record.data(), num, scale, offset, dst);
+        }
+
+        dst += num;
+        rest -= num;
+
+        if (num < maxNumberOfElements && rest != 0) {
+            EWOMS_THROW(std::runtime_error, "Error reading binary data, incorrect number of elements");
+        }
+
+        int dtail;
+        fileH.read(reinterpret_cast<char*>(&dtail), sizeof(dtail));
+        dtail = Ewoms::EclIO::flipEndianInt(dtail);
+
+        if (dhead != dtail) {
+            EWOMS_THROW(std::runtime_error, "Error reading binary data, tail not matching header.");
+        }
+    }
+}
+
+std::vector<int> Ewoms::EclIO::readBinaryInteArray(std::istream &fileH, const int64_t size)
 {
     std::function<int(int)> f = Ewoms::EclIO::flipEndianInt;
     return readBinaryArray<int,int>(fileH, size, Ewoms::EclIO::INTE, f, sizeOfInte);
 }
 
-std::vector<float> Ewoms::EclIO::readBinaryRealArray(std::fstream& fileH, const int64_t size)
+std::vector<float> Ewoms::EclIO::readBinaryRealArray(std::istream& fileH, const int64_t size)
 {
     std::function<float(float)> f = Ewoms::EclIO::flipEndianFloat;
     return readBinaryArray<float,float>(fileH, size, Ewoms::EclIO::REAL, f, sizeOfReal);
 }
 
-std::vector<double> Ewoms::EclIO::readBinaryDoubArray(std::fstream& fileH, const int64_t size)
+std::vector<double> Ewoms::EclIO::readBinaryDoubArray(std::istream& fileH, const int64_t size)
 {
     std::function<double(double)> f = Ewoms::EclIO::flipEndianDouble;
     return readBinaryArray<double,double>(fileH, size, Ewoms::EclIO::DOUB, f, sizeOfDoub);
 }
 
-std::vector<bool> Ewoms::EclIO::readBinaryLogiArray(std::fstream &fileH, const int64_t size)
+std::vector<bool> Ewoms::EclIO::readBinaryLogiArray(std::istream &fileH, const int64_t size)
 {
     std::function<bool(unsigned int)> f = [](unsigned int intVal)
                                           {
@@ -500,7 +595,7 @@ std::vector<bool> Ewoms::EclIO::readBinaryLogiArray(std::fstream &fileH, const i
     return readBinaryArray<bool,unsigned int>(fileH, size, Ewoms::EclIO::LOGI, f, sizeOfLogi);
 }
 
-std::vector<unsigned int> Ewoms::EclIO::readBinaryRawLogiArray(std::fstream &fileH, const int64_t size)
+std::vector<unsigned int> Ewoms::EclIO::readBinaryRawLogiArray(std::istream &fileH, const int64_t size)
 {
     std::function<unsigned int(unsigned int)> f = [](unsigned int intVal)
                                           {
@@ -509,7 +604,7 @@ std::vector<unsigned int> Ewoms::EclIO::readBinaryRawLogiArray(std::fstream &fil
     return readBinaryArray<unsigned int, unsigned int>(fileH, size, Ewoms::EclIO::LOGI, f, sizeOfLogi);
 }
 
-std::vector<std::string> Ewoms::EclIO::readBinaryCharArray(std::fstream& fileH, const int64_t size)
+std::vector<std::string> Ewoms::EclIO::readBinaryCharArray(std::istream& fileH, const int64_t size)
 {
     using Char8 = std::array<char, 8>;
     std::function<std::string(Char8)> f = [](const Char8& val)
@@ -520,7 +615,7 @@ std::vector<std::string> Ewoms::EclIO::readBinaryCharArray(std::fstream& fileH,
     return readBinaryArray<std::string,Char8>(fileH, size, Ewoms::EclIO::CHAR, f, sizeOfChar);
 }
 
-std::vector<std::string> Ewoms::EclIO::readBinaryC0nnArray(std::fstream& fileH, const int64_t size, int elementSize)
+std::vector<std::string> Ewoms::EclIO::readBinaryC0nnArray(std::istream& fileH, const int64_t size, int elementSize)
 {
     std::function<std::string(std::string)> f = [](const std::string& val)
                                           {
@@ -530,6 +625,238 @@ std::vector<std::string> Ewoms::EclIO::readBinaryC0nnArray(std::fstream& fileH,
     return readBinaryArray<std::string,std::string>(fileH, size, Ewoms::EclIO::C0NN, f, elementSize);
 }
 
+namespace {
+
+    /*
+      Write value, which must be finite, like printf("%.*E", precision,
+      value) but without going through the locale. Both std::to_chars()
+      and printf() round the exact binary value correctly to the requested
+      number of digits, so the results are identical.
+    */
+    int formatScientific(double value, int precision, char* dst)
+    {
+#ifdef __cpp_lib_to_chars
+        const auto res = std::to_chars(dst, dst + Ewoms::EclIO::maxFormattedValueLength, value,
+                                       std::chars_format::scientific, precision);
+        char* exp_char = std::find(dst, res.ptr, 'e');
+        if (exp_char != res.ptr)
+            *exp_char = 'E';
+
+        return static_cast<int>(res.ptr - dst);
+#else
+        char buffer[Ewoms::EclIO::maxFormattedValueLength + 1];
+        const int length = std::snprintf(buffer, sizeof buffer, "%.*E", precision, value);
+        std::copy(buffer, buffer + length, dst);
+        return length;
+#endif
+    }
+
+    // Equivalent of printf("%+03i", value).
+    int formatExponent(int value, char* dst)
+    {
+        char* p = dst;
+        *p++ = value < 0 ? '-' : '+';
+
+        unsigned int abs_value = value < 0 ? -static_cast<unsigned int>(value) : value;
+        char digits[10];
+        int num_digits = 0;
+        do {
+            digits[num_digits++] = static_cast<char>('0' + abs_value % 10);
+            abs_value /= 10;
+        } while (abs_value > 0);
+
+        if (num_digits < 2)
+            *p++ = '0';
+
+        while (num_digits > 0)
+            *p++ = digits[--num_digits];
+
+        return static_cast<int>(p - dst);
+    }
+
+    int copyString(const char* str, char* dst)
+    {
+        const auto length = std::strlen(str);
+        std::copy(str, str + length, dst);
+        return static_cast<int>(length);
+    }
+
+    template <typename T>
+    int formatNonFinite(T value, char* dst)
+    {
+        if (std::isnan(value))
+            return copyString("NAN", dst);
+
+        return copyString(value > 0 ? "INF" : "-INF", dst);
+    }
+
+    /*
+      The Eclipse format moves the decimal point one position to the left,
+      i.e. 1.2345678E+00 is written as 0.12345678E+01. Writes the sign and
+      the mantissa and returns the exponent in \p exp.
+    */
+    int formatShiftedMantissa(double value, int precision, char* dst, int& exp)
+    {
+        char sci[Ewoms::EclIO::maxFormattedValueLength + 1];
+        const int sci_length = formatScientific(std::fabs(value), precision, sci);
+        sci[sci_length] = '\0';
+
+        char* exp_pos = std::find(sci, sci + sci_length, 'E');
+        exp = static_cast<int>(std::strtol(exp_pos + 1, nullptr, 10)) + 1;
+
+        char* p = dst;
+        if (value < 0)
+            *p++ = '-';
+
+        *p++ = '0';
+        *p++ = '.';
+        *p++ = sci[0];
+        p = std::copy(sci + 2, exp_pos, p);
+
+        return static_cast<int>(p - dst);
+    }
+
+    double parseFormattedToken(const char* first, const char* last)
+    {
+        // Normalize to a representation std::from_chars()/strtod() accept:
+        // 'D' exponent markers are replaced with 'E', and an 'E' is inserted
+        // before an exponent which is only given by its sign.
+        char buffer[Ewoms::EclIO::maxFormattedValueLength * 2 + 2];
+        const auto length = last - first;
+        if (length <= 0 || length > Ewoms::EclIO::maxFormattedValueLength * 2)
+            EWOMS_THROW(std::invalid_argument, "Could not convert '" + std::string(first, last) + "' to a floating point value");
+
+        if (*first == '+')
+            ++first;
+
+        char* p = buffer;
+        bool has_exp_char = false;
+        for (const char* c = first; c != last; ++c) {
+            char ch = *c;
+            if (ch == 'D' || ch == 'd')
+                ch = 'E';
+
+            if (ch == 'E' || ch == 'e')
+                has_exp_char = true;
+            else if ((ch == '+' || ch == '-') && c != first && !has_exp_char) {
+                *p++ = 'E';
+                has_exp_char = true;
+            }
+
+            *p++ = ch;
+        }
+
+        double value;
+#ifdef __cpp_lib_to_chars
+        const auto res = std::from_chars(buffer, p, value);
+        if (res.ec == std::errc::result_out_of_range)
+            EWOMS_THROW(std::out_of_range, "Value '" + std::string(first, last) + "' is out of range");
+
+        if (res.ec != std::errc() || res.ptr == buffer)
+            EWOMS_THROW(std::invalid_argument, "Could not convert '" + std::string(first, last) + "' to a floating point value");
+#else
+        *p = '\0';
+        char* end;
+        errno = 0;
+        value = std::strtod(buffer, &end);
+        if (end == buffer)
+            EWOMS_THROW(std::invalid_argument, "Could not convert '" + std::string(first, last) + "' to a floating point value");
+
+        if (errno == ERANGE)
+            EWOMS_THROW(std::out_of_range, "Value '" + std::string(first, last) + "' is out of range");
+#endif
+        return value;
+    }
+
+    bool isSeparator(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r';
+    }
+
+    template <typename T>
+    std::vector<T> readFormattedNumbers(const std::string& file_str, const int64_t size, int64_t fromPos)
+    {
+        std::vector<T> arr;
+        arr.reserve(size);
+
+        const char* p = file_str.data() + fromPos;
+        const char* end = file_str.data() + file_str.size();
+
+        for (int64_t i = 0; i < size; i++) {
+            while (p != end && isSeparator(*p))
+                ++p;
+
+            const char* token_end = p;
+            while (token_end != end && !isSeparator(*token_end))
+                ++token_end;
+
+            arr.push_back(static_cast<T>(parseFormattedToken(p, token_end)));
+            p = token_end;
+        }
+
+        return arr;
+    }
+}
+
+int Ewoms::EclIO::formatRealEcl(float value, char* dst)
+{
+    if (value == 0.0)
+        return copyString("0.00000000E+00", dst);
+
+    if (!std::isfinite(value))
+        return formatNonFinite(value, dst);
+
+    int exp;
+    int length = formatShiftedMantissa(value, 7, dst, exp);
+    dst[length++] = 'E';
+    return length + formatExponent(exp, dst + length);
+}
+
+int Ewoms::EclIO::formatRealIx(float value, char* dst)
+{
+    if (value == 0.0)
+        return copyString(" 0.0000000E+00", dst);
+
+    if (!std::isfinite(value))
+        return formatNonFinite(value, dst);
+
+    return formatScientific(static_cast<double>(value), 7, dst);
+}
+
+int Ewoms::EclIO::formatDoubEcl(double value, char* dst)
+{
+    if (value == 0.0)
+        return copyString("0.00000000000000D+00", dst);
+
+    if (!std::isfinite(value))
+        return formatNonFinite(value, dst);
+
+    int exp;
+    int length = formatShiftedMantissa(value, 13, dst, exp);
+
+    // Three digit exponents are written without the 'D'.
+    if ((exp >= -99) && (exp < 100))
+        dst[length++] = 'D';
+
+    return length + formatExponent(exp, dst + length);
+}
+
+int Ewoms::EclIO::formatDoubIx(double value, char* dst)
+{
+    if (value == 0.0)
+        return copyString(" 0.0000000000000E+00", dst);
+
+    if (!std::isfinite(value))
+        return formatNonFinite(value, dst);
+
+    return formatScientific(value, 13, dst);
+}
+
+double Ewoms::EclIO::parseFormattedDouble(const char* first, const char* last)
+{
+    return parseFormattedToken(first, last);
+}
+
 template<typename T>
 std::vector<T> Ewoms::EclIO::readFormattedArray(const std::string& file_str, const int size, int64_t fromPos,
                                  std::function<T(const std::string&)>& process)
@@ -589,16 +916,9 @@ std::vector<std::string> Ewoms::EclIO::readFormattedCharArray(const std::string&
 
 std::vector<float> Ewoms::EclIO::readFormattedRealArray(const std::string& file_str, const int64_t size, int64_t fromPos)
 {
-
-    std::function<float(const std::string&)> f = [](const std::string& val)
-                                                 {
-                                                     // tskille: temporary fix, need to be discussed. OPM flow writes numbers
-                                                     // that are outside valid range for float, and function stof will fail
-                                                     double dtmpv = std::stod(val);
-                                                     return dtmpv;
-                                                 };
-
-    return readFormattedArray<float>(file_str, size, fromPos, f);
+    // tskille: temporary fix, need to be discussed. OPM flow writes numbers
+    // that are outside valid range for float, and function stof will fail
+    return readFormattedNumbers<float>(file_str, size, fromPos);
 }
 
 std::vector<std::string> Ewoms::EclIO::readFormattedRealRawStrings(const std::string& file_str, const int64_t size, int64_t fromPos)
@@ -632,26 +952,6 @@ std::vector<bool> Ewoms::EclIO::readFormattedLogiArray(const std::string& file_s
 
 std::vector<double> Ewoms::EclIO::readFormattedDoubArray(const std::string& file_str, const int64_t size, int64_t fromPos)
 {
-
-    std::function<double(const std::string&)> f = [](std::string val)
-                                                  {
-                                                      auto p1 = val.find_first_of("D");
-
-                                                      if (p1 != std::string::npos) {
-                                                          val.replace(p1,1,"E");
-                                                      }
-
-                                                      p1 = val.find_first_of("E");
-
-                                                      if (p1 == std::string::npos) {
-                                                          auto p2 = val.find_first_of("-+", 1);
-
-                                                          if (p2 != std::string::npos)
-                                                              val = val.insert(p2,"E");
-                                                      }
-                                                      return std::stod(val);
-                                                  };
-
-    return readFormattedArray<double>(file_str, size, fromPos, f);
+    return readFormattedNumbers<double>(file_str, size, fromPos);
 }
 
@@ -25,6 +25,7 @@
 #include <tuple>
 #include <vector>
 #include <functional>
+#include <iosfwd>
 
 namespace Ewoms { namespace EclIO {
 
@@ -44,26 +45,32 @@ namespace Ewoms { namespace EclIO {
     uint64_t sizeOnDiskBinary(int64_t num, Ewoms::EclIO::eclArrType arrType, int elementSize);
     uint64_t sizeOnDiskFormatted(const int64_t num, Ewoms::EclIO::eclArrType arrType, int elementSize);
 
-    void readBinaryHeader(std::fstream& fileH, std::string& tmpStrName,
+    void readBinaryHeader(std::istream& fileH, std::string& tmpStrName,
                       int& tmpSize, std::string& tmpStrType);
 
-    void readBinaryHeader(std::fstream& fileH, std::string& arrName,
+    void readBinaryHeader(std::istream& fileH, std::string& arrName,
                       int64_t& size, Ewoms::EclIO::eclArrType &arrType, int& elementSize);
 
     void readFormattedHeader(std::fstream& fileH, std::string& arrName,
                       int64_t &num, Ewoms::EclIO::eclArrType &arrType, int& elementSize);
 
     template<typename T, typename T2>
-    std::vector<T> readBinaryArray(std::fstream& fileH, const int64_t size, Ewoms::EclIO::eclArrType type,
+    std::vector<T> readBinaryArray(std::istream& fileH, const int64_t size, Ewoms::EclIO::eclArrType type,
                                std::function<T(T2)>& flip, int elementSize);
 
-    std::vector<int> readBinaryInteArray(std::fstream &fileH, const int64_t size);
-    std::vector<float> readBinaryRealArray(std::fstream& fileH, const int64_t size);
-    std::vector<double> readBinaryDoubArray(std::fstream& fileH, const int64_t size);
-    std::vector<bool> readBinaryLogiArray(std::fstream &fileH, const int64_t size);
-    std::vector<unsigned int> readBinaryRawLogiArray(std::fstream &fileH, const int64_t size);
-    std::vector<std::string> readBinaryCharArray(std::fstream& fileH, const int64_t size);
-    std::vector<std::string> readBinaryC0nnArray(std::fstream& fileH, const int64_t size, int elementSize);
+    std::vector<int> readBinaryInteArray(std::istream &fileH, const int64_t size);
+    std::vector<float> readBinaryRealArray(std::istream& fileH, const int64_t size);
+    std::vector<double> readBinaryDoubArray(std::istream& fileH, const int64_t size);
+    std::vector<bool> readBinaryLogiArray(std::istream &fileH, const int64_t size);
+    std::vector<unsigned int> readBinaryRawLogiArray(std::istream &fileH, const int64_t size);
+    std::vector<std::string> readBinaryCharArray(std::istream& fileH, const int64_t size);
+    std::vector<std::string> readBinaryC0nnArray(std::istream& fileH, const int64_t size, int elementSize);
+
+    // Read a binary REAL or DOUB array of the given size into dst as
+    // scale*x + offset in double precision. Byte swap, widening and
+    // scaling are done in a single pass over each data record.
+    void readBinaryArrayAsDouble(std::istream& fileH, const int64_t size, Ewoms::EclIO::eclArrType type,
+                                 double scale, double offset, double* dst);
 
     template<typename T>
     std::vector<T> readFormattedArray(const std::string& file_str, const int size, int64_t fromPos,
@@ -80,6 +87,21 @@ namespace Ewoms { namespace EclIO {
     std::vector<bool> readFormattedLogiArray(const std::string& file_str, const int64_t size, int64_t fromPos);
     std::vector<double> readFormattedDoubArray(const std::string& file_str, const int64_t size, int64_t fromPos);
 
+    // Text representation of REAL and DOUB values in formatted files, in
+    // the Eclipse and the IX dialect. The functions write at most
+    // maxFormattedValueLength characters to dst, without a terminating
+    // null character, and return the number of characters written.
+    const int maxFormattedValueLength = 32;
+
+    int formatRealEcl(float value, char* dst);
+    int formatRealIx(float value, char* dst);
+    int formatDoubEcl(double value, char* dst);
+    int formatDoubIx(double value, char* dst);
+
+    // Parse a REAL or DOUB value from a formatted file; the exponent may
+    // be marked with 'E' or 'D', or be given by its sign only.
+    double parseFormattedDouble(const char* first, const char* last);
+
 }} // namespace Ewoms::EclIO
 
 #endif // EWOMS_IO_ECLUTIL_H
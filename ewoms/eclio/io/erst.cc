@@ -62,6 +62,18 @@ ERst::ERst(const std::string& filename)
     }
 }
 
+ERst::ERst(const std::string& filename, const std::vector<int>& reportStepNumbers)
+    : EclFile(filename, reportStepNumbers)
+{
+    // No arrays are left of unified files without the selected steps.
+    if (this->array_name.empty() || this->hasKey("SEQNUM")) {
+        this->initUnified();
+    }
+    else {
+        this->initSeparate(seqnumFromSeparateFilename(filename));
+    }
+}
+
 bool ERst::hasReportStepNumber(int number) const
 {
     auto search = arrIndexRange.find(number);
@@ -165,14 +177,27 @@ int ERst::occurrence_count(const std::string& name, int reportStepNumber) const
 
 void ERst::initUnified()
 {
-    loadData("SEQNUM");
+    // Files with a seek index know their report steps without loading
+    // the SEQNUM arrays.
+    if (reportStepIndex.empty())
+        loadData("SEQNUM");
 
     std::vector<int> firstIndex;
+    auto step = reportStepIndex.begin();
 
     for (size_t i = 0;  i < array_name.size(); i++) {
         if (array_name[i] == "SEQNUM") {
-            auto seqn = get<int>(i);
-            seqnum.push_back(seqn[0]);
+            if (reportStepIndex.empty()) {
+                auto seqn = get<int>(i);
+                seqnum.push_back(seqn[0]);
+            } else {
+                if (step == reportStepIndex.end() || step->firstArray != i)
+                    EWOMS_THROW(std::runtime_error, "Seek index of " + inputFilename + " does not match its SEQNUM arrays");
+
+                seqnum.push_back(step->seqnum);
+                ++step;
+            }
+
             firstIndex.push_back(i);
             lgr_names.push_back({});
         }
@@ -301,6 +326,27 @@ int ERst::getArrayIndex(const std::string& name, int number, int occurrenc)
     return std::distance(array_name.begin(), it);
 }
 
+std::vector<double> ERst::readRestartDataAsDouble(const std::string& name, int number,
+                                                 double scale, double offset) const
+{
+    if (!hasReportStepNumber(number)) {
+        std::string message = "Trying to get vector " + name + " from non existing sequence " + std::to_string(number);
+        EWOMS_THROW(std::invalid_argument, message);
+    }
+
+    const auto& indexRange = arrIndexRange.at(number);
+
+    auto it = std::find(array_name.begin() + indexRange.first,
+                        array_name.begin() + indexRange.second, name);
+
+    if (std::distance(array_name.begin(), it) == indexRange.second) {
+        std::string message = "Array " + name + " not found in sequence " + std::to_string(number);
+        EWOMS_THROW(std::runtime_error, message);
+    }
+
+    return this->readAsDouble(std::distance(array_name.begin(), it), scale, offset);
+}
+
 int ERst::getArrayIndex(const std::string& name, int number, const std::string& lgr_name)
 {
     auto range_it = arrIndexRange.find(number);
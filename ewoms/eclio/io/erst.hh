@@ -38,6 +38,11 @@ class ERst : public EclFile
 public:
     explicit ERst(const std::string& filename);
 
+    // Lazy open: only the given report steps of a unified restart file
+    // are available, and only their array headers are read. Separate
+    // restart files are opened completely.
+    ERst(const std::string& filename, const std::vector<int>& reportStepNumbers);
+
     bool hasReportStepNumber(int number) const;
     bool hasLGR(const std::string& gridname, int reportStepNumber) const;
 
@@ -74,6 +79,11 @@ public:
         return  this->get<T>(index + start_ind);
     }
 
+    // Read a REAL or DOUB array of a report step as scale*x + offset in
+    // double precision, see EclFile::readAsDouble().
+    std::vector<double> readRestartDataAsDouble(const std::string& name, int reportStepNumber,
+                                                double scale = 1.0, double offset = 0.0) const;
+
     int occurrence_count(const std::string& name, int reportStepNumber) const;
     size_t numberOfReportSteps() const { return seqnum.size(); };
 
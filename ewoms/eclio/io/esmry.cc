@@ -23,6 +23,7 @@
 #include <ewoms/eclio/io/esmry.hh>
 #include <ewoms/common/filesystem.hh>
 #include <ewoms/eclio/utility/timeservice.hh>
+#include <ewoms/eclio/io/eclcompress.hh>
 #include <ewoms/eclio/io/eclfile.hh>
 #include <ewoms/eclio/io/eclutil.hh>
 #include <ewoms/eclio/io/ecloutput.hh>
@@ -85,6 +86,26 @@ std::chrono::system_clock::time_point make_date(const std::vector<int>& datetime
 
 namespace Ewoms { namespace EclIO {
 
+namespace {
+
+    // PARAMS array 'arrIndex' of a compressed summary data file.
+    std::vector<float> readCompressedParams(std::istream& fileH,
+                                            const std::vector<CompressedArray>& index,
+                                            uint64_t arrIndex)
+    {
+        CompressedArrayStream input(fileH, index[arrIndex]);
+
+        std::string arrName;
+        int64_t size;
+        eclArrType arrType;
+        int sizeOfElement;
+        readBinaryHeader(input, arrName, size, arrType, sizeOfElement);
+
+        return readBinaryRealArray(input, size);
+    }
+
+}
+
 ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
     inputFileName { filename },
     summaryNodes { }
@@ -436,6 +457,8 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData) :
                 if (std::find(dataFileList.begin(), dataFileList.end(), std::get<1>(arraySourceList[i])) == dataFileList.end())
                 {
                     dataFileList.push_back(std::get<1>(arraySourceList[i]));
+                    compressedDataFiles.push_back(!formattedFiles[specInd] &&
+                                                  isCompressedEclFile(dataFileList.back()));
                     dataFileIndex++;
                 }
 
@@ -654,11 +677,17 @@ void ESmry::LoadData(const std::vector<std::string>& vectList) const
             blockSize_f= static_cast<uint64_t>(MaxNumBlockReal * numColumnsReal * columnWidthReal + nLinesBlock);
         }
 
+        std::vector<CompressedArray> compressedIndex;
+        std::vector<float> params;
+
         if (formattedFiles[specInd])
             fileH.open(dataFileList[dataFileIndex], std::ios::in);
         else
             fileH.open(dataFileList[dataFileIndex], std::ios::in |  std::ios::binary);
 
+        if (compressedDataFiles[dataFileIndex])
+            compressedIndex = readCompressedIndex(fileH);
+
         for (auto ministep : timeStepList) {
 
             if (dataFileIndex != std::get<1>(ministep)) {
@@ -670,10 +699,18 @@ void ESmry::LoadData(const std::vector<std::string>& vectList) const
                     fileH.open(dataFileList[dataFileIndex], std::ios::in );
                 else
                     fileH.open(dataFileList[dataFileIndex], std::ios::in |  std::ios::binary);
+
+                if (compressedDataFiles[dataFileIndex])
+                    compressedIndex = readCompressedIndex(fileH);
             }
 
             stepFilePos = std::get<2>(ministep);;
 
+            // Compressed files hold the array index instead of a file
+            // position, the whole PARAMS array is decompressed.
+            if (compressedDataFiles[dataFileIndex])
+                params = readCompressedParams(fileH, compressedIndex, stepFilePos);
+
             for (auto ind : keywIndVect) {
 
                 auto it = arrayPos[specInd].find(ind);
@@ -685,7 +722,10 @@ void ESmry::LoadData(const std::vector<std::string>& vectList) const
                 } else {
                     int paramPos = it->second;
 
-                    if (formattedFiles[specInd]) {
+                    if (compressedDataFiles[dataFileIndex]) {
+                        vectorData[ind].push_back(params[paramPos]);
+
+                    } else if (formattedFiles[specInd]) {
                         uint64_t elementPos = 0;
                         int nBlocks = paramPos / MaxBlockSizeReal;
                         int sizeOfLastBlock = paramPos %  MaxBlockSizeReal;
@@ -766,12 +806,16 @@ void ESmry::LoadData() const
         uint64_t stepFilePos = std::get<2>(timeStepList[0]);
 
         std::vector<int> keywpos = makeKeywPosVector(specInd);
+        std::vector<CompressedArray> compressedIndex;
 
         if (formattedFiles[specInd])
             fileH.open(dataFileList[dataFileIndex], std::ios::in);
         else
             fileH.open(dataFileList[dataFileIndex], std::ios::in |  std::ios::binary);
 
+        if (compressedDataFiles[dataFileIndex])
+            compressedIndex = readCompressedIndex(fileH);
+
         for (auto ministep : timeStepList) {
 
             if (dataFileIndex != std::get<1>(ministep)) {
@@ -788,10 +832,24 @@ void ESmry::LoadData() const
                     fileH.open(dataFileList[dataFileIndex], std::ios::in );
                 else
                     fileH.open(dataFileList[dataFileIndex], std::ios::in |  std::ios::binary);
+
+                if (compressedDataFiles[dataFileIndex])
+                    compressedIndex = readCompressedIndex(fileH);
             }
 
             stepFilePos = std::get<2>(ministep);
             int maxNumberOfElements = MaxBlockSizeReal / sizeOfReal;
+
+            if (compressedDataFiles[dataFileIndex]) {
+                const auto params = readCompressedParams(fileH, compressedIndex, stepFilePos);
+
+                for (int p = 0; p < nParamsSpecFile[specInd]; p++)
+                    if ((keywpos[p] > -1) && (!vectorLoaded[keywpos[p]]))
+                        vectorData[keywpos[p]].push_back(params[p]);
+
+                continue;
+            }
+
             fileH.seekg (stepFilePos, fileH.beg);
 
             if (formattedFiles[specInd]) {
@@ -871,6 +929,18 @@ ESmry::getListOfArrays(std::string filename, bool formatted)
 {
     std::vector<std::tuple <std::string, uint64_t>> resultVect;
 
+    // Arrays in compressed files are identified by their position in the
+    // file's index.
+    if (!formatted && isCompressedEclFile(filename)) {
+        std::ifstream fileH(filename, std::ios::binary);
+        const auto index = readCompressedIndex(fileH);
+
+        for (std::size_t n = 0; n < index.size(); n++)
+            resultVect.emplace_back(index[n].name, n);
+
+        return resultVect;
+    }
+
     FILE *ptr;
     char arrName[9];
     char numstr[13];
@@ -84,6 +84,7 @@ private:
 
     std::vector<bool> formattedFiles;
     std::vector<std::string> dataFileList;
+    std::vector<bool> compressedDataFiles;
     mutable std::vector<std::vector<float>> vectorData;
     mutable std::vector<bool> vectorLoaded;
     std::vector<TimeStepEntry> timeStepList;
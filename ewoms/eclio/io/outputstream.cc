@@ -22,6 +22,7 @@
 
 #include <ewoms/eclio/opmlog/opmlog.hh>
 
+#include <ewoms/eclio/io/eclseekindex.hh>
 #include <ewoms/eclio/io/ecloutput.hh>
 #include <ewoms/eclio/io/erst.hh>
 
@@ -146,8 +147,17 @@ namespace {
 
             std::unique_ptr<Ewoms::EclIO::EclOutput>
             writeNew(const std::string& filename,
-                     const bool         isFmt)
+                     const bool         isFmt,
+                     const bool         isCompressed)
             {
+                if (isCompressed && !isFmt)
+                    return std::unique_ptr<Ewoms::EclIO::EclOutput> {
+                        new Ewoms::EclIO::EclOutput {
+                            filename, isFmt, std::ios_base::out,
+                            Ewoms::EclIO::CompressionOptions{}
+                        }
+                    };
+
                 return std::unique_ptr<Ewoms::EclIO::EclOutput> {
                     new Ewoms::EclIO::EclOutput {
                         filename, isFmt, std::ios_base::out
@@ -157,8 +167,17 @@ namespace {
 
             std::unique_ptr<Ewoms::EclIO::EclOutput>
             writeExisting(const std::string& filename,
-                          const bool         isFmt)
+                          const bool         isFmt,
+                          const bool         isCompressed)
             {
+                if (isCompressed && !isFmt)
+                    return std::unique_ptr<Ewoms::EclIO::EclOutput> {
+                        new Ewoms::EclIO::EclOutput {
+                            filename, isFmt, std::ios_base::app,
+                            Ewoms::EclIO::CompressionOptions{}
+                        }
+                    };
+
                 return std::unique_ptr<Ewoms::EclIO::EclOutput> {
                     new Ewoms::EclIO::EclOutput {
                         filename, isFmt, std::ios_base::app
@@ -290,10 +309,11 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
 // =====================================================================
 
 Ewoms::EclIO::OutputStream::Restart::
-Restart(const ResultSet& rset,
-        const int        seqnum,
-        const Formatted& fmt,
-        const Unified&   unif)
+Restart(const ResultSet&  rset,
+        const int         seqnum,
+        const Formatted&  fmt,
+        const Unified&    unif,
+        const Compressed& comp)
 {
     const auto ext = FileExtension::
         restart(seqnum, fmt.set, unif.set);
@@ -302,7 +322,11 @@ Restart(const ResultSet& rset,
 
     if (unif.set) {
         // Run uses unified restart files.
-        this->openUnified(fname, fmt.set, seqnum);
+        this->openUnified(fname, fmt.set, comp.set, seqnum);
+
+        if (this->seekIndex_ != nullptr) {
+            this->seekIndex_->addReportStep(seqnum);
+        }
 
         // Write SEQNUM value to stream to start new output sequence.
         this->stream_->write("SEQNUM", std::vector<int>{ seqnum });
@@ -310,21 +334,31 @@ Restart(const ResultSet& rset,
     else {
         // Run uses separate, not unified, restart files.  Create a
         // new output file and open an output stream on it.
-        this->openNew(fname, fmt.set);
+        this->openNew(fname, fmt.set, comp.set);
     }
 }
 
 Ewoms::EclIO::OutputStream::Restart::~Restart()
-{}
+{
+    this->closeStream();
+}
 
 Ewoms::EclIO::OutputStream::Restart::Restart(Restart&& rhs)
-    : stream_{ std::move(rhs.stream_) }
+    : stream_   { std::move(rhs.stream_) }
+    , seekIndex_{ std::move(rhs.seekIndex_) }
+    , appendSeekIndex_{ rhs.appendSeekIndex_ }
+    , fname_    { std::move(rhs.fname_) }
 {}
 
 Ewoms::EclIO::OutputStream::Restart&
 Ewoms::EclIO::OutputStream::Restart::operator=(Restart&& rhs)
 {
-    this->stream_ = std::move(rhs.stream_);
+    this->closeStream();
+
+    this->stream_    = std::move(rhs.stream_);
+    this->seekIndex_ = std::move(rhs.seekIndex_);
+    this->appendSeekIndex_ = rhs.appendSeekIndex_;
+    this->fname_     = std::move(rhs.fname_);
 
     return *this;
 }
@@ -381,6 +415,7 @@ void
 Ewoms::EclIO::OutputStream::Restart::
 openUnified(const std::string& fname,
             const bool         formatted,
+            const bool         compressed,
             const int          seqnum)
 {
     // Determine if we're creating a new output/restart file or
@@ -390,7 +425,11 @@ openUnified(const std::string& fname,
 
     if (rst == nullptr) {
         // No such unified restart file exists.  Create new file.
-        this->openNew(fname, formatted);
+        this->openNew(fname, formatted, compressed);
+
+        if (! formatted && ! compressed) {
+            this->startSeekIndex(fname, SeekIndex{}, false);
+        }
     }
     else if (! rst->hasKey("SEQNUM")) {
         // File with correct filename exists but does not appear
@@ -404,27 +443,103 @@ openUnified(const std::string& fname,
     else {
         // Restart file exists and appears to be a unified restart
         // resource.  Open writable restart stream backed by the
-        // specific file.
-        this->openExisting(fname, formatted,
-                           rst->restartStepWritePosition(seqnum));
+        // specific file, keeping the file's compression mode.
+        //
+        // An existing seek index must be checked before the file is
+        // resized.  When the next report step is appended, which is the
+        // normal case, only its own arrays are added to the sidecar file;
+        // loading and rewriting the whole index for every report step
+        // would make the index output quadratic in the number of steps.
+        const auto rstCompressed = rst->compressedInput();
+        const auto writePos = rst->restartStepWritePosition(seqnum);
+        const auto indexed = ! formatted && ! rstCompressed;
+
+        if (writePos == std::streampos(-1)) {
+            const auto current = indexed && SeekIndex::isCurrent(fname);
+
+            this->openExisting(fname, formatted, rstCompressed, writePos);
+
+            if (current) {
+                this->startSeekIndex(fname, SeekIndex{}, true);
+            }
+            else {
+                SeekIndex::remove(fname);
+            }
+
+            return;
+        }
+
+        // Rewriting from an earlier report step cuts the index along with
+        // the file, so it is loaded and saved in full.
+        auto index = indexed
+            ? SeekIndex::load(fname) : Ewoms::optional<SeekIndex>{};
+
+        this->openExisting(fname, formatted, rstCompressed, writePos);
+
+        if (index.has_value()) {
+            index->truncate(static_cast<uint64_t>(std::streamoff(writePos)));
+            this->startSeekIndex(fname, std::move(*index), false);
+        }
+        else {
+            SeekIndex::remove(fname);
+        }
+    }
+}
+
+void
+Ewoms::EclIO::OutputStream::Restart::
+startSeekIndex(const std::string& fname, SeekIndex&& index, const bool append)
+{
+    this->seekIndex_.reset(new SeekIndex(std::move(index)));
+    this->appendSeekIndex_ = append;
+    this->fname_ = fname;
+
+    this->stream_->recordSeekIndex(this->seekIndex_.get());
+}
+
+void
+Ewoms::EclIO::OutputStream::Restart::closeStream()
+{
+    this->stream_.reset();
+
+    if (this->seekIndex_ == nullptr) {
+        return;
     }
+
+    // A missing index only makes later readers walk the file headers, so
+    // failing to save it must not fail the restart output.
+    try {
+        if (this->appendSeekIndex_) {
+            this->seekIndex_->append(this->fname_);
+        }
+        else {
+            this->seekIndex_->save(this->fname_);
+        }
+    }
+    catch (const std::exception&) {
+        SeekIndex::remove(this->fname_);
+    }
+
+    this->seekIndex_.reset();
 }
 
 void
 Ewoms::EclIO::OutputStream::Restart::
 openNew(const std::string& fname,
-        const bool         formatted)
+        const bool         formatted,
+        const bool         compressed)
 {
-    this->stream_ = Open::Restart::writeNew(fname, formatted);
+    this->stream_ = Open::Restart::writeNew(fname, formatted, compressed);
 }
 
 void
 Ewoms::EclIO::OutputStream::Restart::
 openExisting(const std::string&   fname,
              const bool           formatted,
+             const bool           compressed,
              const std::streampos writePos)
 {
-    this->stream_ = Open::Restart::writeExisting(fname, formatted);
+    this->stream_ = Open::Restart::writeExisting(fname, formatted, compressed);
 
     if (writePos == std::streampos(-1)) {
         // No specified initial write position.  Typically the case if
@@ -444,6 +559,14 @@ openExisting(const std::string&   fname,
     // already opened 'stream_'.  In other words, 'open' followed by
     // resize_file() followed by seekp() is the intended and expected
     // order of operations.
+    //
+    // Compressed files are cut at the start of the frame holding the
+    // array at 'writePos', and their index is rewritten accordingly.
+
+    if (this->stream_->compressedFile) {
+        this->stream_->compressedFile->truncate(writePos);
+        return;
+    }
 
     Ewoms::filesystem::resize_file(fname, writePos);
 
@@ -780,13 +903,22 @@ Ewoms::EclIO::OutputStream::SummarySpecification::stream()
 // =====================================================================
 
 std::unique_ptr<Ewoms::EclIO::EclOutput>
-Ewoms::EclIO::OutputStream::createSummaryFile(const ResultSet& rset,
-                                            const int        seqnum,
-                                            const Formatted& fmt,
-                                            const Unified&   unif)
+Ewoms::EclIO::OutputStream::createSummaryFile(const ResultSet&  rset,
+                                            const int         seqnum,
+                                            const Formatted&  fmt,
+                                            const Unified&    unif,
+                                            const Compressed& comp)
 {
     const auto ext = FileExtension::summary(seqnum, fmt.set, unif.set);
 
+    if (comp.set && !fmt.set)
+        return std::unique_ptr<Ewoms::EclIO::EclOutput> {
+            new Ewoms::EclIO::EclOutput {
+                outputFileName(rset, ext), fmt.set, std::ios_base::out,
+                CompressionOptions{}
+            }
+        };
+
     return std::unique_ptr<Ewoms::EclIO::EclOutput> {
         new Ewoms::EclIO::EclOutput {
             outputFileName(rset, ext),
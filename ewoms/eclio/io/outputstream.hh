@@ -31,6 +31,7 @@
 namespace Ewoms { namespace EclIO {
 
     class EclOutput;
+    class SeekIndex;
 
 }} // namespace Ewoms::EclIO
 
@@ -39,6 +40,10 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
     struct Formatted { bool set; };
     struct Unified   { bool set; };
 
+    /// Whether or not to write binary output as block compressed files,
+    /// see eclcompress.hh.  Formatted output is never compressed.
+    struct Compressed { bool set; };
+
     /// Abstract representation of an ECLIPSE-style result set.
     struct ResultSet
     {
@@ -150,10 +155,15 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
         /// \param[in] fmt Whether or not to create formatted output files.
         ///
         /// \param[in] unif Whether or not to create unified output files.
-        explicit Restart(const ResultSet& rset,
-                         const int        seqnum,
-                         const Formatted& fmt,
-                         const Unified&   unif);
+        ///
+        /// \param[in] comp Whether or not to create compressed output
+        ///    files.  An existing unified restart file is continued in
+        ///    its own format.
+        explicit Restart(const ResultSet&  rset,
+                         const int         seqnum,
+                         const Formatted&  fmt,
+                         const Unified&    unif,
+                         const Compressed& comp = Compressed{ false });
 
         ~Restart();
 
@@ -224,6 +234,32 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
         /// Restart output stream.
         std::unique_ptr<EclOutput> stream_;
 
+        /// Seek index of a unified, binary and uncompressed restart
+        /// file.  Saved next to the file when the stream is closed.
+        std::unique_ptr<SeekIndex> seekIndex_;
+
+        /// Whether \c seekIndex_ only holds the arrays written by this
+        /// stream, which are appended to the existing sidecar file.
+        bool appendSeekIndex_{false};
+
+        /// Filename of the output stream indexed by \c seekIndex_.
+        std::string fname_;
+
+        /// Start maintaining seek index of output stream.
+        ///
+        /// \param[in] fname Filename of output stream.
+        ///
+        /// \param[in] index Existing arrays of output stream.
+        ///
+        /// \param[in] append Whether \p index is empty and the new arrays
+        ///    are appended to the current sidecar file of \p fname.
+        void startSeekIndex(const std::string& fname, SeekIndex&& index,
+                            const bool append);
+
+        /// Close output stream and save its seek index, if any.  A seek
+        /// index that cannot be saved is removed.
+        void closeStream();
+
         /// Open unified output file and place stream's output indicator
         /// in appropriate location.
         ///
@@ -234,10 +270,14 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
         /// \param[in] formatted Whether or not to create a
         ///    formatted output file.
         ///
+        /// \param[in] compressed Whether or not to create a
+        ///    compressed output file.
+        ///
         /// \param[in] seqnum Sequence number of new report.  One-based
         ///    report step ID.
         void openUnified(const std::string& fname,
                          const bool         formatted,
+                         const bool         compressed,
                          const int          seqnum);
 
         /// Open new output stream.
@@ -249,8 +289,12 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
         ///
         /// \param[in] formatted Whether or not to create a
         ///    formatted output file.
+        ///
+        /// \param[in] compressed Whether or not to create a
+        ///    compressed output file.
         void openNew(const std::string& fname,
-                     const bool         formatted);
+                     const bool         formatted,
+                     const bool         compressed);
 
         /// Open existing output file and place stream's output indicator
         /// in appropriate location.
@@ -264,6 +308,7 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
         ///    place output indicator at end of file (i.e, simple append).
         void openExisting(const std::string&   fname,
                           const bool           formatted,
+                          const bool           compressed,
                           const std::streampos writePos);
 
         /// Access writable output stream.
@@ -428,10 +473,11 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
     };
 
     std::unique_ptr<EclOutput>
-    createSummaryFile(const ResultSet& rset,
-                      const int        seqnum,
-                      const Formatted& fmt,
-                      const Unified&   unif);
+    createSummaryFile(const ResultSet&  rset,
+                      const int         seqnum,
+                      const Formatted&  fmt,
+                      const Unified&    unif,
+                      const Compressed& comp = Compressed{ false });
 
     /// Derive filename corresponding to output stream of particular result
     /// set, with user-specified file extension.
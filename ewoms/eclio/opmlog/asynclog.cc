@@ -0,0 +1,220 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <ewoms/eclio/opmlog/asynclog.hh>
+
+namespace Ewoms {
+
+namespace {
+
+    std::size_t roundUpPower2(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n)
+            p *= 2;
+
+        return p;
+    }
+
+}
+
+AsyncLog::AsyncLog(std::shared_ptr<LogBackend> backend,
+                   std::size_t queueCapacity,
+                   OverflowPolicy overflowPolicy,
+                   int64_t flushMask)
+    : LogBackend(backend ? backend->getMask() : 0),
+      m_backend(std::move(backend)),
+      m_overflowPolicy(overflowPolicy),
+      m_flushMask(flushMask),
+      m_cells(roundUpPower2(queueCapacity)),
+      m_cellMask(m_cells.size() - 1),
+      m_enqueuePos(0),
+      m_dropped(0),
+      m_dequeuePos(0),
+      m_processed(0),
+      m_writerIdle(false),
+      m_stop(false)
+{
+    if (!m_backend)
+        throw std::invalid_argument("AsyncLog requires a backend to forward messages to");
+
+    for (std::size_t i = 0; i < m_cells.size(); ++i)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+
+    m_writer = std::thread([this]() { this->writerLoop(); });
+}
+
+AsyncLog::~AsyncLog() {
+    m_stop.store(true);
+    this->wakeWriter();
+    m_writer.join();
+}
+
+void AsyncLog::addTaggedMessage(int64_t messageFlag, const std::string& messageTag, const std::string& message) {
+    // The mask check is repeated by the wrapped backend, doing it here as
+    // well avoids queueing messages which will be discarded anyway.
+    if ((messageFlag & this->getMask()) != messageFlag || messageFlag <= 0)
+        return;
+
+    this->enqueue(messageFlag, messageTag, message);
+}
+
+void AsyncLog::addMessageUnconditionally(int64_t messageFlag, const std::string& message) {
+    this->enqueue(messageFlag, "", message);
+}
+
+void AsyncLog::enqueue(int64_t messageFlag, const std::string& messageTag, const std::string& message) {
+    const bool critical = (messageFlag & m_flushMask) != 0;
+
+    while (!this->tryPush(messageFlag, messageTag, message)) {
+        if (!critical && m_overflowPolicy == OverflowPolicy::Drop) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        this->wakeWriter();
+        std::this_thread::yield();
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerIdle.load())
+        this->wakeWriter();
+
+    if (critical)
+        this->flush();
+}
+
+/*
+  Bounded queue after D. Vyukov: every cell carries a sequence number
+  which tells producers whether the cell is free for the current lap
+  (sequence == pos) and the consumer whether it has been filled
+  (sequence == pos + 1).
+*/
+bool AsyncLog::tryPush(int64_t messageFlag, const std::string& messageTag, const std::string& message) {
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &m_cells[pos & m_cellMask];
+        const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0)
+            return false;
+        else
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    cell->entry.flag = messageFlag;
+    cell->entry.tag = messageTag;
+    cell->entry.message = message;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLog::tryPop(Entry& entry) {
+    Cell& cell = m_cells[m_dequeuePos & m_cellMask];
+    if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+        return false;
+
+    std::swap(entry, cell.entry);
+    cell.sequence.store(m_dequeuePos + m_cells.size(), std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+void AsyncLog::wakeWriter() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeup.notify_one();
+}
+
+void AsyncLog::writerLoop() {
+    Entry entry;
+    std::size_t reportedDropped = 0;
+
+    while (true) {
+        bool gotEntry = this->tryPop(entry);
+        if (gotEntry) {
+            try {
+                m_backend->addTaggedMessage(entry.flag, entry.tag, entry.message);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_error)
+                    m_error = std::current_exception();
+            }
+            m_processed.fetch_add(1, std::memory_order_release);
+            continue;
+        }
+
+        const std::size_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped) {
+            if (this->getMask() & Log::MessageType::Warning)
+                m_backend->addMessage(Log::MessageType::Warning,
+                                      "Log queue overflow: " + std::to_string(dropped - reportedDropped) + " messages were dropped");
+            reportedDropped = dropped;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_progress.notify_all();
+            if (m_stop.load() && m_processed.load() == m_enqueuePos.load())
+                return;
+
+            // Announce that we are about to sleep before looking at the
+            // queue a last time; together with the fence in enqueue() this
+            // ensures that a producer either sees the flag or we see its
+            // message.
+            m_writerIdle.store(true);
+            const Cell& next = m_cells[m_dequeuePos & m_cellMask];
+            if (next.sequence.load() != m_dequeuePos + 1)
+                m_wakeup.wait_for(lock, std::chrono::milliseconds(100));
+            m_writerIdle.store(false);
+        }
+    }
+}
+
+void AsyncLog::flush() {
+    const std::size_t target = m_enqueuePos.load();
+    this->wakeWriter();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_processed.load(std::memory_order_acquire) < target)
+        m_progress.wait_for(lock, std::chrono::milliseconds(1));
+
+    if (m_error) {
+        auto error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+std::size_t AsyncLog::numDropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<LogBackend> AsyncLog::backend() const {
+    return m_backend;
+}
+
+} // namespace Ewoms
@@ -0,0 +1,142 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_ASYNCLOG_H
+#define EWOMS_ASYNCLOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ewoms/eclio/opmlog/logbackend.hh>
+#include <ewoms/eclio/opmlog/logutil.hh>
+
+namespace Ewoms {
+
+/*!
+ * \brief Log backend which forwards messages to another backend on a
+ *        dedicated writer thread.
+ *
+ * Messages are put on a bounded lock-free multi-producer/single-consumer
+ * queue, so any number of threads may log through the same AsyncLog
+ * concurrently. All formatting, message limiting and I/O is done by the
+ * wrapped backend on the writer thread; message formatters and limiters
+ * should therefore be configured on the wrapped backend and not on the
+ * AsyncLog itself.
+ *
+ * Messages whose type is contained in the flush mask (errors, problems
+ * and bugs by default) are never dropped and the call does not return
+ * before they have been handed to the wrapped backend, so that they are
+ * not lost if the process terminates right afterwards.
+ */
+class AsyncLog : public LogBackend {
+public:
+    /// What to do if a message is added while the queue is full.
+    enum class OverflowPolicy {
+        Block, //!< Wait until the writer thread has made room.
+        Drop   //!< Discard the message and count it in numDropped().
+    };
+
+    static const int64_t DefaultFlushMask = Log::MessageType::Error
+                                          | Log::MessageType::Problem
+                                          | Log::MessageType::Bug;
+
+    /// Wrap \p backend. The capacity of the queue is rounded up to the
+    /// next power of two.
+    explicit AsyncLog(std::shared_ptr<LogBackend> backend,
+                      std::size_t queueCapacity = 4096,
+                      OverflowPolicy overflowPolicy = OverflowPolicy::Block,
+                      int64_t flushMask = DefaultFlushMask);
+
+    /// Process all pending messages and stop the writer thread.
+    ~AsyncLog();
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    void addTaggedMessage(int64_t messageFlag,
+                          const std::string& messageTag,
+                          const std::string& message) override;
+
+    /// Wait until all messages added before the call have been passed to
+    /// the wrapped backend. If the wrapped backend threw an exception
+    /// since the last call, it is rethrown here.
+    void flush();
+
+    /// Number of messages which have been discarded because the queue
+    /// was full.
+    std::size_t numDropped() const;
+
+    std::shared_ptr<LogBackend> backend() const;
+
+protected:
+    void addMessageUnconditionally(int64_t messageFlag,
+                                   const std::string& message) override;
+
+private:
+    struct Entry {
+        int64_t flag = 0;
+        std::string tag;
+        std::string message;
+    };
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Entry entry;
+    };
+
+    bool tryPush(int64_t messageFlag, const std::string& messageTag, const std::string& message);
+    bool tryPop(Entry& entry);
+    void enqueue(int64_t messageFlag, const std::string& messageTag, const std::string& message);
+    void writerLoop();
+    void wakeWriter();
+
+    std::shared_ptr<LogBackend> m_backend;
+    OverflowPolicy m_overflowPolicy;
+    int64_t m_flushMask;
+
+    std::vector<Cell> m_cells;
+    std::size_t m_cellMask;
+
+    // producer side
+    alignas(64) std::atomic<std::size_t> m_enqueuePos;
+    std::atomic<std::size_t> m_dropped;
+
+    // consumer side
+    alignas(64) std::size_t m_dequeuePos;
+    std::atomic<std::size_t> m_processed;
+
+    std::atomic<bool> m_writerIdle;
+    std::atomic<bool> m_stop;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_progress;
+    std::exception_ptr m_error;
+    std::thread m_writer;
+};
+
+} // namespace Ewoms
+
+#endif
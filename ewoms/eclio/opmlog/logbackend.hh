@@ -48,9 +48,9 @@ namespace Ewoms
         void addMessage(int64_t messageFlag, const std::string& message);
 
         /// Add a tagged message to the backend if accepted by the message limiter.
-        void addTaggedMessage(int64_t messageFlag,
-                              const std::string& messageTag,
-                              const std::string& message);
+        virtual void addTaggedMessage(int64_t messageFlag,
+                                      const std::string& messageTag,
+                                      const std::string& message);
 
         /// The message mask types are specified in the
         /// Ewoms::Log::MessageType namespace, in file LogUtils.hpp.
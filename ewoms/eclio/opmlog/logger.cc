@@ -46,10 +46,8 @@ namespace Ewoms {
             throw std::invalid_argument("Tried to issue message with unrecognized message ID");
 
         if (m_globalMask & messageType) {
-            for (auto iter : m_backends) {
-                LogBackend& backend = *(iter.second);
-                backend.addTaggedMessage( messageType, tag, message );
-            }
+            for (const auto& iter : m_backends)
+                iter.second->addTaggedMessage( messageType, tag, message );
         }
     }
 
@@ -22,6 +22,7 @@
 #include <ewoms/eclio/opmlog/logger.hh>
 #include <ewoms/eclio/opmlog/streamlog.hh>
 #include <iostream>
+#include <mutex>
 #include <errno.h>  // For errno
 #include <stdio.h>  // For fileno() and stdout
 
@@ -54,6 +55,14 @@ namespace Ewoms {
                 return isatty(file_descriptor);
             }
         }
+
+        // The backends are not thread safe; messages issued concurrently,
+        // e.g. during parallel construction of the EclipseState, are
+        // serialized here.
+        std::mutex& messageMutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
     }
 
     std::shared_ptr<Logger> OpmLog::getLogger() {
@@ -64,13 +73,17 @@ namespace Ewoms {
     }
 
     void OpmLog::addMessage(int64_t messageFlag , const std::string& message) {
-        if (m_logger)
+        if (m_logger) {
+            std::lock_guard<std::mutex> lock(messageMutex());
             m_logger->addMessage( messageFlag , message );
+        }
     }
 
     void OpmLog::addTaggedMessage(int64_t messageFlag, const std::string& tag, const std::string& message) {
-        if (m_logger)
+        if (m_logger) {
+            std::lock_guard<std::mutex> lock(messageMutex());
             m_logger->addTaggedMessage( messageFlag, tag, message );
+        }
     }
 
     void OpmLog::info(const std::string& message)
@@ -20,10 +20,11 @@
 
 #include <ewoms/eclio/output/aggregateconnectiondata.hh>
 
+#include <ewoms/eclio/output/aggregationindex.hh>
 #include <ewoms/eclio/output/vectoritems/connection.hh>
 #include <ewoms/eclio/output/vectoritems/intehead.hh>
 
-#include <ewoms/eclio/output/data/wells.hh>
+#include <ewoms/eclio/output/data/wellresults.hh>
 
 #include <ewoms/eclio/parser/eclipsestate/grid/eclipsegrid.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
@@ -55,44 +56,30 @@ namespace {
         return inteHead[VI::intehead::NCWMAX];
     }
 
+    /// Calls connOp(wellID, conn, connID, resIx) for the output connections
+    /// of a well, where resIx is the index of the connection's results in
+    /// well \p wellRes of \p xw, or npos if there are none.
     template <class ConnOp>
-    void connectionLoop(const Ewoms::EclipseGrid& grid,
-                        const Ewoms::Well&        well,
-                        const std::size_t       wellID,
-                        const Ewoms::data::Well*  wellRes,
-                        ConnOp&&                connOp)
+    void connectionLoop(const Ewoms::EclipseGrid&      grid,
+                        const Ewoms::Well&             well,
+                        const std::size_t              wellID,
+                        const Ewoms::data::WellResults& xw,
+                        const std::size_t              wellRes,
+                        ConnOp&&                       connOp)
     {
+        constexpr auto npos = Ewoms::data::WellResults::npos;
+
         std::size_t connID = 0;
         for (const auto* connPtr : well.getConnections().output(grid)) {
-            const auto* dynConnRes = (wellRes == nullptr)
-                ? nullptr : wellRes->find_connection(connPtr->global_index());
+            const auto resIx = (wellRes == npos)
+                ? npos : xw.findConnection(wellRes, connPtr->global_index());
 
-            connOp(wellID, *connPtr, connID, dynConnRes);
+            connOp(wellID, *connPtr, connID, resIx);
 
             ++connID;
         }
     }
 
-    template <class ConnOp>
-    void wellConnectionLoop(const Ewoms::Schedule&        sched,
-                            const std::size_t           sim_step,
-                            const Ewoms::EclipseGrid&     grid,
-                            const Ewoms::data::WellRates& xw,
-                            ConnOp&&                    connOp)
-    {
-        std::size_t wellID = 0;
-        for (const auto& wname : sched.wellNames(sim_step)) {
-            const auto  well_iter = xw.find(wname);
-            const auto* wellRes   = (well_iter == xw.end())
-                ? nullptr : &well_iter->second;
-
-            connectionLoop(grid, sched.getWell(wname, sim_step), wellID,
-                           wellRes, std::forward<ConnOp>(connOp));
-
-            ++wellID;
-        }
-    }
-
     namespace IConn {
         std::size_t entriesPerConn(const std::vector<int>& inteHead)
         {
@@ -203,9 +190,11 @@ namespace {
         }
 
         template <class SConnArray>
-        void dynamicContrib(const Ewoms::data::Connection& xconn,
+        void dynamicContrib(const Ewoms::data::WellResults& xw,
+                            const std::size_t              well,
+                            const std::size_t              conn,
                             const Ewoms::UnitSystem&       units,
-                            SConnArray&                  sConn)
+                            SConnArray&                    sConn)
         {
             using M  = ::Ewoms::UnitSystem::measure;
             using Ix = ::Ewoms::RestartIO::Helpers::VectorItems::SConn::index;
@@ -216,7 +205,7 @@ namespace {
             };
 
             sConn[Ix::item12] = sConn[Ix::ConnTrans] =
-                scprop(M::transmissibility, xconn.trans_factor);
+                scprop(M::transmissibility, xw.connectionTransFactor(well, conn));
         }
     } // SConn
 
@@ -239,52 +228,62 @@ namespace {
         }
 
         template <class XConnArray>
-        void dynamicContrib(const Ewoms::data::Connection& x,
+        void dynamicContrib(const Ewoms::data::WellResults& xw,
+                            const std::size_t              well,
+                            const std::size_t              conn,
                             const Ewoms::UnitSystem&       units,
-                            XConnArray&                  xConn)
+                            XConnArray&                    xConn)
         {
             using M  = ::Ewoms::UnitSystem::measure;
             using Ix = ::Ewoms::RestartIO::Helpers::VectorItems::XConn::index;
             using R  = ::Ewoms::data::Rates::opt;
 
-            xConn[Ix::Pressure] = units.from_si(M::pressure, x.pressure);
+            xConn[Ix::Pressure] = units.from_si(M::pressure, xw.connectionPressure(well, conn));
 
             // Note flow rate sign.  Treat production rates as positive.
-            const auto& Q = x.rates;
+            const auto has = [&xw, well, conn](const R q)
+            {
+                return xw.hasConnectionRate(well, conn, q);
+            };
 
-            if (Q.has(R::oil)) {
+            const auto get = [&xw, well, conn](const R q)
+            {
+                return xw.connectionRate(well, conn, q);
+            };
+
+            if (has(R::oil)) {
                 xConn[Ix::OilRate] =
-                    - units.from_si(M::liquid_surface_rate, Q.get(R::oil));
+                    - units.from_si(M::liquid_surface_rate, get(R::oil));
                 xConn[Ix::OilRate_Copy] = xConn[Ix::OilRate];
             }
 
-            if (Q.has(R::wat)) {
+            if (has(R::wat)) {
                 xConn[Ix::WaterRate] =
-                    - units.from_si(M::liquid_surface_rate, Q.get(R::wat));
+                    - units.from_si(M::liquid_surface_rate, get(R::wat));
                 xConn[Ix::WaterRate_Copy] = xConn[Ix::WaterRate];
             }
 
-            if (Q.has(R::gas)) {
+            if (has(R::gas)) {
                 xConn[Ix::GasRate] =
-                    - units.from_si(M::gas_surface_rate, Q.get(R::gas));
+                    - units.from_si(M::gas_surface_rate, get(R::gas));
                 xConn[Ix::GasRate_Copy] = xConn[Ix::GasRate];
             }
 
             xConn[Ix::ResVRate] = 0.0;
 
-            if (Q.has(R::reservoir_oil)) {
+            if (has(R::reservoir_oil)) {
                 xConn[Ix::ResVRate] -=
-                    units.from_si(M::rate, Q.get(R::reservoir_oil));
+                    units.from_si(M::rate, get(R::reservoir_oil));
             }
 
-            if (Q.has(R::reservoir_water)) {
+            if (has(R::reservoir_water)) {
                 xConn[Ix::ResVRate] -=
-                    units.from_si(M::rate, Q.get(R::reservoir_water));
+                    units.from_si(M::rate, get(R::reservoir_water));
             }
 
-            if (Q.has(R::reservoir_gas)) {
+            if (has(R::reservoir_gas)) {
                 xConn[Ix::ResVRate] -=
-                    units.from_si(M::rate, Q.get(R::reservoir_gas));
+                    units.from_si(M::rate, get(R::reservoir_gas));
             }
         }
     } // XConn
@@ -307,25 +306,46 @@ captureDeclaredConnData(const Schedule&        sched,
                         const data::WellRates& xw,
                         const std::size_t      sim_step)
 {
-    wellConnectionLoop(sched, sim_step, grid, xw, [&units, this]
-        (const std::size_t       wellID,
-         const Connection&       conn,
-         const std::size_t       connID,
-         const data::Connection* dynConnRes) -> void
+    const auto results = data::WellResults{ xw };
+
+    this->captureDeclaredConnData(AggregationIndex{ sched, sim_step, results }, grid, units);
+}
+
+void
+Ewoms::RestartIO::Helpers::AggregateConnectionData::
+captureDeclaredConnData(const AggregationIndex& index,
+                        const EclipseGrid&      grid,
+                        const UnitSystem&       units)
+{
+    index.forEachWellWindow([&index, &grid, &units, this]
+        (const std::size_t begin, const std::size_t end) -> void
     {
-        auto ic = this->iConn_(wellID, connID);
-        auto sc = this->sConn_(wellID, connID);
+        for (auto w = begin; w < end; ++w) {
+            const auto& xw = index.results();
+            const auto wellRes = index.resultIndex(w);
+
+            connectionLoop(grid, index.well(w), w, xw, wellRes,
+                [&xw, wellRes, &units, this]
+                (const std::size_t wellID,
+                 const Connection& conn,
+                 const std::size_t connID,
+                 const std::size_t connRes) -> void
+            {
+                auto ic = this->iConn_(wellID, connID);
+                auto sc = this->sConn_(wellID, connID);
 
-        IConn::staticContrib(conn, connID, ic);
-        SConn::staticContrib(conn, units, sc);
+                IConn::staticContrib(conn, connID, ic);
+                SConn::staticContrib(conn, units, sc);
 
-        if (dynConnRes != nullptr) {
-            // Simulator provides dynamic connection results such as flow
-            // rates and PI-adjusted transmissibility factors.
-            auto xc = this->xConn_(wellID, connID);
+                if (connRes != data::WellResults::npos) {
+                    // Simulator provides dynamic connection results such as flow
+                    // rates and PI-adjusted transmissibility factors.
+                    auto xc = this->xConn_(wellID, connID);
 
-            SConn::dynamicContrib(*dynConnRes, units, sc);
-            XConn::dynamicContrib(*dynConnRes, units, xc);
+                    SConn::dynamicContrib(xw, wellRes, connRes, units, sc);
+                    XConn::dynamicContrib(xw, wellRes, connRes, units, xc);
+                }
+            });
         }
     });
 }
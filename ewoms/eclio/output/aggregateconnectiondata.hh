@@ -37,6 +37,8 @@ namespace Ewoms { namespace data {
 
 namespace Ewoms { namespace RestartIO { namespace Helpers {
 
+    class AggregationIndex;
+
     class AggregateConnectionData
     {
     public:
@@ -48,6 +50,12 @@ namespace Ewoms { namespace RestartIO { namespace Helpers {
                                      const Ewoms::data::WellRates& xw,
                                      const std::size_t           sim_step);
 
+        /// Connection data of the wells in \p index, processing separate
+        /// well windows concurrently.
+        void captureDeclaredConnData(const AggregationIndex&   index,
+                                     const Ewoms::EclipseGrid& grid,
+                                     const Ewoms::UnitSystem&  units);
+
         const std::vector<int>& getIConn() const
         {
             return this->iConn_.data();
@@ -19,6 +19,7 @@
 #include "config.h"
 
 #include <ewoms/eclio/output/aggregategroupdata.hh>
+#include <ewoms/eclio/output/aggregationindex.hh>
 #include <ewoms/eclio/output/writerestarthelpers.hh>
 #include <ewoms/eclio/output/vectoritems/group.hh>
 #include <ewoms/eclio/output/vectoritems/well.hh>
@@ -1111,45 +1112,51 @@ captureDeclaredGroupData(const Ewoms::Schedule&                 sched,
                          const Ewoms::SummaryState&             sumState,
                          const std::vector<int>&              inteHead)
 {
-    const auto& curGroups = sched.restart_groups(simStep);
+    this->captureGroups(sched.restart_groups(simStep), sched, units, simStep, sumState, inteHead);
+}
 
-    groupLoop(curGroups, [&sched, simStep, sumState, this]
-              (const Group& group, const std::size_t groupID) -> void
-                         {
-                             auto ig = this->iGroup_[groupID];
-
-                             IGrp::staticContrib(sched, group, this->nWGMax_, this->nGMaxz_,
-                                                 simStep, sumState, this->PCntlModeToPCMode, this->cmodeToNum, ig);
-                         });
-
-    // Define Static Contributions to SGrp Array.
-    groupLoop(curGroups,
-              [&sumState, &units, this](const Group& group , const std::size_t groupID) -> void
-              {
-                  auto sw = this->sGroup_[groupID];
-                  SGrp::staticContrib(group, sumState, units, sw);
-              });
-
-    // Define Dynamic Contributions to XGrp Array.
-    groupLoop(curGroups, [&sumState, this]
+void
+Ewoms::RestartIO::Helpers::AggregateGroupData::
+captureDeclaredGroupData(const AggregationIndex&  index,
+                         const Ewoms::Schedule&     sched,
+                         const Ewoms::UnitSystem&   units,
+                         const Ewoms::SummaryState& sumState,
+                         const std::vector<int>&  inteHead)
+{
+    this->captureGroups(index.groups(), sched, units, index.simStep(), sumState, inteHead);
+}
+
+void
+Ewoms::RestartIO::Helpers::AggregateGroupData::
+captureGroups(const std::vector<const Ewoms::Group*>& groups,
+              const Ewoms::Schedule&                  sched,
+              const Ewoms::UnitSystem&                units,
+              const std::size_t                     simStep,
+              const Ewoms::SummaryState&              sumState,
+              const std::vector<int>&               inteHead)
+{
+    // All arrays of a group are filled in a single pass.
+    groupLoop(groups, [&sched, simStep, &sumState, &units, &inteHead, this]
               (const Group& group, const std::size_t groupID) -> void
-                         {
-                             auto xg = this->xGroup_[groupID];
-
-                             XGrp::dynamicContrib(this->restart_group_keys, this->restart_field_keys,
-                                                  this->groupKeyToIndex, this->fieldKeyToIndex, group,
-                                                  sumState, xg);
-                         });
-
-    // Define Static Contributions to ZGrp Array.
-    groupLoop(curGroups, [this, &inteHead]
-              (const Group& group, const std::size_t /* groupID */) -> void
-                         {
-                             std::size_t group_index = group.insert_index() - 1;
-                             if (group.name() == "FIELD")
-                                 group_index = ngmaxz(inteHead) - 1;
-                             auto zg = this->zGroup_[ group_index ];
-
-                             ZGrp::staticContrib(group, zg);
-                         });
+    {
+        auto ig = this->iGroup_[groupID];
+        IGrp::staticContrib(sched, group, this->nWGMax_, this->nGMaxz_,
+                            simStep, sumState, this->PCntlModeToPCMode, this->cmodeToNum, ig);
+
+        auto sg = this->sGroup_[groupID];
+        SGrp::staticContrib(group, sumState, units, sg);
+
+        auto xg = this->xGroup_[groupID];
+        XGrp::dynamicContrib(this->restart_group_keys, this->restart_field_keys,
+                             this->groupKeyToIndex, this->fieldKeyToIndex, group,
+                             sumState, xg);
+
+        std::size_t group_index = group.insert_index() - 1;
+        if (group.name() == "FIELD")
+            group_index = ngmaxz(inteHead) - 1;
+        auto zg = this->zGroup_[ group_index ];
+
+        ZGrp::staticContrib(group, zg);
+    });
 }
+
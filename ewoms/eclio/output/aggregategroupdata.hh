@@ -37,6 +37,8 @@ class UnitSystem;
 
 namespace Ewoms { namespace RestartIO { namespace Helpers {
 
+class AggregationIndex;
+
 class AggregateGroupData
 {
 public:
@@ -48,6 +50,12 @@ public:
                          const Ewoms::SummaryState&             sumState,
                          const std::vector<int>&              inteHead);
 
+    void captureDeclaredGroupData(const AggregationIndex&  index,
+                                  const Ewoms::Schedule&     sched,
+                                  const Ewoms::UnitSystem&   units,
+                                  const Ewoms::SummaryState& sumState,
+                                  const std::vector<int>&  inteHead);
+
     const std::vector<int>& getIGroup() const
     {
         return this->iGroup_.data();
@@ -176,6 +184,13 @@ public:
     };
 
 private:
+    void captureGroups(const std::vector<const Ewoms::Group*>& groups,
+                       const Ewoms::Schedule&                  sched,
+                       const Ewoms::UnitSystem&                units,
+                       const std::size_t                     simStep,
+                       const Ewoms::SummaryState&              sumState,
+                       const std::vector<int>&               inteHead);
+
     /// Aggregate 'IWEL' array (Integer) for all wells.
     WindowedArray<int> iGroup_;
 
@@ -22,9 +22,12 @@
 
 #include <ewoms/eclio/output/vectoritems/msw.hh>
 
+#include <ewoms/eclio/output/data/wellresults.hh>
+
 #include <ewoms/eclio/parser/eclipsestate/eclipsestate.hh>
 #include <ewoms/eclio/parser/eclipsestate/runspec.hh>
 
+#include <ewoms/eclio/parser/eclipsestate/schedule/msw/segmenttopology.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/sicd.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/valve.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/summarystate.hh>
@@ -74,45 +77,20 @@ namespace {
         return inteHead[180];
     }
 
-    std::vector<std::size_t>
-    inflowSegmentsIndex(const Ewoms::WellSegments& segSet, const std::size_t& segIndex) {
-        const auto& segNumber  = segSet[segIndex].segmentNumber();
-        std::vector<std::size_t> inFlowSegInd;
-        for (std::size_t ind = 0; ind < segSet.size(); ind++) {
-            const auto& i_outletSeg = segSet[ind].outletSegment();
-            if (segNumber == i_outletSeg) {
-                inFlowSegInd.push_back(ind);
-            }
-        }
-        return inFlowSegInd;
-    }
-
     Ewoms::RestartIO::Helpers::BranchSegmentPar
     getBranchSegmentParam(const Ewoms::WellSegments& segSet, const int branch)
     {
-        int noSegInBranch = 0;
-        int firstSeg = -1;
-        int lastSeg  = -1;
-        int outletS = 0;
-        for (std::size_t segInd = 0; segInd < segSet.size(); segInd++) {
-            const auto& segNo = segSet[segInd].segmentNumber();
-            const auto& i_branch = segSet[segInd].branchNumber();
-            const auto& i_outS = segSet[segInd].outletSegment();
-            if (i_branch == branch) {
-                noSegInBranch +=1;
-                if (firstSeg < 0) {
-                    firstSeg = segNo;
-                    outletS = (branch > 1) ? i_outS : 0;
-                }
-                lastSeg = segNo;
-            }
+        const auto branchSegments = segSet.topology().branchSegments(branch);
+        if (branchSegments.empty()) {
+            return { 0, 0, -1, -1, branch };
         }
 
+        const auto& first = segSet[branchSegments[0]];
         return {
-            outletS,
-            noSegInBranch,
-            firstSeg,
-            lastSeg,
+            (branch > 1) ? first.outletSegment() : 0,
+            static_cast<int>(branchSegments.size()),
+            first.segmentNumber(),
+            segSet[branchSegments[branchSegments.size() - 1]].segmentNumber(),
             branch
         };
     }
@@ -124,67 +102,22 @@ namespace {
         }
         return sNFOSN;
     }
-    std::vector<std::size_t> segmentOrder(const Ewoms::WellSegments& segSet, const std::size_t segIndex) {
-        std::vector<std::size_t> ordSegNumber;
-        std::vector<std::size_t> segIndCB;
-        // Store "heel" segment since that will not always be at the end of the list
-        segIndCB.push_back(segIndex);
-        std::size_t newSInd = segIndex;
-        const auto& origBranchNo = segSet[segIndex].branchNumber();
-        bool endOrigBranch;
-        // loop down branch to find all segments in branch and number from "toe" to "heel"
-        while (newSInd < segSet.size()) {
-            endOrigBranch = true;
-            const auto& iSInd = inflowSegmentsIndex(segSet, newSInd);
-            for (auto& isi : iSInd )  {
-                const auto& inflowBranch = segSet[isi].branchNumber();
-                if (origBranchNo == inflowBranch) {
-                    endOrigBranch = false;
-                }
-            }
-            if (iSInd.size() > 0) {
-                for (const auto& ind : iSInd) {
-                    auto inflowBranch = segSet[ind].branchNumber();
-                    if (origBranchNo == inflowBranch) {
-                        // if inflow segment belongs to same branch add contribution
-                        segIndCB.insert(segIndCB.begin(), ind);
-                        // search recursively down this branch to find more inflow branches
-                        newSInd = ind;
-                    }
-                    else {
-                        // if inflow segment belongs to different branch, start new search
-                        const auto& nSOrd = segmentOrder(segSet, ind);
-                        // copy the segments already found and indexed into the total ordered segment vector
-                        for (std::size_t indOS = 0; indOS < nSOrd.size(); indOS++) {
-                            ordSegNumber.push_back(nSOrd[indOS]);
-                        }
-                        if (endOrigBranch) {
-                            newSInd = segSet.size();
-                        }
-                        // increment the local branch sequence number counter
-                    }
-                }
-            }
-            if (endOrigBranch || (iSInd.size()==0)) {
-                // have come to toe of current branch - store segment indicies of current branch
-                for (std::size_t indOS = 0; indOS < segIndCB.size(); indOS++) {
-                    ordSegNumber.push_back(segIndCB[indOS]);
-                }
-                // set new index to exit while loop
-                newSInd = segSet.size();
-            }
+
+    const std::vector<std::size_t>& segmentOrder(const Ewoms::WellSegments& segSet) {
+        const auto& order = segSet.topology().flowOrder();
+        if (order.size() != segSet.size()) {
+            throw std::invalid_argument("Not all segments are connected to the top segment");
         }
-        return ordSegNumber;
-    }
 
-    std::vector<std::size_t> segmentOrder(const Ewoms::WellSegments& segSet) {
-        return segmentOrder(segSet, 0);
+        return order;
     }
 
     /// Accumulate connection flow rates (surface conditions) to their connecting segment.
+    /// The rates are those of well \p wellRes in \p xw.
     Ewoms::RestartIO::Helpers::SegmentSetSourceSinkTerms
     getSegmentSetSSTerms(const Ewoms::WellSegments& segSet,
-                         const std::vector<Ewoms::data::Connection>& rateConns,
+                         const Ewoms::data::WellResults& xw,
+                         const std::size_t wellRes,
                          const Ewoms::WellConnections& welConns,
                          const Ewoms::UnitSystem& units)
     {
@@ -200,22 +133,17 @@ namespace {
                 continue;
             }
 
-            auto xcPos = std::find_if(rateConns.begin(), rateConns.end(),
-                [&conn](const Ewoms::data::Connection& xconn) -> bool
-            {
-                return xconn.index == conn.global_index();
-            });
+            const auto xc = xw.findConnection(wellRes, conn.global_index());
 
-            if (xcPos == rateConns.end()) {
+            if (xc == Ewoms::data::WellResults::npos) {
                 continue;
             }
 
-            const auto segInd = segSet.segmentNumberToIndex(conn.segment());
-            const auto& Q = xcPos->rates;
+            const auto segInd = segSet.topology().index(conn.segment());
 
-            auto get = [&units, &Q](const M u, const R q) -> double
+            auto get = [&units, &xw, wellRes, xc](const M u, const R q) -> double
             {
-                const auto val = Q.has(q) ? Q.get(q) : 0.0;
+                const auto val = xw.connectionRate(wellRes, xc, q, 0.0);
 
                 return - units.from_si(u, val);
             };
@@ -234,7 +162,8 @@ namespace {
 
     Ewoms::RestartIO::Helpers::SegmentSetFlowRates
     getSegmentSetFlowRates(const Ewoms::WellSegments& segSet,
-                           const std::vector<Ewoms::data::Connection>& rateConns,
+                           const Ewoms::data::WellResults& xw,
+                           const std::size_t wellRes,
                            const Ewoms::WellConnections& welConns,
                            const Ewoms::UnitSystem& units)
     {
@@ -243,10 +172,11 @@ namespace {
         std::vector<double> sgfr (segSet.size(), 0.);
         //
         //call function to calculate the individual segment source/sink terms
-        auto segmentSources = getSegmentSetSSTerms(segSet, rateConns, welConns, units);
+        auto segmentSources = getSegmentSetSSTerms(segSet, xw, wellRes, welConns, units);
 
         // find an ordered list of segments
-        auto orderedSegmentInd = segmentOrder(segSet);
+        const auto& topology = segSet.topology();
+        const auto& orderedSegmentInd = segmentOrder(segSet);
         auto sNFOSN = segmentIndFromOrderedSegmentInd(segSet, orderedSegmentInd);
         // loop over segments according to the ordered segments sequence which ensures that the segments alway are traversed in the from
         // inflow to outflow direction (a branch toe is the innermost inflow end)
@@ -259,7 +189,7 @@ namespace {
             sgfr[segInd] += segmentSources.qgsc[segInd];
             // add flow from all inflow segments
             for (const auto& segNo : segSet[segInd].inletSegments()) {
-                const auto & ifSegInd = segSet.segmentNumberToIndex(segNo);
+                const auto ifSegInd = topology.index(segNo);
                 sofr[segInd] += sofr[ifSegInd];
                 swfr[segInd] += swfr[ifSegInd];
                 sgfr[segInd] += sgfr[ifSegInd];
@@ -273,110 +203,43 @@ namespace {
         };
     }
 
-    std::vector<std::size_t> SegmentSetBranches(const Ewoms::WellSegments& segSet) {
-        std::vector<std::size_t> branches;
-        for (std::size_t segInd = 0; segInd < segSet.size(); segInd++) {
-            const auto& i_branch = segSet[segInd].branchNumber();
-            if (std::find(branches.begin(), branches.end(), i_branch) == branches.end()) {
-                branches.push_back(i_branch);
-            }
-        }
-        return branches;
-    }
-
-    int firstSegmentInBranch(const Ewoms::WellSegments& segSet, const int branch) {
-        int firstSegInd = 0;
-        std::size_t segInd = 0;
-        while ((segInd < segSet.size()) && (firstSegInd == 0)) {
-            const auto& i_branch = segSet[segInd].branchNumber();
-            if (branch == i_branch) {
-                firstSegInd = segInd;
-            }
-            segInd+=1;
-        }
-        return firstSegInd;
-    }
-
-    int noConnectionsSegment(const Ewoms::WellConnections& compSet,
-                             const Ewoms::WellSegments&    segSet,
-                             const std::size_t           segIndex)
+    /// Number of connections in each segment, by segment index.
+    std::vector<int> noConnectionsSegments(const Ewoms::WellConnections& compSet,
+                                           const Ewoms::WellSegments&    segSet)
     {
-        const auto& segNumber  = segSet[segIndex].segmentNumber();
-        int noConnections = 0;
-        for (const auto& it : compSet) {
-            auto cSegment = it.segment();
-            if (segNumber == cSegment) {
-                noConnections+=1;
+        const auto& topology = segSet.topology();
+
+        std::vector<int> noConnections(segSet.size(), 0);
+        for (const auto& conn : compSet) {
+            const auto segInd = topology.index(conn.segment());
+            if (segInd != Ewoms::SegmentTopology::npos) {
+                noConnections[segInd] += 1;
             }
         }
 
         return noConnections;
     }
 
-    int sumConnectionsSegment(const Ewoms::WellConnections& compSet,
-                              const Ewoms::WellSegments&    segSet,
-                              const std::size_t           segIndex)
-    {
-        // This function returns (for a given segment) the sum of number of connections for each segment
-        // with lower segment index than the currnet segment
-        // If the segment contains no connections, the number returned is zero.
-        int sumConn = 0;
-        if (noConnectionsSegment(compSet, segSet, segIndex) > 0) {
-            // add up the number of connections for å segments with lower segment index than current segment
-            for (size_t ind = 0; ind <= segIndex; ind++) {
-                size_t addCon = (ind == segIndex) ? 1 : noConnectionsSegment(compSet, segSet, ind);
-                sumConn += addCon;
-            }
-        }
-        return sumConn;
-    }
-
     int noInFlowBranches(const Ewoms::WellSegments& segSet, std::size_t segIndex) {
-        const auto& segNumber  = segSet[segIndex].segmentNumber();
-        const auto& branch     = segSet[segIndex].branchNumber();
+        const auto& topology = segSet.topology();
+        const auto& branch = segSet[segIndex].branchNumber();
         int noIFBr = 0;
-        for (std::size_t ind = 0; ind < segSet.size(); ind++) {
-            const auto& o_segNum = segSet[ind].outletSegment();
-            const auto& i_branch = segSet[ind].branchNumber();
-            if ((segNumber == o_segNum) && (branch != i_branch)){
+        for (const auto ind : topology.inlets(segIndex)) {
+            if (branch != segSet[ind].branchNumber()) {
                 noIFBr+=1;
             }
         }
         return noIFBr;
     }
-    //find the number of inflow branch-segments (segments that has a branch) from the
-    // first segment to the current segment for segments that has at least one inflow branch
-    // Segments with no inflow branches get the value zero
-    int sumNoInFlowBranches(const Ewoms::WellSegments& segSet, const std::size_t& segIndex) {
-        int sumIFB = 0;
-        //auto segInd = segIndex;
-        for (int segInd = static_cast<int>(segIndex); segInd >= 0; segInd--) {
-            const auto& curBranch = segSet[segInd].branchNumber();
-            const auto& iSInd = inflowSegmentsIndex(segSet, segInd);
-            for (auto inFlowInd : iSInd) {
-                const auto& inFlowBranch = segSet[inFlowInd].branchNumber();
-                // if inflow segment belongs to different branch add contribution
-                if (curBranch != inFlowBranch) {
-                    sumIFB+=1;
-                }
-            }
-        }
-        // check if the segment has inflow branches - if yes return sumIFB else return zero
-        return  (noInFlowBranches(segSet, segIndex) >= 1)
-            ? sumIFB : 0;
-    }
 
     int inflowSegmentCurBranch(const std::string& wname, const Ewoms::WellSegments& segSet, std::size_t segIndex) {
         const auto& branch = segSet[segIndex].branchNumber();
         const auto& segNumber  = segSet[segIndex].segmentNumber();
         int inFlowSegInd = -1;
-        for (std::size_t ind = 0; ind < segSet.size(); ind++) {
-            const auto& i_segNum = segSet[ind].segmentNumber();
-            const auto& i_branch = segSet[ind].branchNumber();
-            const auto& i_outFlowSeg = segSet[ind].outletSegment();
-            if ((branch == i_branch) && (segNumber == i_outFlowSeg)) {
+        for (const auto ind : segSet.topology().inlets(segIndex)) {
+            if (branch == segSet[ind].branchNumber()) {
                 if (inFlowSegInd == -1) {
-                    inFlowSegInd = segSet.segmentNumberToIndex(i_segNum);
+                    inFlowSegInd = static_cast<int>(ind);
                 }
                 else {
                     std::cout << "Non-unique inflow segment in same branch, Well: " << wname << std::endl;
@@ -460,27 +323,34 @@ namespace {
                 const auto& welSegSet     = well.getSegments();
                 const auto& completionSet = well.getConnections();
                 const auto& noElmSeg      = nisegz(inteHead);
-                auto orderedSegmentNo = segmentOrder(welSegSet);
-                std::vector<int> seg_reorder (welSegSet.size(),0);
-                for (std::size_t ind = 0; ind < welSegSet.size(); ind++ ){
-                    const auto s_no = welSegSet[orderedSegmentNo[ind]].segmentNumber();
-                    const auto s_ind = welSegSet.segmentNumberToIndex(s_no);
-                    seg_reorder[s_ind] = ind+1;
-                }
+                const auto& orderedSegmentNo = segmentOrder(welSegSet);
+                const auto& topology = welSegSet.topology();
+                const auto noConnections = noConnectionsSegments(completionSet, welSegSet);
+
+                // Running totals over the segments with lower or equal
+                // index: inflow branches and connections.
+                int sumIFB = 0;
+                int sumConn = 0;
                 for (std::size_t ind = 0; ind < welSegSet.size(); ind++) {
                     const auto& segment = welSegSet[ind];
+                    const auto noIFB = noInFlowBranches(welSegSet, ind);
+                    const auto inFlowSegInd = inflowSegmentCurBranch(well.name(), welSegSet, ind);
+
+                    sumIFB += noIFB;
 
                     auto segNumber = segment.segmentNumber();
                     auto iS = (segNumber-1)*noElmSeg;
                     iSeg[iS + Ix::SegNo]          = welSegSet[orderedSegmentNo[ind]].segmentNumber();
                     iSeg[iS + Ix::OutSeg]         = segment.outletSegment();
-                    iSeg[iS + Ix::InSegCurBranch] = (inflowSegmentCurBranch(well.name(), welSegSet, ind) == 0) ? 0 : welSegSet[inflowSegmentCurBranch(well.name(), welSegSet, ind)].segmentNumber();
+                    iSeg[iS + Ix::InSegCurBranch] = (inFlowSegInd == 0) ? 0 : welSegSet[inFlowSegInd].segmentNumber();
                     iSeg[iS + Ix::BranchNo]       = segment.branchNumber();
-                    iSeg[iS + 4] = noInFlowBranches(welSegSet, ind);
-                    iSeg[iS + 5] = sumNoInFlowBranches(welSegSet, ind);
-                    iSeg[iS + 6] = noConnectionsSegment(completionSet, welSegSet, ind);
-                    iSeg[iS + 7] = sumConnectionsSegment(completionSet, welSegSet, ind);
-                    iSeg[iS + 8] = seg_reorder[ind];
+                    iSeg[iS + 4] = noIFB;
+                    iSeg[iS + 5] = (noIFB >= 1) ? sumIFB : 0;
+                    iSeg[iS + 6] = noConnections[ind];
+                    iSeg[iS + 7] = (noConnections[ind] > 0) ? sumConn + 1 : 0;
+                    iSeg[iS + 8] = static_cast<int>(topology.flowPosition(ind)) + 1;
+
+                    sumConn += noConnections[ind];
 
                     iSeg[iS + Ix::SegmentType] = segment.ecl_type_id();
                     if (! segment.isRegular()) {
@@ -630,7 +500,7 @@ namespace {
                                   const Ewoms::EclipseGrid&     grid,
                                   const Ewoms::UnitSystem&      units,
                                   const ::Ewoms::SummaryState&  smry,
-                                  const Ewoms::data::WellRates& wr,
+                                  const Ewoms::data::WellResults& wr,
                                   RSegArray&                  rSeg)
         {
             using Ix = ::Ewoms::RestartIO::Helpers::VectorItems::RSeg::index;
@@ -649,10 +519,10 @@ namespace {
                 const auto& welConns = Ewoms::WellConnections(conn0, grid);
                 const auto& wname     = well.name();
                 const auto wPKey = "WBHP:"  + wname;
-                const auto& wRatesIt =  wr.find(wname);
+                const auto wellRes = wr.findWell(wname);
                 //
                 //Do not calculate well segment rates for shut wells
-                bool haveWellRes = (well.getStatus() != Ewoms::Well::Status::SHUT) ? (wRatesIt != wr.end()) : false;
+                bool haveWellRes = (well.getStatus() != Ewoms::Well::Status::SHUT) ? (wellRes != Ewoms::data::WellResults::npos) : false;
                 const auto volFromLengthUnitConv = units.from_si(M::length, units.from_si(M::length, units.from_si(M::length, 1.)));
                 const auto areaFromLengthUnitConv =  units.from_si(M::length, units.from_si(M::length, 1.));
                 //
@@ -664,7 +534,7 @@ namespace {
                 // find well connections and calculate segment rates based on well connection production/injection terms
                 auto sSFR = Ewoms::RestartIO::Helpers::SegmentSetFlowRates{};
                 if (haveWellRes) {
-                    sSFR = getSegmentSetFlowRates(welSegSet, wRatesIt->second.connections, welConns, units);
+                    sSFR = getSegmentSetFlowRates(welSegSet, wr, wellRes, welConns, units);
                 }
 
                 std::string stringSegNum = std::to_string(segment0.segmentNumber());
@@ -685,7 +555,7 @@ namespace {
                 //
                 // branch according to whether multisegment well calculations are switched on or not
 
-                if (haveWellRes && wRatesIt->second.segments.size() < 2) {
+                if (haveWellRes && wr.numSegments(wellRes) < 2) {
                     // Note: Segment flow rates and pressure from 'smry' have correct
                     // output units and sign conventions.
                     temp_o = sSFR.sofr[0];
@@ -723,7 +593,7 @@ namespace {
                 //Treat subsequent segments
                 for (std::size_t segIndex = 1; segIndex < welSegSet.size(); segIndex++) {
                     const auto& segment = welSegSet[segIndex];
-                    const auto& outlet_segment = welSegSet.getFromSegmentNumber( segment.outletSegment() );
+                    const auto& outlet_segment = welSegSet[welSegSet.topology().outlet(segIndex)];
                     const int segNumber = segment.segmentNumber();
                     stringSegNum = std::to_string(segNumber);
 
@@ -740,7 +610,7 @@ namespace {
 
                     // see section above for explanation of values
                     // branch according to whether multisegment well calculations are switched on or not
-                    if (haveWellRes && wRatesIt->second.segments.size() < 2) {
+                    if (haveWellRes && wr.numSegments(wellRes) < 2) {
                         // Note: Segment flow rates and pressure from 'smry' have correct
                         // output units and sign conventions.
                         temp_o = sSFR.sofr[segIndex];
@@ -812,9 +682,10 @@ namespace {
                 // Store the segment number of the first segment in branch for branch number
                 // 2 and upwards
                 const auto& welSegSet = well.getSegments();
-                const auto& branches = SegmentSetBranches(welSegSet);
+                const auto& topology = welSegSet.topology();
+                const auto& branches = topology.branches();
                 for (auto it = branches.begin()+1; it != branches.end(); it++){
-                    iLBS[*it-2] = welSegSet[firstSegmentInBranch(welSegSet, *it)].segmentNumber();
+                    iLBS[*it-2] = welSegSet[topology.branchSegments(*it)[0]].segmentNumber();
                 }
             }
             else {
@@ -850,7 +721,7 @@ namespace {
             if (well.isMultiSegment()) {
                 //
                 const auto& welSegSet = well.getSegments();
-                const auto& branches = SegmentSetBranches(welSegSet);
+                const auto& branches = welSegSet.topology().branches();
                 const auto& noElmBranch = nilbrz(inteHead);
                 for (auto it = branches.begin(); it != branches.end(); it++){
                     const auto iB = (*it-1)*noElmBranch;
@@ -892,6 +763,20 @@ captureDeclaredMSWData(const Schedule&         sched,
                        const Ewoms::SummaryState& smry,
                        const Ewoms::data::WellRates&  wr
                        )
+{
+    this->captureDeclaredMSWData(sched, rptStep, units, inteHead, grid, smry,
+                                 Ewoms::data::WellResults{ wr });
+}
+
+void
+Ewoms::RestartIO::Helpers::AggregateMSWData::
+captureDeclaredMSWData(const Schedule&                sched,
+                       const std::size_t              rptStep,
+                       const Ewoms::UnitSystem&       units,
+                       const std::vector<int>&        inteHead,
+                       const Ewoms::EclipseGrid&      grid,
+                       const Ewoms::SummaryState&     smry,
+                       const Ewoms::data::WellResults& wr)
 {
     const auto& wells = sched.getWells(rptStep);
     auto msw = std::vector<const Ewoms::Well*>{};
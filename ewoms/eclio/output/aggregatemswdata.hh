@@ -33,6 +33,10 @@ namespace Ewoms {
     class SummaryState;
 } // namespace Ewoms
 
+namespace Ewoms { namespace data {
+    class WellResults;
+}} // Ewoms::data
+
 namespace Ewoms { namespace RestartIO { namespace Helpers {
 
     struct BranchSegmentPar {
@@ -69,6 +73,14 @@ namespace Ewoms { namespace RestartIO { namespace Helpers {
 				     const Ewoms::data::WellRates&  wr
 				   );
 
+        void captureDeclaredMSWData(const Ewoms::Schedule&         sched,
+                                    const std::size_t              rptStep,
+                                    const Ewoms::UnitSystem&       units,
+                                    const std::vector<int>&        inteHead,
+                                    const Ewoms::EclipseGrid&      grid,
+                                    const Ewoms::SummaryState&     smry,
+                                    const Ewoms::data::WellResults& wr);
+
         /// Retrieve Integer Multisegment well data Array.
         const std::vector<int>& getISeg() const
         {
@@ -20,9 +20,11 @@
 
 #include <ewoms/eclio/output/aggregatewelldata.hh>
 
+#include <ewoms/eclio/output/aggregationindex.hh>
 #include <ewoms/eclio/output/vectoritems/intehead.hh>
 #include <ewoms/eclio/output/vectoritems/well.hh>
 
+#include <ewoms/eclio/output/data/wellresults.hh>
 #include <ewoms/eclio/output/data/wells.hh>
 
 #include <ewoms/eclio/parser/eclipsestate/eclipsestate.hh>
@@ -148,21 +150,17 @@ namespace {
             return well.productionControls(st).vfp_table_number;
         }
 
-        bool wellControlDefined(const Ewoms::data::Well& xw)
+        bool wellControlDefined(const Ewoms::data::CurrentControl& curr)
         {
             using PMode = ::Ewoms::Well::ProducerCMode;
             using IMode = ::Ewoms::Well::InjectorCMode;
 
-            const auto& curr = xw.current_control;
-
             return (curr.isProducer && (curr.prod != PMode::CMODE_UNDEFINED))
                 || (!curr.isProducer && (curr.inj != IMode::CMODE_UNDEFINED));
         }
 
-        int ctrlMode(const Ewoms::Well& well, const Ewoms::data::Well& xw)
+        int ctrlMode(const Ewoms::Well& well, const Ewoms::data::CurrentControl& curr)
         {
-            const auto& curr = xw.current_control;
-
             if (curr.isProducer) {
                 return ::Ewoms::eclipseControlMode(curr.prod);
             }
@@ -360,20 +358,28 @@ namespace {
             iWell[Ix::Status] = Value::Shut;
         }
 
+        bool anyFlowingConnection(const Ewoms::data::WellResults& xw,
+                                  const std::size_t              wellIx)
+        {
+            const auto nConn = xw.numConnections(wellIx);
+            for (auto conn = std::size_t{0}; conn < nConn; ++conn) {
+                if (xw.connectionFlowing(wellIx, conn)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
         template <class IWellArray>
-        void dynamicContribStop(const Ewoms::data::Well&  xw,
-                                IWellArray&             iWell)
+        void dynamicContribStop(const Ewoms::data::WellResults& xw,
+                                const std::size_t              wellIx,
+                                IWellArray&                    iWell)
         {
             using Ix = VI::IWell::index;
             using Value = VI::IWell::Value::Status;
 
-            const auto any_flowing_conn =
-                std::any_of(std::begin(xw.connections),
-                            std::end  (xw.connections),
-                    [](const Ewoms::data::Connection& c)
-                {
-                    return c.rates.flowing();
-                });
+            const auto any_flowing_conn = anyFlowingConnection(xw, wellIx);
 
             iWell[Ix::item9] = any_flowing_conn
                 ? 0 : -1;
@@ -384,24 +390,20 @@ namespace {
         }
 
         template <class IWellArray>
-        void dynamicContribOpen(const Ewoms::Well&       well,
-                                const Ewoms::data::Well& xw,
-                                IWellArray&            iWell)
+        void dynamicContribOpen(const Ewoms::Well&             well,
+                                const Ewoms::data::WellResults& xw,
+                                const std::size_t              wellIx,
+                                IWellArray&                    iWell)
         {
             using Ix = VI::IWell::index;
             using Value = VI::IWell::Value::Status;
 
-            if (wellControlDefined(xw)) {
-                setCurrentControl(ctrlMode(well, xw), iWell);
+            const auto& curr = xw.currentControl(wellIx);
+            if (wellControlDefined(curr)) {
+                setCurrentControl(ctrlMode(well, curr), iWell);
             }
 
-            const auto any_flowing_conn =
-                std::any_of(std::begin(xw.connections),
-                            std::end  (xw.connections),
-                    [](const Ewoms::data::Connection& c)
-                {
-                    return c.rates.flowing();
-                });
+            const auto any_flowing_conn = anyFlowingConnection(xw, wellIx);
 
             iWell[Ix::item9] = any_flowing_conn
                 ? iWell[Ix::ActWCtrl] : -1;
@@ -409,6 +411,29 @@ namespace {
             iWell[Ix::Status] = any_flowing_conn
                 ? Value::Open : Value::Shut;
         }
+
+        /// Results of the well are entry \p wellIx of \p xw, npos if the
+        /// simulator provided none.
+        template <class IWellArray>
+        void dynamicContrib(const Ewoms::Well&             well,
+                            const Ewoms::data::WellResults& xw,
+                            const std::size_t              wellIx,
+                            IWellArray&                    iWell)
+        {
+            const auto noResults = wellIx == Ewoms::data::WellResults::npos;
+
+            if (noResults || (well.getStatus() != Ewoms::Well::Status::OPEN)) {
+                if (noResults || (well.getStatus() == Ewoms::Well::Status::SHUT))  {
+                    dynamicContribShut(iWell);
+                }
+                else {
+                    dynamicContribStop(xw, wellIx, iWell);
+                }
+            }
+            else {
+                dynamicContribOpen(well, xw, wellIx, iWell);
+            }
+        }
     } // IWell
 
     namespace SWell {
@@ -1035,24 +1060,15 @@ captureDynamicWellData(const Ewoms::Schedule&        sched,
 {
     const auto& wells = sched.getWells(sim_step);
 
+    const auto results = Ewoms::data::WellResults{ xw };
+
     // Dynamic contributions to IWEL array.
-    wellLoop(wells, [this, &xw]
+    wellLoop(wells, [this, &results]
         (const Well& well, const std::size_t wellID) -> void
     {
         auto iWell = this->iWell_[wellID];
 
-        auto i = xw.find(well.name());
-        if ((i == std::end(xw)) || (well.getStatus() != Ewoms::Well::Status::OPEN)) {
-            if ((i == std::end(xw)) || (well.getStatus() == Ewoms::Well::Status::SHUT))  {
-                IWell::dynamicContribShut(iWell);
-            }
-            else {
-                IWell::dynamicContribStop(i->second, iWell);
-            }
-        }
-        else {
-            IWell::dynamicContribOpen(well, i->second, iWell);
-        }
+        IWell::dynamicContrib(well, results, results.findWell(well.name()), iWell);
     });
 
     // Dynamic contributions to XWEL array.
@@ -1064,3 +1080,43 @@ captureDynamicWellData(const Ewoms::Schedule&        sched,
         XWell::dynamicContrib(well, smry, xwell);
     });
 }
+
+// ---------------------------------------------------------------------
+
+void
+Ewoms::RestartIO::Helpers::AggregateWellData::
+captureWellData(const AggregationIndex&       index,
+                const Schedule&               sched,
+                const UnitSystem&             units,
+                const ::Ewoms::Action::State& action_state,
+                const ::Ewoms::SummaryState&  smry,
+                const std::vector<int>&       inteHead)
+{
+    const auto  sim_step = index.simStep();
+    const auto& step_glo = sched.glo(sim_step);
+
+    const auto groupMapNameIndex = IWell::currentGroupMapNameIndex(sched, sim_step, inteHead);
+    const auto actResStat = ZWell::act_res_stat(sched, action_state, smry, sim_step);
+
+    // All arrays of a well are filled before moving to the next well, and
+    // every well only writes its own windows.
+    index.forEachWellWindow([&](const std::size_t begin, const std::size_t end) -> void
+    {
+        for (auto wellID = begin; wellID < end; ++wellID) {
+            const auto& well = index.well(wellID);
+
+            auto iw = this->iWell_[wellID];
+            auto sw = this->sWell_[wellID];
+            auto xw = this->xWell_[wellID];
+            auto zw = this->zWell_[wellID];
+
+            IWell::staticContrib(well, step_glo, smry, index.msWellID(wellID), groupMapNameIndex, iw);
+            SWell::staticContrib(well, step_glo, units, sim_step, sched, smry, sw);
+            XWell::staticContrib(well, smry, units, xw);
+            ZWell::staticContrib(well, actResStat, zw);
+
+            IWell::dynamicContrib(well, index.results(), index.resultIndex(wellID), iw);
+            XWell::dynamicContrib(well, smry, xw);
+        }
+    });
+}
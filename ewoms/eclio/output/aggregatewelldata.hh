@@ -43,6 +43,8 @@ namespace Ewoms { namespace data {
 
 namespace Ewoms { namespace RestartIO { namespace Helpers {
 
+    class AggregationIndex;
+
     class AggregateWellData
     {
     public:
@@ -60,6 +62,16 @@ namespace Ewoms { namespace RestartIO { namespace Helpers {
                                     const Ewoms::data::WellRates& xw,
                                     const Ewoms::SummaryState&    smry);
 
+        /// Declared and dynamic well data in a single pass over the wells
+        /// of \p index.  Produces the same arrays as
+        /// captureDeclaredWellData() followed by captureDynamicWellData().
+        void captureWellData(const AggregationIndex&       index,
+                             const Schedule&               sched,
+                             const UnitSystem&             units,
+                             const ::Ewoms::Action::State& action_state,
+                             const ::Ewoms::SummaryState&  smry,
+                             const std::vector<int>&       inteHead);
+
         /// Retrieve Integer Well Data Array.
         const std::vector<int>& getIWell() const
         {
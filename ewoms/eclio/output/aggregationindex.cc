@@ -0,0 +1,86 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/output/aggregationindex.hh>
+
+#include <ewoms/eclio/output/data/wellresults.hh>
+
+#include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/well.hh>
+
+#include <ewoms/eclio/utility/taskgraph.hh>
+
+#include <algorithm>
+#include <string>
+
+namespace {
+    // Smallest number of wells worth handing to a separate thread.
+    constexpr std::size_t minWellsPerWindow = 256;
+}
+
+Ewoms::RestartIO::Helpers::AggregationIndex::
+AggregationIndex(const Schedule&         sched,
+                 const std::size_t       sim_step,
+                 const data::WellResults& xw)
+    : simStep_(sim_step)
+    , results_(&xw)
+    , groups_ (sched.restart_groups(sim_step))
+{
+    const auto wellNames = sched.wellNames(sim_step);
+
+    this->wells_.reserve(wellNames.size());
+    this->resultIndex_.reserve(wellNames.size());
+    this->msWellID_.reserve(wellNames.size());
+
+    auto msWellID = std::size_t{0};
+    for (const auto& wname : wellNames) {
+        const auto& well = sched.getWell(wname, sim_step);
+
+        this->wells_.push_back(&well);
+
+        this->resultIndex_.push_back(xw.findWell(wname));
+
+        this->msWellID_.push_back(well.isMultiSegment() ? ++msWellID : 0);
+    }
+}
+
+void
+Ewoms::RestartIO::Helpers::AggregationIndex::
+forEachWellWindow(const std::function<void(std::size_t, std::size_t)>& op) const
+{
+    const auto nWells = this->numWells();
+    const auto nThreads = std::min(TaskGraph::hardwareThreads(),
+                                   nWells / minWellsPerWindow);
+
+    if (nThreads <= 1) {
+        op(0, nWells);
+        return;
+    }
+
+    const auto windowSize = (nWells + nThreads - 1) / nThreads;
+
+    TaskGraph windows;
+    for (auto begin = std::size_t{0}; begin < nWells; begin += windowSize) {
+        const auto end = std::min(begin + windowSize, nWells);
+        windows.addTask([&op, begin, end]() { op(begin, end); });
+    }
+
+    windows.run(nThreads);
+}
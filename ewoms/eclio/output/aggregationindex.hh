@@ -0,0 +1,104 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_AGGREGATION_INDEX_H
+#define EWOMS_AGGREGATION_INDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Ewoms {
+    class Group;
+    class Schedule;
+    class Well;
+} // namespace Ewoms
+
+namespace Ewoms { namespace data {
+    class WellResults;
+}} // Ewoms::data
+
+namespace Ewoms { namespace RestartIO { namespace Helpers {
+
+    /*
+      Wells and groups of one report step in the order of the restart
+      arrays, together with the simulator results of each well.  Built once
+      per report step and shared by the well, connection and group
+      aggregators, which then neither copy the schedule's wells nor look
+      them up by name.
+    */
+    class AggregationIndex
+    {
+    public:
+        AggregationIndex(const Schedule&         sched,
+                         const std::size_t       sim_step,
+                         const data::WellResults& xw);
+
+        std::size_t simStep() const { return this->simStep_; }
+
+        std::size_t numWells() const { return this->wells_.size(); }
+
+        const Well& well(const std::size_t wellID) const
+        {
+            return *this->wells_[wellID];
+        }
+
+        /// Simulator results of all wells.
+        const data::WellResults& results() const
+        {
+            return *this->results_;
+        }
+
+        /// Index of a well in results(), data::WellResults::npos if the
+        /// simulator provided no results for it.
+        std::size_t resultIndex(const std::size_t wellID) const
+        {
+            return this->resultIndex_[wellID];
+        }
+
+        /// One-based index of a multi-segmented well among all
+        /// multi-segmented wells, zero for other wells.
+        std::size_t msWellID(const std::size_t wellID) const
+        {
+            return this->msWellID_[wellID];
+        }
+
+        /// Groups in IGRP order, see Schedule::restart_groups().
+        const std::vector<const Group*>& groups() const
+        {
+            return this->groups_;
+        }
+
+        /// Call op(begin, end) for consecutive ranges of well IDs which
+        /// together cover all wells.  With many wells the ranges are
+        /// processed concurrently, so op must only write to the array
+        /// windows of the wells in its own range.
+        void forEachWellWindow(const std::function<void(std::size_t, std::size_t)>& op) const;
+
+    private:
+        std::size_t simStep_;
+        std::vector<const Well*> wells_;
+        const data::WellResults* results_;
+        std::vector<std::size_t> resultIndex_;
+        std::vector<std::size_t> msWellID_;
+        std::vector<const Group*> groups_;
+    };
+
+}}} // Ewoms::RestartIO::Helpers
+
+#endif // EWOMS_AGGREGATION_INDEX_H
@@ -0,0 +1,107 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/output/data/solutionbuffer.hh>
+
+#include <stdexcept>
+
+namespace Ewoms { namespace data {
+
+    SolutionBuffer::SolutionBuffer(const std::size_t numCells)
+        : numCells_(numCells)
+    {}
+
+    std::size_t SolutionBuffer::addField(const std::string& name,
+                                         const UnitSystem::measure dim,
+                                         const TargetType target)
+    {
+        const auto slot = this->fields_.size();
+        if (! this->index_.emplace(name, slot).second) {
+            throw std::invalid_argument {
+                "Field '" + name + "' appears more than once in solution buffer"
+            };
+        }
+
+        this->fields_.push_back({ name, dim, target });
+        this->values_.resize(this->values_.size() + this->numCells_, 0.0);
+
+        return slot;
+    }
+
+    bool SolutionBuffer::has(const std::string& name) const
+    {
+        return this->index_.count(name) > 0;
+    }
+
+    std::size_t SolutionBuffer::slot(const std::string& name) const
+    {
+        const auto pos = this->index_.find(name);
+        if (pos == this->index_.end()) {
+            throw std::invalid_argument {
+                "Field '" + name + "' is not in solution buffer"
+            };
+        }
+
+        return pos->second;
+    }
+
+    double* SolutionBuffer::data(const std::size_t slot)
+    {
+        return this->values_.data() + slot*this->numCells_;
+    }
+
+    const double* SolutionBuffer::data(const std::size_t slot) const
+    {
+        return this->values_.data() + slot*this->numCells_;
+    }
+
+    void SolutionBuffer::exportTo(Solution& sol) const
+    {
+        for (auto slot = std::size_t{0}; slot < this->numFields(); ++slot) {
+            const auto& field = this->fields_[slot];
+            const auto* begin = this->data(slot);
+            const auto* end   = begin + this->numCells_;
+
+            auto pos = sol.find(field.name);
+            if (pos == sol.end()) {
+                sol.insert(field.name, field.dim,
+                           std::vector<double>(begin, end), field.target);
+                continue;
+            }
+
+            // Reuses the storage of the previous time step.
+            pos->second.dim = field.dim;
+            pos->second.target = field.target;
+            pos->second.data.assign(begin, end);
+        }
+
+        if (sol.size() != this->numFields()) {
+            for (auto pos = sol.begin(); pos != sol.end(); ) {
+                if (this->index_.count(pos->first) == 0) {
+                    pos = sol.erase(pos);
+                }
+                else {
+                    ++pos;
+                }
+            }
+        }
+    }
+
+}} // Ewoms::data
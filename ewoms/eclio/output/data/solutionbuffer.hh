@@ -0,0 +1,90 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_OUTPUT_SOLUTIONBUFFER_H
+#define EWOMS_OUTPUT_SOLUTIONBUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ewoms/eclio/output/data/cells.hh>
+#include <ewoms/eclio/output/data/solution.hh>
+
+namespace Ewoms { namespace data {
+
+    /*
+      Cell data in preallocated slots, one per field, all of the same
+      number of cells.  The fields are registered once and then addressed
+      by slot number, and the values of all fields are stored in a single
+      allocation.
+
+      The restart writer reads the buffer directly.  exportTo() hands the
+      fields to code still taking data::Solution; fields already in the
+      target are overwritten in place, reusing their storage from the
+      previous time step.
+    */
+    class SolutionBuffer {
+    public:
+        explicit SolutionBuffer(std::size_t numCells);
+
+        /// Register a field and return its slot.  Invalidates pointers
+        /// returned by data().
+        std::size_t addField(const std::string& name,
+                             UnitSystem::measure dim,
+                             TargetType target);
+
+        std::size_t numFields() const { return this->fields_.size(); }
+        std::size_t numCells() const { return this->numCells_; }
+
+        /// Name, unit of measure and output target of the field in \p slot.
+        const std::string& name(std::size_t slot) const { return this->fields_[slot].name; }
+        UnitSystem::measure dim(std::size_t slot) const { return this->fields_[slot].dim; }
+        TargetType target(std::size_t slot) const { return this->fields_[slot].target; }
+
+        bool has(const std::string& name) const;
+
+        /// Slot of the named field.  Throws std::invalid_argument for
+        /// unknown fields.
+        std::size_t slot(const std::string& name) const;
+
+        /// Values of the field in \p slot, numCells() of them.
+        double* data(std::size_t slot);
+        const double* data(std::size_t slot) const;
+
+        /// Store the fields in \p sol.  Fields of \p sol not in the buffer
+        /// are removed.
+        void exportTo(Solution& sol) const;
+
+    private:
+        struct Field {
+            std::string name;
+            UnitSystem::measure dim;
+            TargetType target;
+        };
+
+        std::size_t numCells_;
+        std::vector<Field> fields_;
+        std::unordered_map<std::string, std::size_t> index_;
+        std::vector<double> values_;
+    };
+
+}} // Ewoms::data
+
+#endif //EWOMS_OUTPUT_SOLUTIONBUFFER_H
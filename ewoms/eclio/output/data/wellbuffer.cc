@@ -0,0 +1,575 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/output/data/wellbuffer.hh>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+    using opt = Ewoms::data::Rates::opt;
+    using Mask = Ewoms::data::Rates::enum_size;
+
+    constexpr std::size_t rateSlot(const opt m)
+    {
+        auto bits = static_cast<Mask>(m);
+        auto slot = std::size_t{0};
+        while (bits > 1) {
+            bits >>= 1;
+            ++slot;
+        }
+
+        return slot;
+    }
+
+    // opt::alq is the last rate type, see Rates.
+    constexpr std::size_t numRateTypes = rateSlot(opt::alq) + 1;
+
+    std::size_t checkedRateSlot(const opt m)
+    {
+        const auto bits = static_cast<Mask>(m);
+        if ((bits == 0) || ((bits & (bits - 1)) != 0) || (rateSlot(m) >= numRateTypes)) {
+            throw std::invalid_argument {
+                "Unknown value type '" + std::to_string(bits) + "'"
+            };
+        }
+
+        return rateSlot(m);
+    }
+
+    template <typename T>
+    void resetValues(std::vector<T>& values)
+    {
+        std::fill(values.begin(), values.end(), T{});
+    }
+
+}
+
+namespace Ewoms { namespace data {
+
+    void WellBuffer::RateTable::resize(const std::size_t numEntities)
+    {
+        this->size_ = numEntities;
+        this->values_.assign(numRateTypes * numEntities, 0.0);
+        this->mask_.assign(numEntities, 0);
+    }
+
+    void WellBuffer::RateTable::reset()
+    {
+        resetValues(this->values_);
+        resetValues(this->mask_);
+    }
+
+    bool WellBuffer::RateTable::has(const std::size_t entity, const opt m) const
+    {
+        const auto bit = static_cast<Mask>(m);
+
+        return (this->mask_[entity] & bit) == bit;
+    }
+
+    double WellBuffer::RateTable::get(const std::size_t entity, const opt m,
+                                      const double default_value) const
+    {
+        if (! this->has(entity, m)) {
+            return default_value;
+        }
+
+        return this->values_[checkedRateSlot(m)*this->size_ + entity];
+    }
+
+    void WellBuffer::RateTable::set(const std::size_t entity, const opt m, const double value)
+    {
+        this->values_[checkedRateSlot(m)*this->size_ + entity] = value;
+        this->mask_[entity] |= static_cast<Mask>(m);
+    }
+
+    void WellBuffer::RateTable::assign(const std::size_t entity, const Rates& rates)
+    {
+        for (auto slot = std::size_t{0}; slot < numRateTypes; ++slot) {
+            const auto m = static_cast<opt>(Mask{1} << slot);
+
+            if (rates.has(m)) {
+                this->set(entity, m, rates.get(m));
+            }
+        }
+    }
+
+    bool WellBuffer::RateTable::flowing(const std::size_t entity) const
+    {
+        // Unset rates are zero, as in Rates::flowing().
+        return (this->values_[rateSlot(opt::wat)*this->size_ + entity] != 0.0)
+            || (this->values_[rateSlot(opt::oil)*this->size_ + entity] != 0.0)
+            || (this->values_[rateSlot(opt::gas)*this->size_ + entity] != 0.0);
+    }
+
+    Rates WellBuffer::RateTable::rates(const std::size_t entity) const
+    {
+        auto rates = Rates{};
+
+        for (auto slot = std::size_t{0}; slot < numRateTypes; ++slot) {
+            const auto bit = static_cast<Mask>(Mask{1} << slot);
+
+            if ((this->mask_[entity] & bit) != 0) {
+                rates.set(static_cast<opt>(bit), this->values_[slot*this->size_ + entity]);
+            }
+        }
+
+        return rates;
+    }
+
+    // ---------------------------------------------------------------------
+
+    WellBuffer::WellBuffer(const std::vector<WellLayout>& wells)
+    {
+        const auto numWells = wells.size();
+
+        this->names_.reserve(numWells);
+        this->connOffset_.reserve(numWells + 1);
+        this->segOffset_.reserve(numWells + 1);
+
+        this->connOffset_.push_back(0);
+        this->segOffset_.push_back(0);
+
+        for (const auto& well : wells) {
+            if (! this->index_.emplace(well.name, this->names_.size()).second) {
+                throw std::invalid_argument {
+                    "Well '" + well.name + "' appears more than once in well buffer"
+                };
+            }
+
+            this->names_.push_back(well.name);
+
+            this->connCell_.insert(this->connCell_.end(),
+                                   well.connections.begin(), well.connections.end());
+            this->connOffset_.push_back(this->connCell_.size());
+
+            this->segNumber_.insert(this->segNumber_.end(),
+                                    well.segments.begin(), well.segments.end());
+            this->segOffset_.push_back(this->segNumber_.size());
+        }
+
+        const auto numConn = this->connCell_.size();
+        const auto numSeg  = this->segNumber_.size();
+
+        this->wellRates_.resize(numWells);
+        this->bhp_.resize(numWells);
+        this->thp_.resize(numWells);
+        this->temperature_.resize(numWells);
+        this->control_.resize(numWells);
+        this->currentControl_.resize(numWells);
+        this->guideRates_.resize(numWells);
+
+        this->connRates_.resize(numConn);
+        this->connPressure_.resize(numConn);
+        this->connReservoirRate_.resize(numConn);
+        this->connCellPressure_.resize(numConn);
+        this->connCellSaturationWater_.resize(numConn);
+        this->connCellSaturationGas_.resize(numConn);
+        this->connEffectiveKh_.resize(numConn);
+        this->connTransFactor_.resize(numConn);
+
+        this->segRates_.resize(numSeg);
+        this->segPressures_.resize(numSeg);
+    }
+
+    WellBuffer::WellBuffer()
+        : WellBuffer(std::vector<WellLayout>{})
+    {}
+
+    WellBuffer::WellBuffer(const Wells& wells)
+        : WellBuffer(layout(wells))
+    {
+        auto w = std::size_t{0};
+        for (const auto& wellPair : wells) {
+            const auto& well = wellPair.second;
+
+            this->wellRates_.assign(w, well.rates);
+            this->bhp_[w] = well.bhp;
+            this->thp_[w] = well.thp;
+            this->temperature_[w] = well.temperature;
+            this->control_[w] = well.control;
+            this->currentControl_[w] = well.current_control;
+            this->guideRates_[w] = well.guide_rates;
+
+            auto c = this->connOffset_[w];
+            for (const auto& conn : well.connections) {
+                this->connRates_.assign(c, conn.rates);
+                this->connPressure_[c] = conn.pressure;
+                this->connReservoirRate_[c] = conn.reservoir_rate;
+                this->connCellPressure_[c] = conn.cell_pressure;
+                this->connCellSaturationWater_[c] = conn.cell_saturation_water;
+                this->connCellSaturationGas_[c] = conn.cell_saturation_gas;
+                this->connEffectiveKh_[c] = conn.effective_Kh;
+                this->connTransFactor_[c] = conn.trans_factor;
+                ++c;
+            }
+
+            for (auto s = this->segOffset_[w]; s < this->segOffset_[w + 1]; ++s) {
+                const auto& seg = well.segments.at(this->segNumber_[s]);
+
+                this->segRates_.assign(s, seg.rates);
+                this->segPressures_[s] = seg.pressures;
+            }
+
+            ++w;
+        }
+    }
+
+    std::vector<WellBuffer::WellLayout> WellBuffer::layout(const Wells& wells)
+    {
+        auto layout = std::vector<WellLayout>{};
+        layout.reserve(wells.size());
+
+        for (const auto& wellPair : wells) {
+            const auto& well = wellPair.second;
+
+            layout.push_back({ wellPair.first, {}, {} });
+            auto& wellLayout = layout.back();
+
+            wellLayout.connections.reserve(well.connections.size());
+            for (const auto& conn : well.connections) {
+                wellLayout.connections.push_back(conn.index);
+            }
+
+            wellLayout.segments.reserve(well.segments.size());
+            for (const auto& segPair : well.segments) {
+                wellLayout.segments.push_back(segPair.first);
+            }
+
+            std::sort(wellLayout.segments.begin(), wellLayout.segments.end());
+        }
+
+        return layout;
+    }
+
+    std::size_t WellBuffer::numConnections(const std::size_t well) const
+    {
+        return this->connOffset_[well + 1] - this->connOffset_[well];
+    }
+
+    std::size_t WellBuffer::numSegments(const std::size_t well) const
+    {
+        return this->segOffset_[well + 1] - this->segOffset_[well];
+    }
+
+    std::size_t WellBuffer::wellIndex(const std::string& name) const
+    {
+        const auto pos = this->index_.find(name);
+        if (pos == this->index_.end()) {
+            throw std::invalid_argument {
+                "Well '" + name + "' is not in well buffer"
+            };
+        }
+
+        return pos->second;
+    }
+
+    std::size_t WellBuffer::findWell(const std::string& name) const
+    {
+        const auto pos = this->index_.find(name);
+
+        return (pos == this->index_.end()) ? npos : pos->second;
+    }
+
+    void WellBuffer::reset()
+    {
+        this->wellRates_.reset();
+        resetValues(this->bhp_);
+        resetValues(this->thp_);
+        resetValues(this->temperature_);
+        resetValues(this->control_);
+        resetValues(this->currentControl_);
+        resetValues(this->guideRates_);
+
+        this->connRates_.reset();
+        resetValues(this->connPressure_);
+        resetValues(this->connReservoirRate_);
+        resetValues(this->connCellPressure_);
+        resetValues(this->connCellSaturationWater_);
+        resetValues(this->connCellSaturationGas_);
+        resetValues(this->connEffectiveKh_);
+        resetValues(this->connTransFactor_);
+
+        this->segRates_.reset();
+        resetValues(this->segPressures_);
+    }
+
+    bool WellBuffer::hasRate(const std::size_t well, const opt m) const
+    {
+        return this->wellRates_.has(well, m);
+    }
+
+    double WellBuffer::rate(const std::size_t well, const opt m) const
+    {
+        if (! this->hasRate(well, m)) {
+            throw std::invalid_argument { "Uninitialized value." };
+        }
+
+        return this->wellRates_.get(well, m, 0.0);
+    }
+
+    double WellBuffer::rate(const std::size_t well, const opt m, const double default_value) const
+    {
+        return this->wellRates_.get(well, m, default_value);
+    }
+
+    bool WellBuffer::flowing(const std::size_t well) const
+    {
+        return this->wellRates_.flowing(well);
+    }
+
+    void WellBuffer::setRate(const std::size_t well, const opt m, const double value)
+    {
+        this->wellRates_.set(well, m, value);
+    }
+
+    Connection::global_index
+    WellBuffer::connectionCell(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connCell_[this->connection(well, conn)];
+    }
+
+    std::size_t WellBuffer::findConnection(const std::size_t well,
+                                           const Connection::global_index cell) const
+    {
+        const auto begin = this->connCell_.begin() + this->connOffset_[well];
+        const auto end   = this->connCell_.begin() + this->connOffset_[well + 1];
+        const auto pos   = std::find(begin, end, cell);
+
+        return (pos == end) ? npos : static_cast<std::size_t>(pos - begin);
+    }
+
+    bool WellBuffer::hasConnectionRate(const std::size_t well, const std::size_t conn, const opt m) const
+    {
+        return this->connRates_.has(this->connection(well, conn), m);
+    }
+
+    double WellBuffer::connectionRate(const std::size_t well, const std::size_t conn,
+                                      const opt m) const
+    {
+        if (! this->hasConnectionRate(well, conn, m)) {
+            throw std::invalid_argument { "Uninitialized value." };
+        }
+
+        return this->connRates_.get(this->connection(well, conn), m, 0.0);
+    }
+
+    double WellBuffer::connectionRate(const std::size_t well, const std::size_t conn,
+                                      const opt m, const double default_value) const
+    {
+        return this->connRates_.get(this->connection(well, conn), m, default_value);
+    }
+
+    void WellBuffer::setConnectionRate(const std::size_t well, const std::size_t conn,
+                                       const opt m, const double value)
+    {
+        this->connRates_.set(this->connection(well, conn), m, value);
+    }
+
+    bool WellBuffer::connectionFlowing(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connRates_.flowing(this->connection(well, conn));
+    }
+
+    double& WellBuffer::connectionPressure(const std::size_t well, const std::size_t conn)
+    {
+        return this->connPressure_[this->connection(well, conn)];
+    }
+
+    double& WellBuffer::connectionReservoirRate(const std::size_t well, const std::size_t conn)
+    {
+        return this->connReservoirRate_[this->connection(well, conn)];
+    }
+
+    double& WellBuffer::connectionCellPressure(const std::size_t well, const std::size_t conn)
+    {
+        return this->connCellPressure_[this->connection(well, conn)];
+    }
+
+    double& WellBuffer::connectionCellSaturationWater(const std::size_t well, const std::size_t conn)
+    {
+        return this->connCellSaturationWater_[this->connection(well, conn)];
+    }
+
+    double& WellBuffer::connectionCellSaturationGas(const std::size_t well, const std::size_t conn)
+    {
+        return this->connCellSaturationGas_[this->connection(well, conn)];
+    }
+
+    double& WellBuffer::connectionEffectiveKh(const std::size_t well, const std::size_t conn)
+    {
+        return this->connEffectiveKh_[this->connection(well, conn)];
+    }
+
+    double& WellBuffer::connectionTransFactor(const std::size_t well, const std::size_t conn)
+    {
+        return this->connTransFactor_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionPressure(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connPressure_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionReservoirRate(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connReservoirRate_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionCellPressure(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connCellPressure_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionCellSaturationWater(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connCellSaturationWater_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionCellSaturationGas(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connCellSaturationGas_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionEffectiveKh(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connEffectiveKh_[this->connection(well, conn)];
+    }
+
+    double WellBuffer::connectionTransFactor(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connTransFactor_[this->connection(well, conn)];
+    }
+
+    std::size_t WellBuffer::segmentNumber(const std::size_t well, const std::size_t seg) const
+    {
+        return this->segNumber_[this->segment(well, seg)];
+    }
+
+    std::size_t WellBuffer::findSegment(const std::size_t well, const std::size_t segNumber) const
+    {
+        const auto begin = this->segNumber_.begin() + this->segOffset_[well];
+        const auto end   = this->segNumber_.begin() + this->segOffset_[well + 1];
+        const auto pos   = std::find(begin, end, segNumber);
+
+        return (pos == end) ? npos : static_cast<std::size_t>(pos - begin);
+    }
+
+    bool WellBuffer::hasSegmentRate(const std::size_t well, const std::size_t seg, const opt m) const
+    {
+        return this->segRates_.has(this->segment(well, seg), m);
+    }
+
+    double WellBuffer::segmentRate(const std::size_t well, const std::size_t seg,
+                                   const opt m, const double default_value) const
+    {
+        return this->segRates_.get(this->segment(well, seg), m, default_value);
+    }
+
+    void WellBuffer::setSegmentRate(const std::size_t well, const std::size_t seg,
+                                    const opt m, const double value)
+    {
+        this->segRates_.set(this->segment(well, seg), m, value);
+    }
+
+    SegmentPressures& WellBuffer::segmentPressures(const std::size_t well, const std::size_t seg)
+    {
+        return this->segPressures_[this->segment(well, seg)];
+    }
+
+    const SegmentPressures&
+    WellBuffer::segmentPressures(const std::size_t well, const std::size_t seg) const
+    {
+        return this->segPressures_[this->segment(well, seg)];
+    }
+
+    void WellBuffer::exportTo(Wells& wells) const
+    {
+        for (auto w = std::size_t{0}; w < this->numWells(); ++w) {
+            auto& well = wells[this->names_[w]];
+
+            well.rates = this->wellRates_.rates(w);
+            well.bhp = this->bhp_[w];
+            well.thp = this->thp_[w];
+            well.temperature = this->temperature_[w];
+            well.control = this->control_[w];
+            well.current_control = this->currentControl_[w];
+            well.guide_rates = this->guideRates_[w];
+
+            // Keeps the capacity of the previous time step.
+            well.connections.resize(this->numConnections(w));
+
+            for (auto c = this->connOffset_[w]; c < this->connOffset_[w + 1]; ++c) {
+                auto& conn = well.connections[c - this->connOffset_[w]];
+
+                conn.index = this->connCell_[c];
+                conn.rates = this->connRates_.rates(c);
+                conn.pressure = this->connPressure_[c];
+                conn.reservoir_rate = this->connReservoirRate_[c];
+                conn.cell_pressure = this->connCellPressure_[c];
+                conn.cell_saturation_water = this->connCellSaturationWater_[c];
+                conn.cell_saturation_gas = this->connCellSaturationGas_[c];
+                conn.effective_Kh = this->connEffectiveKh_[c];
+                conn.trans_factor = this->connTransFactor_[c];
+            }
+
+            const auto sameSegments = (well.segments.size() == this->numSegments(w))
+                && std::all_of(this->segNumber_.begin() + this->segOffset_[w],
+                               this->segNumber_.begin() + this->segOffset_[w + 1],
+                               [&well](const std::size_t segNumber)
+                               { return well.segments.count(segNumber) > 0; });
+
+            if (! sameSegments) {
+                well.segments.clear();
+            }
+
+            for (auto s = this->segOffset_[w]; s < this->segOffset_[w + 1]; ++s) {
+                auto& seg = well.segments[this->segNumber_[s]];
+
+                seg.rates = this->segRates_.rates(s);
+                seg.pressures = this->segPressures_[s];
+                seg.segNumber = this->segNumber_[s];
+            }
+        }
+
+        if (wells.size() != this->numWells()) {
+            for (auto well = wells.begin(); well != wells.end(); ) {
+                if (this->index_.count(well->first) == 0) {
+                    well = wells.erase(well);
+                }
+                else {
+                    ++well;
+                }
+            }
+        }
+    }
+
+    std::size_t WellBuffer::connection(const std::size_t well, const std::size_t conn) const
+    {
+        return this->connOffset_[well] + conn;
+    }
+
+    std::size_t WellBuffer::segment(const std::size_t well, const std::size_t seg) const
+    {
+        return this->segOffset_[well] + seg;
+    }
+
+}} // Ewoms::data
@@ -0,0 +1,221 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_OUTPUT_WELLBUFFER_H
+#define EWOMS_OUTPUT_WELLBUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ewoms/eclio/output/data/wells.hh>
+
+namespace Ewoms { namespace data {
+
+    /*
+      Well results in structure-of-arrays layout.  Wells are addressed by
+      their index in the list the buffer is created with, typically the
+      schedule's well order, and connections and segments by their index
+      within the well.  Rates are stored per rate type, so that a loop over
+      all wells for one rate type reads contiguous memory.
+
+      All storage is allocated by the constructor.  reset() clears the
+      values for the next time step without releasing memory.  The summary
+      and restart writers read the buffer through a WellResults view;
+      exportTo() hands the results to code still taking data::Wells, reusing
+      the map nodes and vectors of the target from the previous time step.
+    */
+    class WellBuffer {
+    public:
+        using opt = Rates::opt;
+
+        struct WellLayout {
+            std::string name;
+
+            /// Active cell index of every connection.
+            std::vector<Connection::global_index> connections;
+
+            /// Segment numbers of a multi-segment well.
+            std::vector<std::size_t> segments;
+        };
+
+        /// Returned by the find functions for entities not in the buffer.
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /// Buffer without wells.
+        WellBuffer();
+
+        explicit WellBuffer(const std::vector<WellLayout>& wells);
+
+        /// Buffer holding the results in \p wells, laid out in the order of
+        /// the map, the connection vectors and increasing segment number.
+        explicit WellBuffer(const Wells& wells);
+
+        std::size_t numWells() const { return this->names_.size(); }
+        std::size_t numConnections(std::size_t well) const;
+        std::size_t numSegments(std::size_t well) const;
+
+        const std::string& wellName(std::size_t well) const { return this->names_[well]; }
+
+        /// Index of the named well.  Throws std::invalid_argument for
+        /// unknown wells.
+        std::size_t wellIndex(const std::string& name) const;
+
+        /// Index of the named well, npos for unknown wells.
+        std::size_t findWell(const std::string& name) const;
+
+        /// Clear all values, keeping the layout.
+        void reset();
+
+        bool hasRate(std::size_t well, opt m) const;
+
+        /// Throws std::invalid_argument if the rate is not set, like
+        /// Rates::get().
+        double rate(std::size_t well, opt m) const;
+        double rate(std::size_t well, opt m, double default_value) const;
+        void setRate(std::size_t well, opt m, double value);
+
+        /// Whether the well has a non-zero surface rate, see Well::flowing().
+        bool flowing(std::size_t well) const;
+
+        double& bhp(std::size_t well) { return this->bhp_[well]; }
+        double& thp(std::size_t well) { return this->thp_[well]; }
+        double& temperature(std::size_t well) { return this->temperature_[well]; }
+        int& control(std::size_t well) { return this->control_[well]; }
+        CurrentControl& currentControl(std::size_t well) { return this->currentControl_[well]; }
+        GuideRateValue& guideRates(std::size_t well) { return this->guideRates_[well]; }
+
+        double bhp(std::size_t well) const { return this->bhp_[well]; }
+        double thp(std::size_t well) const { return this->thp_[well]; }
+        double temperature(std::size_t well) const { return this->temperature_[well]; }
+        int control(std::size_t well) const { return this->control_[well]; }
+        const CurrentControl& currentControl(std::size_t well) const { return this->currentControl_[well]; }
+        const GuideRateValue& guideRates(std::size_t well) const { return this->guideRates_[well]; }
+
+        /// Active cell index of a connection.
+        Connection::global_index connectionCell(std::size_t well, std::size_t conn) const;
+
+        /// Index within the well of the connection to \p cell, npos if the
+        /// well has no such connection.
+        std::size_t findConnection(std::size_t well, Connection::global_index cell) const;
+
+        bool hasConnectionRate(std::size_t well, std::size_t conn, opt m) const;
+        double connectionRate(std::size_t well, std::size_t conn, opt m) const;
+        double connectionRate(std::size_t well, std::size_t conn, opt m, double default_value) const;
+        void setConnectionRate(std::size_t well, std::size_t conn, opt m, double value);
+
+        /// Whether the connection has a non-zero surface rate, see
+        /// Rates::flowing().
+        bool connectionFlowing(std::size_t well, std::size_t conn) const;
+
+        double& connectionPressure(std::size_t well, std::size_t conn);
+        double& connectionReservoirRate(std::size_t well, std::size_t conn);
+        double& connectionCellPressure(std::size_t well, std::size_t conn);
+        double& connectionCellSaturationWater(std::size_t well, std::size_t conn);
+        double& connectionCellSaturationGas(std::size_t well, std::size_t conn);
+        double& connectionEffectiveKh(std::size_t well, std::size_t conn);
+        double& connectionTransFactor(std::size_t well, std::size_t conn);
+
+        double connectionPressure(std::size_t well, std::size_t conn) const;
+        double connectionReservoirRate(std::size_t well, std::size_t conn) const;
+        double connectionCellPressure(std::size_t well, std::size_t conn) const;
+        double connectionCellSaturationWater(std::size_t well, std::size_t conn) const;
+        double connectionCellSaturationGas(std::size_t well, std::size_t conn) const;
+        double connectionEffectiveKh(std::size_t well, std::size_t conn) const;
+        double connectionTransFactor(std::size_t well, std::size_t conn) const;
+
+        /// Segment number of a segment.
+        std::size_t segmentNumber(std::size_t well, std::size_t seg) const;
+
+        /// Index within the well of segment number \p segNumber, npos if the
+        /// well has no such segment.
+        std::size_t findSegment(std::size_t well, std::size_t segNumber) const;
+
+        bool hasSegmentRate(std::size_t well, std::size_t seg, opt m) const;
+        double segmentRate(std::size_t well, std::size_t seg, opt m, double default_value) const;
+        void setSegmentRate(std::size_t well, std::size_t seg, opt m, double value);
+
+        SegmentPressures& segmentPressures(std::size_t well, std::size_t seg);
+        const SegmentPressures& segmentPressures(std::size_t well, std::size_t seg) const;
+
+        /// Store the results in \p wells.  Existing entries are updated in
+        /// place, entries for wells not in the buffer are removed.
+        void exportTo(Wells& wells) const;
+
+    private:
+        using Mask = Rates::enum_size;
+
+        /// Rate storage of one kind of entity, rate type major.
+        class RateTable {
+        public:
+            void resize(std::size_t numEntities);
+            void reset();
+
+            bool has(std::size_t entity, opt m) const;
+            double get(std::size_t entity, opt m, double default_value) const;
+            void set(std::size_t entity, opt m, double value);
+
+            Rates rates(std::size_t entity) const;
+            void assign(std::size_t entity, const Rates& rates);
+            bool flowing(std::size_t entity) const;
+
+        private:
+            std::size_t size_ = 0;
+            std::vector<double> values_;
+            std::vector<Mask> mask_;
+        };
+
+        std::vector<std::string> names_;
+        std::unordered_map<std::string, std::size_t> index_;
+
+        RateTable wellRates_;
+        std::vector<double> bhp_;
+        std::vector<double> thp_;
+        std::vector<double> temperature_;
+        std::vector<int> control_;
+        std::vector<CurrentControl> currentControl_;
+        std::vector<GuideRateValue> guideRates_;
+
+        // Connections and segments of well i are the entries
+        // [offset[i], offset[i + 1]) of the corresponding arrays.
+        std::vector<std::size_t> connOffset_;
+        std::vector<Connection::global_index> connCell_;
+        RateTable connRates_;
+        std::vector<double> connPressure_;
+        std::vector<double> connReservoirRate_;
+        std::vector<double> connCellPressure_;
+        std::vector<double> connCellSaturationWater_;
+        std::vector<double> connCellSaturationGas_;
+        std::vector<double> connEffectiveKh_;
+        std::vector<double> connTransFactor_;
+
+        std::vector<std::size_t> segOffset_;
+        std::vector<std::size_t> segNumber_;
+        RateTable segRates_;
+        std::vector<SegmentPressures> segPressures_;
+
+        static std::vector<WellLayout> layout(const Wells& wells);
+
+        std::size_t connection(std::size_t well, std::size_t conn) const;
+        std::size_t segment(std::size_t well, std::size_t seg) const;
+    };
+
+}} // Ewoms::data
+
+#endif //EWOMS_OUTPUT_WELLBUFFER_H
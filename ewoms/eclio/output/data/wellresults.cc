@@ -0,0 +1,286 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/output/data/wellresults.hh>
+
+#include <ewoms/eclio/output/data/wellbuffer.hh>
+
+#include <algorithm>
+
+namespace Ewoms { namespace data {
+
+    WellResults::WellResults(const WellBuffer& buffer)
+        : buffer_(&buffer)
+    {}
+
+    WellResults::WellResults(const Wells& wells)
+    {
+        this->wells_.reserve(wells.size());
+        for (const auto& well : wells) {
+            this->wells_.push_back(&well);
+        }
+    }
+
+    std::size_t WellResults::numWells() const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->numWells() : this->wells_.size();
+    }
+
+    std::size_t WellResults::numConnections(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->numConnections(well) : this->well(well).connections.size();
+    }
+
+    std::size_t WellResults::numSegments(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->numSegments(well) : this->well(well).segments.size();
+    }
+
+    const std::string& WellResults::wellName(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->wellName(well) : this->wells_[well]->first;
+    }
+
+    std::size_t WellResults::findWell(const std::string& name) const
+    {
+        if (this->buffer_ != nullptr) {
+            return this->buffer_->findWell(name);
+        }
+
+        // The entries are sorted by well name, as in the map.
+        const auto pos = std::lower_bound(this->wells_.begin(), this->wells_.end(), name,
+            [](const Wells::value_type* well, const std::string& wname)
+        {
+            return well->first < wname;
+        });
+
+        return ((pos == this->wells_.end()) || ((*pos)->first != name))
+            ? npos : static_cast<std::size_t>(pos - this->wells_.begin());
+    }
+
+    bool WellResults::hasRate(const std::size_t well, const opt m) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->hasRate(well, m) : this->well(well).rates.has(m);
+    }
+
+    double WellResults::rate(const std::size_t well, const opt m) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->rate(well, m) : this->well(well).rates.get(m);
+    }
+
+    double WellResults::rate(const std::size_t well, const opt m, const double default_value) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->rate(well, m, default_value)
+            : this->well(well).rates.get(m, default_value);
+    }
+
+    bool WellResults::flowing(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->flowing(well) : this->well(well).flowing();
+    }
+
+    double WellResults::bhp(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->bhp(well) : this->well(well).bhp;
+    }
+
+    double WellResults::thp(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->thp(well) : this->well(well).thp;
+    }
+
+    double WellResults::temperature(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->temperature(well) : this->well(well).temperature;
+    }
+
+    int WellResults::control(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->control(well) : this->well(well).control;
+    }
+
+    const CurrentControl& WellResults::currentControl(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->currentControl(well) : this->well(well).current_control;
+    }
+
+    const GuideRateValue& WellResults::guideRates(const std::size_t well) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->guideRates(well) : this->well(well).guide_rates;
+    }
+
+    Connection::global_index
+    WellResults::connectionCell(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionCell(well, conn) : this->connection(well, conn).index;
+    }
+
+    std::size_t WellResults::findConnection(const std::size_t well,
+                                            const Connection::global_index cell) const
+    {
+        if (this->buffer_ != nullptr) {
+            return this->buffer_->findConnection(well, cell);
+        }
+
+        const auto* conn = this->well(well).find_connection(cell);
+
+        return (conn == nullptr)
+            ? npos : static_cast<std::size_t>(conn - this->well(well).connections.data());
+    }
+
+    bool WellResults::hasConnectionRate(const std::size_t well, const std::size_t conn, const opt m) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->hasConnectionRate(well, conn, m)
+            : this->connection(well, conn).rates.has(m);
+    }
+
+    double WellResults::connectionRate(const std::size_t well, const std::size_t conn,
+                                       const opt m) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionRate(well, conn, m)
+            : this->connection(well, conn).rates.get(m);
+    }
+
+    double WellResults::connectionRate(const std::size_t well, const std::size_t conn,
+                                       const opt m, const double default_value) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionRate(well, conn, m, default_value)
+            : this->connection(well, conn).rates.get(m, default_value);
+    }
+
+    bool WellResults::connectionFlowing(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionFlowing(well, conn)
+            : this->connection(well, conn).rates.flowing();
+    }
+
+    double WellResults::connectionPressure(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionPressure(well, conn)
+            : this->connection(well, conn).pressure;
+    }
+
+    double WellResults::connectionReservoirRate(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionReservoirRate(well, conn)
+            : this->connection(well, conn).reservoir_rate;
+    }
+
+    double WellResults::connectionCellPressure(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionCellPressure(well, conn)
+            : this->connection(well, conn).cell_pressure;
+    }
+
+    double WellResults::connectionCellSaturationWater(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionCellSaturationWater(well, conn)
+            : this->connection(well, conn).cell_saturation_water;
+    }
+
+    double WellResults::connectionCellSaturationGas(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionCellSaturationGas(well, conn)
+            : this->connection(well, conn).cell_saturation_gas;
+    }
+
+    double WellResults::connectionEffectiveKh(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionEffectiveKh(well, conn)
+            : this->connection(well, conn).effective_Kh;
+    }
+
+    double WellResults::connectionTransFactor(const std::size_t well, const std::size_t conn) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->connectionTransFactor(well, conn)
+            : this->connection(well, conn).trans_factor;
+    }
+
+    std::size_t WellResults::findSegment(const std::size_t well, const std::size_t segNumber) const
+    {
+        if (this->buffer_ != nullptr) {
+            return this->buffer_->findSegment(well, segNumber);
+        }
+
+        // The segment number itself addresses a segment of data::Wells.
+        return (this->well(well).segments.count(segNumber) == 0)
+            ? npos : segNumber;
+    }
+
+    bool WellResults::hasSegmentRate(const std::size_t well, const std::size_t seg, const opt m) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->hasSegmentRate(well, seg, m)
+            : this->segment(well, seg).rates.has(m);
+    }
+
+    double WellResults::segmentRate(const std::size_t well, const std::size_t seg,
+                                    const opt m, const double default_value) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->segmentRate(well, seg, m, default_value)
+            : this->segment(well, seg).rates.get(m, default_value);
+    }
+
+    const SegmentPressures&
+    WellResults::segmentPressures(const std::size_t well, const std::size_t seg) const
+    {
+        return (this->buffer_ != nullptr)
+            ? this->buffer_->segmentPressures(well, seg)
+            : this->segment(well, seg).pressures;
+    }
+
+    const Connection& WellResults::connection(const std::size_t well, const std::size_t conn) const
+    {
+        return this->well(well).connections[conn];
+    }
+
+    const Segment& WellResults::segment(const std::size_t well, const std::size_t seg) const
+    {
+        return this->well(well).segments.at(seg);
+    }
+
+}} // Ewoms::data
@@ -0,0 +1,120 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_OUTPUT_WELLRESULTS_H
+#define EWOMS_OUTPUT_WELLRESULTS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ewoms/eclio/output/data/wells.hh>
+
+namespace Ewoms { namespace data {
+
+    class WellBuffer;
+
+    /*
+      Read-only view of the well results of one time step, held either in
+      a WellBuffer or in data::Wells.  The summary and restart writers read
+      the results through this view, so callers still passing data::Wells
+      are served by lookups in the map instead of a copy of all results.
+
+      Wells and connections are addressed by index as in WellBuffer; for
+      data::Wells the wells are in the order of the map.  Segments are
+      addressed by the value findSegment() returns.  The view refers to
+      the results it is created from, which must outlive it.
+    */
+    class WellResults {
+    public:
+        using opt = Rates::opt;
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /// View without any wells.
+        WellResults() = default;
+        explicit WellResults(const WellBuffer& buffer);
+        explicit WellResults(const Wells& wells);
+
+        std::size_t numWells() const;
+        std::size_t numConnections(std::size_t well) const;
+        std::size_t numSegments(std::size_t well) const;
+
+        const std::string& wellName(std::size_t well) const;
+
+        /// Index of the named well, npos for unknown wells.
+        std::size_t findWell(const std::string& name) const;
+
+        bool hasRate(std::size_t well, opt m) const;
+
+        /// Throws std::invalid_argument if the rate is not set, like
+        /// Rates::get().
+        double rate(std::size_t well, opt m) const;
+        double rate(std::size_t well, opt m, double default_value) const;
+
+        bool flowing(std::size_t well) const;
+
+        double bhp(std::size_t well) const;
+        double thp(std::size_t well) const;
+        double temperature(std::size_t well) const;
+        int control(std::size_t well) const;
+        const CurrentControl& currentControl(std::size_t well) const;
+        const GuideRateValue& guideRates(std::size_t well) const;
+
+        Connection::global_index connectionCell(std::size_t well, std::size_t conn) const;
+
+        /// Index within the well of the connection to \p cell, npos if the
+        /// well has no such connection.
+        std::size_t findConnection(std::size_t well, Connection::global_index cell) const;
+
+        bool hasConnectionRate(std::size_t well, std::size_t conn, opt m) const;
+        double connectionRate(std::size_t well, std::size_t conn, opt m) const;
+        double connectionRate(std::size_t well, std::size_t conn, opt m, double default_value) const;
+        bool connectionFlowing(std::size_t well, std::size_t conn) const;
+
+        double connectionPressure(std::size_t well, std::size_t conn) const;
+        double connectionReservoirRate(std::size_t well, std::size_t conn) const;
+        double connectionCellPressure(std::size_t well, std::size_t conn) const;
+        double connectionCellSaturationWater(std::size_t well, std::size_t conn) const;
+        double connectionCellSaturationGas(std::size_t well, std::size_t conn) const;
+        double connectionEffectiveKh(std::size_t well, std::size_t conn) const;
+        double connectionTransFactor(std::size_t well, std::size_t conn) const;
+
+        /// Segment number \p segNumber of the well, npos if the well has no
+        /// such segment.
+        std::size_t findSegment(std::size_t well, std::size_t segNumber) const;
+
+        bool hasSegmentRate(std::size_t well, std::size_t seg, opt m) const;
+        double segmentRate(std::size_t well, std::size_t seg, opt m, double default_value) const;
+        const SegmentPressures& segmentPressures(std::size_t well, std::size_t seg) const;
+
+    private:
+        const WellBuffer* buffer_ = nullptr;
+
+        // Entries of the data::Wells map in map order, only set if the
+        // view is created from data::Wells.
+        std::vector<const Wells::value_type*> wells_;
+
+        const Well& well(std::size_t well) const { return this->wells_[well]->second; }
+        const Connection& connection(std::size_t well, std::size_t conn) const;
+        const Segment& segment(std::size_t well, std::size_t seg) const;
+    };
+
+}} // Ewoms::data
+
+#endif //EWOMS_OUTPUT_WELLRESULTS_H
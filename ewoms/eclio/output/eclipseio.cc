@@ -34,6 +34,7 @@
 #include <ewoms/eclio/parser/units/dimension.hh>
 #include <ewoms/eclio/parser/units/unitsystem.hh>
 
+#include <ewoms/eclio/output/data/wellbuffer.hh>
 #include <ewoms/eclio/output/restartio.hh>
 #include <ewoms/eclio/output/summary.hh>
 #include <ewoms/eclio/output/writeinit.hh>
@@ -99,6 +100,12 @@ class EclipseIO::Impl {
         void writeEGRIDFile( const std::vector<NNCdata>& nnc );
         bool wantRFTOutput( const int report_step, const bool isSubstep ) const;
 
+        void writeSummaryFiles( const SummaryState& st, int report_step, bool isSubstep );
+        template <class SaveRestart>
+        void writeRestartFile( int report_step, bool isSubstep, SaveRestart&& save ) const;
+        void writeRFTFile( int report_step, double secs_elapsed, const data::Wells& wells ) const;
+        void writeReports( int report_step, bool isSubstep ) const;
+
         const EclipseState& es;
         EclipseGrid grid;
         const Schedule& schedule;
@@ -157,6 +164,97 @@ bool EclipseIO::Impl::wantRFTOutput( const int  report_step,
             >= this->schedule.rftConfig().firstRFTOutput());
 }
 
+void EclipseIO::Impl::writeSummaryFiles( const SummaryState& st,
+                                         const int           report_step,
+                                         const bool          isSubstep )
+{
+    /*
+      Summary data is written unconditionally for every timestep except for the
+      very intial report_step==0 call, which is only garbage.
+    */
+    if (report_step > 0) {
+        this->summary.add_timestep( st,
+                                    report_step);
+        this->summary.write();
+    }
+
+    bool final_step { report_step == static_cast<int>(this->schedule.size()) - 1 };
+
+    if (final_step && !isSubstep && this->summaryConfig.createRunSummary()) {
+        Ewoms::filesystem::path outputDir { this->outputDir } ;
+        Ewoms::filesystem::path outputFile { outputDir / this->baseName } ;
+        EclIO::ESmry(outputFile).write_rsm_file();
+    }
+}
+
+template <class SaveRestart>
+void EclipseIO::Impl::writeRestartFile( const int     report_step,
+                                        const bool    isSubstep,
+                                        SaveRestart&& save ) const
+{
+    /*
+      Current implementation will not write restart files for substep,
+      but there is an unsupported option to the RPTSCHED keyword which
+      will request restart output from every timestep.
+    */
+    if (isSubstep || !this->schedule.restart().getWriteRestartFile(report_step))
+        return;
+
+    const auto& ioConfig = this->es.cfg().io();
+
+    EclIO::OutputStream::Restart rstFile {
+        EclIO::OutputStream::ResultSet { this->outputDir,
+                                         this->baseName },
+        report_step,
+        EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
+        EclIO::OutputStream::Unified   { ioConfig.getUNIFOUT() },
+        EclIO::OutputStream::Compressed { ioConfig.getCompressedOutput() }
+    };
+
+    save(rstFile);
+}
+
+void EclipseIO::Impl::writeRFTFile( const int          report_step,
+                                    const double       secs_elapsed,
+                                    const data::Wells& wells ) const
+{
+    const auto& ioConfig = this->es.cfg().io();
+
+    // Open existing RFT file if report step is after first RFT event.
+    const auto openExisting = EclIO::OutputStream::RFT::OpenExisting {
+        static_cast<std::size_t>(report_step)
+        > this->schedule.rftConfig().firstRFTOutput()
+    };
+
+    EclIO::OutputStream::RFT rftFile {
+        EclIO::OutputStream::ResultSet { this->outputDir,
+                                         this->baseName },
+        EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
+        openExisting
+    };
+
+    RftIO::write(report_step, secs_elapsed, this->es.getUnits(),
+                 this->grid, this->schedule, wells, rftFile);
+}
+
+void EclipseIO::Impl::writeReports( const int  report_step,
+                                    const bool isSubstep ) const
+{
+    if (isSubstep)
+        return;
+
+    for (const auto& report : this->schedule.report_config(report_step)) {
+        std::stringstream ss;
+        const auto& unit_system = this->es.getUnits();
+
+        RptIO::write_report(ss, report.first, report.second, this->schedule, this->grid, unit_system, report_step);
+
+        auto log_string = ss.str();
+        if (!log_string.empty())
+            OpmLog::note(log_string);
+    }
+}
+
 /*
 int_data: Writes key(string) and integers vector to INIT file as eclipse keywords
 - Key: Max 8 chars.
@@ -197,77 +295,63 @@ void EclipseIO::writeTimeStep(const Action::State& action_state,
     const auto& es = this->impl->es;
     const auto& grid = this->impl->grid;
     const auto& schedule = this->impl->schedule;
-    const auto& ioConfig = es.cfg().io();
 
-    /*
-      Summary data is written unconditionally for every timestep except for the
-      very intial report_step==0 call, which is only garbage.
-    */
-    if (report_step > 0) {
-        this->impl->summary.add_timestep( st,
-                                          report_step);
-        this->impl->summary.write();
-    }
+    this->impl->writeSummaryFiles(st, report_step, isSubstep);
 
-    bool final_step { report_step == static_cast<int>(this->impl->schedule.size()) - 1 };
-
-    if (final_step && !isSubstep && this->impl->summaryConfig.createRunSummary()) {
-        Ewoms::filesystem::path outputDir { this->impl->outputDir } ;
-        Ewoms::filesystem::path outputFile { outputDir / this->impl->baseName } ;
-        EclIO::ESmry(outputFile).write_rsm_file();
-    }
-
-    /*
-      Current implementation will not write restart files for substep,
-      but there is an unsupported option to the RPTSCHED keyword which
-      will request restart output from every timestep.
-    */
-    if(!isSubstep && schedule.restart().getWriteRestartFile(report_step))
+    this->impl->writeRestartFile(report_step, isSubstep,
+        [&](EclIO::OutputStream::Restart& rstFile)
     {
-        EclIO::OutputStream::Restart rstFile {
-            EclIO::OutputStream::ResultSet { this->impl->outputDir,
-                                             this->impl->baseName },
-            report_step,
-            EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
-            EclIO::OutputStream::Unified   { ioConfig.getUNIFOUT() }
-        };
-
         RestartIO::save(rstFile, report_step, secs_elapsed, value,
                         es, grid, schedule, action_state, st, udq_state, write_double);
-    }
+    });
 
     // RFT file written only if requested and never for substeps.
     if (this->impl->wantRFTOutput(report_step, isSubstep)) {
-        // Open existing RFT file if report step is after first RFT event.
-        const auto openExisting = EclIO::OutputStream::RFT::OpenExisting {
-            static_cast<std::size_t>(report_step)
-            > schedule.rftConfig().firstRFTOutput()
-        };
+        this->impl->writeRFTFile(report_step, secs_elapsed, value.wells);
+    }
 
-        EclIO::OutputStream::RFT rftFile {
-            EclIO::OutputStream::ResultSet { this->impl->outputDir,
-                                             this->impl->baseName },
-            EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
-            openExisting
-        };
+    this->impl->writeReports(report_step, isSubstep);
+ }
 
-        RftIO::write(report_step, secs_elapsed, es.getUnits(),
-                     grid, schedule, value.wells, rftFile);
+void EclipseIO::writeTimeStep(const Action::State& action_state,
+                              const SummaryState& st,
+                              const UDQState& udq_state,
+                              int report_step,
+                              bool  isSubstep,
+                              double secs_elapsed,
+                              const data::SolutionBuffer& solution,
+                              const data::WellBuffer& wells,
+                              RestartValue::ExtraVector extra,
+                              const bool write_double)
+{
+    if (! this->impl->output_enabled) {
+        return;
     }
 
-    if (!isSubstep) {
-        for (const auto& report : schedule.report_config(report_step)) {
-            std::stringstream ss;
-            const auto& unit_system = this->impl->es.getUnits();
+    const auto& es = this->impl->es;
+    const auto& grid = this->impl->grid;
+    const auto& schedule = this->impl->schedule;
+
+    this->impl->writeSummaryFiles(st, report_step, isSubstep);
+
+    this->impl->writeRestartFile(report_step, isSubstep,
+        [&](EclIO::OutputStream::Restart& rstFile)
+    {
+        RestartIO::save(rstFile, report_step, secs_elapsed, solution, wells,
+                        std::move(extra), es, grid, schedule, action_state,
+                        st, udq_state, write_double);
+    });
 
-            RptIO::write_report(ss, report.first, report.second, schedule, grid, unit_system, report_step);
+    // The RFT writer still takes data::Wells.
+    if (this->impl->wantRFTOutput(report_step, isSubstep)) {
+        auto rftWells = data::Wells{};
+        wells.exportTo(rftWells);
 
-            auto log_string = ss.str();
-            if (!log_string.empty())
-                OpmLog::note(log_string);
-        }
+        this->impl->writeRFTFile(report_step, secs_elapsed, rftWells);
     }
- }
+
+    this->impl->writeReports(report_step, isSubstep);
+}
 
 RestartValue EclipseIO::loadRestart(Action::State& action_state, SummaryState& summary_state, const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys) const {
     const auto& es                       = this->impl->es;
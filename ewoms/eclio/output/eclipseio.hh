@@ -36,6 +36,11 @@ namespace Ewoms { namespace out {
     class Summary;
 }} // namespace Ewoms::out
 
+namespace Ewoms { namespace data {
+    class SolutionBuffer;
+    class WellBuffer;
+}} // namespace Ewoms::data
+
 namespace Ewoms {
 
 class EclipseState;
@@ -178,6 +183,22 @@ public:
                         RestartValue value,
                         const bool write_double = false);
 
+    /*
+     * As above, but with the solution and the well results read directly
+     * from the simulator's buffers.  The extra argument holds the extra
+     * restart vectors otherwise passed in RestartValue::extra.
+     */
+    void writeTimeStep( const Action::State& action_state,
+                        const SummaryState& st,
+                        const UDQState& udq_state,
+                        int report_step,
+                        bool isSubstep,
+                        double seconds_elapsed,
+                        const data::SolutionBuffer& solution,
+                        const data::WellBuffer& wells,
+                        RestartValue::ExtraVector extra,
+                        const bool write_double = false);
+
     /*
       Will load solution data and wellstate from the restart
       file. This method will consult the IOConfig object to get
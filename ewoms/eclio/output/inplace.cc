@@ -20,41 +20,182 @@
 
 #include <algorithm>
 #include <exception>
-#include <ewoms/common/optional.hh>
+#include <stdexcept>
 
 #include <ewoms/common/fmt/format.h>
 
 #include <ewoms/eclio/output/inplace.hh>
+#include <ewoms/eclio/utility/taskgraph.hh>
 
 namespace Ewoms {
 
 namespace {
 static const std::string FIELD_NAME = std::string{"FIELD"};
 static const std::size_t FIELD_ID   = 0;
+
+// Number of cells per partial sum in the region reduction.
+const std::size_t REDUCTION_CHUNK = std::size_t{1} << 16;
+
+/*
+  Sum of the cell values per region number, indexed by region number, with
+  one row of partial sums per chunk of cells.
+*/
+std::vector<double> region_totals(const std::vector<int>& cell_regions, const std::vector<double>& cell_values, std::size_t num_regions) {
+    const auto size = cell_regions.size();
+    const auto num_chunks = std::max((size + REDUCTION_CHUNK - 1) / REDUCTION_CHUNK, std::size_t{1});
+    std::vector<double> partial(num_chunks * num_regions, 0.0);
+
+    auto sum_chunk = [&](std::size_t chunk) {
+        auto* sums = partial.data() + chunk * num_regions;
+        const auto end = std::min(size, (chunk + 1) * REDUCTION_CHUNK);
+        for (auto cell = chunk * REDUCTION_CHUNK; cell < end; ++cell) {
+            const auto region = cell_regions[cell];
+            if (region > 0)
+                sums[region] += cell_values[cell];
+        }
+    };
+
+    const auto num_threads = TaskGraph::hardwareThreads();
+    if (num_chunks == 1 || num_threads <= 1) {
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+            sum_chunk(chunk);
+    } else {
+        TaskGraph tasks;
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk)
+            tasks.addTask([&sum_chunk, chunk]() { sum_chunk(chunk); });
+
+        tasks.run(num_threads);
+    }
+
+    std::vector<double> totals(partial.begin(), partial.begin() + num_regions);
+    for (std::size_t chunk = 1; chunk < num_chunks; ++chunk) {
+        const auto* sums = partial.data() + chunk * num_regions;
+        for (std::size_t region = 0; region < num_regions; ++region)
+            totals[region] += sums[region];
+    }
+
+    return totals;
+}
+}
+
+const Inplace::RegionBlock* Inplace::find_block(const std::string& region) const {
+    const auto iter = std::find_if(this->blocks.begin(), this->blocks.end(),
+                                   [&region](const RegionBlock& block) { return block.name == region; });
+
+    return (iter == this->blocks.end()) ? nullptr : &*iter;
+}
+
+/*
+  The block of the region name, with room for at least num_regions region
+  numbers. Blocks grow geometrically; growing one moves the blocks behind
+  it.
+*/
+Inplace::RegionBlock& Inplace::block(const std::string& region, std::size_t num_regions) {
+    auto iter = std::find_if(this->blocks.begin(), this->blocks.end(),
+                             [&region](const RegionBlock& block) { return block.name == region; });
+
+    if (iter == this->blocks.end()) {
+        RegionBlock block;
+        block.name = region;
+        block.offset = this->values.size();
+        block.num_regions = num_regions;
+
+        this->values.resize(block.offset + num_phases * num_regions, 0.0);
+        this->present.resize(this->values.size(), 0);
+        this->blocks.push_back(block);
+
+        return this->blocks.back();
+    }
+
+    if (iter->num_regions >= num_regions)
+        return *iter;
+
+    std::vector<RegionBlock> new_blocks = this->blocks;
+    new_blocks[iter - this->blocks.begin()].num_regions = std::max(num_regions, 2 * iter->num_regions);
+
+    std::size_t offset = 0;
+    for (auto& new_block : new_blocks) {
+        new_block.offset = offset;
+        offset += num_phases * new_block.num_regions;
+    }
+
+    std::vector<double> new_values(offset, 0.0);
+    std::vector<char> new_present(offset, 0);
+    for (std::size_t b = 0; b < this->blocks.size(); ++b) {
+        const auto& old_block = this->blocks[b];
+        for (std::size_t phase = 0; phase < num_phases; ++phase) {
+            const auto src = old_block.offset + phase * old_block.num_regions;
+            const auto dst = new_blocks[b].offset + phase * new_blocks[b].num_regions;
+
+            std::copy_n(this->values.begin() + src, old_block.num_regions, new_values.begin() + dst);
+            std::copy_n(this->present.begin() + src, old_block.num_regions, new_present.begin() + dst);
+        }
+    }
+
+    const auto position = iter - this->blocks.begin();
+    this->blocks = std::move(new_blocks);
+    this->values = std::move(new_values);
+    this->present = std::move(new_present);
+
+    return this->blocks[position];
+}
+
+std::size_t Inplace::index(const RegionBlock& block, Inplace::Phase phase, std::size_t region_id) const {
+    return block.offset + static_cast<std::size_t>(phase) * block.num_regions + region_id;
+}
+
+bool Inplace::has_phase(const RegionBlock& block, Inplace::Phase phase) const {
+    const auto begin = this->present.begin() + this->index(block, phase, 0);
+    return std::find(begin, begin + block.num_regions, char{1}) != begin + block.num_regions;
 }
 
 void Inplace::add(const std::string& region, Inplace::Phase phase, std::size_t region_id, double value) {
-    this->phase_values[region][phase][region_id] = value;
+    auto& block = this->block(region, region_id + 1);
+    const auto idx = this->index(block, phase, region_id);
+
+    this->values[idx] = value;
+    this->present[idx] = 1;
+    block.max_region = std::max(block.max_region, region_id);
 }
 
 void Inplace::add(Inplace::Phase phase, double value) {
     this->add( FIELD_NAME, phase, FIELD_ID, value );
 }
 
+void Inplace::add(const std::string& region, Inplace::Phase phase, const std::vector<int>& cell_regions, const std::vector<double>& cell_values) {
+    if (cell_regions.size() != cell_values.size())
+        throw std::invalid_argument(fmt::format("Region array of size {} does not match {} cell values",
+                                                cell_regions.size(), cell_values.size()));
+
+    const auto max_iter = std::max_element(cell_regions.begin(), cell_regions.end());
+    if (max_iter == cell_regions.end() || *max_iter < 1)
+        return;
+
+    const auto max_id = static_cast<std::size_t>(*max_iter);
+    const auto totals = region_totals(cell_regions, cell_values, max_id + 1);
+
+    auto& block = this->block(region, max_id + 1);
+    const auto first = this->index(block, phase, 1);
+    std::copy(totals.begin() + 1, totals.end(), this->values.begin() + first);
+    std::fill_n(this->present.begin() + first, max_id, char{1});
+    block.max_region = std::max(block.max_region, max_id);
+}
+
 double Inplace::get(const std::string& region, Inplace::Phase phase, std::size_t region_id) const {
-    auto region_iter = this->phase_values.find(region);
-    if (region_iter == this->phase_values.end())
+    const auto* block = this->find_block(region);
+    if (block == nullptr)
         throw std::logic_error(fmt::format("No such region: {}", region));
 
-    auto phase_iter = region_iter->second.find(phase);
-    if (phase_iter == region_iter->second.end())
-        throw std::logic_error(fmt::format("No such phase: {}:{}", region, static_cast<int>(phase)));
+    if (region_id < block->num_regions) {
+        const auto idx = this->index(*block, phase, region_id);
+        if (this->present[idx])
+            return this->values[idx];
+    }
 
-    auto value_iter = phase_iter->second.find(region_id);
-    if (value_iter == phase_iter->second.end())
-        throw std::logic_error(fmt::format("No such region id: {}:{}:{}", region, static_cast<int>(phase), region_id));
+    if (!this->has_phase(*block, phase))
+        throw std::logic_error(fmt::format("No such phase: {}:{}", region, static_cast<int>(phase)));
 
-    return value_iter->second;
+    throw std::logic_error(fmt::format("No such region id: {}:{}:{}", region, static_cast<int>(phase), region_id));
 }
 
 double Inplace::get(Inplace::Phase phase) const {
@@ -62,74 +203,45 @@ double Inplace::get(Inplace::Phase phase) const {
 }
 
 bool Inplace::has(const std::string& region, Phase phase, std::size_t region_id) const {
-    auto region_iter = this->phase_values.find(region);
-    if (region_iter == this->phase_values.end())
-        return false;
-
-    auto phase_iter = region_iter->second.find(phase);
-    if (phase_iter == region_iter->second.end())
+    const auto* block = this->find_block(region);
+    if (block == nullptr || region_id >= block->num_regions)
         return false;
 
-    auto value_iter = phase_iter->second.find(region_id);
-    if (value_iter == phase_iter->second.end())
-        return false;
-
-    return true;
+    return this->present[this->index(*block, phase, region_id)] != 0;
 }
 
 bool Inplace::has(Phase phase) const {
     return this->has(FIELD_NAME, phase, FIELD_ID);
 }
 
-namespace {
-std::size_t region_max(const std::unordered_map<std::size_t, double>& region_map) {
-    std::size_t max_value = 0;
-    for (const auto& rPair : region_map) {
-        const auto& region_id = rPair.first;
-        max_value = std::max(max_value, region_id);
-    }
-    return max_value;
-}
-}
-
 std::size_t Inplace::max_region() const {
     std::size_t max_value = 0;
-    for (const auto& pvPair : this->phase_values) {
-        const auto& phase_map = pvPair.second;
-        for (const auto& pPair : phase_map) {
-             const auto& region_map = pPair.second;
-             max_value = std::max(max_value, region_max(region_map));
-        }
-    }
+    for (const auto& block : this->blocks)
+        max_value = std::max(max_value, block.max_region);
 
     return max_value;
 }
 
 std::size_t Inplace::max_region(const std::string& region_name) const {
-    Ewoms::optional<std::size_t> max_value;
-    const auto& region_iter = this->phase_values.find(region_name);
-    if (region_iter != this->phase_values.end()) {
-        max_value = 0;
-        for (const auto& rPair : region_iter->second) {
-            const auto& region_map = rPair.second;
-            max_value = std::max(*max_value, region_max(region_map));
-        }
-    }
-
-    if (!static_cast<bool>(max_value))
+    const auto* block = this->find_block(region_name);
+    if (block == nullptr)
         throw std::logic_error(fmt::format("No such region: {}", region_name));
 
-    return max_value.value();
+    return block->max_region;
 }
 
 // This should probably die - temporarily added for porting of ecloutputblackoilmodule
 std::vector<double> Inplace::get_vector(const std::string& region, Phase phase) const {
     std::vector<double> v(this->max_region(region), 0);
-    const auto& region_map = this->phase_values.at(region).at(phase);
-    for (const auto& rPair : region_map) {
-        const auto& region_id = rPair.first;
-        const auto& value = rPair.second;
-        v[region_id - 1] = value;
+
+    const auto& block = *this->find_block(region);
+    if (!this->has_phase(block, phase))
+        throw std::out_of_range(fmt::format("No such phase: {}:{}", region, static_cast<int>(phase)));
+
+    for (std::size_t region_id = 1; region_id <= v.size(); ++region_id) {
+        const auto idx = this->index(block, phase, region_id);
+        if (this->present[idx])
+            v[region_id - 1] = this->values[idx];
     }
 
     return v;
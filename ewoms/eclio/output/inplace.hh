@@ -19,9 +19,8 @@
 #ifndef ORIGINAL_OIP
 #define ORIGINAL_OIP
 
+#include <cstddef>
 #include <string>
-#include <unordered_map>
-#include <map>
 #include <vector>
 
 namespace Ewoms {
@@ -54,11 +53,24 @@ public:
       to fit in with the current implementation in the simulator. The functions
       which don't accept region_name & region_number arguments should be called
       for totals, i.e. field properties.
+
+      The values are stored in one array, with a block per region name
+      holding one row of regions per phase.
     */
 
     void add(const std::string& region, Phase phase, std::size_t region_number, double value);
     void add(Phase phase, double value);
 
+    /*
+      Store the sum of cell_values over the cells of each region given by
+      cell_regions, e.g. the FIPNUM array, for all region numbers 1 ...
+      max(cell_regions). Cells with region number below one are not
+      counted. Large arrays are summed in fixed size chunks in parallel; the
+      chunk sums are added in order, so the result does not depend on the
+      number of threads.
+    */
+    void add(const std::string& region, Phase phase, const std::vector<int>& cell_regions, const std::vector<double>& cell_values);
+
     double get(const std::string& region, Phase phase, std::size_t region_number) const;
     double get(Phase phase) const;
 
@@ -78,7 +90,23 @@ public:
 
     static const std::vector<Phase>& phases();
 private:
-    std::unordered_map<std::string, std::map<Phase, std::unordered_map<std::size_t, double>>> phase_values;
+    static constexpr std::size_t num_phases = static_cast<std::size_t>(Phase::PressureHydroCarbonPV) + 1;
+
+    struct RegionBlock {
+        std::string name;
+        std::size_t offset = 0;
+        std::size_t num_regions = 0;    // region numbers 0 ... num_regions - 1
+        std::size_t max_region = 0;     // largest region number added
+    };
+
+    std::vector<RegionBlock> blocks;
+    std::vector<double> values;
+    std::vector<char> present;
+
+    const RegionBlock* find_block(const std::string& region) const;
+    RegionBlock& block(const std::string& region, std::size_t num_regions);
+    std::size_t index(const RegionBlock& block, Phase phase, std::size_t region_number) const;
+    bool has_phase(const RegionBlock& block, Phase phase) const;
 };
 
 }
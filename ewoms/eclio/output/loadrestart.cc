@@ -49,6 +49,8 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/well.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/udq/udqenums.hh>
 
+#include <ewoms/eclio/utility/taskgraph.hh>
+
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
@@ -144,6 +146,22 @@ public:
         return this->rst_file_->getRestartData<ElmType>(vector, this->report_step_, 0);
     }
 
+    template <typename ElmType>
+    std::size_t keywordSize(const std::string& vector) const
+    {
+        return this->vectors_.at(ArrayType<ElmType>::T).at(vector);
+    }
+
+    /// REAL or DOUB vector as scale*x + offset in double precision,
+    /// decoded straight from the file.  Safe to call concurrently.
+    std::vector<double>
+    readAsDouble(const std::string& vector,
+                 const double       scale,
+                 const double       offset) const
+    {
+        return this->rst_file_->readRestartDataAsDouble(vector, this->report_step_, scale, offset);
+    }
+
     const std::vector<int>& intehead()
     {
         const auto& ihkw = std::string { "INTEHEAD" };
@@ -160,7 +178,7 @@ public:
 private:
     using RstFile = std::unique_ptr<Ewoms::EclIO::ERst>;
 
-    using VectorColl = std::unordered_set<std::string>;
+    using VectorColl = std::unordered_map<std::string, std::size_t>;
     using TypedColl  = std::unordered_map<
         Ewoms::EclIO::eclArrType, VectorColl, std::hash<int>
         >;
@@ -180,7 +198,7 @@ private:
 
 RestartFileView::RestartFileView(const std::string& filename,
                                  const int          report_step)
-    : rst_file_   { new Ewoms::EclIO::ERst{filename} }
+    : rst_file_   { new Ewoms::EclIO::ERst{filename, std::vector<int>{ report_step }} }
     , report_step_(report_step)
     , sim_step_   (std::max(report_step - 1, 0))
 {
@@ -189,8 +207,8 @@ RestartFileView::RestartFileView(const std::string& filename,
         return;
     }
 
-    this->rst_file_->loadReportStepNumber(this->report_step_);
-
+    // Vectors are loaded on first access, and the solution vectors are
+    // read directly into their destination, see restoreSOLUTION().
     for (const auto& vector : this->rst_file_->listOfRstArrays(this->report_step_)) {
         const auto& type = std::get<1>(vector);
 
@@ -201,7 +219,7 @@ RestartFileView::RestartFileView(const std::string& filename,
             continue;
 
         default:
-            this->vectors_[type].emplace(std::get<0>(vector));
+            this->vectors_[type].emplace(std::get<0>(vector), std::get<2>(vector));
             break;
         }
     }
@@ -667,100 +685,121 @@ namespace {
         return {};
     }
 
-    void insertSolutionVector(const std::vector<double>&           vector,
-                              const Ewoms::RestartKey&               value,
-                              const std::vector<double>::size_type numcells,
-                              Ewoms::data::Solution&                 sol)
+    bool hasDoubleVector(const std::string& key, const RestartFileView& rst_view)
     {
-        if (vector.size() != numcells) {
-            throw std::runtime_error {
-                "Restart file: Could not restore '"
-                + value.key
-                + "', mismatched number of cells"
-            };
-        }
-
-        sol.insert(value.key, value.dim, vector,
-                   Ewoms::data::TargetType::RESTART_SOLUTION);
+        // Empty vectors are treated as unavailable.
+        return (rst_view.hasKeyword<double>(key) && (rst_view.keywordSize<double>(key) > 0))
+            || (rst_view.hasKeyword<float>(key) && (rst_view.keywordSize<float>(key) > 0));
     }
 
-    void loadIfAvailable(const Ewoms::RestartKey&               value,
-                         const std::vector<double>::size_type numcells,
-                         RestartFileView&                     rst_view,
-                         Ewoms::data::Solution&                 sol)
+    std::size_t doubleVectorSize(const std::string& key, const RestartFileView& rst_view)
     {
-        const auto& kwdata = double_vector(value.key, rst_view);
+        return rst_view.hasKeyword<double>(key)
+            ? rst_view.keywordSize<double>(key)
+            : rst_view.keywordSize<float>(key);
+    }
 
-        if (kwdata.empty()) {
-            throwIfMissingRequired(value);
+    // ECLIPSE-compatible restart vector from which EFlow's hysteresis
+    // parameter 'vector' is derived, or empty if there is none.
+    std::string hysteresisSource(const std::string& vector)
+    {
+        if ((vector == "KRNSW_OW") || (vector == "PCSWM_OW")) {
+            return "SOMAX";
+        }
 
-            // If we get here, the requested value was not available in the
-            // result set.  However, the client does not actually require
-            // the value for restart purposes so we can safely skip this.
-            return;
+        if ((vector == "KRNSW_GO") || (vector == "PCSWM_GO")) {
+            return "SGMAX";
         }
 
-        insertSolutionVector(kwdata, value, numcells, sol);
+        return "";
     }
 
-    void loadHysteresisIfAvailable(const std::string&                   primary,
-                                   const Ewoms::RestartKey&               fallback_key,
-                                   const std::vector<double>::size_type numcells,
-                                   RestartFileView&                     rst_view,
-                                   Ewoms::data::Solution&                 sol)
+    struct SolutionSource
     {
-        auto kwdata = double_vector(primary, rst_view);
+        const Ewoms::RestartKey* key;
 
-        if (kwdata.empty()) {
-            // Primary key does not exist in rst_view.  Attempt to load
-            // fallback keys directly.
+        /// Restart vector holding the values of \c key.
+        std::string vector;
 
-            loadIfAvailable(fallback_key, numcells, rst_view, sol);
-        }
-        else {
-            // Primary exists in rst_view.  Translate to EFlow's hysteresis
-            // parameter.
-            auto smax = std::move(kwdata);
+        /// Whether values are stored as 1 - value (SOMAX and SGMAX).
+        bool complement;
+    };
 
-            std::transform(std::begin(smax), std::end(smax), std::begin(smax),
-                           [](const double s) { return 1.0 - s; });
+    /// Restart vectors from which to load the solution keys.
+    ///
+    /// Missing and mismatched vectors are reported here, in the order
+    /// of the keys, before any vector data is read.
+    std::vector<SolutionSource>
+    solutionSources(const std::vector<Ewoms::RestartKey>& solution_keys,
+                    const std::size_t                   numcells,
+                    const RestartFileView&              rst_view)
+    {
+        auto sources = std::vector<SolutionSource>{};
+        sources.reserve(solution_keys.size());
 
-            insertSolutionVector(smax, fallback_key, numcells, sol);
-        }
-    }
+        for (const auto& value : solution_keys) {
+            // Hysteresis data possibly needs translation from the
+            // ECLIPSE-compatible set to EFlow's known set of hysteresis
+            // vectors.  Fall back to value.key if unavailable--typically
+            // in OPM Extended restart file.
+            auto source = SolutionSource { &value, hysteresisSource(value.key), true };
+
+            if (source.vector.empty() || ! hasDoubleVector(source.vector, rst_view)) {
+                source.vector = value.key;
+                source.complement = false;
+            }
 
-    bool isHysteresis(const std::string& vector)
-    {
-        for (const auto* flow_hyst_key : { "KRNSW_OW", "PCSWM_OW",
-                                           "KRNSW_GO", "PCSWM_GO", })
-        {
-            if (vector == flow_hyst_key) { return true; }
+            if (! hasDoubleVector(source.vector, rst_view)) {
+                throwIfMissingRequired(value);
+
+                // If we get here, the requested value was not available in
+                // the result set.  However, the client does not actually
+                // require the value for restart purposes so we can safely
+                // skip this.
+                continue;
+            }
+
+            if (doubleVectorSize(source.vector, rst_view) != numcells) {
+                throw std::runtime_error {
+                    "Restart file: Could not restore '"
+                    + value.key
+                    + "', mismatched number of cells"
+                };
+            }
+
+            sources.push_back(std::move(source));
         }
 
-        return false;
+        return sources;
     }
 
-    void restoreHysteresisVector(const Ewoms::RestartKey& value,
-                                 const int              numcells,
-                                 RestartFileView&       rst_view,
-                                 Ewoms::data::Solution&   sol)
+    /// Solution vector in SI units.  Byte swap, widening to double and
+    /// unit conversion are done in a single pass over the file data.
+    std::vector<double>
+    readSolutionVector(const SolutionSource&  source,
+                       const Ewoms::UnitSystem& usys,
+                       const RestartFileView& rst_view)
     {
-        const auto& key = value.key;
+        using M = Ewoms::UnitSystem::measure;
 
-        if ((key == "KRNSW_OW") || (key == "PCSWM_OW"))
-        {
-            // Attempt to load from SOMAX, fall back to value.key if
-            // unavailable--typically in OPM Extended restart file.
-            loadHysteresisIfAvailable("SOMAX", value, numcells,
-                                      rst_view, sol);
+        const auto dim = source.key->dim;
+
+        if (source.complement) {
+            auto data = rst_view.readAsDouble(source.vector, -1.0, 1.0);
+
+            if (dim != M::identity) {
+                usys.to_si(dim, data);
+            }
+
+            return data;
         }
-        else if ((key == "KRNSW_GO") || (key == "PCSWM_GO"))
-        {
-            // Attempt to load from SGMAX, fall back to value.key if
-            // unavailable--typically in OPM Extended restart file.
-            loadHysteresisIfAvailable("SGMAX", value, numcells,
-                                      rst_view, sol);
+
+        if (dim == M::identity) {
+            return rst_view.readAsDouble(source.vector, 1.0, 0.0);
         }
+
+        const auto si = usys.getDimension(dim);
+        return rst_view.readAsDouble(source.vector, si.getSIScaling(), si.getSIOffset());
     }
 
     std::vector<double>
@@ -784,21 +823,32 @@ namespace {
     Ewoms::data::Solution
     restoreSOLUTION(const std::vector<Ewoms::RestartKey>& solution_keys,
                     const int                           numcells,
+                    const Ewoms::UnitSystem&              usys,
                     RestartFileView&                    rst_view)
     {
-        Ewoms::data::Solution sol(/* init_si = */ false);
+        const auto sources = solutionSources(solution_keys, numcells, rst_view);
 
-        for (const auto& value : solution_keys) {
-            if (isHysteresis(value.key)) {
-                // Special case handling of hysteresis data.  Possibly needs
-                // translation from ECLIPSE-compatible set to EFlow's known
-                // set of hysteresis vectors.
-                restoreHysteresisVector(value, numcells, rst_view, sol);
-                continue;
+        // Only the requested vectors are read, one task per vector.
+        auto data = std::vector<std::vector<double>>(sources.size());
+        {
+            Ewoms::TaskGraph tasks;
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                tasks.addTask([&sources, &data, &usys, &rst_view, i]()
+                {
+                    data[i] = readSolutionVector(sources[i], usys, rst_view);
+                });
             }
 
-            // Load regular (non-hysteresis) vector if available.
-            loadIfAvailable(value, numcells, rst_view, sol);
+            tasks.run(std::min(sources.size(), Ewoms::TaskGraph::hardwareThreads()));
+        }
+
+        Ewoms::data::Solution sol(/* init_si = */ true);
+
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            const auto& key = *sources[i].key;
+
+            sol.insert(key.key, key.dim, std::move(data[i]),
+                       Ewoms::data::TargetType::RESTART_SOLUTION);
         }
 
         return sol;
@@ -1546,10 +1596,8 @@ namespace Ewoms { namespace RestartIO  {
         auto rst_view =
             std::make_shared<RestartFileView>(filename, report_step);
 
-        auto xr = restoreSOLUTION(solution_keys,
-                                  grid.getNumActive(), *rst_view);
-
-        xr.convertToSI(es.getUnits());
+        auto xr = restoreSOLUTION(solution_keys, grid.getNumActive(),
+                                  es.getUnits(), *rst_view);
 
         auto xw = rst_view->hasKeyword<double>("OPM_XWEL")
             ? restore_wells_ewoms(es, grid, schedule, *rst_view)
@@ -18,8 +18,14 @@
 */
 #include "config.h"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
 #include <ewoms/eclio/parser/eclipsestate/eclipsestate.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/fieldpropsmanager.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/events.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/connection.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wellconnections.hh>
@@ -27,55 +33,254 @@
 
 #include <ewoms/eclio/output/regioncache.hh>
 
+namespace {
+
+    constexpr auto noRegion = std::numeric_limits<std::size_t>::max();
+
+    // Events after which the connections of a well must be looked up again.
+    constexpr uint64_t connectionEvents = Ewoms::ScheduleEvents::NEW_WELL
+        | Ewoms::ScheduleEvents::WELL_WELSPECS_UPDATE
+        | Ewoms::ScheduleEvents::COMPLETION_CHANGE;
+
+    template <typename HasEvent>
+    bool eventBetween(std::size_t first_step, std::size_t last_step, HasEvent&& hasEvent)
+    {
+        for (auto step = first_step; step <= last_step; ++step) {
+            if (hasEvent(step))
+                return true;
+        }
+
+        return false;
+    }
+
+}
+
 namespace Ewoms {
 namespace out {
 
-RegionCache::RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp, const EclipseGrid& grid, const Schedule& schedule) {
+RegionCache::RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp) {
     for (const auto& fip_name : fip_regions) {
-        const auto& fip_region = fp.get_int(fip_name);
+        RegionSet region_set;
+        region_set.name = fip_name;
+        region_set.regions = fp.get_int(fip_name);
 
-        const auto& wells = schedule.getWellsatEnd();
-        for (const auto& well : wells) {
-            const auto& connections = well.getConnections( );
-            if (connections.empty())
-                continue;
+        this->region_sets.push_back(std::move(region_set));
+    }
+}
 
-            for (const auto& c : connections) {
-                if (grid.cellActive(c.getI(), c.getJ(), c.getK())) {
-                    size_t active_index = grid.activeIndex(c.getI(), c.getJ(), c.getK());
-                    int region_id = fip_region[active_index];
-                    auto key = std::make_pair(fip_name, region_id);
-                    auto& well_index_list = this->connection_map[ key ];
-                    well_index_list.push_back( { well.name() , active_index } );
-                }
-            }
+RegionCache::RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp, const EclipseGrid& grid, const Schedule& schedule)
+    : RegionCache(fip_regions, fp)
+{
+    this->loadWells(grid, schedule, schedule.size() - 1);
+}
+
+RegionCache::RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp, const EclipseGrid& grid, const Schedule& schedule, std::size_t report_step)
+    : RegionCache(fip_regions, fp)
+{
+    this->loadWells(grid, schedule, report_step);
+    this->at_report_step = true;
+    this->report_step = report_step;
+}
+
+bool RegionCache::update(const EclipseGrid& grid, const Schedule& schedule, std::size_t report_step) {
+    if (!this->at_report_step || (report_step < this->report_step)) {
+        this->loadWells(grid, schedule, report_step);
+        this->at_report_step = true;
+        this->report_step = report_step;
+        return true;
+    }
+
+    const auto first_step = this->report_step + 1;
+    this->report_step = report_step;
 
-            const auto& conn0 = connections[0];
-            auto region_id = fip_region[grid.activeIndex(conn0.global_index())];
-            auto key = std::make_pair(fip_name, region_id);
-            this->well_map[ key ].push_back(well.name());
+    const auto& events = schedule.getEvents();
+    if (!eventBetween(first_step, report_step, [&events](std::size_t step)
+                      { return events.hasEvent(connectionEvents, step); }))
+        return false;
+
+    std::unordered_map<std::string, std::size_t> old_index;
+    for (std::size_t i = 0; i < this->well_entries.size(); ++i)
+        old_index.emplace(this->well_entries[i].name, i);
+
+    const auto well_names = schedule.wellNames(report_step);
+    bool changed = well_names.size() != this->well_entries.size();
+
+    std::vector<WellEntry> entries;
+    entries.reserve(well_names.size());
+    for (const auto& well : well_names) {
+        const auto old = old_index.find(well);
+        const auto reuse = (old != old_index.end())
+            && !eventBetween(first_step, report_step, [&schedule, &well](std::size_t step)
+                             { return schedule.hasWellGroupEvent(well, connectionEvents, step); });
+
+        if (reuse) {
+            changed = changed || (old->second != entries.size());
+            entries.push_back(std::move(this->well_entries[old->second]));
+        }
+        else {
+            entries.push_back(makeWellEntry(grid, schedule, well, report_step));
+            changed = true;
         }
     }
+
+    this->well_entries = std::move(entries);
+    if (changed)
+        this->buildRegions();
+
+    return changed;
+}
+
+void RegionCache::loadWells(const EclipseGrid& grid, const Schedule& schedule, std::size_t report_step) {
+    this->well_entries.clear();
+    for (const auto& well : schedule.wellNames(report_step))
+        this->well_entries.push_back(makeWellEntry(grid, schedule, well, report_step));
+
+    this->buildRegions();
 }
 
-    const std::vector<std::pair<std::string,size_t>>& RegionCache::connections( const std::string& region_name, int region_id ) const {
-        auto key = std::make_pair(region_name, region_id);
-        const auto iter = this->connection_map.find( key );
-        if (iter == this->connection_map.end())
-            return this->connections_empty;
-        else
-            return iter->second;
+RegionCache::WellEntry RegionCache::makeWellEntry(const EclipseGrid& grid, const Schedule& schedule,
+                                                  const std::string& well, std::size_t report_step) {
+    WellEntry entry;
+    entry.name = well;
+
+    const auto& connections = schedule.getWell(well, report_step).getConnections();
+    for (const auto& c : connections) {
+        if (grid.cellActive(c.getI(), c.getJ(), c.getK()))
+            entry.cells.push_back(grid.activeIndex(c.getI(), c.getJ(), c.getK()));
     }
 
-    std::vector<std::string> RegionCache::wells(const std::string& region_name, int region_id) const {
-        auto key = std::make_pair(region_name, region_id);
-        const auto iter = this->well_map.find( key );
-        if (iter == this->well_map.end())
-            return {};
-        else
-            return iter->second;
+    if (!connections.empty()) {
+        entry.hasConnections = true;
+        entry.firstCell = grid.activeIndex(connections[0].global_index());
     }
 
+    return entry;
 }
+
+/*
+  Counting sort of the connections and wells by region, one region set
+  after the other.  The sort is stable, so within a region connections and
+  wells keep the schedule's well order and the well's connection order.
+*/
+void RegionCache::buildRegions() {
+    this->connection_list.clear();
+    this->well_list.clear();
+
+    for (auto& region_set : this->region_sets) {
+        const auto& regions = region_set.regions;
+
+        auto min_region = std::numeric_limits<int>::max();
+        auto max_region = std::numeric_limits<int>::min();
+        for (const auto& well : this->well_entries) {
+            if (!well.hasConnections)
+                continue;
+
+            for (const auto cell : well.cells) {
+                min_region = std::min(min_region, regions[cell]);
+                max_region = std::max(max_region, regions[cell]);
+            }
+
+            min_region = std::min(min_region, regions[well.firstCell]);
+            max_region = std::max(max_region, regions[well.firstCell]);
+        }
+
+        const auto num_regions = (min_region <= max_region)
+            ? static_cast<std::size_t>(static_cast<long>(max_region) - min_region + 1) : std::size_t{0};
+
+        region_set.minRegion = min_region;
+        region_set.connOffset.assign(num_regions + 1, 0);
+        region_set.wellOffset.assign(num_regions + 1, 0);
+
+        for (const auto& well : this->well_entries) {
+            if (!well.hasConnections)
+                continue;
+
+            for (const auto cell : well.cells)
+                ++region_set.connOffset[regions[cell] - min_region + 1];
+
+            ++region_set.wellOffset[regions[well.firstCell] - min_region + 1];
+        }
+
+        region_set.connOffset[0] = this->connection_list.size();
+        region_set.wellOffset[0] = this->well_list.size();
+        for (std::size_t r = 0; r < num_regions; ++r) {
+            region_set.connOffset[r + 1] += region_set.connOffset[r];
+            region_set.wellOffset[r + 1] += region_set.wellOffset[r];
+        }
+
+        this->connection_list.resize(region_set.connOffset.back());
+        this->well_list.resize(region_set.wellOffset.back());
+
+        std::vector<std::size_t> conn_pos(region_set.connOffset.begin(), region_set.connOffset.end() - 1);
+        std::vector<std::size_t> well_pos(region_set.wellOffset.begin(), region_set.wellOffset.end() - 1);
+        for (const auto& well : this->well_entries) {
+            if (!well.hasConnections)
+                continue;
+
+            for (const auto cell : well.cells)
+                this->connection_list[conn_pos[regions[cell] - min_region]++] = { well.name, cell };
+
+            this->well_list[well_pos[regions[well.firstCell] - min_region]++] = well.name;
+        }
+    }
 }
 
+bool RegionCache::hasRegionSet(const std::string& region_name) const {
+    return std::any_of(this->region_sets.begin(), this->region_sets.end(),
+                       [&region_name](const RegionSet& region_set) { return region_set.name == region_name; });
+}
+
+std::size_t RegionCache::regionSetID(const std::string& region_name) const {
+    const auto pos = std::find_if(this->region_sets.begin(), this->region_sets.end(),
+                                  [&region_name](const RegionSet& region_set) { return region_set.name == region_name; });
+    if (pos == this->region_sets.end())
+        throw std::invalid_argument("No region set " + region_name + " in region cache");
+
+    return std::distance(this->region_sets.begin(), pos);
+}
+
+std::size_t RegionCache::regionIndex(const RegionSet& region_set, int region_id) const {
+    const auto num_regions = region_set.connOffset.size() - 1;
+    if ((num_regions == 0) || (region_id < region_set.minRegion))
+        return noRegion;
+
+    const auto index = static_cast<std::size_t>(static_cast<long>(region_id) - region_set.minRegion);
+    return (index < num_regions) ? index : noRegion;
+}
+
+RegionCache::ConnectionRange RegionCache::connections(std::size_t region_set, int region_id) const {
+    const auto& rset = this->region_sets.at(region_set);
+    const auto index = this->regionIndex(rset, region_id);
+    if (index == noRegion)
+        return {};
+
+    const auto* data = this->connection_list.data();
+    return { data + rset.connOffset[index], data + rset.connOffset[index + 1] };
+}
+
+RegionCache::ConnectionRange RegionCache::connections( const std::string& region_name, int region_id ) const {
+    if (!this->hasRegionSet(region_name))
+        return {};
+
+    return this->connections(this->regionSetID(region_name), region_id);
+}
+
+std::vector<std::string> RegionCache::wells(std::size_t region_set, int region_id) const {
+    const auto& rset = this->region_sets.at(region_set);
+    const auto index = this->regionIndex(rset, region_id);
+    if (index == noRegion)
+        return {};
+
+    return { this->well_list.begin() + rset.wellOffset[index],
+             this->well_list.begin() + rset.wellOffset[index + 1] };
+}
+
+std::vector<std::string> RegionCache::wells(const std::string& region_name, int region_id) const {
+    if (!this->hasRegionSet(region_name))
+        return {};
+
+    return this->wells(this->regionSetID(region_name), region_id);
+}
+
+}
+}
@@ -19,8 +19,10 @@
 #ifndef EWOMS_REGION_CACHE_H
 #define EWOMS_REGION_CACHE_H
 
-#include <map>
+#include <cstddef>
 #include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace Ewoms {
@@ -29,18 +31,100 @@ namespace Ewoms {
     class FieldPropsManager;
 
 namespace out {
+    /*
+      Well connections and wells of every region of a set of region
+      arrays, e.g. FIPNUM.  Region sets are numbered in the order of their
+      names and the connections of all regions are stored back to back,
+      region set major, with an offset table per region set.  Looking up a
+      region is therefore two array accesses once the region set ID is
+      known.
+
+      A cache built for a report step can be brought forward with update(),
+      which only revisits wells the schedule reports new or changed
+      connections for.
+    */
     class RegionCache {
     public:
+        using ConnectionEntry = std::pair<std::string, std::size_t>;
+
+        /// Connections of one region: well name and active cell index.
+        class ConnectionRange {
+        public:
+            using const_iterator = const ConnectionEntry*;
+
+            ConnectionRange() = default;
+            ConnectionRange(const_iterator first, const_iterator last)
+                : first_(first), last_(last)
+            {}
+
+            const_iterator begin() const { return this->first_; }
+            const_iterator end() const { return this->last_; }
+            std::size_t size() const { return this->last_ - this->first_; }
+            bool empty() const { return this->first_ == this->last_; }
+            const ConnectionEntry& operator[](std::size_t i) const { return this->first_[i]; }
+
+        private:
+            const_iterator first_ = nullptr;
+            const_iterator last_ = nullptr;
+        };
+
         RegionCache() = default;
+
+        /// Cache of the connections of all wells at the end of the schedule.
         RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp, const EclipseGrid& grid, const Schedule& schedule);
-        const std::vector<std::pair<std::string,size_t>>& connections( const std::string& region_name, int region_id ) const;
+
+        /// Cache of the connections at report step \p report_step.
+        RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp, const EclipseGrid& grid, const Schedule& schedule, std::size_t report_step);
+
+        /// Bring the cache to report step \p report_step.  Returns whether
+        /// the content changed.  Wells are only revisited if the schedule
+        /// has a new well or connection change event for them since the
+        /// step the cache was built for; going back in time rebuilds.
+        bool update(const EclipseGrid& grid, const Schedule& schedule, std::size_t report_step);
+
+        bool hasRegionSet(const std::string& region_name) const;
+
+        /// Throws std::invalid_argument for unknown region sets.
+        std::size_t regionSetID(const std::string& region_name) const;
+
+        ConnectionRange connections(std::size_t region_set, int region_id) const;
+        ConnectionRange connections( const std::string& region_name, int region_id ) const;
 
         // A well is assigned to the region_id where the first connection is
+        std::vector<std::string> wells(std::size_t region_set, int region_id) const;
         std::vector<std::string> wells(const std::string& region_name, int region_id) const;
+
     private:
-        std::vector<std::pair<std::string,size_t>> connections_empty;
-        std::map<std::pair<std::string, int> , std::vector<std::pair<std::string,size_t>>> connection_map;
-        std::map<std::pair<std::string, int>, std::vector<std::string>> well_map;
+        struct WellEntry {
+            std::string name;
+            std::vector<std::size_t> cells;     // active connections
+            bool hasConnections = false;
+            std::size_t firstCell = 0;          // active index of first connection
+        };
+
+        struct RegionSet {
+            std::string name;
+            std::vector<int> regions;           // region of every active cell
+            int minRegion = 0;
+            std::vector<std::size_t> connOffset;
+            std::vector<std::size_t> wellOffset;
+        };
+
+        std::vector<RegionSet> region_sets;
+        std::vector<WellEntry> well_entries;
+        std::vector<ConnectionEntry> connection_list;
+        std::vector<std::string> well_list;
+
+        bool at_report_step = false;
+        std::size_t report_step = 0;
+
+        RegionCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp);
+
+        void loadWells(const EclipseGrid& grid, const Schedule& schedule, std::size_t report_step);
+        static WellEntry makeWellEntry(const EclipseGrid& grid, const Schedule& schedule,
+                                       const std::string& well, std::size_t report_step);
+        void buildRegions();
+        std::size_t regionIndex(const RegionSet& region_set, int region_id) const;
     };
 }
 }
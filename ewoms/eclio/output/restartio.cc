@@ -26,6 +26,10 @@
 #include <ewoms/eclio/output/aggregatemswdata.hh>
 #include <ewoms/eclio/output/aggregateudqdata.hh>
 #include <ewoms/eclio/output/aggregateactionxdata.hh>
+#include <ewoms/eclio/output/aggregationindex.hh>
+
+#include <ewoms/eclio/output/data/solutionbuffer.hh>
+#include <ewoms/eclio/output/data/wellresults.hh>
 
 #include <ewoms/eclio/output/writerestarthelpers.hh>
 
@@ -92,12 +96,12 @@ namespace {
     }
 
     std::vector<int>
-    serialize_OPM_IWEL(const data::Wells&              wells,
+    serialize_OPM_IWEL(const data::WellResults&        wells,
                        const std::vector<std::string>& well_names)
     {
       const auto getctrl = [&]( const std::string& wname ) {
-            const auto itr = wells.find( wname );
-            return itr == wells.end() ? 0 : itr->second.control;
+            const auto w = wells.findWell( wname );
+            return w == data::WellResults::npos ? 0 : wells.control( w );
         };
 
         std::vector<int> iwel(well_names.size(), 0.0);
@@ -107,7 +111,7 @@ namespace {
     }
 
     std::vector<double>
-    serialize_OPM_XWEL(const data::Wells&              wells,
+    serialize_OPM_XWEL(const data::WellResults&        wells,
                        const Schedule&                 schedule,
                        const std::vector<std::string>& well_names,
                        const int                       sim_step,
@@ -124,7 +128,8 @@ namespace {
         std::vector< double > xwel;
         for (const auto& wellname : well_names) {
             const auto& sched_well = schedule.getWell(wellname, sim_step);
-            if (wells.count(wellname) == 0 ||
+            const auto  w = wells.findWell(wellname);
+            if (w == data::WellResults::npos ||
                 sched_well.getStatus() == Ewoms::Well::Status::SHUT)
             {
                 const auto elems = (sched_well.getConnections().size()
@@ -137,14 +142,12 @@ namespace {
                 continue;
             }
 
-            const auto& well = wells.at( wellname );
-
-            xwel.push_back( well.bhp );
-            xwel.push_back( well.thp );
-            xwel.push_back( well.temperature );
+            xwel.push_back( wells.bhp(w) );
+            xwel.push_back( wells.thp(w) );
+            xwel.push_back( wells.temperature(w) );
 
             for (auto phase : phases)
-                xwel.push_back(well.rates.get(phase));
+                xwel.push_back(wells.rate(w, phase));
 
             for (const auto& sc : sched_well.getConnections()) {
                 const auto i = sc.getI(), j = sc.getJ(), k = sc.getK();
@@ -157,47 +160,54 @@ namespace {
 
                 const auto global_index = grid.getGlobalIndex(i, j, k);
 
-                const auto& connection =
-                    std::find_if(well.connections.begin(),
-                                 well.connections.end(),
-                        [global_index](const data::Connection& c)
-                    {
-                        return c.index == global_index;
-                    });
+                const auto c = wells.findConnection(w, global_index);
 
-                if (connection == well.connections.end()) {
+                if (c == data::WellResults::npos) {
                     xwel.insert( xwel.end(), rs_size, 0.0 );
                     continue;
                 }
 
-                xwel.push_back(connection->pressure);
-                xwel.push_back(connection->reservoir_rate);
-                xwel.push_back(connection->cell_pressure);
-                xwel.push_back(connection->cell_saturation_water);
-                xwel.push_back(connection->cell_saturation_gas);
-                xwel.push_back(connection->effective_Kh);
+                xwel.push_back(wells.connectionPressure(w, c));
+                xwel.push_back(wells.connectionReservoirRate(w, c));
+                xwel.push_back(wells.connectionCellPressure(w, c));
+                xwel.push_back(wells.connectionCellSaturationWater(w, c));
+                xwel.push_back(wells.connectionCellSaturationGas(w, c));
+                xwel.push_back(wells.connectionEffectiveKh(w, c));
 
                 for (auto phase : phases)
-                    xwel.push_back(connection->rates.get(phase));
+                    xwel.push_back(wells.connectionRate(w, c, phase));
             }
         }
 
         return xwel;
     }
 
+    void checkSolutionSize(const std::string& name,
+                           const std::size_t  size,
+                           const EclipseGrid& grid)
+    {
+        if (size != grid.getNumActive()) {
+            const auto msg = fmt::format("Incorrectly sized solution vector {}.  "
+                                         "Expected {} elements, but got {}.", name,
+                                         grid.getNumActive(), size);
+            throw std::runtime_error(msg);
+        }
+    }
+
+    void checkSolutionBuffer(const data::SolutionBuffer& solution,
+                             const EclipseGrid&          grid)
+    {
+        for (auto slot = std::size_t{0}; slot < solution.numFields(); ++slot) {
+            checkSolutionSize(solution.name(slot), solution.numCells(), grid);
+        }
+    }
+
     void checkSaveArguments(const EclipseState& es,
                             const RestartValue& restart_value,
                             const EclipseGrid&  grid)
     {
         for (const auto& rvPair : restart_value.solution) {
-            const auto& name = rvPair.first;
-            const auto& vector = rvPair.second;
-            if (vector.data.size() != grid.getNumActive()) {
-                const auto msg = fmt::format("Incorrectly sized solution vector {}.  "
-                                             "Expected {} elements, but got {}.", name,
-                                             grid.getNumActive(), vector.data.size());
-                throw std::runtime_error(msg);
-            }
+            checkSolutionSize(rvPair.first, rvPair.second.data.size(), grid);
         }
 
         if (es.getSimulationConfig().getThresholdPressure().size() > 0) {
@@ -247,7 +257,7 @@ namespace {
         return ih;
     }
 
-    void writeGroup(int                           sim_step,
+    void writeGroup(const Helpers::AggregationIndex& index,
                     const UnitSystem&             units,
                     const Schedule&               schedule,
                     const Ewoms::SummaryState&      sumState,
@@ -255,11 +265,9 @@ namespace {
                     EclIO::OutputStream::Restart& rstFile)
     {
         // write IGRP to restart file
-        const size_t simStep = static_cast<size_t> (sim_step);
-
         auto  groupData = Helpers::AggregateGroupData(ih);
 
-        groupData.captureDeclaredGroupData(schedule, units, simStep, sumState, ih);
+        groupData.captureDeclaredGroupData(index, schedule, units, sumState, ih);
 
         rstFile.write("IGRP", groupData.getIGroup());
         rstFile.write("SGRP", groupData.getSGroup());
@@ -272,7 +280,7 @@ namespace {
                       const Schedule&               schedule,
                       const EclipseGrid&            grid,
                       const Ewoms::SummaryState&      sumState,
-                      const Ewoms::data::Wells&       wells,
+                      const data::WellResults&      wells,
                       const std::vector<int>&       ih,
                       EclIO::OutputStream::Restart& rstFile)
     {
@@ -352,23 +360,23 @@ namespace {
         }
     }
 
-    void writeWell(int                             sim_step,
+    void writeWell(const Helpers::AggregationIndex&  index,
                    const bool                      ecl_compatible_rst,
                    const Phases&                   phases,
                    const UnitSystem&               units,
                    const EclipseGrid&              grid,
                    const Schedule&                 schedule,
                    const std::vector<std::string>& well_names,
-                   const data::Wells&              wells,
+                   const data::WellResults&        wells,
                    const Ewoms::Action::State&       action_state,
                    const Ewoms::SummaryState&        sumState,
                    const std::vector<int>&         ih,
                    EclIO::OutputStream::Restart&   rstFile)
     {
+        const auto sim_step = index.simStep();
+
         auto wellData = Helpers::AggregateWellData(ih);
-        wellData.captureDeclaredWellData(schedule, units, sim_step, action_state, sumState, ih);
-        wellData.captureDynamicWellData(schedule, sim_step,
-                                        wells, sumState);
+        wellData.captureWellData(index, schedule, units, action_state, sumState, ih);
 
         rstFile.write("IWEL", wellData.getIWell());
         rstFile.write("SWEL", wellData.getSWell());
@@ -389,8 +397,7 @@ namespace {
         }
 
         auto connectionData = Helpers::AggregateConnectionData(ih);
-        connectionData.captureDeclaredConnData(schedule, grid, units,
-                                               wells, sim_step);
+        connectionData.captureDeclaredConnData(index, grid, units);
 
         rstFile.write("ICON", connectionData.getIConn());
         rstFile.write("SCON", connectionData.getSConn());
@@ -403,13 +410,16 @@ namespace {
                           const UnitSystem&             units,
                           const EclipseGrid&            grid,
                           const Schedule&               schedule,
-                          const data::WellRates&        wellSol,
+                          const data::WellResults&      wellSol,
                           const Ewoms::Action::State&     action_state,
                           const Ewoms::SummaryState&      sumState,
                           const std::vector<int>&       inteHD,
                           EclIO::OutputStream::Restart& rstFile)
     {
-        writeGroup(sim_step, units, schedule, sumState, inteHD, rstFile);
+        // Wells and groups of this report step, shared by all aggregators.
+        const auto index = Helpers::AggregationIndex(schedule, sim_step, wellSol);
+
+        writeGroup(index, units, schedule, sumState, inteHD, rstFile);
 
         // Write well and MSW data only when applicable (i.e., when present)
         const auto& wells = schedule.wellNames(sim_step);
@@ -427,55 +437,65 @@ namespace {
                              wellSol, inteHD, rstFile);
             }
 
-            writeWell(sim_step, ecl_compatible_rst,
+            writeWell(index, ecl_compatible_rst,
                       phases, units, grid, schedule, wells,
                       wellSol, action_state, sumState, inteHD, rstFile);
         }
     }
 
-    bool haveHysteresis(const RestartValue& value)
+    /*
+      Solution vectors in output units.  They come either from a
+      data::Solution already converted by RestartValue::convertFromSI(), or
+      from a SolutionBuffer in SI units, which is converted vector by vector
+      as it is written.
+    */
+    struct BufferedSolution {
+        const data::SolutionBuffer& buffer;
+        const UnitSystem&           units;
+    };
+
+    bool hasVector(const data::Solution& solution, const std::string& name)
     {
-        for (const auto* key : { "KRNSW_OW", "PCSWM_OW",
-                                 "KRNSW_GO", "PCSWM_GO", })
-        {
-            if (value.solution.has(key)) { return true; }
-        }
+        return solution.has(name);
+    }
 
-        return false;
+    bool hasVector(const BufferedSolution& solution, const std::string& name)
+    {
+        return solution.buffer.has(name);
     }
 
-    std::vector<double>
-    convertedHysteresisSat(const RestartValue& value,
-                           const std::string&  primary,
-                           const std::string&  fallback)
+    const std::vector<double>&
+    vectorData(const data::Solution& solution, const std::string& name)
     {
-        auto smax = std::vector<double>{};
+        return solution.data(name);
+    }
 
-        if (value.solution.has(primary)) {
-            smax = value.solution.data(primary);
-        }
-        else if (value.solution.has(fallback)) {
-            smax = value.solution.data(fallback);
-        }
+    std::vector<double>
+    vectorData(const BufferedSolution& solution, const std::string& name)
+    {
+        const auto& buffer = solution.buffer;
+        const auto  slot   = buffer.slot(name);
+        const auto* begin  = buffer.data(slot);
 
-        if (! smax.empty()) {
-            std::transform(std::begin(smax), std::end(smax), std::begin(smax),
-                           [](const double s) { return 1.0 - s; });
-        }
+        auto data = std::vector<double>(begin, begin + buffer.numCells());
+        solution.units.from_si(buffer.dim(slot), data);
 
-        return smax;
+        return data;
     }
 
+    /// Names of the vectors with a target for which \p select is true, in
+    /// alphabetical order.
+    template <class Select>
     std::vector<std::string>
-    solutionVectorNames(const RestartValue& value)
+    vectorNames(const data::Solution& solution, Select&& select)
     {
         auto vectors = std::vector<std::string>{};
-        vectors.reserve(value.solution.size());
+        vectors.reserve(solution.size());
 
-        for (const auto& vs : value.solution) {
+        for (const auto& vs : solution) {
             const auto& name = vs.first;
             const auto& vector = vs.second;
-            if (vector.target == data::TargetType::RESTART_SOLUTION) {
+            if (select(vector.target)) {
                 vectors.push_back(name);
             }
         }
@@ -483,51 +503,109 @@ namespace {
         return vectors;
     }
 
+    template <class Select>
     std::vector<std::string>
-    extendedSolutionVectorNames(const RestartValue& value)
+    vectorNames(const BufferedSolution& solution, Select&& select)
     {
+        const auto& buffer = solution.buffer;
+
         auto vectors = std::vector<std::string>{};
-        vectors.reserve(value.solution.size());
+        vectors.reserve(buffer.numFields());
 
-        for (const auto& vs : value.solution) {
-            const auto& name = vs.first;
-            const auto& vector = vs.second;
-            if ((vector.target == data::TargetType::RESTART_AUXILIARY) ||
-                (vector.target == data::TargetType::RESTART_EWOMS_EXTENDED))
-            {
-                vectors.push_back(name);
+        for (auto slot = std::size_t{0}; slot < buffer.numFields(); ++slot) {
+            if (select(buffer.target(slot))) {
+                vectors.push_back(buffer.name(slot));
             }
         }
 
+        // Same order as the map of data::Solution.
+        std::sort(vectors.begin(), vectors.end());
+
         return vectors;
     }
 
-    template <class OutputVector>
-    void writeSolutionVectors(const RestartValue&             value,
+    template <class Solution>
+    bool haveHysteresis(const Solution& solution)
+    {
+        for (const auto* key : { "KRNSW_OW", "PCSWM_OW",
+                                 "KRNSW_GO", "PCSWM_GO", })
+        {
+            if (hasVector(solution, key)) { return true; }
+        }
+
+        return false;
+    }
+
+    template <class Solution>
+    std::vector<double>
+    convertedHysteresisSat(const Solution&    solution,
+                           const std::string& primary,
+                           const std::string& fallback)
+    {
+        auto smax = std::vector<double>{};
+
+        if (hasVector(solution, primary)) {
+            smax = vectorData(solution, primary);
+        }
+        else if (hasVector(solution, fallback)) {
+            smax = vectorData(solution, fallback);
+        }
+
+        if (! smax.empty()) {
+            std::transform(std::begin(smax), std::end(smax), std::begin(smax),
+                           [](const double s) { return 1.0 - s; });
+        }
+
+        return smax;
+    }
+
+    template <class Solution>
+    std::vector<std::string>
+    solutionVectorNames(const Solution& solution)
+    {
+        return vectorNames(solution, [](const data::TargetType target)
+        {
+            return target == data::TargetType::RESTART_SOLUTION;
+        });
+    }
+
+    template <class Solution>
+    std::vector<std::string>
+    extendedSolutionVectorNames(const Solution& solution)
+    {
+        return vectorNames(solution, [](const data::TargetType target)
+        {
+            return (target == data::TargetType::RESTART_AUXILIARY)
+                || (target == data::TargetType::RESTART_EWOMS_EXTENDED);
+        });
+    }
+
+    template <class Solution, class OutputVector>
+    void writeSolutionVectors(const Solution&                 solution,
                               const std::vector<std::string>& vectors,
                               const bool                      write_double,
                               OutputVector&&                  writeVector)
     {
         for (const auto& vector : vectors) {
-            writeVector(vector, value.solution.data(vector), write_double);
+            writeVector(vector, vectorData(solution, vector), write_double);
         }
     }
 
-    template <class OutputVector>
-    void writeRegularSolutionVectors(const RestartValue& value,
-                                     const bool          write_double,
-                                     OutputVector&&      writeVector)
+    template <class Solution, class OutputVector>
+    void writeRegularSolutionVectors(const Solution& solution,
+                                     const bool      write_double,
+                                     OutputVector&&  writeVector)
     {
-        writeSolutionVectors(value, solutionVectorNames(value), write_double,
+        writeSolutionVectors(solution, solutionVectorNames(solution), write_double,
                              std::forward<OutputVector>(writeVector));
     }
 
-    template <class OutputVector>
-    void writeExtendedSolutionVectors(const RestartValue& value,
-                                      const bool          write_double,
-                                      OutputVector&&      writeVector)
+    template <class Solution, class OutputVector>
+    void writeExtendedSolutionVectors(const Solution& solution,
+                                      const bool      write_double,
+                                      OutputVector&&  writeVector)
     {
-        writeSolutionVectors(value, extendedSolutionVectorNames(value), write_double,
+        writeSolutionVectors(solution, extendedSolutionVectorNames(solution), write_double,
                              std::forward<OutputVector>(writeVector));
     }
 
@@ -545,17 +623,17 @@ namespace {
         }
     }
 
-    template <class OutputVector>
-    void writeEclipseCompatHysteresis(const RestartValue& value,
-                                      const bool          write_double,
-                                      OutputVector&&      writeVector)
+    template <class Solution, class OutputVector>
+    void writeEclipseCompatHysteresis(const Solution& solution,
+                                      const bool      write_double,
+                                      OutputVector&&  writeVector)
     {
         // Convert EFlow-specific vectors {KRNSW,PCSWM}_OW to ECLIPSE's
         // requisite SOMAX vector.  Only partially characterised.
         // Sufficient for Norne.
         {
             const auto somax =
-                convertedHysteresisSat(value, "KRNSW_OW", "PCSWM_OW");
+                convertedHysteresisSat(solution, "KRNSW_OW", "PCSWM_OW");
 
             if (! somax.empty()) {
                 writeVector("SOMAX", somax, write_double);
@@ -567,7 +645,7 @@ namespace {
         // Sufficient for Norne.
         {
             const auto sgmax =
-                convertedHysteresisSat(value, "KRNSW_GO", "PCSWM_GO");
+                convertedHysteresisSat(solution, "KRNSW_GO", "PCSWM_GO");
 
             if (! sgmax.empty()) {
                 writeVector("SGMAX", sgmax, write_double);
@@ -575,7 +653,9 @@ namespace {
         }
     }
 
-    void writeSolution(const RestartValue&           value,
+    template <class Solution>
+    void writeSolution(const Solution&               solution,
+                       const RestartValue&           value,
                        const Schedule&               schedule,
                        const UDQState&               udq_state,
                        int                           report_step,
@@ -602,18 +682,18 @@ namespace {
 
         rstFile.message("STARTSOL");
 
-        writeRegularSolutionVectors(value, write_double_arg, write);
+        writeRegularSolutionVectors(solution, write_double_arg, write);
 
         writeUDQ(report_step, sim_step, schedule, udq_state, inteHD, rstFile);
 
         writeExtraVectors(value, write);
 
-        if (ecl_compatible_rst && haveHysteresis(value)) {
-            writeEclipseCompatHysteresis(value, write_double_arg, write);
+        if (ecl_compatible_rst && haveHysteresis(solution)) {
+            writeEclipseCompatHysteresis(solution, write_double_arg, write);
         }
 
         if (! ecl_compatible_rst) {
-            writeExtendedSolutionVectors(value, write_double_arg, write);
+            writeExtendedSolutionVectors(solution, write_double_arg, write);
         }
 
         rstFile.message("ENDSOL");
@@ -659,6 +739,56 @@ namespace {
         ::Ewoms::OpmLog::info(msg);
     }
 
+    /// Write the restart file of a report step.  The solution and the
+    /// extra values of \p value are in output units, the well results in
+    /// SI units.
+    template <class Solution>
+    void writeRestart(EclIO::OutputStream::Restart& rstFile,
+                      int                           report_step,
+                      double                        seconds_elapsed,
+                      const Solution&               solution,
+                      const data::WellResults&      wells,
+                      const RestartValue&           value,
+                      const EclipseState&           es,
+                      const EclipseGrid&            grid,
+                      const Schedule&               schedule,
+                      const Action::State&          action_state,
+                      const SummaryState&           sumState,
+                      const UDQState&               udqState,
+                      bool                          write_double)
+    {
+        const auto& ioCfg = es.getIOConfig();
+        const auto ecl_compatible_rst = ioCfg.getEclCompatibleRST();
+
+        const auto  sim_step = std::max(report_step - 1, 0);
+        const auto& units    = es.getUnits();
+
+        if (ecl_compatible_rst) {
+            write_double = false;
+        }
+
+        const auto inteHD =
+            writeHeader(report_step, sim_step, nextStepSize(value),
+                        seconds_elapsed, schedule, grid, es, rstFile);
+
+        if (report_step > 0) {
+            writeDynamicData(sim_step, ecl_compatible_rst, es.runspec().phases(),
+                             units, grid, schedule, wells, action_state, sumState,
+                             inteHD, rstFile);
+        }
+
+        writeActionx(report_step, sim_step, es, schedule, action_state, sumState, rstFile);
+
+        writeSolution(solution, value, schedule, udqState, report_step, sim_step,
+                      ecl_compatible_rst, write_double, inteHD, rstFile);
+
+        if (! ecl_compatible_rst) {
+            writeExtraData(value.extra, rstFile);
+        }
+
+        logRestartOutput(report_step, schedule.getTimeMap().numTimesteps(), inteHD);
+    }
+
 } // Anonymous namespace
 
 void save(EclIO::OutputStream::Restart& rstFile,
@@ -675,39 +805,45 @@ void save(EclIO::OutputStream::Restart& rstFile,
 {
     ::Ewoms::RestartIO::checkSaveArguments(es, value, grid);
 
-    const auto& ioCfg = es.getIOConfig();
-    const auto ecl_compatible_rst = ioCfg.getEclCompatibleRST();
-
-    const auto  sim_step = std::max(report_step - 1, 0);
-    const auto& units    = es.getUnits();
-
-    if (ecl_compatible_rst) {
-        write_double = false;
-    }
-
     // Convert solution fields and extra values from SI to user units.
-    value.convertFromSI(units);
+    value.convertFromSI(es.getUnits());
 
-    const auto inteHD =
-        writeHeader(report_step, sim_step, nextStepSize(value),
-                    seconds_elapsed, schedule, grid, es, rstFile);
+    const auto wells = data::WellResults{ value.wells };
 
-    if (report_step > 0) {
-        writeDynamicData(sim_step, ecl_compatible_rst, es.runspec().phases(),
-                         units, grid, schedule, value.wells, action_state, sumState,
-                         inteHD, rstFile);
-    }
+    writeRestart(rstFile, report_step, seconds_elapsed, value.solution, wells,
+                 value, es, grid, schedule, action_state, sumState, udqState,
+                 write_double);
+}
 
-    writeActionx(report_step, sim_step, es, schedule, action_state, sumState, rstFile);
+void save(EclIO::OutputStream::Restart& rstFile,
+          int                           report_step,
+          double                        seconds_elapsed,
+          const data::SolutionBuffer&   solution,
+          const data::WellBuffer&       wells,
+          RestartValue::ExtraVector     extra,
+          const EclipseState&           es,
+          const EclipseGrid&            grid,
+          const Schedule&               schedule,
+          const Action::State&          action_state,
+          const SummaryState&           sumState,
+          const UDQState&               udqState,
+          bool                          write_double)
+{
+    auto value = RestartValue{};
+    value.extra = std::move(extra);
 
-    writeSolution(value, schedule, udqState, report_step, sim_step,
-                  ecl_compatible_rst, write_double, inteHD, rstFile);
+    checkSolutionBuffer(solution, grid);
+    ::Ewoms::RestartIO::checkSaveArguments(es, value, grid);
 
-    if (! ecl_compatible_rst) {
-        writeExtraData(value.extra, rstFile);
-    }
+    // Convert extra values from SI to user units.  The solution is
+    // converted as it is written.
+    const auto& units = es.getUnits();
+    value.convertFromSI(units);
 
-    logRestartOutput(report_step, schedule.getTimeMap().numTimesteps(), inteHD);
+    writeRestart(rstFile, report_step, seconds_elapsed,
+                 BufferedSolution{ solution, units }, data::WellResults{ wells },
+                 value, es, grid, schedule, action_state, sumState, udqState,
+                 write_double);
 }
 
 }} // Ewoms::RestartIO
@@ -35,6 +35,13 @@ namespace Ewoms {
 
 } // namespace Ewoms
 
+namespace Ewoms { namespace data {
+
+    class SolutionBuffer;
+    class WellBuffer;
+
+}}
+
 namespace Ewoms { namespace EclIO { namespace OutputStream {
 
     class Restart;
@@ -82,6 +89,25 @@ namespace Ewoms { namespace RestartIO {
               const UDQState&               udqState,
               bool                          write_double = false);
 
+    /*
+      As above, but with the solution and the well results read directly
+      from the simulator's buffers, both in SI units.  Only the extra
+      vectors are passed in a RestartValue.
+    */
+    void save(EclIO::OutputStream::Restart& rstFile,
+              int                           report_step,
+              double                        seconds_elapsed,
+              const data::SolutionBuffer&   solution,
+              const data::WellBuffer&       wells,
+              RestartValue::ExtraVector     extra,
+              const EclipseState&           es,
+              const EclipseGrid&            grid,
+              const Schedule&               schedule,
+              const Action::State&          action_state,
+              const SummaryState&           sumState,
+              const UDQState&               udqState,
+              bool                          write_double = false);
+
     RestartValue load(const std::string&             filename,
                       int                            report_step,
                       Action::State&                 action_state,
@@ -48,6 +48,7 @@
 
 #include <ewoms/eclio/output/data/groups.hh>
 #include <ewoms/eclio/output/data/guideratevalue.hh>
+#include <ewoms/eclio/output/data/wellresults.hh>
 #include <ewoms/eclio/output/data/wells.hh>
 #include <ewoms/eclio/output/data/aquifer.hh>
 #include <ewoms/eclio/output/inplace.hh>
@@ -423,7 +424,7 @@ struct fn_args {
     int  num;
     const Ewoms::optional<Ewoms::variant<std::string, int>> extra_data;
     const Ewoms::SummaryState& st;
-    const Ewoms::data::Wells& wells;
+    const Ewoms::data::WellResults& wells;
     const Ewoms::data::GroupAndNetworkValues& grp_nwrk;
     const Ewoms::out::RegionCache& regionCache;
     const Ewoms::EclipseGrid& grid;
@@ -508,12 +509,12 @@ inline quantity glir( const fn_args& args ) {
         if (well.isInjector())
             continue;
 
-        auto xwPos = args.wells.find(well.name());
-        if (xwPos == args.wells.end())
+        const auto xw = args.wells.findWell(well.name());
+        if (xw == Ewoms::data::WellResults::npos)
             continue;
 
         double eff_fac = efac( args.eff_factors, well.name() );
-        alq_rate += eff_fac*xwPos->second.rates.get(rt::alq, well.alq_value());
+        alq_rate += eff_fac*args.wells.rate(xw, rt::alq, well.alq_value());
     }
     return { alq_rate, measure::gas_surface_rate };
 }
@@ -539,11 +540,12 @@ inline quantity rate( const fn_args& args ) {
 
     for( const auto& sched_well : args.schedule_wells ) {
         const auto& name = sched_well.name();
-        if( args.wells.count( name ) == 0 ) continue;
+        const auto xw = args.wells.findWell( name );
+        if( xw == Ewoms::data::WellResults::npos ) continue;
 
         double eff_fac = efac( args.eff_factors, name );
 
-        const auto v = args.wells.at(name).rates.get(phase, 0.0) * eff_fac;
+        const auto v = args.wells.rate(xw, phase, 0.0) * eff_fac;
 
         if( ( v > 0 ) == injection )
             sum += v;
@@ -567,24 +569,19 @@ inline quantity ratel( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well.name();
-    if( args.wells.count( name ) == 0 ) return zero;
-    const auto& well_data = args.wells.at( name );
-    if (well_data.current_control.isProducer == injection) return zero;
+    const auto xw = args.wells.findWell( name );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
+    if (args.wells.currentControl(xw).isProducer == injection) return zero;
 
     double sum = 0;
     const auto& connections = well.getConnections( args.num );
     for (const auto& conn_ptr : connections) {
         const size_t global_index = conn_ptr->global_index();
-        const auto& conn_data = std::find_if(well_data.connections.begin(),
-                                             well_data.connections.end(),
-                                             [global_index] (const Ewoms::data::Connection cdata)
-                                             {
-                                                 return cdata.index == global_index;
-                                             });
-
-        if (conn_data != well_data.connections.end()) {
+        const auto xc = args.wells.findConnection(xw, global_index);
+
+        if (xc != Ewoms::data::WellResults::npos) {
             double eff_fac = efac( args.eff_factors, name );
-            sum += conn_data->rates.get( phase, 0.0 ) * eff_fac;
+            sum += args.wells.connectionRate( xw, xc, phase, 0.0 ) * eff_fac;
         }
     }
     if( !injection ) sum *= -1;
@@ -604,9 +601,9 @@ inline quantity cratel( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well.name();
-    if( args.wells.count( name ) == 0 ) return zero;
-    const auto& well_data = args.wells.at( name );
-    if (well_data.current_control.isProducer == injection) return zero;
+    const auto xw = args.wells.findWell( name );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
+    if (args.wells.currentControl(xw).isProducer == injection) return zero;
 
     const auto complnum = getCompletionNumberFromGlobalConnectionIndex(well.getConnections(), args.num - 1);
     if (!static_cast<bool>(complnum))
@@ -617,15 +614,10 @@ inline quantity cratel( const fn_args& args ) {
     const auto& connections = well.getConnections(*complnum);
     for (const auto& conn_ptr : connections) {
         const size_t global_index = conn_ptr->global_index();
-        const auto& conn_data = std::find_if(well_data.connections.begin(),
-                                             well_data.connections.end(),
-                                             [global_index] (const Ewoms::data::Connection cdata)
-                                             {
-                                                 return cdata.index == global_index;
-                                             });
-        if (conn_data != well_data.connections.end()) {
+        const auto xc = args.wells.findConnection(xw, global_index);
+        if (xc != Ewoms::data::WellResults::npos) {
             double eff_fac = efac( args.eff_factors, name );
-            sum += conn_data->rates.get( phase, 0.0 ) * eff_fac;
+            sum += args.wells.connectionRate( xw, xc, phase, 0.0 ) * eff_fac;
         }
     }
     if( !injection ) sum *= -1;
@@ -637,10 +629,12 @@ template< bool injection >
 inline quantity flowing( const fn_args& args ) {
     const auto& wells = args.wells;
     auto pred = [&wells]( const Ewoms::Well& w ) {
-        const auto& name = w.name();
-        return w.isInjector( ) == injection
-            && wells.count( name ) > 0
-            && wells.at( name ).flowing();
+        if (w.isInjector( ) != injection)
+            return false;
+
+        const auto xw = wells.findWell( w.name() );
+        return (xw != Ewoms::data::WellResults::npos)
+            && wells.flowing( xw );
     };
 
     return { double( std::count_if( args.schedule_wells.begin(),
@@ -661,19 +655,15 @@ inline quantity crate( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well.name();
-    if( args.wells.count( name ) == 0 ) return zero;
+    const auto xw = args.wells.findWell( name );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
 
-    const auto& well_data = args.wells.at( name );
-    const auto& completion = std::find_if( well_data.connections.begin(),
-                                           well_data.connections.end(),
-                                           [=]( const Ewoms::data::Connection& c ) {
-                                                return c.index == global_index;
-                                           } );
-    if (well_data.current_control.isProducer == injection) return zero;
-    if( completion == well_data.connections.end() ) return zero;
+    const auto xc = args.wells.findConnection( xw, global_index );
+    if (args.wells.currentControl(xw).isProducer == injection) return zero;
+    if( xc == Ewoms::data::WellResults::npos ) return zero;
 
     double eff_fac = efac( args.eff_factors, name );
-    auto v = completion->rates.get( phase, 0.0 ) * eff_fac;
+    auto v = args.wells.connectionRate( xw, xc, phase, 0.0 ) * eff_fac;
     if (!injection)
         v *= -1;
 
@@ -693,16 +683,15 @@ inline quantity srate( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well.name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& well_data = args.wells.at( name );
+    const auto xw = args.wells.findWell( name );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
 
-    const auto& segment = well_data.segments.find(segNumber);
+    const auto segment = args.wells.findSegment(xw, segNumber);
 
-    if( segment == well_data.segments.end() ) return zero;
+    if( segment == Ewoms::data::WellResults::npos ) return zero;
 
     double eff_fac = efac( args.eff_factors, name );
-    auto v = segment->second.rates.get( phase, 0.0 ) * eff_fac;
+    auto v = args.wells.segmentRate( xw, segment, phase, 0.0 ) * eff_fac;
     //switch sign of rate - opposite convention in flow vs eclipse
     v *= -1;
 
@@ -717,26 +706,21 @@ inline quantity trans_factors ( const fn_args& args ) {
         // No wells.  Before simulation starts?
         return zero;
 
-    auto xwPos = args.wells.find(args.schedule_wells.front().name());
-    if (xwPos == args.wells.end())
+    const auto xw = args.wells.findWell(args.schedule_wells.front().name());
+    if (xw == Ewoms::data::WellResults::npos)
         // No dynamic results for this well.  Not open?
         return zero;
 
     // Like completion rate we need to look up a connection with offset 0.
     const size_t global_index = args.num - 1;
-    const auto& connections = xwPos->second.connections;
-    auto connPos = std::find_if(connections.begin(), connections.end(),
-        [global_index](const Ewoms::data::Connection& c)
-    {
-        return c.index == global_index;
-    });
+    const auto xc = args.wells.findConnection(xw, global_index);
 
-    if (connPos == connections.end())
+    if (xc == Ewoms::data::WellResults::npos)
         // No dynamic results for this connection.
         return zero;
 
     // Dynamic connection result's "trans_factor" includes PI-adjustment.
-    return { connPos->trans_factor, measure::transmissibility };
+    return { args.wells.connectionTransFactor(xw, xc), measure::transmissibility };
 }
 
 template <Ewoms::data::SegmentPressures::Value ix>
@@ -751,25 +735,24 @@ inline quantity segpress ( const fn_args& args ) {
 
     const auto& well = args.schedule_wells.front();
     const auto& name = well.name();
-    if( args.wells.count( name ) == 0 ) return zero;
-
-    const auto& well_data = args.wells.at( name );
+    const auto xw = args.wells.findWell( name );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
 
-    const auto& segment = well_data.segments.find(segNumber);
+    const auto segment = args.wells.findSegment(xw, segNumber);
 
-    if( segment == well_data.segments.end() ) return zero;
+    if( segment == Ewoms::data::WellResults::npos ) return zero;
 
-    return { segment->second.pressures[ix], measure::pressure };
+    return { args.wells.segmentPressures(xw, segment)[ix], measure::pressure };
 }
 
 inline quantity bhp( const fn_args& args ) {
     const quantity zero = { 0, measure::pressure };
     if( args.schedule_wells.empty() ) return zero;
 
-    const auto p = args.wells.find( args.schedule_wells.front().name() );
-    if( p == args.wells.end() ) return zero;
+    const auto xw = args.wells.findWell( args.schedule_wells.front().name() );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
 
-    return { p->second.bhp, measure::pressure };
+    return { args.wells.bhp(xw), measure::pressure };
 }
 
 /*
@@ -801,20 +784,20 @@ inline quantity temperature( const fn_args& args ) {
     const quantity zero = { 0, measure::temperature };
     if( args.schedule_wells.empty() ) return zero;
 
-    const auto p = args.wells.find( args.schedule_wells.front().name() );
-    if( p == args.wells.end() ) return zero;
+    const auto xw = args.wells.findWell( args.schedule_wells.front().name() );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
 
-    return { p->second.temperature, measure::temperature };
+    return { args.wells.temperature(xw), measure::temperature };
 }
 
 inline quantity thp( const fn_args& args ) {
     const quantity zero = { 0, measure::pressure };
     if( args.schedule_wells.empty() ) return zero;
 
-    const auto p = args.wells.find( args.schedule_wells.front().name() );
-    if( p == args.wells.end() ) return zero;
+    const auto xw = args.wells.findWell( args.schedule_wells.front().name() );
+    if( xw == Ewoms::data::WellResults::npos ) return zero;
 
-    return { p->second.thp, measure::pressure };
+    return { args.wells.thp(xw), measure::pressure };
 }
 
 inline quantity bhp_history( const fn_args& args ) {
@@ -898,13 +881,13 @@ inline quantity abondoned_well( const fn_args& args ) {
             continue;
 
         const auto& well_name = sched_well.name();
-        auto well_iter = args.wells.find( well_name );
-        if (well_iter == args.wells.end()) {
+        const auto xw = args.wells.findWell( well_name );
+        if (xw == Ewoms::data::WellResults::npos) {
             count += 1;
             continue;
         }
 
-        count += !well_iter->second.flowing();
+        count += !args.wells.flowing(xw);
     }
 
     return { 1.0 * count, measure::identity };
@@ -933,7 +916,13 @@ quantity region_rate( const fn_args& args ) {
 
         double eff_fac = efac( args.eff_factors, pair.first );
 
-        double rate = args.wells.get( pair.first , pair.second , phase ) * eff_fac;
+        double rate = 0.0;
+        const auto xw = args.wells.findWell( pair.first );
+        if (xw != Ewoms::data::WellResults::npos) {
+            const auto xc = args.wells.findConnection( xw, pair.second );
+            if (xc != Ewoms::data::WellResults::npos)
+                rate = args.wells.connectionRate( xw, xc, phase, 0.0 ) * eff_fac;
+        }
 
         // We are asking for the production rate in an injector - or
         // opposite. We just clamp to zero.
@@ -964,14 +953,15 @@ inline quantity potential_rate( const fn_args& args ) {
 
     for( const auto& sched_well : args.schedule_wells ) {
         const auto& name = sched_well.name();
-        if( args.wells.count( name ) == 0 ) continue;
+        const auto xw = args.wells.findWell( name );
+        if( xw == Ewoms::data::WellResults::npos ) continue;
 
         if (sched_well.isInjector() && outputInjector) {
-	    const auto v = args.wells.at(name).rates.get(phase, 0.0);
+	    const auto v = args.wells.rate(xw, phase, 0.0);
 	    sum += v * efac(args.eff_factors, name);
 	}
 	else if (sched_well.isProducer() && outputProducer) {
-	    const auto v = args.wells.at(name).rates.get(phase, 0.0);
+	    const auto v = args.wells.rate(xw, phase, 0.0);
 	    sum += v * efac(args.eff_factors, name);
 	}
     }
@@ -1030,8 +1020,8 @@ inline quantity connection_productivity_index(const fn_args& args) {
     if (args.schedule_wells.empty())
         return zero;
 
-    auto xwPos = args.wells.find(args.schedule_wells.front().name());
-    if (xwPos == args.wells.end())
+    const auto xw = args.wells.findWell(args.schedule_wells.front().name());
+    if (xw == Ewoms::data::WellResults::npos)
         return zero;
 
     // The args.num value is the literal value which will go to the
@@ -1040,28 +1030,22 @@ inline quantity connection_productivity_index(const fn_args& args) {
     // up a completion with offset 0.
     const auto global_index = static_cast<std::size_t>(args.num) - 1;
 
-    const auto& xcon = xwPos->second.connections;
-    const auto& completion =
-        std::find_if(xcon.begin(), xcon.end(),
-            [global_index](const Ewoms::data::Connection& c)
-        {
-            return c.index == global_index;
-        });
+    const auto xc = args.wells.findConnection(xw, global_index);
 
-    if (completion == xcon.end())
+    if (xc == Ewoms::data::WellResults::npos)
         return zero;
 
     switch (args.schedule_wells.front().getPreferredPhase()) {
     case Ewoms::Phase::OIL:
-        return { completion->rates.get(rt::productivity_index_oil, 0.0),
+        return { args.wells.connectionRate(xw, xc, rt::productivity_index_oil, 0.0),
                  rate_unit<rt::productivity_index_oil>() };
 
     case Ewoms::Phase::GAS:
-        return { completion->rates.get(rt::productivity_index_gas, 0.0),
+        return { args.wells.connectionRate(xw, xc, rt::productivity_index_gas, 0.0),
                  rate_unit<rt::productivity_index_gas>() };
 
     case Ewoms::Phase::WATER:
-        return { completion->rates.get(rt::productivity_index_water, 0.0),
+        return { args.wells.connectionRate(xw, xc, rt::productivity_index_water, 0.0),
                  rate_unit<rt::productivity_index_water>() };
 
     default:
@@ -1138,13 +1122,11 @@ inline quantity group_control( const fn_args& args ) {
 }
 
 namespace {
-    bool well_control_mode_defined(const ::Ewoms::data::Well& xw)
+    bool well_control_mode_defined(const ::Ewoms::data::CurrentControl& curr)
     {
         using PMode = ::Ewoms::Well::ProducerCMode;
         using IMode = ::Ewoms::Well::InjectorCMode;
 
-        const auto& curr = xw.current_control;
-
         return (curr.isProducer && (curr.prod != PMode::CMODE_UNDEFINED))
             || (!curr.isProducer && (curr.inj != IMode::CMODE_UNDEFINED));
     }
@@ -1160,13 +1142,14 @@ inline quantity well_control_mode( const fn_args& args ) {
     }
 
     const auto& well = args.schedule_wells.front();
-    auto xwPos = args.wells.find(well.name());
-    if (xwPos == args.wells.end()) {
+    const auto xw = args.wells.findWell(well.name());
+    if (xw == Ewoms::data::WellResults::npos) {
         // No dynamic results for 'well'.  Treat as shut/stopped.
         return { 0.0, unit };
     }
 
-    if (! well_control_mode_defined(xwPos->second)) {
+    const auto& curr = args.wells.currentControl(xw);
+    if (! well_control_mode_defined(curr)) {
         // No dynamic control mode defined.  Use input control.
         const auto wmctl = ::Ewoms::eclipseControlMode(well, args.st);
 
@@ -1175,7 +1158,6 @@ inline quantity well_control_mode( const fn_args& args ) {
 
     // Well has simulator-provided active control mode.  Pick the
     // appropriate value depending on well type (producer/injector).
-    const auto& curr = xwPos->second.current_control;
     const auto wmctl = curr.isProducer
         ? ::Ewoms::eclipseControlMode(curr.prod)
         : ::Ewoms::eclipseControlMode(curr.inj, well.injectorType());
@@ -1214,12 +1196,12 @@ quantity well_guiderate(const fn_args& args)
         return { 0.0, rate_unit<i>() };
     }
 
-    auto xwPos = args.wells.find(well.name());
-    if (xwPos == args.wells.end()) {
+    const auto xw = args.wells.findWell(well.name());
+    if (xw == Ewoms::data::WellResults::npos) {
         return { 0.0, rate_unit<i>() };
     }
 
-    return guiderate_value<i>(xwPos->second.guide_rates);
+    return guiderate_value<i>(args.wells.guideRates(xw));
 }
 
 /*
@@ -1977,7 +1959,7 @@ namespace Evaluator {
 
     struct SimulatorResults
     {
-        const Ewoms::data::WellRates& wellSol;
+        const Ewoms::data::WellResults& wellSol;
         const Ewoms::data::GroupAndNetworkValues& grpNwrkSol;
         const std::map<std::string, double>& single;
         const Ewoms::Inplace inplace;
@@ -2831,7 +2813,7 @@ public:
 
     void eval(const int                          sim_step,
               const double                       secs_elapsed,
-              const data::WellRates&             well_solution,
+              const data::WellResults&            well_solution,
               const data::GroupAndNetworkValues& grp_nwrk_solution,
               GlobalProcessParameters&           single_values,
               const Inplace&                     initial_inplace,
@@ -2866,6 +2848,7 @@ private:
     Ewoms::EclIO::OutputStream::ResultSet rset_;
     Ewoms::EclIO::OutputStream::Formatted fmt_;
     Ewoms::EclIO::OutputStream::Unified   unif_;
+    Ewoms::EclIO::OutputStream::Compressed comp_;
 
     int miniStepID_{0};
     int prevCreate_{-1};
@@ -2915,6 +2898,7 @@ SummaryImplementation(const EclipseState&  es,
     , rset_          (makeResultSet(es.cfg().io(), basename))
     , fmt_           { es.cfg().io().getFMTOUT() }
     , unif_          { es.cfg().io().getUNIFOUT() }
+    , comp_          { es.cfg().io().getCompressedOutput() }
 {
     this->configureTimeVectors(es, sumcfg);
     this->configureSummaryInput(es, sumcfg, grid, sched);
@@ -2962,7 +2946,7 @@ void
 Ewoms::out::Summary::SummaryImplementation::
 eval(const int                          sim_step,
      const double                       secs_elapsed,
-     const data::WellRates&             well_solution,
+     const data::WellResults&            well_solution,
      const data::GroupAndNetworkValues& grp_nwrk_solution,
      GlobalProcessParameters&           single_values,
      const Inplace&                     initial_inplace,
@@ -3346,7 +3330,7 @@ createSmryStreamIfNecessary(const int report_step)
     if (do_create) {
         this->stream_ = Ewoms::EclIO::OutputStream::
             createSummaryFile(this->rset_, report_step,
-                              this->fmt_, this->unif_);
+                              this->fmt_, this->unif_, this->comp_);
 
         this->prevCreate_ = report_step;
     }
@@ -3375,6 +3359,29 @@ void Summary::eval(SummaryState&                      st,
                    const BlockValues&                 block_values,
                    const Ewoms::data::Aquifers&         aquifer_values) const
 {
+    // The results are read from the map, see below for report_step and
+    // sim_step.
+    const auto sim_step = std::max( 0, report_step - 1 );
+
+    this->pImpl_->eval(sim_step, secs_elapsed,
+                       data::WellResults{ well_solution }, grp_nwrk_solution, single_values,
+                       initial_inplace, inplace,
+                       region_values, block_values, aquifer_values, st);
+}
+
+void Summary::eval(SummaryState&                      st,
+                   const int                          report_step,
+                   const double                       secs_elapsed,
+                   const data::WellBuffer&            well_solution,
+                   const data::GroupAndNetworkValues& grp_nwrk_solution,
+                   GlobalProcessParameters            single_values,
+                   const Inplace&                     initial_inplace,
+                   const Inplace&                     inplace,
+                   const PAvgCalculatorCollection&    ,
+                   const RegionParameters&            region_values,
+                   const BlockValues&                 block_values,
+                   const Ewoms::data::Aquifers&         aquifer_values) const
+{
 
     /* Report_step is the one-based sequence number of the containing report.
      * Report_step = 0 for the initial condition, before simulation starts.
@@ -3388,7 +3395,7 @@ void Summary::eval(SummaryState&                      st,
     const auto sim_step = std::max( 0, report_step - 1 );
 
     this->pImpl_->eval(sim_step, secs_elapsed,
-                       well_solution, grp_nwrk_solution, single_values,
+                       data::WellResults{ well_solution }, grp_nwrk_solution, single_values,
                        initial_inplace, inplace,
                        region_values, block_values, aquifer_values, st);
 }
@@ -40,6 +40,7 @@ namespace Ewoms {
 } // namespace Ewoms
 
 namespace Ewoms { namespace data {
+    class WellBuffer;
     class WellRates;
     class GroupAndNetworkValues;
 }} // namespace Ewoms::data
@@ -75,6 +76,21 @@ public:
               const BlockValues&                 block_values  = {},
               const data::Aquifers&              aquifers_values = {}) const;
 
+    /// As above, with the well results read directly from the simulator's
+    /// buffer.
+    void eval(SummaryState&                      summary_state,
+              const int                          report_step,
+              const double                       secs_elapsed,
+              const data::WellBuffer&            well_solution,
+              const data::GroupAndNetworkValues& group_and_nwrk_solution,
+              GlobalProcessParameters            single_values,
+              const Inplace&                     initial_inplace,
+              const Inplace&                     inplace,
+              const PAvgCalculatorCollection&    ,
+              const RegionParameters&            region_values = {},
+              const BlockValues&                 block_values  = {},
+              const data::Aquifers&              aquifers_values = {}) const;
+
     void write() const;
 
     PAvgCalculatorCollection wbp_calculators(std::size_t report_step) const;
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <ctime>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
@@ -152,15 +153,19 @@ namespace {
         }
     } // namespace RftUnits
 
+    /// Per-connection RFT data of one well.
+    ///
+    /// Sized for the largest well of a plan on construction and reused for
+    /// all wells of the plan, so collecting a well's data does not allocate.
     class WellRFT
     {
     public:
-        explicit WellRFT(const std::size_t nconn = 0);
+        explicit WellRFT(const std::size_t maxConn);
 
-        void add(const ::Ewoms::UnitSystem&       usys,
-                 const ::Ewoms::Connection&       conn,
-                 const ::Ewoms::data::Connection& xcon,
-                 const double                   depth);
+        void collect(const ::Ewoms::RftIO::Plan&                plan,
+                     const std::size_t                        well,
+                     const ::Ewoms::UnitSystem&                 usys,
+                     const std::vector<Ewoms::data::Connection>& xcon);
 
         std::size_t nConn() const { return this->i_.size(); }
 
@@ -190,32 +195,47 @@ namespace {
         std::vector<float> sgas_;
 
         std::vector<Ewoms::EclIO::PaddedOutputString<8>> host_;
+
+        void resize(const std::size_t nconn);
     };
 
-    WellRFT::WellRFT(const std::size_t nconn)
+    WellRFT::WellRFT(const std::size_t maxConn)
     {
-        if (nconn == 0) { return; }
+        this->i_.reserve(maxConn);
+        this->j_.reserve(maxConn);
+        this->k_.reserve(maxConn);
+
+        this->depth_.reserve(maxConn);
+        this->press_.reserve(maxConn);
+        this->swat_ .reserve(maxConn);
+        this->sgas_ .reserve(maxConn);
+
+        this->host_.reserve(maxConn);
+    }
 
-        this->i_.reserve(nconn);
-        this->j_.reserve(nconn);
-        this->k_.reserve(nconn);
+    void WellRFT::resize(const std::size_t nconn)
+    {
+        this->i_.resize(nconn);
+        this->j_.resize(nconn);
+        this->k_.resize(nconn);
 
-        this->depth_.reserve(nconn);
-        this->press_.reserve(nconn);
-        this->swat_ .reserve(nconn);
-        this->sgas_ .reserve(nconn);
+        this->depth_.resize(nconn);
+        this->press_.resize(nconn);
+        this->swat_ .resize(nconn);
+        this->sgas_ .resize(nconn);
 
-        this->host_.reserve(nconn);
+        this->host_.resize(nconn);
     }
 
-    void WellRFT::add(const ::Ewoms::UnitSystem&       usys,
-                      const ::Ewoms::Connection&       conn,
-                      const ::Ewoms::data::Connection& xcon,
-                      const double                   depth)
+    void WellRFT::collect(const ::Ewoms::RftIO::Plan&                plan,
+                          const std::size_t                        well,
+                          const ::Ewoms::UnitSystem&                 usys,
+                          const std::vector<Ewoms::data::Connection>& xcon)
     {
-        this->i_.push_back(conn.getI() + 1);
-        this->j_.push_back(conn.getJ() + 1);
-        this->k_.push_back(conn.getK() + 1);
+        const auto begin = plan.connBegin(well);
+        const auto end   = plan.connEnd(well);
+
+        this->resize(end - begin);
 
         using M = ::Ewoms::UnitSystem::measure;
         auto cvrt = [&usys](const M meas, const double x) -> float
@@ -223,51 +243,43 @@ namespace {
             return usys.from_si(meas, x);
         };
 
-        this->depth_.push_back(cvrt(M::length  , depth));
-        this->press_.push_back(cvrt(M::pressure, xcon.cell_pressure));
-
-        this->swat_.push_back(xcon.cell_saturation_water);
-        this->sgas_.push_back(xcon.cell_saturation_gas);
-
-        this->host_.emplace_back();
-    }
-
-    WellRFT
-    createWellRFT(const int                                 reportStep,
-                  const std::string&                        wname,
-                  const ::Ewoms::UnitSystem&                  usys,
-                  const ::Ewoms::EclipseGrid&                 grid,
-                  const ::Ewoms::Schedule&                    sched,
-                  const std::vector<Ewoms::data::Connection>& xcon)
-    {
-        auto rft = WellRFT{ xcon.size() };
-
-        for (const auto& conn : sched.getWell(wname, reportStep).getConnections()) {
-            const auto i = static_cast<std::size_t>(conn.getI());
-            const auto j = static_cast<std::size_t>(conn.getJ());
-            const auto k = static_cast<std::size_t>(conn.getK());
-
-            if (! grid.cellActive(i, j, k)) {
-                // Inactive cell.  Ignore.
-                continue;
+        // The simulator normally reports connections in the order of the
+        // schedule, so try the entry after the previous match first.
+        auto next = xcon.begin();
+        auto n = std::size_t{0};
+        for (auto c = begin; c < end; ++c) {
+            const auto ix = plan.cell(c);
+
+            auto xconPos = next;
+            if ((xconPos == xcon.end()) || (xconPos->index != ix)) {
+                xconPos = std::find_if(xcon.begin(), xcon.end(),
+                    [ix](const ::Ewoms::data::Connection& xc)
+                {
+                    return xc.index == ix;
+                });
             }
 
-            const auto ix = grid.getGlobalIndex(i, j, k);
-            auto xconPos = std::find_if(xcon.begin(), xcon.end(),
-                [ix](const ::Ewoms::data::Connection& c)
-            {
-                return c.index == ix;
-            });
-
             if (xconPos == xcon.end()) {
                 // RFT data not available for this connection.  Unexpected.
                 continue;
             }
 
-            rft.add(usys, conn, *xconPos, grid.getCellDepth(ix));
+            next = xconPos + 1;
+
+            this->i_[n] = plan.conI(c);
+            this->j_[n] = plan.conJ(c);
+            this->k_[n] = plan.conK(c);
+
+            this->depth_[n] = cvrt(M::length  , plan.depth(c));
+            this->press_[n] = cvrt(M::pressure, xconPos->cell_pressure);
+
+            this->swat_[n] = xconPos->cell_saturation_water;
+            this->sgas_[n] = xconPos->cell_saturation_gas;
+
+            ++n;
         }
 
-        return rft;
+        this->resize(n);
     }
 
     std::vector<Ewoms::EclIO::PaddedOutputString<8>>
@@ -318,7 +330,7 @@ namespace {
 
     void writeWellHeader(const double                     elapsed,
                          const std::string&               wellName,
-                         const ::Ewoms::Schedule&           sched,
+                         const std::time_t                startTime,
                          const ::Ewoms::UnitSystem&         usys,
                          ::Ewoms::EclIO::OutputStream::RFT& rftFile)
     {
@@ -333,7 +345,7 @@ namespace {
 
         {
             const auto timePoint = ::Ewoms::RestartIO::
-                getSimulationTimePoint(sched.getStartTime(), elapsed);
+                getSimulationTimePoint(startTime, elapsed);
 
             rftFile.write("DATE", std::vector<int> {
                 timePoint.day,   // 1..31
@@ -358,26 +370,56 @@ namespace {
         rftFile.write("SWAT"    , rft.swat());
         rftFile.write("SGAS"    , rft.sgas());
     }
+} // Anonymous namespace
 
-    void writeWellRFT(const int                                 reportStep,
-                      const double                              elapsed,
-                      const std::string&                        wname,
-                      const ::Ewoms::UnitSystem&                  usys,
-                      const ::Ewoms::EclipseGrid&                 grid,
-                      const ::Ewoms::Schedule&                    sched,
-                      const std::vector<Ewoms::data::Connection>& xcon,
-                      ::Ewoms::EclIO::OutputStream::RFT&          rftFile)
-    {
-        const auto rft =
-            createWellRFT(reportStep, wname, usys, grid, sched, xcon);
+Ewoms::RftIO::Plan::Plan(const int             reportStep,
+                         const EclipseGrid&    grid,
+                         const Schedule&       schedule)
+    : reportStep_(reportStep)
+    , startTime_ (schedule.getStartTime())
+{
+    this->connOffset_.push_back(0);
 
-        writeWellHeader(elapsed, wname, sched, usys, rftFile);
+    const auto& rftCfg = schedule.rftConfig();
+    if (! rftCfg.active(reportStep)) {
+        // RFT not yet activated.  Nothing to do.
+        return;
+    }
 
-        if (rft.nConn() > std::size_t{0}) {
-            write(rft, rftFile);
+    for (const auto& wname : schedule.wellNames(reportStep)) {
+        if (! (rftCfg.rft(wname, reportStep) ||
+               rftCfg.plt(wname, reportStep)))
+        {
+            // RFT output not requested for 'wname' at this time.
+            continue;
         }
+
+        const auto begin = this->cell_.size();
+        for (const auto& conn : schedule.getWell(wname, reportStep).getConnections()) {
+            const auto i = static_cast<std::size_t>(conn.getI());
+            const auto j = static_cast<std::size_t>(conn.getJ());
+            const auto k = static_cast<std::size_t>(conn.getK());
+
+            if (! grid.cellActive(i, j, k)) {
+                // Inactive cell.  Ignore.
+                continue;
+            }
+
+            const auto ix = grid.getGlobalIndex(i, j, k);
+
+            this->i_.push_back(conn.getI() + 1);
+            this->j_.push_back(conn.getJ() + 1);
+            this->k_.push_back(conn.getK() + 1);
+            this->cell_.push_back(ix);
+            this->depth_.push_back(grid.getCellDepth(ix));
+        }
+
+        this->wells_.push_back(wname);
+        this->connOffset_.push_back(this->cell_.size());
+
+        this->maxConn_ = std::max(this->maxConn_, this->cell_.size() - begin);
     }
-} // Anonymous namespace
+}
 
 void Ewoms::RftIO::write(const int                        reportStep,
                        const double                     elapsed,
@@ -387,23 +429,30 @@ void Ewoms::RftIO::write(const int                        reportStep,
                        const ::Ewoms::data::WellRates&    wellSol,
                        ::Ewoms::EclIO::OutputStream::RFT& rftFile)
 {
-    const auto& rftCfg = schedule.rftConfig();
-    if (! rftCfg.active(reportStep)) {
-        // RFT not yet activated.  Nothing to do.
+    write(Plan { reportStep, grid, schedule }, elapsed, usys, wellSol, rftFile);
+}
+
+void Ewoms::RftIO::write(const Plan&                      plan,
+                       const double                     elapsed,
+                       const ::Ewoms::UnitSystem&         usys,
+                       const ::Ewoms::data::WellRates&    wellSol,
+                       ::Ewoms::EclIO::OutputStream::RFT& rftFile)
+{
+    if (plan.empty()) {
         return;
     }
 
-    for (const auto& wname : schedule.wellNames(reportStep)) {
-        if (! (rftCfg.rft(wname, reportStep) ||
-               rftCfg.plt(wname, reportStep)))
-        {
-            // RFT output not requested for 'wname' at this time.
-            continue;
-        }
+    auto rft = WellRFT { plan.maxConnections() };
+
+    for (auto w = std::size_t{0}; w < plan.numWells(); ++w) {
+        const auto& wname = plan.well(w);
 
-        // RFT output requested for 'wname' at this time.
-        writeWellRFT(reportStep, elapsed, wname, usys, grid,
-                     schedule, wellSol.at(wname).connections,
-                     rftFile);
+        rft.collect(plan, w, usys, wellSol.at(wname).connections);
+
+        writeWellHeader(elapsed, wname, plan.startTime(), usys, rftFile);
+
+        if (rft.nConn() > std::size_t{0}) {
+            write(rft, rftFile);
+        }
     }
 }
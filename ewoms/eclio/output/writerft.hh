@@ -19,6 +19,11 @@
 #ifndef EWOMS_WRITE_RFT_H
 #define EWOMS_WRITE_RFT_H
 
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
 namespace Ewoms {
 
     class EclipseGrid;
@@ -41,6 +46,62 @@ namespace Ewoms { namespace EclIO { namespace OutputStream {
 
 namespace Ewoms { namespace RftIO {
 
+    /// Wells and reservoir connections for which RFT output is requested
+    /// at a single report step.
+    ///
+    /// The plan depends on the schedule and the grid only, so a simulator
+    /// can create it once per report step and reuse it.  Connections in
+    /// inactive cells are excluded.  Connection data of all wells is
+    /// stored in common arrays with the connections of well \c w in the
+    /// range [\code connBegin(w) \endcode, \code connEnd(w) \endcode).
+    class Plan
+    {
+    public:
+        Plan(const int             reportStep,
+             const EclipseGrid&    grid,
+             const Schedule&       schedule);
+
+        int reportStep() const { return this->reportStep_; }
+        std::time_t startTime() const { return this->startTime_; }
+
+        /// Whether or not no RFT output is requested at this step.
+        bool empty() const { return this->wells_.empty(); }
+
+        std::size_t numWells() const { return this->wells_.size(); }
+        const std::string& well(const std::size_t w) const { return this->wells_[w]; }
+
+        std::size_t connBegin(const std::size_t w) const { return this->connOffset_[w]; }
+        std::size_t connEnd(const std::size_t w) const { return this->connOffset_[w + 1]; }
+
+        /// Largest number of connections of any well in the plan.
+        std::size_t maxConnections() const { return this->maxConn_; }
+
+        /// One-based cell indices of a connection.
+        int conI(const std::size_t c) const { return this->i_[c]; }
+        int conJ(const std::size_t c) const { return this->j_[c]; }
+        int conK(const std::size_t c) const { return this->k_[c]; }
+
+        /// Global (Cartesian) index of the cell of a connection.
+        std::size_t cell(const std::size_t c) const { return this->cell_[c]; }
+
+        /// Depth of the cell of a connection in SI units.
+        double depth(const std::size_t c) const { return this->depth_[c]; }
+
+    private:
+        int reportStep_;
+        std::time_t startTime_;
+        std::size_t maxConn_{0};
+
+        std::vector<std::string> wells_;
+        std::vector<std::size_t> connOffset_;
+
+        std::vector<int> i_;
+        std::vector<int> j_;
+        std::vector<int> k_;
+        std::vector<std::size_t> cell_;
+        std::vector<double> depth_;
+    };
+
     /// Collect RFT data and output to pre-opened output stream.
     ///
     /// RFT data is output for all affected wells at a given timestep,
@@ -83,6 +144,29 @@ namespace Ewoms { namespace RftIO {
                const ::Ewoms::data::WellRates&    wellSol,
                ::Ewoms::EclIO::OutputStream::RFT& rftFile);
 
+    /// Output RFT data for all wells of a pre-computed plan.
+    ///
+    /// Equivalent to the overload taking the report step, grid and
+    /// schedule, for the report step of \p plan.
+    ///
+    /// \param[in] plan Wells and connections for which to output RFT
+    ///    data.
+    ///
+    /// \param[in] elapsed Number of seconds of simulated time until the
+    ///    plan's report step.
+    ///
+    /// \param[in] usys Unit system conventions for output.
+    ///
+    /// \param[in] wellSol Dynamic well results.  Must contain every well
+    ///    of the plan.
+    ///
+    /// \param[in,out] rftFile RFT output stream.
+    void write(const Plan&                      plan,
+               const double                     elapsed,
+               const ::Ewoms::UnitSystem&         usys,
+               const ::Ewoms::data::WellRates&    wellSol,
+               ::Ewoms::EclIO::OutputStream::RFT& rftFile);
+
 }} // namespace Ewoms::RftIO
 
 #endif // EWOMS_WRITE_RFT_H
@@ -29,19 +29,34 @@
 
 namespace Ewoms {
 
-    bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
-        auto key = this->keywordMap.find( keyword.name() );
+    void DeckView::KeywordIndex::add( const std::string& name, size_t offset ) {
+        auto id = this->ids.emplace( name, this->offsets.size() );
+        if( id.second )
+            this->offsets.emplace_back();
+
+        this->offsets[ id.first->second ].push_back( offset );
+    }
+
+    const std::vector< size_t >* DeckView::KeywordIndex::find( const std::string& name ) const {
+        auto id = this->ids.find( name );
+        if( id == this->ids.end() )
+            return nullptr;
 
-        if( key == this->keywordMap.end() ) return false;
+        return &this->offsets[ id->second ];
+    }
+
+    bool DeckView::hasKeyword( const DeckKeyword& keyword ) const {
+        const auto* indices = this->keywordIndex ? this->keywordIndex->find( keyword.name() ) : nullptr;
+        if( !indices ) return false;
 
-        for( auto index : key->second )
+        for( auto index : *indices )
             if( &this->getKeyword( index ) == &keyword ) return true;
 
         return false;
     }
 
     bool DeckView::hasKeyword( const std::string& keyword ) const {
-        return this->keywordMap.find( keyword ) != this->keywordMap.end();
+        return this->keywordIndex && this->keywordIndex->find( keyword );
     }
 
     const DeckKeyword& DeckView::getKeyword( const std::string& keyword, size_t index ) const {
@@ -66,14 +81,10 @@ namespace Ewoms {
     }
 
     size_t DeckView::count( const std::string& keyword ) const {
-        if( !this->hasKeyword( keyword ) ) return 0;
-
         return this->offsets( keyword ).size();
    }
 
     const std::vector< const DeckKeyword* > DeckView::getKeywordList( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return {};
-
         const auto& indices = this->offsets( keyword );
 
         std::vector< const DeckKeyword* > ret;
@@ -85,6 +96,10 @@ namespace Ewoms {
         return ret;
     }
 
+    DeckView::KeywordRange DeckView::keywords( const std::string& keyword ) const {
+        return KeywordRange( this->begin(), this->offsets( keyword ) );
+    }
+
     size_t DeckView::size() const {
         return std::distance( this->begin(), this->end() );
     }
@@ -98,16 +113,22 @@ namespace Ewoms {
     }
 
     void DeckView::add( const DeckKeyword* kw, const_iterator f, const_iterator l ) {
-        this->keywordMap[ kw->name() ].push_back( std::distance( f, l ) - 1 );
+        if( !this->keywordIndex )
+            this->keywordIndex = std::make_shared< KeywordIndex >();
+        else if( this->keywordIndex.use_count() > 1 )
+            this->keywordIndex = std::make_shared< KeywordIndex >( *this->keywordIndex );
+
+        this->keywordIndex->add( kw->name(), std::distance( f, l ) - 1 );
         this->first = f;
         this->last = l;
     }
 
     static const std::vector< size_t > empty_indices = {};
     const std::vector< size_t >& DeckView::offsets( const std::string& keyword ) const {
-        if( !hasKeyword( keyword ) ) return empty_indices;
+        const auto* indices = this->keywordIndex ? this->keywordIndex->find( keyword ) : nullptr;
+        if( !indices ) return empty_indices;
 
-        return this->keywordMap.find( keyword )->second;
+        return *indices;
     }
 
     DeckView::DeckView( const_iterator first_arg, const_iterator last_arg)
@@ -115,21 +136,32 @@ namespace Ewoms {
         this->init(first_arg, last_arg);
     }
 
+    std::shared_ptr< DeckView::KeywordIndex > DeckView::buildIndex( const_iterator first_arg, const_iterator last_arg ) {
+        auto index = std::make_shared< KeywordIndex >();
+
+        size_t offset = 0;
+        for( auto iter = first_arg; iter != last_arg; ++iter )
+            index->add( iter->name(), offset++ );
+
+        return index;
+    }
+
     void DeckView::init( const_iterator first_arg, const_iterator last_arg ) {
         this->first = first_arg;
         this->last = last_arg;
-
-        this->keywordMap.clear();
-
-        size_t index = 0;
-        for( const auto& kw : *this )
-            this->keywordMap[ kw.name() ].push_back( index++ );
+        this->keywordIndex = buildIndex( first_arg, last_arg );
     }
 
     DeckView::DeckView( std::pair< const_iterator, const_iterator > limits ) :
         DeckView( limits.first, limits.second )
     {}
 
+    DeckView::DeckView( std::pair< const_iterator, const_iterator > limits, std::shared_ptr< KeywordIndex > index ) :
+        first( limits.first ),
+        last( limits.second ),
+        keywordIndex( std::move( index ) )
+    {}
+
     Deck::Deck() :
         Deck( std::vector<DeckKeyword>() )
     {}
@@ -149,7 +181,7 @@ namespace Ewoms {
     }
 
     Deck::Deck( const Deck& d ) :
-        DeckView(d.begin(), d.end()),
+        DeckView(),
         keywordList( d.keywordList ),
         defaultUnits( d.defaultUnits ),
         m_dataFile( d.m_dataFile ),
@@ -158,7 +190,7 @@ namespace Ewoms {
         this->init(this->keywordList.begin(), this->keywordList.end());
         if (d.activeUnits)
             this->activeUnits.reset( new UnitSystem(*d.activeUnits.get()));
-        unit_system_access_count = d.unit_system_access_count;
+        unit_system_access_count = d.unit_system_access_count.load();
     }
 
     Deck Deck::serializeObject()
@@ -184,6 +216,7 @@ namespace Ewoms {
         else if (keyword.name() == "PVT-M")
             this->selectActiveUnitSystem( UnitSystem::UnitType::UNIT_TYPE_PVT_M );
 
+        this->clearSectionIndices();
         this->keywordList.push_back( std::move( keyword ) );
         auto fst = this->keywordList.begin();
         auto lst = this->keywordList.end();
@@ -199,6 +232,23 @@ namespace Ewoms {
         return this->keywordList.at( index );
     }
 
+    std::shared_ptr< DeckView::KeywordIndex > Deck::sectionIndex( const std::string& section,
+                                                                  const_iterator first_arg,
+                                                                  const_iterator last_arg ) const {
+        std::lock_guard< std::mutex > lock( this->sectionIndexMutex );
+
+        auto& index = this->sectionIndices[ section ];
+        if( !index )
+            index = buildIndex( first_arg, last_arg );
+
+        return index;
+    }
+
+    void Deck::clearSectionIndices() {
+        std::lock_guard< std::mutex > lock( this->sectionIndexMutex );
+        this->sectionIndices.clear();
+    }
+
     UnitSystem& Deck::getDefaultUnitSystem() {
         return this->defaultUnits;
     }
@@ -283,8 +333,9 @@ namespace Ewoms {
         defaultUnits = data.defaultUnits;
         m_dataFile = data.m_dataFile;
         input_path = data.input_path;
-        unit_system_access_count = data.unit_system_access_count;
+        unit_system_access_count = data.unit_system_access_count.load();
         this->init(this->keywordList.begin(), this->keywordList.end());
+        this->clearSectionIndices();
         activeUnits.reset();
         if (data.activeUnits)
             activeUnits.reset(new UnitSystem(*data.activeUnits));
@@ -303,7 +354,7 @@ namespace Ewoms {
                this->defaultUnits == data.defaultUnits &&
                this->m_dataFile == data.m_dataFile &&
                this->input_path == data.input_path &&
-               this->unit_system_access_count == data.unit_system_access_count;
+               this->unit_system_access_count.load() == data.unit_system_access_count.load();
     }
 
     std::ostream& operator<<(std::ostream& os, const Deck& deck) {
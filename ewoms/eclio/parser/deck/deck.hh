@@ -19,9 +19,14 @@
 #ifndef DECK_H
 #define DECK_H
 
+#include <atomic>
+#include <cstddef>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -55,6 +60,54 @@ namespace Ewoms {
         public:
             typedef std::vector< DeckKeyword >::const_iterator const_iterator;
 
+            /*
+              The keywords with a given name, in the order they appear in the
+              view. The range refers to the keyword index of the view and is
+              invalidated when keywords are added to the deck.
+            */
+            class KeywordRange {
+                public:
+                    class iterator {
+                        public:
+                            using iterator_category = std::forward_iterator_tag;
+                            using value_type = DeckKeyword;
+                            using difference_type = std::ptrdiff_t;
+                            using pointer = const DeckKeyword*;
+                            using reference = const DeckKeyword&;
+
+                            iterator( const_iterator first, std::vector< size_t >::const_iterator offset ) :
+                                first( first ), offset( offset )
+                            {}
+
+                            reference operator*() const { return *(this->first + *this->offset); }
+                            pointer operator->() const { return &**this; }
+                            iterator& operator++() { ++this->offset; return *this; }
+                            iterator operator++(int) { auto tmp = *this; ++this->offset; return tmp; }
+                            bool operator==( const iterator& other ) const { return this->offset == other.offset; }
+                            bool operator!=( const iterator& other ) const { return this->offset != other.offset; }
+
+                        private:
+                            const_iterator first;
+                            std::vector< size_t >::const_iterator offset;
+                    };
+
+                    iterator begin() const { return iterator( this->first, this->offsets->begin() ); }
+                    iterator end() const { return iterator( this->first, this->offsets->end() ); }
+                    size_t size() const { return this->offsets->size(); }
+                    bool empty() const { return this->offsets->empty(); }
+                    const DeckKeyword& operator[]( size_t index ) const { return *(this->first + (*this->offsets)[index]); }
+                    const DeckKeyword& back() const { return *(this->first + this->offsets->back()); }
+
+                private:
+                    friend class DeckView;
+                    KeywordRange( const_iterator first, const std::vector< size_t >& offsets ) :
+                        first( first ), offsets( &offsets )
+                    {}
+
+                    const_iterator first;
+                    const std::vector< size_t >* offsets;
+            };
+
             bool hasKeyword( const DeckKeyword& keyword ) const;
             bool hasKeyword( const std::string& keyword ) const;
             template< class Keyword >
@@ -85,6 +138,13 @@ namespace Ewoms {
                 return getKeywordList( Keyword::keywordName );
             }
 
+            /// Like getKeywordList(), without allocating a vector.
+            KeywordRange keywords( const std::string& keyword ) const;
+            template< class Keyword >
+            KeywordRange keywords() const {
+                return keywords( Keyword::keywordName );
+            }
+
             size_t count(const std::string& keyword) const;
             size_t size() const;
 
@@ -92,19 +152,37 @@ namespace Ewoms {
             const_iterator end() const;
 
         protected:
+            /*
+              The positions of the keywords in the view, grouped by keyword
+              name. Every distinct name is given a dense id when it is first
+              seen, so a lookup costs a single hash of the name. Views over
+              the same keywords can share the index; a shared index is never
+              modified.
+            */
+            struct KeywordIndex {
+                std::unordered_map< std::string, size_t > ids;
+                std::vector< std::vector< size_t > > offsets;
+
+                void add( const std::string& name, size_t offset );
+                const std::vector< size_t >* find( const std::string& name ) const;
+            };
+
             void add( const DeckKeyword*, const_iterator, const_iterator );
 
             const std::vector< size_t >& offsets( const std::string& ) const;
 
             DeckView( const_iterator first, const_iterator last );
             explicit DeckView( std::pair< const_iterator, const_iterator > );
+            DeckView( std::pair< const_iterator, const_iterator >, std::shared_ptr< KeywordIndex > );
             DeckView() = default;
             void init( const_iterator, const_iterator );
 
+            static std::shared_ptr< KeywordIndex > buildIndex( const_iterator, const_iterator );
+
         private:
             const_iterator first;
             const_iterator last;
-            std::map< std::string, std::vector< size_t > > keywordMap;
+            std::shared_ptr< KeywordIndex > keywordIndex;
 
     };
 
@@ -114,6 +192,8 @@ namespace Ewoms {
             using DeckView::hasKeyword;
             using DeckView::getKeyword;
             using DeckView::getKeywordList;
+            using DeckView::keywords;
+            using DeckView::KeywordRange;
             using DeckView::count;
             using DeckView::size;
             using DeckView::begin;
@@ -158,21 +238,44 @@ namespace Ewoms {
                 serializer(activeUnits);
                 serializer(m_dataFile);
                 serializer(input_path);
-                serializer(unit_system_access_count);
-                if (!serializer.isSerializing())
+                if (serializer.isSerializing())
+                    serializer(unit_system_access_count.load());
+                else {
+                    std::size_t access_count = 0;
+                    serializer(access_count);
+                    unit_system_access_count = access_count;
+                }
+                if (!serializer.isSerializing()) {
                   this->init(this->keywordList.begin(), this->keywordList.end());
+                  this->clearSectionIndices();
+                }
             }
 
         private:
+            friend class DeckSection;
+
             Deck(std::vector<DeckKeyword>&& keywordList);
 
+            /*
+              The keyword index of a section, built on first use and shared
+              by all DeckSection objects for the section.
+            */
+            std::shared_ptr< KeywordIndex > sectionIndex( const std::string& section,
+                                                          const_iterator first,
+                                                          const_iterator last ) const;
+            void clearSectionIndices();
+
+            mutable std::map< std::string, std::shared_ptr< KeywordIndex > > sectionIndices;
+            mutable std::mutex sectionIndexMutex;
+
             std::vector< DeckKeyword > keywordList;
             UnitSystem defaultUnits;
             std::unique_ptr<UnitSystem> activeUnits;
 
             std::string m_dataFile;
             std::string input_path;
-            mutable std::size_t unit_system_access_count = 0;
+            // Counted from const accessors, which may run concurrently.
+            mutable std::atomic<std::size_t> unit_system_access_count{0};
     };
 }
 #endif  /* DECK_HH */
@@ -122,7 +122,6 @@ DeckItem DeckItem::serializeObject()
     result.type = type_tag::string;
     result.item_name = "test2";
     result.value_status = {value::status::deck_value};
-    result.raw_data = false;
     result.active_dimensions = {Dimension::serializeObject()};
     result.default_dimensions = {Dimension::serializeObject()};
 
@@ -194,6 +193,7 @@ const std::vector< T >& DeckItem::getData() const {
 template< typename T >
 void DeckItem::push( T x ) {
     auto& val = this->value_ref< T >();
+    this->si_data.reset();
 
     val.push_back( std::move( x ) );
     this->value_status.push_back( value::status::deck_value );
@@ -226,6 +226,7 @@ void DeckItem::push_back( UDAValue x ) {
 template< typename T >
 void DeckItem::push( T x, size_t n ) {
     auto& val = this->value_ref< T >();
+    this->si_data.reset();
 
     val.insert( val.end(), n, x );
     this->value_status.insert( this->value_status.end(), n, value::status::deck_value );
@@ -254,6 +255,7 @@ void DeckItem::push_default( T x ) {
         throw std::logic_error("To add a value to an item, "
                 "no 'pseudo defaults' can be added before");
 
+    this->si_data.reset();
     val.push_back( std::move( x ) );
     this->value_status.push_back( value::status::valid_default );
 }
@@ -285,6 +287,7 @@ void DeckItem::push_backDefault( UDAValue x ) {
 template<typename T>
 void DeckItem::push_backDummyDefault() {
     auto& val = this->value_ref< T >();
+    this->si_data.reset();
     val.push_back( T() );
     this->value_status.push_back( value::status::empty_default );
 }
@@ -293,60 +296,48 @@ std::string DeckItem::getTrimmedString( size_t index ) const {
     return trim_copy(this->value_ref< std::string >().at(index));
 }
 
-double DeckItem::getSIDouble( size_t index ) const {
-    return this->getSIDoubleData().at( index );
-}
-
-template<>
-const std::vector<double>& DeckItem::getData() const {
-    auto& data = (const_cast<DeckItem*>(this))->value_ref< double >();
-    if (this->raw_data)
-        return data;
-
-    const auto dim_size = this->active_dimensions.size();
-    for( size_t index = 0; index < data.size(); index++ ) {
-        const auto dimIndex = index % dim_size;
-        if (value::defaulted(this->value_status[index])) {
-            const auto& dim = this->default_dimensions[dimIndex];
-            data[ index ] = dim.convertSiToRaw( data[ index ] );
-        } else {
-            const auto& dim = this->active_dimensions[dimIndex];
-            data[ index ] = dim.convertSiToRaw( data[ index ] );
-        }
-    }
-    this->raw_data = true;
-    return data;
-}
-
-const std::vector< double >& DeckItem::getSIDoubleData() const {
-    auto& data = (const_cast<DeckItem*>(this))->value_ref< double >();
-    if (!this->raw_data)
-        return data;
-
+const Dimension& DeckItem::dimension( size_t index ) const {
     if( this->active_dimensions.empty() )
         throw std::invalid_argument("No dimension has been set for item'"
                                     + this->name()
                                     + "'; can not ask for SI data");
 
-    /*
-     * This is an unobservable state change - SIData is lazily converted to
-     * SI units, so externally the object still behaves as const
-     */
-
-    const auto dim_size = this->active_dimensions.size();
-    const auto sz = data.size();
-    for( size_t index = 0; index < sz; index++ ) {
-        const auto dimIndex = index % dim_size;
-        if (value::defaulted(this->value_status[index])) {
-            const auto& dim = this->default_dimensions[dimIndex];
-            data[ index ] = dim.convertRawToSi( data[ index ] );
-        } else {
-            const auto& dim = this->active_dimensions[dimIndex];
-            data[ index ] = dim.convertRawToSi( data[ index ] );
-        }
+    const auto dimIndex = index % this->active_dimensions.size();
+    if (value::defaulted(this->value_status[index]))
+        return this->default_dimensions[dimIndex];
+
+    return this->active_dimensions[dimIndex];
+}
+
+double DeckItem::getSIDouble( size_t index ) const {
+    const auto& data = this->value_ref< double >();
+    if (auto si = this->si_data.load())
+        return si->at( index );
+
+    const double value = data.at( index );
+    return this->dimension( index ).convertRawToSi( value );
+}
+
+const std::vector< double >& DeckItem::getSIDoubleData() const {
+    const auto& data = this->value_ref< double >();
+    if (auto si = this->si_data.load())
+        return *si;
+
+    auto si = std::make_shared<std::vector<double>>( data.size() );
+    const auto singleDimension = (this->active_dimensions.size() == 1)
+        && (this->default_dimensions.size() == 1)
+        && (this->active_dimensions[0] == this->default_dimensions[0]);
+
+    if (singleDimension)
+        this->active_dimensions[0].convertRawToSi( data.data(), si->data(), data.size() );
+    else {
+        for( size_t index = 0; index < data.size(); index++ )
+            (*si)[ index ] = this->dimension( index ).convertRawToSi( data[ index ] );
     }
-    this->raw_data = false;
-    return data;
+
+    // If several threads convert concurrently all but the first result are
+    // discarded; the published vector lives as long as the item is unchanged.
+    return *this->si_data.publish( std::move(si) );
 }
 
 type_tag DeckItem::getType() const {
@@ -445,13 +436,8 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
                     return false;
             }
         } else {
-            if (this->raw_data == other.raw_data)
-                return (this->dval == other.dval);
-            else {
-                const auto& this_data = this->getData<double>();
-                const auto& other_data = other.getData<double>();
-                return (this_data == other_data);
-            }
+            if (this->dval != other.dval)
+                return false;
         }
         break;
     default:
@@ -524,6 +510,7 @@ template void DeckItem::push_backDummyDefault<RawString>();
 template void DeckItem::push_backDummyDefault<UDAValue>();
 
 template const std::vector< int >& DeckItem::getData< int >() const;
+template const std::vector< double >& DeckItem::getData< double >() const;
 template const std::vector< UDAValue >& DeckItem::getData< UDAValue >() const;
 template const std::vector< std::string >& DeckItem::getData< std::string >() const;
 template const std::vector<RawString>& DeckItem::getData<RawString>() const;
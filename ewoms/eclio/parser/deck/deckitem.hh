@@ -19,6 +19,7 @@
 #ifndef DECKITEM_H
 #define DECKITEM_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -138,13 +139,47 @@ namespace Ewoms {
             serializer(type);
             serializer(item_name);
             serializer.template vector<value::status, false>(value_status);
-            serializer(raw_data);
             serializer.vector(active_dimensions);
             serializer.vector(default_dimensions);
         }
 
     private:
-        mutable std::vector< double > dval;
+        /*
+          Copy of the double data converted to SI units, built on the first
+          request. The raw data is never modified by const member functions
+          and the copy is published atomically, so a const DeckItem can be
+          read from several threads.
+        */
+        class SIData {
+        public:
+            using Ptr = std::shared_ptr<const std::vector<double>>;
+
+            SIData() = default;
+            SIData(const SIData& other) : data(other.load()) {}
+            SIData& operator=(const SIData& other) {
+                std::atomic_store(&this->data, other.load());
+                return *this;
+            }
+
+            Ptr load() const { return std::atomic_load(&this->data); }
+
+            // Publish new_data unless another thread has been first; the
+            // published data is returned.
+            Ptr publish(Ptr new_data) const {
+                Ptr expected;
+                if (std::atomic_compare_exchange_strong(&this->data, &expected, new_data))
+                    return new_data;
+
+                return expected;
+            }
+
+            void reset() { std::atomic_store(&this->data, Ptr()); }
+
+        private:
+            mutable Ptr data;
+        };
+
+        std::vector< double > dval;
         std::vector< int > ival;
         std::vector< std::string > sval;
         std::vector< RawString > rsval;
@@ -154,12 +189,7 @@ namespace Ewoms {
 
         std::string item_name;
         std::vector<value::status> value_status;
-        /*
-          To save space we mutate the dval object in place when asking for SI
-          data; the current state of of the dval member is tracked with the
-          raw_data bool member.
-        */
-        mutable bool raw_data = true;
+        SIData si_data;
         std::vector< Dimension > active_dimensions;
         std::vector< Dimension > default_dimensions;
 
@@ -169,6 +199,7 @@ namespace Ewoms {
         template< typename T > void push( T, size_t );
         template< typename T > void push_default( T );
         template< typename T > void write_vector(DeckOutput& writer, const std::vector<T>& data) const;
+        const Dimension& dimension( size_t ) const;
     };
 }
 #endif  /* DECKITEM_HH */
@@ -31,37 +31,49 @@
 
 namespace Ewoms {
 
-    static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
-            if( name == x ) return true;
-
-        return false;
-    }
-
     static std::pair< DeckView::const_iterator, DeckView::const_iterator >
     find_section( const Deck& deck, const std::string& keyword ) {
 
-        const auto fn = [&keyword]( const DeckKeyword& kw ) {
-            return kw.name() == keyword;
-        };
-
-        auto first = std::find_if( deck.begin(), deck.end(), fn );
+        const auto start = deck.keywords( keyword );
+        if( start.empty() )
+            return { deck.end(), deck.end() };
 
-        if( first == deck.end() )
-            return { first, first };
-
-        auto last = std::find_if( first + 1, deck.end(), isSectionDelimiter );
+        // The keywords are stored contiguously, so the positions can be
+        // recovered from the addresses.
+        const auto position = [&deck]( const DeckKeyword& kw ) {
+            return static_cast< size_t >( &kw - &*deck.begin() );
+        };
 
-        if( last != deck.end() && last->name() == keyword )
+        const auto first = position( start[0] );
+        auto last = deck.size();
+        std::string last_name;
+        for( const auto& name : { "RUNSPEC", "GRID", "EDIT", "PROPS",
+                                  "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } ) {
+            for( const auto& kw : deck.keywords( name ) ) {
+                const auto pos = position( kw );
+                if( pos > first ) {
+                    if( pos < last ) {
+                        last = pos;
+                        last_name = name;
+                    }
+                    break;
+                }
+            }
+        }
+
+        if( last_name == keyword )
             throw std::invalid_argument( std::string( "Deck contains the '" ) + keyword + "' section multiple times" );
 
-        return { first, last };
+        return { deck.begin() + first, deck.begin() + last };
     }
 
     DeckSection::DeckSection( const Deck& deck, const std::string& section )
-        : DeckView( find_section( deck, section ) ),
+        : DeckSection( deck, section, find_section( deck, section ) )
+    {}
+
+    DeckSection::DeckSection( const Deck& deck, const std::string& section,
+                              std::pair< const_iterator, const_iterator > limits )
+        : DeckView( limits, deck.sectionIndex( section, limits.first, limits.second ) ),
           section_name( section ),
           units( deck.getActiveUnitSystem() )
     {}
@@ -63,6 +63,9 @@ class DeckSection : public DeckView {
                                          bool ensureKeywordSectionAffiliation = false);
 
     private:
+        DeckSection( const Deck& deck, const std::string& section,
+                     std::pair< const_iterator, const_iterator > limits );
+
         std::string section_name;
         const UnitSystem& units;
 
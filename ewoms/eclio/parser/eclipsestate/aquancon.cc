@@ -28,43 +28,45 @@
 #include <algorithm>
 #include <iterator>
 #include <iostream>
+#include <vector>
 
 namespace Ewoms {
 
     namespace{
 
-        void add_cell(std::unordered_map<std::size_t, Aquancon::AquancCell>& work, Aquancon::AquancCell cell) {
-            auto cell_iter = work.find(cell.global_index);
-            if (cell_iter == work.end())
-                work.insert( std::make_pair(cell.global_index, std::move(cell)));
-            else {
-                auto& prev_cell = cell_iter->second;
-                if (prev_cell.aquiferID == cell.aquiferID) {
-                    if (prev_cell.influx_coeff.first != cell.influx_coeff.first)
-                        throw std::invalid_argument("Can not combine defaulted and not defaulted influx coefficient");
-
-                    if (prev_cell.influx_coeff.first) {
-                        if (cell.influx_coeff.second == 0)
-                            prev_cell.influx_coeff.second = 0;
-                        else
-                            prev_cell.influx_coeff.second += cell.influx_coeff.second;
-                    }
-                } else {
-                    static bool warningPrinted = false;
-                    if (!warningPrinted) {
-                        std::string msg = "Cell with global index: " + std::to_string(cell.global_index) + " is already connected to Aquifer: " + std::to_string(prev_cell.aquiferID);
-                        OpmLog::warning(msg);
-                        warningPrinted = true;
-                    }
-                    return;
-                }
+        /*
+          Combines a cell with a later connection of the same cell. Returns
+          false, and leaves the cell alone, if the connection is to another
+          aquifer.
+        */
+        bool merge_cell(Aquancon::AquancCell& prev_cell, const Aquancon::AquancCell& cell) {
+            if (prev_cell.aquiferID != cell.aquiferID)
+                return false;
+
+            if (prev_cell.influx_coeff.first != cell.influx_coeff.first)
+                throw std::invalid_argument("Can not combine defaulted and not defaulted influx coefficient");
+
+            if (prev_cell.influx_coeff.first) {
+                if (cell.influx_coeff.second == 0)
+                    prev_cell.influx_coeff.second = 0;
+                else
+                    prev_cell.influx_coeff.second += cell.influx_coeff.second;
             }
+
+            return true;
         }
+
     }
 
+    /*
+      The connections of all records are collected in input order, then
+      stably sorted on global index and reduced, so a cell named by several
+      records is combined in input order. The resulting cells of every
+      aquifer are sorted on global index.
+    */
     Aquancon::Aquancon(const EclipseGrid& grid, const Deck& deck)
     {
-        std::unordered_map<std::size_t, Aquancon::AquancCell> work;
+        std::vector<AquancCell> connections;
         for (std::size_t iaq = 0; iaq < deck.count("AQUANCON"); iaq++) {
             const auto& aquanconKeyword = deck.getKeyword("AQUANCON", iaq);
             OpmLog::info(OpmInputError::format("Initializing aquifer connections from {keyword} in {file} line {line}", aquanconKeyword.location()));
@@ -84,33 +86,55 @@ namespace Ewoms {
                     = aquanconRecord.getItem("CONNECT_ADJOINING_ACTIVE_CELL").getTrimmedString(0);
                 const bool allow_aquifer_inside_reservoir = DeckItem::to_bool(str_inside_reservoir);
 
-                // Loop over the cartesian indices to convert to the global grid index
+                std::pair<bool, double> influx_coeff = std::make_pair(false, 0);
+                const auto& influx_coeff_item = aquanconRecord.getItem("INFLUX_COEFF");
+                if (influx_coeff_item.hasValue(0))
+                    influx_coeff = std::make_pair(true, influx_coeff_item.getSIDouble(0));
+
+                if (i1 > i2 || j1 > j2 || k1 > k2)
+                    continue;
+
+                // Both corners inside the grid means the whole box is.
+                grid.assertIJK(i1, j1, k1);
+                grid.assertIJK(i2, j2, k2);
+
+                // Every (j, k) row of the box is a run of consecutive global indices.
                 for (int k = k1; k <= k2; k++) {
                     for (int j = j1; j <= j2; j++) {
+                        const auto row_begin = grid.getGlobalIndex(i1, j, k);
                         for (int i = i1; i <= i2; i++) {
-                            if (grid.cellActive(i, j, k)) { // the cell itself needs to be active
-                                if (allow_aquifer_inside_reservoir
-                                    || !neighborCellInsideReservoirAndActive(grid, i, j, k, faceDir)) {
-                                    std::pair<bool, double> influx_coeff = std::make_pair(false, 0);
-                                    auto global_index = grid.getGlobalIndex(i, j, k);
-                                    if (aquanconRecord.getItem("INFLUX_COEFF").hasValue(0))
-                                        influx_coeff = std::make_pair(
-                                            true, aquanconRecord.getItem("INFLUX_COEFF").getSIDouble(0));
-
-                                    AquancCell cell(aquiferID, global_index, influx_coeff, influx_mult, faceDir);
-                                    add_cell(work, cell);
-                                }
-                            }
+                            const auto global_index = row_begin + (i - i1);
+                            if (!grid.cellActive(global_index)) // the cell itself needs to be active
+                                continue;
+
+                            if (allow_aquifer_inside_reservoir
+                                || !neighborCellInsideReservoirAndActive(grid, i, j, k, faceDir))
+                                connections.emplace_back(aquiferID, global_index, influx_coeff, influx_mult, faceDir);
                         }
                     }
                 }
             }
         }
 
-        for (const auto& gi_cell : work) {
-            const auto& cell = gi_cell.second;
+        std::stable_sort(connections.begin(), connections.end(),
+                         [](const AquancCell& c1, const AquancCell& c2)
+                         { return c1.global_index < c2.global_index; });
+
+        auto conn = connections.begin();
+        while (conn != connections.end()) {
+            auto cell = *conn;
+            for (++conn; conn != connections.end() && conn->global_index == cell.global_index; ++conn) {
+                if (!merge_cell(cell, *conn)) {
+                    static bool warningPrinted = false;
+                    if (!warningPrinted) {
+                        std::string msg = "Cell with global index: " + std::to_string(cell.global_index) + " is already connected to Aquifer: " + std::to_string(cell.aquiferID);
+                        OpmLog::warning(msg);
+                        warningPrinted = true;
+                    }
+                }
+            }
 
-            this->cells[cell.aquiferID].emplace_back(std::move(cell));
+            this->cells[cell.aquiferID].push_back(std::move(cell));
         }
     }
 
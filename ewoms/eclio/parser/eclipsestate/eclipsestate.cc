@@ -19,12 +19,14 @@
 #include "config.h"
 
 #include <set>
+#include <utility>
 
 #include <ewoms/common/fmt/format.h>
 
 #include <ewoms/eclio/opmlog/infologger.hh>
 #include <ewoms/eclio/opmlog/logutil.hh>
 #include <ewoms/eclio/utility/opminputerror.hh>
+#include <ewoms/eclio/utility/taskgraph.hh>
 
 #include <ewoms/eclio/parser/deck/decksection.hh>
 #include <ewoms/eclio/parser/deck/deck.hh>
@@ -48,14 +50,59 @@
 
 namespace Ewoms {
 
-    EclipseState::EclipseState(const Deck& deck)
+    struct EclipseState::IndependentParts {
+        TableManager tables;
+        EclipseGrid grid;
+        NNC nnc;
+    };
+
+    /*
+      The tasks below run concurrently and share the const Deck, and through
+      it the active UnitSystem. This is only correct as long as every const
+      member function of Deck, DeckSection, DeckKeyword, DeckItem and
+      UnitSystem reachable from the TableManager, EclipseGrid and NNC
+      constructors is safe for concurrent callers: any mutable state they
+      update (the section indices, the SI data of the items and the access
+      counters of the deck and of the unit system) must be guarded by a
+      mutex or be atomic. A new constructor added to the graph must read
+      the deck through such members only.
+    */
+    EclipseState::IndependentParts EclipseState::buildIndependentParts(const Deck& deck, std::size_t num_threads) {
+        IndependentParts parts;
+        TaskGraph tasks;
+
+        tasks.addTask([&deck, &parts]() { parts.tables = TableManager( deck ); });
+        auto grid_task = tasks.addTask([&deck, &parts]() { parts.grid = EclipseGrid( deck, nullptr ); });
+        tasks.addTask([&deck, &parts]() { parts.nnc = NNC( parts.grid, deck ); }, {grid_task});
+
+        tasks.run(num_threads);
+        return parts;
+    }
+
+    EclipseState::EclipseState(const Deck& deck) :
+        EclipseState(deck, 1)
+    {}
+
+    EclipseState::EclipseState(const Deck& deck, std::size_t num_threads)
     try
-        : m_tables(            deck ),
+        : EclipseState(deck, buildIndependentParts(deck, num_threads))
+    {}
+    catch (const OpmInputError& opm_error) {
+        throw;
+    }
+    catch (const std::exception& std_error) {
+        OpmLog::error(fmt::format("An error occured while creating the reservoir properties\n",
+                                  "Internal error: {}", std_error.what()));
+        throw;
+    }
+
+    EclipseState::EclipseState(const Deck& deck, IndependentParts&& parts)
+        : m_tables(            std::move(parts.tables) ),
           m_runspec(           deck ),
           m_eclipseConfig(     deck ),
           m_deckUnitSystem(    deck.getActiveUnitSystem() ),
-          m_inputGrid(         deck, nullptr ),
-          m_inputNnc(          m_inputGrid, deck),
+          m_inputGrid(         std::move(parts.grid) ),
+          m_inputNnc(          std::move(parts.nnc) ),
           m_gridDims(          deck ),
           field_props(         deck, m_runspec.phases(), m_inputGrid, m_tables),
           m_simulationConfig(  m_eclipseConfig.getInitConfig().restartRequested(), deck, field_props),
@@ -81,14 +128,6 @@ namespace Ewoms {
         this->initFaults(deck);
         this->field_props.reset_actnum( this->m_inputGrid.getACTNUM() );
     }
-    catch (const OpmInputError& opm_error) {
-        throw;
-    }
-    catch (const std::exception& std_error) {
-        OpmLog::error(fmt::format("An error occured while creating the reservoir properties\n",
-                                  "Internal error: {}", std_error.what()));
-        throw;
-    }
 
     const UnitSystem& EclipseState::getDeckUnitSystem() const {
         return m_deckUnitSystem;
@@ -228,10 +267,9 @@ namespace Ewoms {
 
     void EclipseState::complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName) {
         OpmLog::error("The " + keywordName + " keyword must be unique in the deck. Ignoring all!");
-        auto keywords = deck.getKeywordList(keywordName);
-        for (size_t i = 0; i < keywords.size(); ++i) {
+        for (const auto& keyword : deck.keywords(keywordName)) {
             std::string msg = "Ambiguous keyword "+keywordName+" defined here";
-            OpmLog::error(Log::fileMessage(keywords[i]->location(), msg));
+            OpmLog::error(Log::fileMessage(keyword.location(), msg));
         }
     }
 
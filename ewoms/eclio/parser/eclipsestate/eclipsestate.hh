@@ -68,6 +68,12 @@ namespace Ewoms {
 
         EclipseState() = default;
         EclipseState(const Deck& deck);
+        /*
+          The tables and the grid only depend on the deck and not on each
+          other; with this constructor they are built concurrently using up to
+          num_threads threads.
+        */
+        EclipseState(const Deck& deck, std::size_t num_threads);
         virtual ~EclipseState() = default;
 
         const IOConfig& getIOConfig() const;
@@ -129,6 +135,10 @@ namespace Ewoms {
         }
 
     private:
+        struct IndependentParts;
+        EclipseState(const Deck& deck, IndependentParts&& parts);
+        static IndependentParts buildIndependentParts(const Deck& deck, std::size_t num_threads);
+
         void initIOConfigPostSchedule(const Deck& deck);
         void initTransMult();
         void initFaults(const Deck& deck);
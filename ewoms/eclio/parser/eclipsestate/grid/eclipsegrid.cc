@@ -1588,8 +1588,9 @@ std::vector<double> EclipseGrid::createDVector(const std::array<int,3>& dims, st
         std::vector<float> coord_f;
         coord_f.resize(m_coord.size());
 
+        const auto& lengthConversion = units.conversion(length);
         for (size_t n=0; n< m_coord.size(); n++){
-            coord_f[n] = static_cast<double>(units.from_si(length, m_coord[n]));
+            coord_f[n] = static_cast<float>(lengthConversion.from_si(m_coord[n]));
         }
 
         // create zcorn vector of floats with input units, converted from SI
@@ -1597,7 +1598,7 @@ std::vector<double> EclipseGrid::createDVector(const std::array<int,3>& dims, st
         zcorn_f.resize(m_zcorn.size());
 
         for (size_t n=0; n< m_zcorn.size(); n++){
-            zcorn_f[n] = static_cast<double>(units.from_si(length, m_zcorn[n]));
+            zcorn_f[n] = static_cast<float>(lengthConversion.from_si(m_zcorn[n]));
         }
 
         std::vector<float> mapaxes_f;
@@ -1749,9 +1750,8 @@ std::vector<double> EclipseGrid::createDVector(const std::array<int,3>& dims, st
         if ( !deck.hasKeyword<AQUNUM>() ) {
             return;
         }
-        const auto &aqunum_keywords = deck.getKeywordList<AQUNUM>();
-        for (const auto &keyword : aqunum_keywords) {
-            for (const auto &record : *keyword) {
+        for (const auto &keyword : deck.keywords<AQUNUM>()) {
+            for (const auto &record : keyword) {
                 const size_t i = record.getItem<AQUNUM::I>().get<int>(0) - 1;
                 const size_t j = record.getItem<AQUNUM::J>().get<int>(0) - 1;
                 const size_t k = record.getItem<AQUNUM::K>().get<int>(0) - 1;
@@ -60,6 +60,9 @@ namespace Ewoms {
           zcorn and or actnum have been adjustments.
         */
         EclipseGrid(const EclipseGrid& src) = default;
+        EclipseGrid(EclipseGrid&& src) = default;
+        EclipseGrid& operator=(const EclipseGrid& src) = default;
+        EclipseGrid& operator=(EclipseGrid&& src) = default;
         EclipseGrid(const EclipseGrid& src, const std::vector<int>& actnum);
         EclipseGrid(const EclipseGrid& src, const double* zcorn, const std::vector<int>& actnum);
 
@@ -44,13 +44,10 @@ namespace Ewoms {
 
     FaultCollection::FaultCollection(const GRIDSection& gridSection,
                                      const GridDims& grid) {
-        const auto& faultKeywords = gridSection.getKeywordList<ParserKeywords::FAULTS>();
+        for (const auto& faultsKeyword : gridSection.keywords<ParserKeywords::FAULTS>()) {
+            OpmLog::info(OpmInputError::format("\nLoading faults from {keyword} in {file} line {line}", faultsKeyword.location()));
 
-        for (auto keyword_iter = faultKeywords.begin(); keyword_iter != faultKeywords.end(); ++keyword_iter) {
-            const auto& faultsKeyword = *keyword_iter;
-            OpmLog::info(OpmInputError::format("\nLoading faults from {keyword} in {file} line {line}", faultsKeyword->location()));
-
-            for (auto iter = faultsKeyword->begin(); iter != faultsKeyword->end(); ++iter) {
+            for (auto iter = faultsKeyword.begin(); iter != faultsKeyword.end(); ++iter) {
                 const auto& faultRecord = *iter;
                 const std::string& faultName = faultRecord.getItem(0).get< std::string >(0);
 
@@ -22,6 +22,7 @@
 #include <ewoms/eclio/parser/eclipsestate/grid/box.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/keywords.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/fielddata.hh>
+#include <ewoms/eclio/parser/eclipsestate/grid/statusvector.hh>
 #include <ewoms/eclio/parser/deck/value_status.hh>
 
 #include <ewoms/common/optional.hh>
@@ -54,10 +55,10 @@ namespace Fieldprops
     template<typename T>
     struct FieldData {
         std::vector<T> data;
-        std::vector<value::status> value_status;
+        StatusVector value_status;
         keywords::keyword_info<T> kw_info;
         Ewoms::optional<std::vector<T>> global_data;
-        Ewoms::optional<std::vector<value::status>> global_value_status;
+        Ewoms::optional<StatusVector> global_value_status;
         mutable bool all_set;
 
         FieldData() = default;
@@ -70,7 +71,7 @@ namespace Fieldprops
         {
             if (global_size != 0) {
                 this->global_data = std::vector<T>(global_size);
-                this->global_value_status = std::vector<value::status>(global_size, value::status::uninitialized);
+                this->global_value_status = StatusVector(global_size, value::status::uninitialized);
             }
 
             if (info.scalar_init)
@@ -85,32 +86,31 @@ namespace Fieldprops
             if (this->all_set)
                 return true;
 
-            static const std::array<value::status,2> invalid_value = {value::status::uninitialized, value::status::empty_default};
-            const auto& it = std::find_first_of(this->value_status.begin(), this->value_status.end(), invalid_value.begin(), invalid_value.end());
-            this->all_set = (it == this->value_status.end());
+            this->all_set = this->value_status.allHaveValue();
 
             return this->all_set;
         }
 
         void compress(const std::vector<bool>& active_map) {
             Fieldprops::compress(this->data, active_map);
-            Fieldprops::compress(this->value_status, active_map);
+            this->value_status.compress(active_map);
         }
 
         void copy(const FieldData<T>& src, const std::vector<Box::cell_index>& index_list) {
             for (const auto& ci : index_list) {
                 this->data[ci.active_index] = src.data[ci.active_index];
-                this->value_status[ci.active_index] = src.value_status[ci.active_index];
+                this->value_status.set(ci.active_index, src.value_status[ci.active_index]);
             }
+            this->value_status.compact();
         }
 
         void default_assign(T value) {
             std::fill(this->data.begin(), this->data.end(), value);
-            std::fill(this->value_status.begin(), this->value_status.end(), value::status::valid_default);
+            this->value_status.fill(value::status::valid_default);
 
             if (this->global_data) {
                 std::fill(this->global_data->begin(), this->global_data->end(), value);
-                std::fill(this->global_value_status->begin(), this->global_value_status->end(), value::status::valid_default);
+                this->global_value_status->fill(value::status::valid_default);
             }
         }
 
@@ -119,24 +119,30 @@ namespace Fieldprops
                 throw std::invalid_argument("Size mismatch got: " + std::to_string(src.size()) + " expected: " + std::to_string(this->size()));
 
             std::copy(src.begin(), src.end(), this->data.begin());
-            std::fill(this->value_status.begin(), this->value_status.end(), value::status::valid_default);
+            this->value_status.fill(value::status::valid_default);
         }
 
         void default_update(const std::vector<T>& src) {
             if (src.size() != this->size())
                 throw std::invalid_argument("Size mismatch got: " + std::to_string(src.size()) + " expected: " + std::to_string(this->size()));
 
+            if (this->value_status.all(value::status::uninitialized)) {
+                this->default_assign(src);
+                return;
+            }
+
             for (std::size_t i = 0; i < src.size(); i++) {
                 if (!value::has_value(this->value_status[i])) {
-                    this->value_status[i] = value::status::valid_default;
+                    this->value_status.set(i, value::status::valid_default);
                     this->data[i] = src[i];
                 }
             }
+            this->value_status.compact();
         }
 
         void update(std::size_t index, T value, value::status status) {
             this->data[index] = value;
-            this->value_status[index] = status;
+            this->value_status.set(index, status);
         }
 
     };
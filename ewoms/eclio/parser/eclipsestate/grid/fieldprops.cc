@@ -177,10 +177,11 @@ void assign_deck(const Fieldprops::keywords::keyword_info<T>& kw_info, const Dec
         if (value::has_value(deck_status[data_index])) {
             if (deck_status[data_index] == value::status::deck_value || field_data.value_status[active_index] == value::status::uninitialized) {
                 field_data.data[active_index] = deck_data[data_index];
-                field_data.value_status[active_index] = deck_status[data_index];
+                field_data.value_status.set(active_index, deck_status[data_index]);
             }
         }
     }
+    field_data.value_status.compact();
 
     if (kw_info.global) {
         auto& global_data = field_data.global_data.value();
@@ -190,9 +191,10 @@ void assign_deck(const Fieldprops::keywords::keyword_info<T>& kw_info, const Dec
         for (const auto& cell : index_list) {
             if (deck_status[cell.data_index] == value::status::deck_value || global_status[cell.global_index] == value::status::uninitialized) {
                 global_data[cell.global_index] = deck_data[cell.data_index];
-                global_status[cell.global_index] = deck_status[cell.data_index];
+                global_status.set(cell.global_index, deck_status[cell.data_index]);
             }
         }
+        global_status.compact();
     }
 }
 
@@ -205,9 +207,10 @@ void multiply_deck(const Fieldprops::keywords::keyword_info<T>& kw_info, const D
 
         if (value::has_value(deck_status[data_index]) && value::has_value(field_data.value_status[active_index])) {
             field_data.data[active_index] *= deck_data[data_index];
-            field_data.value_status[active_index] = deck_status[data_index];
+            field_data.value_status.set(active_index, deck_status[data_index]);
         }
     }
+    field_data.value_status.compact();
 
     if (kw_info.global) {
         auto& global_data = field_data.global_data.value();
@@ -217,22 +220,31 @@ void multiply_deck(const Fieldprops::keywords::keyword_info<T>& kw_info, const D
         for (const auto& cell : index_list) {
             if (deck_status[cell.data_index] == value::status::deck_value || global_status[cell.global_index] == value::status::uninitialized) {
                 global_data[cell.global_index] *= deck_data[cell.data_index];
-                global_status[cell.global_index] = deck_status[cell.data_index];
+                global_status.set(cell.global_index, deck_status[cell.data_index]);
             }
         }
+        global_status.compact();
     }
 }
 
 template <typename T>
-void assign_scalar(std::vector<T>& data, std::vector<value::status>& value_status, T value, const std::vector<Box::cell_index>& index_list) {
-    for (const auto& cell_index : index_list) {
+void assign_scalar(std::vector<T>& data, Fieldprops::StatusVector& value_status, T value, const std::vector<Box::cell_index>& index_list) {
+    for (const auto& cell_index : index_list)
         data[cell_index.active_index] = value;
-        value_status[cell_index.active_index] = value::status::deck_value;
+
+    // The cells of a box are distinct, i.e. a box of the same size as the
+    // property covers all of it.
+    if (index_list.size() == value_status.size())
+        value_status.fill(value::status::deck_value);
+    else {
+        for (const auto& cell_index : index_list)
+            value_status.set(cell_index.active_index, value::status::deck_value);
+        value_status.compact();
     }
 }
 
 template <typename T>
-void multiply_scalar(std::vector<T>& data, std::vector<value::status>& value_status, T value, const std::vector<Box::cell_index>& index_list) {
+void multiply_scalar(std::vector<T>& data, const Fieldprops::StatusVector& value_status, T value, const std::vector<Box::cell_index>& index_list) {
     for (const auto& cell_index : index_list) {
         if (value::has_value(value_status[cell_index.active_index]))
             data[cell_index.active_index] *= value;
@@ -240,7 +252,7 @@ void multiply_scalar(std::vector<T>& data, std::vector<value::status>& value_sta
 }
 
 template <typename T>
-void add_scalar(std::vector<T>& data, std::vector<value::status>& value_status, T value, const std::vector<Box::cell_index>& index_list) {
+void add_scalar(std::vector<T>& data, const Fieldprops::StatusVector& value_status, T value, const std::vector<Box::cell_index>& index_list) {
     for (const auto& cell_index : index_list) {
         if (value::has_value(value_status[cell_index.active_index]))
             data[cell_index.active_index] += value;
@@ -248,7 +260,7 @@ void add_scalar(std::vector<T>& data, std::vector<value::status>& value_status,
 }
 
 template <typename T>
-void min_value(std::vector<T>& data, std::vector<value::status>& value_status, T min_value, const std::vector<Box::cell_index>& index_list) {
+void min_value(std::vector<T>& data, const Fieldprops::StatusVector& value_status, T min_value, const std::vector<Box::cell_index>& index_list) {
     for (const auto& cell_index : index_list) {
         if (value::has_value(value_status[cell_index.active_index])) {
             T value = data[cell_index.active_index];
@@ -258,7 +270,7 @@ void min_value(std::vector<T>& data, std::vector<value::status>& value_status, T
 }
 
 template <typename T>
-void max_value(std::vector<T>& data, std::vector<value::status>& value_status, T max_value, const std::vector<Box::cell_index>& index_list) {
+void max_value(std::vector<T>& data, const Fieldprops::StatusVector& value_status, T max_value, const std::vector<Box::cell_index>& index_list) {
     for (const auto& cell_index : index_list) {
         if (value::has_value(value_status[cell_index.active_index])) {
             T value = data[cell_index.active_index];
@@ -421,7 +433,7 @@ void FieldProps::distribute_toplayer(Fieldprops::FieldData<double>& field_data,
     for (const auto& cell_index : box.index_list()) {
         if (cell_index.global_index < layer_size) {
             toplayer.data[cell_index.global_index] = deck_data[cell_index.data_index];
-            toplayer.value_status[cell_index.global_index] = value::status::deck_value;
+            toplayer.value_status.set(cell_index.global_index, value::status::deck_value);
         }
     }
 
@@ -435,7 +447,7 @@ void FieldProps::distribute_toplayer(Fieldprops::FieldData<double>& field_data,
                         std::size_t layer_index = i + j*this->nx;
                         if (toplayer.value_status[layer_index] == value::status::deck_value) {
                             field_data.data[active_index] = toplayer.data[layer_index];
-                            field_data.value_status[active_index] = value::status::valid_default;
+                            field_data.value_status.set(active_index, value::status::valid_default);
                         }
                     }
                     active_index += 1;
@@ -443,6 +455,7 @@ void FieldProps::distribute_toplayer(Fieldprops::FieldData<double>& field_data,
             }
         }
     }
+    field_data.value_status.compact();
 }
 
 template <>
@@ -669,7 +682,7 @@ void FieldProps::handle_double_keyword(Section section, const Fieldprops::keywor
 }
 
 template <typename T>
-void FieldProps::apply(Fieldprops::ScalarOperation op, std::vector<T>& data, std::vector<value::status>& value_status, T scalar_value, const std::vector<Box::cell_index>& index_list) {
+void FieldProps::apply(Fieldprops::ScalarOperation op, std::vector<T>& data, Fieldprops::StatusVector& value_status, T scalar_value, const std::vector<Box::cell_index>& index_list) {
     if (op == Fieldprops::ScalarOperation::EQUAL)
         assign_scalar(data, value_status, scalar_value, index_list);
 
@@ -719,7 +732,7 @@ void FieldProps::operate(const DeckRecord& record, Fieldprops::FieldData<T>& tar
         if (value::has_value(src_data.value_status[cell_index.active_index])) {
             if ((check_target == false) || (value::has_value(target_data.value_status[cell_index.active_index]))) {
                 target_data.data[cell_index.active_index]         = func(target_data.data[cell_index.active_index], src_data.data[cell_index.active_index]);
-                target_data.value_status[cell_index.active_index] = src_data.value_status[cell_index.active_index];
+                target_data.value_status.set(cell_index.active_index, src_data.value_status[cell_index.active_index]);
             } else
                 throw std::invalid_argument("Tried to use unset property value in OPERATE/OPERATER keyword");
         } else
@@ -929,9 +942,10 @@ void FieldProps::init_porv(Fieldprops::FieldData<double>& porv) {
     for (std::size_t active_index = 0; active_index < this->active_size; active_index++) {
         if (value::has_value(poro_status[active_index])) {
             porv_data[active_index] = this->cell_volume[active_index] * poro_data[active_index];
-            porv_status[active_index] = value::status::valid_default;
+            porv_status.set(active_index, value::status::valid_default);
         }
     }
+    porv_status.compact();
 
     if (this->has<double>("NTG")) {
         const auto& ntg = this->get<double>("NTG");
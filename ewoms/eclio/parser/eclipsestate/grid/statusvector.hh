@@ -0,0 +1,193 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_FIELDPROPS_STATUS_VECTOR_H
+#define EWOMS_FIELDPROPS_STATUS_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <ewoms/eclio/parser/deck/value_status.hh>
+
+namespace Ewoms
+{
+namespace Fieldprops
+{
+
+/*
+  Compact storage of the value::status of every cell of a property. As long
+  as all the cells have the same status - which is by far the most common
+  situation - only that status is stored. Otherwise the statuses are packed
+  with two bits per cell, 32 cells in every 64 bit word.
+
+  The encoding of value::status is such that the low bit is set for the two
+  statuses where value::has_value() is true, i.e. a property is completely
+  valid if the low bit of all cells is set.
+*/
+class StatusVector {
+public:
+    StatusVector() = default;
+
+    StatusVector(std::size_t size, value::status status) :
+        m_size(size),
+        m_uniform(status)
+    {}
+
+    std::size_t size() const {
+        return this->m_size;
+    }
+
+    value::status operator[](std::size_t index) const {
+        if (this->m_words.empty())
+            return this->m_uniform;
+
+        return static_cast<value::status>((this->m_words[index / cells_per_word] >> shift(index)) & status_mask);
+    }
+
+    void set(std::size_t index, value::status status) {
+        if (this->m_words.empty()) {
+            if (status == this->m_uniform)
+                return;
+
+            this->m_words.assign((this->m_size + cells_per_word - 1) / cells_per_word, pattern(this->m_uniform));
+        }
+
+        auto& word = this->m_words[index / cells_per_word];
+        word = (word & ~(status_mask << shift(index))) | (static_cast<std::uint64_t>(status) << shift(index));
+    }
+
+    void fill(value::status status) {
+        this->m_words.clear();
+        this->m_words.shrink_to_fit();
+        this->m_uniform = status;
+    }
+
+    bool uniform() const {
+        return this->m_words.empty();
+    }
+
+    // True if all cells have the given status.
+    bool all(value::status status) const {
+        if (this->m_words.empty())
+            return this->m_uniform == status || this->m_size == 0;
+
+        return this->allMatch(pattern(status), ~std::uint64_t{0});
+    }
+
+    // True if value::has_value() is true for all cells.
+    bool allHaveValue() const {
+        if (this->m_words.empty())
+            return value::has_value(this->m_uniform) || this->m_size == 0;
+
+        return this->allMatch(low_bits, low_bits);
+    }
+
+    /*
+      Go back to uniform storage if all cells have the same status; should
+      be called after operations which have updated many cells.
+    */
+    void compact() {
+        if (this->m_words.empty() || this->m_size == 0)
+            return;
+
+        const auto first = (*this)[0];
+        if (this->all(first))
+            this->fill(first);
+    }
+
+    void compress(const std::vector<bool>& active_map) {
+        std::size_t new_size = 0;
+        for (const auto active : active_map)
+            new_size += active;
+
+        if (!this->m_words.empty()) {
+            StatusVector compressed(new_size, this->m_uniform);
+            std::size_t new_index = 0;
+            for (std::size_t g = 0; g < active_map.size(); g++) {
+                if (active_map[g])
+                    compressed.set(new_index++, (*this)[g]);
+            }
+            compressed.compact();
+            *this = std::move(compressed);
+        }
+
+        this->m_size = new_size;
+    }
+
+    std::vector<value::status> data() const {
+        std::vector<value::status> result(this->m_size, this->m_uniform);
+        if (!this->m_words.empty()) {
+            for (std::size_t index = 0; index < this->m_size; index++)
+                result[index] = (*this)[index];
+        }
+        return result;
+    }
+
+    bool operator==(const StatusVector& other) const {
+        if (this->m_size != other.m_size)
+            return false;
+
+        for (std::size_t index = 0; index < this->m_size; index++) {
+            if ((*this)[index] != other[index])
+                return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr std::size_t cells_per_word = 32;
+    static constexpr std::uint64_t status_mask = 3;
+    static constexpr std::uint64_t low_bits = 0x5555555555555555ULL;
+
+    static std::size_t shift(std::size_t index) {
+        return 2 * (index % cells_per_word);
+    }
+
+    static std::uint64_t pattern(value::status status) {
+        return low_bits * static_cast<std::uint64_t>(status);
+    }
+
+    // Compare the bits in mask of all words with expected; the unused
+    // cells of the last word are ignored.
+    bool allMatch(std::uint64_t expected, std::uint64_t mask) const {
+        const std::size_t full_words = this->m_size / cells_per_word;
+        for (std::size_t w = 0; w < full_words; w++) {
+            if ((this->m_words[w] & mask) != (expected & mask))
+                return false;
+        }
+
+        const std::size_t tail = this->m_size % cells_per_word;
+        if (tail > 0) {
+            const std::uint64_t tail_mask = mask & ((std::uint64_t{1} << (2 * tail)) - 1);
+            if ((this->m_words[full_words] & tail_mask) != (expected & tail_mask))
+                return false;
+        }
+        return true;
+    }
+
+    std::size_t m_size = 0;
+    value::status m_uniform = value::status::uninitialized;
+    std::vector<std::uint64_t> m_words;
+};
+
+} // end namespace Fieldprops
+} // end namespace Ewoms
+
+#endif
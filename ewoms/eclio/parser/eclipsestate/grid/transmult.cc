@@ -18,7 +18,9 @@
 */
 #include "config.h"
 
+#include <algorithm>
 #include <stdexcept>
+#include <utility>
 
 #include <ewoms/common/fmt/format.h>
 
@@ -39,6 +41,60 @@
 
 namespace Ewoms {
 
+namespace {
+
+    constexpr std::array<FaceDir::DirEnum, TransMult::numDirections> directions {{
+        FaceDir::XPlus, FaceDir::XMinus,
+        FaceDir::YPlus, FaceDir::YMinus,
+        FaceDir::ZPlus, FaceDir::ZMinus
+    }};
+
+    std::size_t directionSlot(FaceDir::DirEnum faceDir) {
+        switch (faceDir) {
+        case FaceDir::XPlus:  return 0;
+        case FaceDir::XMinus: return 1;
+        case FaceDir::YPlus:  return 2;
+        case FaceDir::YMinus: return 3;
+        case FaceDir::ZPlus:  return 4;
+        case FaceDir::ZMinus: return 5;
+        }
+
+        throw std::invalid_argument("Invalid face direction " + std::to_string(static_cast<int>(faceDir)));
+    }
+
+}
+
+    TransMult::FaultFaceIndex::FaultFaceIndex(const FaultCollection& faultCollection)
+        : numFaults(faultCollection.size())
+    {
+        std::array<std::vector<std::pair<std::size_t, std::size_t>>, numDirections> entries;
+        for (size_t faultIndex = 0; faultIndex < faultCollection.size(); faultIndex++) {
+            for (const auto& face : faultCollection.getFault(faultIndex)) {
+                auto& slot = entries[directionSlot(face.getDir())];
+                for (auto globalIndex : face)
+                    slot.emplace_back(globalIndex, faultIndex);
+            }
+        }
+
+        for (std::size_t d = 0; d < numDirections; ++d) {
+            auto& slot = entries[d];
+
+            // Stable, so that the multipliers of a cell on several faults
+            // are applied in the same order as fault by fault.
+            std::stable_sort(slot.begin(), slot.end(),
+                             [](const std::pair<std::size_t, std::size_t>& a,
+                                const std::pair<std::size_t, std::size_t>& b)
+                             { return a.first < b.first; });
+
+            this->cells[d].reserve(slot.size());
+            this->faults[d].reserve(slot.size());
+            for (const auto& entry : slot) {
+                this->cells[d].push_back(entry.first);
+                this->faults[d].push_back(entry.second);
+            }
+        }
+    }
+
    TransMult::TransMult(const GridDims& dims, const Deck& deck, const FieldPropsManager& fp) :
         m_nx( dims.getNX()),
         m_ny( dims.getNY()),
@@ -67,7 +123,7 @@ namespace Ewoms {
         result.m_nx = 1;
         result.m_ny = 2;
         result.m_nz = 3;
-        result.m_trans = {{FaceDir::YPlus, {4.0, 5.0}}};
+        result.m_trans[directionSlot(FaceDir::YPlus)] = {4.0, 5.0};
         result.m_names = {{FaceDir::ZPlus, "test1"}};
         result.m_multregtScanner = MULTREGTScanner::serializeObject();
 
@@ -92,10 +148,10 @@ namespace Ewoms {
     }
 
     double TransMult::getMultiplier__(size_t globalIndex,  FaceDir::DirEnum faceDir) const {
-        if (hasDirectionProperty( faceDir )) {
-            const auto& data = m_trans.at(faceDir);
+        const auto& data = m_trans[directionSlot(faceDir)];
+        if (!data.empty())
             return data[globalIndex];
-        } else
+        else
             return 1.0;
     }
 
@@ -109,23 +165,45 @@ namespace Ewoms {
     }
 
     bool TransMult::hasDirectionProperty(FaceDir::DirEnum faceDir) const {
-        return m_trans.count(faceDir) == 1;
+        return !m_trans[directionSlot(faceDir)].empty();
     }
 
     std::vector<double>& TransMult::getDirectionProperty(FaceDir::DirEnum faceDir) {
-        if (m_trans.count(faceDir) == 0) {
+        auto& data = m_trans[directionSlot(faceDir)];
+        if (data.empty()) {
             std::size_t global_size = this->m_nx * this->m_ny * this->m_nz;
-            m_trans[faceDir] = std::vector<double>(global_size, 1);
+            data.assign(global_size, 1);
         }
 
-        return m_trans.at( faceDir );
+        return data;
+    }
+
+    std::map<FaceDir::DirEnum, std::vector<double>> TransMult::directionMap() const {
+        std::map<FaceDir::DirEnum, std::vector<double>> trans;
+        for (std::size_t d = 0; d < numDirections; ++d) {
+            if (!m_trans[d].empty())
+                trans.emplace(directions[d], m_trans[d]);
+        }
+
+        return trans;
+    }
+
+    void TransMult::setDirections(const std::map<FaceDir::DirEnum, std::vector<double>>& trans) {
+        for (auto& data : m_trans)
+            data.clear();
+
+        for (const auto& entry : trans)
+            m_trans[directionSlot(entry.first)] = entry.second;
     }
 
     void TransMult::applyMULT(const std::vector<double>& srcData, FaceDir::DirEnum faceDir)
     {
         auto& dstProp = this->getDirectionProperty(faceDir);
-        for (size_t i = 0; i < srcData.size(); ++i)
-            dstProp[i] *= srcData[i];
+        if (srcData.size() > dstProp.size())
+            throw std::invalid_argument("Transmissibility multiplier array is larger than the grid");
+
+        std::transform(srcData.begin(), srcData.end(), dstProp.begin(), dstProp.begin(),
+                       [](const double src, const double dst) { return dst * src; });
     }
 
     void TransMult::applyMULTFLT(const Fault& fault) {
@@ -141,9 +219,26 @@ namespace Ewoms {
     }
 
     void TransMult::applyMULTFLT(const FaultCollection& faults) {
-        for (size_t faultIndex = 0; faultIndex < faults.size(); faultIndex++) {
-            auto& fault = faults.getFault(faultIndex);
-            this->applyMULTFLT(fault);
+        this->applyMULTFLT(FaultFaceIndex(faults), faults);
+    }
+
+    void TransMult::applyMULTFLT(const FaultFaceIndex& faces, const FaultCollection& faults) {
+        if (faces.numFaults != faults.size())
+            throw std::invalid_argument("Fault face index was built for a different fault collection");
+
+        std::vector<double> faultMult(faults.size());
+        for (size_t faultIndex = 0; faultIndex < faults.size(); faultIndex++)
+            faultMult[faultIndex] = faults.getFault(faultIndex).getTransMult();
+
+        for (std::size_t d = 0; d < numDirections; ++d) {
+            const auto& cells = faces.cells[d];
+            if (cells.empty())
+                continue;
+
+            const auto& faultIndex = faces.faults[d];
+            auto& multProperty = this->getDirectionProperty(directions[d]);
+            for (std::size_t n = 0; n < cells.size(); ++n)
+                multProperty[cells[n]] *= faultMult[faultIndex[n]];
         }
     }
 
@@ -28,9 +28,12 @@
 #ifndef EWOMS_PARSER_TRANSMULT_H
 #define EWOMS_PARSER_TRANSMULT_H
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <ewoms/eclio/parser/eclipsestate/grid/facedir.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/multregtscanner.hh>
@@ -45,6 +48,25 @@ namespace Ewoms {
     class TransMult {
 
     public:
+        /// Number of face directions, i.e. of direction slots.
+        static constexpr std::size_t numDirections = 6;
+
+        /**
+           The faces of all faults in a collection, grouped by direction.
+           For every direction the cells are sorted, and faults[n] is the
+           index in the collection of the fault cells[n] belongs to.  A
+           cell which is on several faults appears once per fault, in the
+           order of the faults.
+        */
+        struct FaultFaceIndex {
+            FaultFaceIndex() = default;
+            explicit FaultFaceIndex(const FaultCollection& faultCollection);
+
+            std::size_t numFaults = 0;
+            std::array<std::vector<std::size_t>, numDirections> cells;
+            std::array<std::vector<std::size_t>, numDirections> faults;
+        };
+
         TransMult() = default;
         TransMult(const GridDims& dims, const Deck& deck, const FieldPropsManager& fp);
 
@@ -55,6 +77,7 @@ namespace Ewoms {
         double getRegionMultiplier( size_t globalCellIndex1, size_t globalCellIndex2, FaceDir::DirEnum faceDir) const;
         void applyMULT(const std::vector<double>& srcMultProp, FaceDir::DirEnum faceDir);
         void applyMULTFLT(const FaultCollection& faults);
+        void applyMULTFLT(const FaultFaceIndex& faces, const FaultCollection& faults);
         void applyMULTFLT(const Fault& fault);
 
         bool operator==(const TransMult& data) const;
@@ -66,7 +89,12 @@ namespace Ewoms {
             serializer(m_ny);
             serializer(m_nz);
             // map used to avoid explicit instances with FaceDir::DirEnum in serializer
-            serializer.template map<decltype(m_trans),false>(m_trans);
+            std::map<FaceDir::DirEnum, std::vector<double>> trans;
+            if (serializer.isSerializing())
+                trans = this->directionMap();
+            serializer.template map<decltype(trans),false>(trans);
+            if (!serializer.isSerializing())
+                this->setDirections(trans);
             serializer.template map<decltype(m_names),false>(m_names);
             m_multregtScanner.serializeOp(serializer);
         }
@@ -77,9 +105,12 @@ namespace Ewoms {
         double getMultiplier__(size_t globalIndex , FaceDir::DirEnum faceDir) const;
         bool hasDirectionProperty(FaceDir::DirEnum faceDir) const;
         std::vector<double>& getDirectionProperty(FaceDir::DirEnum faceDir);
+        std::map<FaceDir::DirEnum, std::vector<double>> directionMap() const;
+        void setDirections(const std::map<FaceDir::DirEnum, std::vector<double>>& trans);
 
         size_t m_nx = 0, m_ny = 0, m_nz = 0;
-        std::map<FaceDir::DirEnum , std::vector<double> > m_trans;
+        // One slot per direction, an empty slot means all multipliers are one.
+        std::array<std::vector<double>, numDirections> m_trans;
         std::map<FaceDir::DirEnum , std::string> m_names;
         MULTREGTScanner m_multregtScanner;
     };
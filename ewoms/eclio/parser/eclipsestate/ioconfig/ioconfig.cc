@@ -100,6 +100,7 @@ namespace Ewoms {
         result.m_nosim = true;
         result.m_base_name = "test3";
         result.ecl_compatible_rst = false;
+        result.compressed_output = true;
 
         return result;
     }
@@ -174,6 +175,14 @@ namespace Ewoms {
         this->ecl_compatible_rst = ecl_rst;
     }
 
+    bool IOConfig::getCompressedOutput() const {
+        return this->compressed_output;
+    }
+
+    void IOConfig::setCompressedOutput(bool compressed) {
+        this->compressed_output = compressed;
+    }
+
     void IOConfig::overrideNOSIM(bool nosim) {
         m_nosim = nosim;
     }
@@ -278,7 +287,8 @@ namespace Ewoms {
                this->getOutputDir() == data.getOutputDir() &&
                this->initOnly() == data.initOnly() &&
                this->getBaseName() == data.getBaseName() &&
-               this->getEclCompatibleRST() == data.getEclCompatibleRST();
+               this->getEclCompatibleRST() == data.getEclCompatibleRST() &&
+               this->getCompressedOutput() == data.getCompressedOutput();
     }
 
     /*****************************************************************/
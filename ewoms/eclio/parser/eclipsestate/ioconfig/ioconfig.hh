@@ -144,6 +144,11 @@ namespace Ewoms {
 
         void setEclCompatibleRST(bool ecl_rst);
         bool getEclCompatibleRST() const;
+
+        /// Write binary restart and summary data files as block
+        /// compressed files, see ewoms/eclio/io/eclcompress.hh.
+        void setCompressedOutput(bool compressed);
+        bool getCompressedOutput() const;
         bool getWriteEGRIDFile() const;
         bool getWriteINITFile() const;
         bool getUNIFOUT() const;
@@ -189,6 +194,7 @@ namespace Ewoms {
             serializer(m_nosim);
             serializer(m_base_name);
             serializer(ecl_compatible_rst);
+            serializer(compressed_output);
         }
 
     private:
@@ -204,6 +210,7 @@ namespace Ewoms {
         bool            m_nosim;
         std::string     m_base_name;
         bool            ecl_compatible_rst = true;
+        bool            compressed_output = false;
 
         IOConfig( const GRIDSection&,
                   const RUNSPECSection&,
@@ -18,11 +18,10 @@
 */
 #include "config.h"
 
-#include <fnmatch.h>
-
 #include <ewoms/eclio/parser/eclipsestate/schedule/action/actioncontext.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/action/actionvalue.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/action/astnode.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlist.hh>
 
 #include <stdexcept>
@@ -115,13 +114,9 @@ Action::Value ASTNode::value(const Action::Context& context) const {
             if (well_arg[0] == '*' && well_arg.size() > 1) {
                 const auto& wlm = context.wlist_manager();
                 wnames = wlm.wells(well_arg);
-            } else {
-                int fnmatch_flags = 0;
-                for (const auto& well : context.wells(this->func)) {
-                    if (fnmatch(well_arg.c_str(), well.c_str(), fnmatch_flags) == 0)
-                        wnames.push_back(well);
-                }
-            }
+            } else
+                wnames = NamePattern(well_arg).filter(context.wells(this->func));
+
             for (const auto& wname : wnames)
                 well_values.add_well(wname, context.get(this->func, wname));
 
@@ -71,6 +71,29 @@ std::vector<const GTNode*> GTNode::all_nodes() const {
     return nodes;
 }
 
+TreeTopology GTNode::topology() const {
+    std::vector<std::string> names;
+    std::vector<std::pair<std::string, std::string>> edges;
+
+    std::vector<const GTNode*> stack { this };
+    while (!stack.empty()) {
+        const auto* node = stack.back();
+        stack.pop_back();
+
+        names.push_back(node->name());
+        for (const auto& well : node->wells())
+            edges.emplace_back(node->name(), well.name());
+
+        for (const auto& child : node->groups())
+            edges.emplace_back(node->name(), child.name());
+
+        for (auto child = node->groups().rbegin(); child != node->groups().rend(); ++child)
+            stack.push_back(&*child);
+    }
+
+    return { names, edges };
+}
+
 std::size_t GTNode::level() const {
     return this->m_level;
 }
@@ -21,6 +21,7 @@
 #include <ewoms/common/optional.hh>
 
 #include <ewoms/eclio/parser/eclipsestate/schedule/group/group.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/treetopology.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/well.hh>
 
 #ifndef GROUPTREE2
@@ -43,6 +44,13 @@ public:
     const Group& group() const;
     std::size_t level() const;
     std::vector<const GTNode*> all_nodes() const;
+
+    /*
+      Compiled tree of this node and all groups and wells below it. The
+      groups get the first ids, in depth first order, followed by the
+      wells.
+    */
+    TreeTopology topology() const;
 private:
     const Group m_group;
     std::size_t m_level;
@@ -24,7 +24,6 @@
 #include <ewoms/eclio/parser/units/units.hh>
 
 #include <algorithm>
-#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -77,16 +76,29 @@ double GuideRate::get(const std::string& group, Group::GuideRateTarget target, c
 }
 
 double GuideRate::get(const std::string& name, GuideRateModel::Target model_target, const RateVector& rates) const
+{
+    const auto index = this->find_index(name);
+    if (index == TreeTopology::npos) {
+        throw std::out_of_range("No guide rate or potentials for: " + name);
+    }
+
+    return this->get(index, model_target, rates);
+}
+
+double GuideRate::get(std::size_t index, GuideRateModel::Target model_target, const RateVector& rates) const
 {
     using namespace unit;
     using prefix::micro;
 
-    auto iter = this->values.find(name);
-    if (iter == this->values.end()) {
-        return this->potentials.at(name).eval(model_target);
+    if (! this->has_value[index]) {
+        if (! this->has_potential[index]) {
+            throw std::out_of_range("No guide rate or potentials for: " + this->names[index]);
+        }
+
+        return this->potentials[index].eval(model_target);
     }
 
-    const auto& value = *iter->second;
+    const auto& value = this->values[index];
     const auto grvalue = this->get_grvalue_result(value);
     if (value.curr.target == model_target) {
         return grvalue;
@@ -105,7 +117,48 @@ double GuideRate::get(const std::string& name, GuideRateModel::Target model_targ
 
 bool GuideRate::has(const std::string& name) const
 {
-    return this->values.count(name) > 0;
+    const auto index = this->find_index(name);
+    return (index != TreeTopology::npos) && this->has(index);
+}
+
+bool GuideRate::has(std::size_t index) const
+{
+    return this->has_value[index];
+}
+
+std::size_t GuideRate::index(const std::string& wgname)
+{
+    const auto result = this->indices.emplace(wgname, this->names.size());
+    if (result.second) {
+        this->names.push_back(wgname);
+        this->values.emplace_back();
+        this->potentials.emplace_back();
+        this->has_value.push_back(false);
+        this->has_potential.push_back(false);
+    }
+
+    return result.first->second;
+}
+
+std::vector<std::size_t> GuideRate::index(const TreeTopology& tree)
+{
+    std::vector<std::size_t> tree_index(tree.size());
+    for (std::size_t node = 0; node < tree.size(); ++node) {
+        tree_index[node] = this->index(tree.name(node));
+    }
+
+    return tree_index;
+}
+
+const std::string& GuideRate::name(std::size_t index) const
+{
+    return this->names[index];
+}
+
+std::size_t GuideRate::find_index(const std::string& name) const
+{
+    const auto iter = this->indices.find(name);
+    return (iter == this->indices.end()) ? TreeTopology::npos : iter->second;
 }
 
 void GuideRate::compute(const std::string& wgname,
@@ -115,39 +168,48 @@ void GuideRate::compute(const std::string& wgname,
                         double             gas_pot,
                         double             wat_pot)
 {
-    this->potentials[wgname] = RateVector{oil_pot, gas_pot, wat_pot};
+    this->compute(this->index(wgname), report_step, sim_time, oil_pot, gas_pot, wat_pot);
+}
+
+void GuideRate::compute(std::size_t index,
+                        size_t      report_step,
+                        double      sim_time,
+                        double      oil_pot,
+                        double      gas_pot,
+                        double      wat_pot)
+{
+    this->potentials[index] = RateVector{oil_pot, gas_pot, wat_pot};
+    this->has_potential[index] = true;
 
     const auto& config = this->schedule.guideRateConfig(report_step);
-    if (config.has_group(wgname)) {
-        this->group_compute(wgname, report_step, sim_time, oil_pot, gas_pot, wat_pot);
+    if (config.has_group(this->names[index])) {
+        this->group_compute(index, report_step, sim_time, oil_pot, gas_pot, wat_pot);
     }
     else {
-        this->well_compute(wgname, report_step, sim_time, oil_pot, gas_pot, wat_pot);
+        this->well_compute(index, report_step, sim_time, oil_pot, gas_pot, wat_pot);
     }
 }
 
-void GuideRate::group_compute(const std::string& wgname,
-                              size_t             report_step,
-                              double             sim_time,
-                              double             oil_pot,
-                              double             gas_pot,
-                              double             wat_pot)
+void GuideRate::group_compute(std::size_t index,
+                              size_t      report_step,
+                              double      sim_time,
+                              double      oil_pot,
+                              double      gas_pot,
+                              double      wat_pot)
 {
     const auto& config = this->schedule.guideRateConfig(report_step);
-    const auto& group = config.group(wgname);
+    const auto& group = config.group(this->names[index]);
 
     if (group.guide_rate > 0.0) {
         auto model_target = GuideRateModel::convert_target(group.target);
 
         const auto& model = config.has_model() ? config.model() : GuideRateModel{};
-        this->assign_grvalue(wgname, model, { sim_time, group.guide_rate, model_target });
+        this->assign_grvalue(index, model, { sim_time, group.guide_rate, model_target });
     }
     else {
-        auto iter = this->values.find(wgname);
-
         // If the FORM mode is used we check if the last computation is
         // recent enough; then we just return.
-        if (iter != this->values.end()) {
+        if (this->has_value[index]) {
             if (group.target == Group::GuideRateTarget::FORM) {
                 if (! config.has_model()) {
                     throw std::logic_error {
@@ -156,7 +218,7 @@ void GuideRate::group_compute(const std::string& wgname,
                     };
                 }
 
-                const auto& grv = iter->second->curr;
+                const auto& grv = this->values[index].curr;
                 const auto time_diff = sim_time - grv.sim_time;
                 if (config.model().update_delay() > time_diff) {
                     return;
@@ -181,19 +243,20 @@ void GuideRate::group_compute(const std::string& wgname,
             }
 
             const auto guide_rate = this->eval_form(config.model(), oil_pot, gas_pot, wat_pot);
-            this->assign_grvalue(wgname, config.model(), { sim_time, guide_rate, config.model().target() });
+            this->assign_grvalue(index, config.model(), { sim_time, guide_rate, config.model().target() });
         }
     }
 }
 
-void GuideRate::well_compute(const std::string& wgname,
-                             size_t             report_step,
-                             double             sim_time,
-                             double             oil_pot,
-                             double             gas_pot,
-                             double             wat_pot)
+void GuideRate::well_compute(std::size_t index,
+                             size_t      report_step,
+                             double      sim_time,
+                             double      oil_pot,
+                             double      gas_pot,
+                             double      wat_pot)
 {
     const auto& config = this->schedule.guideRateConfig(report_step);
+    const auto& wgname = this->names[index];
 
     // guide rates spesified with WGRUPCON
     if (config.has_well(wgname)) {
@@ -202,7 +265,7 @@ void GuideRate::well_compute(const std::string& wgname,
             auto model_target = GuideRateModel::convert_target(well.target);
 
             const auto& model = config.has_model() ? config.model() : GuideRateModel{};
-            this->assign_grvalue(wgname, model, { sim_time, well.guide_rate, model_target });
+            this->assign_grvalue(index, model, { sim_time, well.guide_rate, model_target });
         }
     }
     else if (config.has_model()) { // GUIDERAT
@@ -218,9 +281,8 @@ void GuideRate::well_compute(const std::string& wgname,
             return;
         }
 
-        auto iter = this->values.find(wgname);
-        if (iter != this->values.end()) {
-            const auto& grv = iter->second->curr;
+        if (this->has_value[index]) {
+            const auto& grv = this->values[index].curr;
             const auto time_diff = sim_time - grv.sim_time;
             if (config.model().update_delay() > time_diff) {
                 return;
@@ -228,7 +290,7 @@ void GuideRate::well_compute(const std::string& wgname,
         }
 
         const auto guide_rate = this->eval_form(config.model(), oil_pot, gas_pot, wat_pot);
-        this->assign_grvalue(wgname, config.model(), { sim_time, guide_rate, config.model().target() });
+        this->assign_grvalue(index, config.model(), { sim_time, guide_rate, config.model().target() });
     }
     // If neither WGRUPCON nor GUIDERAT is specified potentials are used
 }
@@ -248,37 +310,35 @@ double GuideRate::eval_group_resvinj() const
     return 0.0;
 }
 
-void GuideRate::assign_grvalue(const std::string&    wgname,
+void GuideRate::assign_grvalue(std::size_t           index,
                                const GuideRateModel& model,
                                GuideRateValue&&      value)
 {
-    auto& v = this->values[wgname];
-    if (v == nullptr) {
-        v = std::make_unique<GRValState>();
-    }
+    auto& v = this->values[index];
+    this->has_value[index] = true;
 
-    if (value.sim_time > v->curr.sim_time) {
+    if (value.sim_time > v.curr.sim_time) {
         // We've advanced in time since we previously calculated/stored this
         // guiderate value.  Push current value into the past and prepare to
         // capture new value.
         using std::swap;
 
-        swap(v->prev, v->curr);
+        swap(v.prev, v.curr);
     }
 
-    v->curr = std::move(value);
+    v.curr = std::move(value);
 
-    if ((v->prev.sim_time < 0.0) || ! (v->prev.value > 0.0)) {
+    if ((v.prev.sim_time < 0.0) || ! (v.prev.value > 0.0)) {
         // No previous non-zero guiderate exists.  No further actions.
         return;
     }
 
     // Incorporate damping &c.
     const auto new_guide_rate = model.allow_increase()
-        ? v->curr.value : std::min(v->curr.value, v->prev.value);
+        ? v.curr.value : std::min(v.curr.value, v.prev.value);
 
     const auto damping_factor = model.damping_factor();
-    v->curr.value = damping_factor*new_guide_rate + (1 - damping_factor)*v->prev.value;
+    v.curr.value = damping_factor*new_guide_rate + (1 - damping_factor)*v.prev.value;
 }
 
 double GuideRate::get_grvalue_result(const GRValState& gr) const
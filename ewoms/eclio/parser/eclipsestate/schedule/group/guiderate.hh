@@ -22,14 +22,15 @@
 #include <cstddef>
 #include <ctime>
 #include <limits>
-#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <stddef.h>
 
 #include <ewoms/eclio/parser/eclipsestate/schedule/group/group.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/group/guideratemodel.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/treetopology.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/well.hh>
 
 namespace Ewoms {
@@ -93,20 +94,42 @@ public:
     double get(const std::string& name, GuideRateModel::Target model_target, const RateVector& rates) const;
     bool has(const std::string& name) const;
 
+    /*
+      The values and potentials are stored in arrays indexed by a dense id
+      per well or group name. index() interns a name, the overloads below
+      taking an index then work without any name lookup; a sweep over the
+      whole group tree uses the indices of all its nodes:
+
+          const auto tree = schedule.groupTree(report_step).topology();
+          const auto index = guide_rate.index(tree);
+          for (const auto node : tree.order())
+              guide_rate.compute(index[node], report_step, sim_time, ...);
+    */
+    std::size_t index(const std::string& wgname);
+    std::vector<std::size_t> index(const TreeTopology& tree);
+    const std::string& name(std::size_t index) const;
+
+    void   compute(std::size_t index, size_t report_step, double sim_time, double oil_pot, double gas_pot, double wat_pot);
+    double get(std::size_t index, GuideRateModel::Target model_target, const RateVector& rates) const;
+    bool has(std::size_t index) const;
+
 private:
-    void well_compute(const std::string& wgname, size_t report_step, double sim_time, double oil_pot, double gas_pot, double wat_pot);
-    void group_compute(const std::string& wgname, size_t report_step, double sim_time, double oil_pot, double gas_pot, double wat_pot);
+    void well_compute(std::size_t index, size_t report_step, double sim_time, double oil_pot, double gas_pot, double wat_pot);
+    void group_compute(std::size_t index, size_t report_step, double sim_time, double oil_pot, double gas_pot, double wat_pot);
     double eval_form(const GuideRateModel& model, double oil_pot, double gas_pot, double wat_pot) const;
     double eval_group_pot() const;
     double eval_group_resvinj() const;
 
-    void assign_grvalue(const std::string& wgname, const GuideRateModel& model, GuideRateValue&& value);
+    void assign_grvalue(std::size_t index, const GuideRateModel& model, GuideRateValue&& value);
     double get_grvalue_result(const GRValState& gr) const;
-
-    using GRValPtr = std::unique_ptr<GRValState>;
-
-    std::unordered_map<std::string, GRValPtr> values;
-    std::unordered_map<std::string, RateVector > potentials;
+    std::size_t find_index(const std::string& name) const;
+
+    std::unordered_map<std::string, std::size_t> indices;
+    std::vector<std::string> names;
+    std::vector<GRValState> values;
+    std::vector<RateVector> potentials;
+    std::vector<bool> has_value;
+    std::vector<bool> has_potential;
     const Schedule& schedule;
 };
 
@@ -1544,6 +1544,7 @@ namespace {
             }
 
             this->wlist_manager.update(handlerContext.currentStep, new_wlm);
+            this->clearWellMatchers();
         }
     }
 
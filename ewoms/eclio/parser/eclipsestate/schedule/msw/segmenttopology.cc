@@ -0,0 +1,217 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include <ewoms/eclio/parser/eclipsestate/schedule/msw/segment.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/msw/segmenttopology.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/msw/wellsegments.hh>
+
+namespace Ewoms {
+
+namespace {
+
+    /*
+      Fills offset[0 .. num_keys] and values such that the values with key
+      k are values[offset[k] .. offset[k+1]), in increasing order of their
+      position in keys. Entries with key npos are skipped.
+    */
+    void buildCSR(const std::vector<std::size_t>& keys, std::size_t num_keys,
+                  std::vector<std::size_t>& offset, std::vector<std::size_t>& values)
+    {
+        offset.assign(num_keys + 1, 0);
+        for (const auto key : keys) {
+            if (key != SegmentTopology::npos)
+                offset[key + 1] += 1;
+        }
+
+        for (std::size_t key = 0; key < num_keys; ++key)
+            offset[key + 1] += offset[key];
+
+        auto fill = std::vector<std::size_t>(offset.begin(), offset.end() - 1);
+        values.resize(offset.back());
+        for (std::size_t pos = 0; pos < keys.size(); ++pos) {
+            if (keys[pos] != SegmentTopology::npos)
+                values[fill[keys[pos]]++] = pos;
+        }
+    }
+
+}
+
+    SegmentTopology::SegmentTopology(const WellSegments& segments) {
+        const auto num_segments = segments.size();
+
+        int max_segment_number = 0;
+        int max_branch_number = 0;
+        for (const auto& segment : segments) {
+            max_segment_number = std::max(max_segment_number, segment.segmentNumber());
+            max_branch_number = std::max(max_branch_number, segment.branchNumber());
+        }
+
+        this->m_index.assign(max_segment_number + 1, npos);
+        this->m_branch_numbers.resize(num_segments);
+        for (std::size_t index = 0; index < num_segments; ++index) {
+            const auto& segment = segments[index];
+            if (segment.segmentNumber() >= 0)
+                this->m_index[segment.segmentNumber()] = index;
+
+            this->m_branch_numbers[index] = segment.branchNumber();
+        }
+
+        this->m_outlet.assign(num_segments, npos);
+        for (std::size_t index = 0; index < num_segments; ++index) {
+            const auto outlet_segment = segments[index].outletSegment();
+            if (outlet_segment <= 0)
+                continue;
+
+            const auto outlet_index = this->index(outlet_segment);
+            if (outlet_index == npos)
+                throw std::logic_error("The outlet segment " + std::to_string(outlet_segment) + " of segment "
+                                       + std::to_string(segments[index].segmentNumber()) + " does not exist");
+
+            this->m_outlet[index] = outlet_index;
+        }
+        buildCSR(this->m_outlet, num_segments, this->m_inlet_offset, this->m_inlets);
+
+        this->m_branch_position.assign(std::max(max_branch_number, 0) + 1, npos);
+        auto branch_position = std::vector<std::size_t>(num_segments, npos);
+        for (std::size_t index = 0; index < num_segments; ++index) {
+            const auto branch = this->m_branch_numbers[index];
+            if (branch < 0)
+                continue;
+
+            auto& position = this->m_branch_position[branch];
+            if (position == npos) {
+                position = this->m_branches.size();
+                this->m_branches.push_back(branch);
+            }
+            branch_position[index] = position;
+        }
+        buildCSR(branch_position, this->m_branches.size(), this->m_branch_offset, this->m_branch_segments);
+
+        this->m_flow_order.reserve(num_segments);
+        std::size_t visited = 0;
+        if (num_segments > 0)
+            this->appendFlowOrder(0, visited);
+
+        this->m_flow_position.assign(num_segments, npos);
+        for (std::size_t pos = 0; pos < this->m_flow_order.size(); ++pos)
+            this->m_flow_position[this->m_flow_order[pos]] = pos;
+
+        this->m_depth_order.resize(num_segments);
+        for (std::size_t index = 0; index < num_segments; ++index)
+            this->m_depth_order[index] = index;
+
+        std::stable_sort(this->m_depth_order.begin(), this->m_depth_order.end(),
+                         [&segments](std::size_t a, std::size_t b) { return segments[a].depth() < segments[b].depth(); });
+    }
+
+    /*
+      Appends the segments of the branch starting at segment_index, from the
+      toe to segment_index, after the segments of all branches joining it,
+      which are visited first in order of their joining segment. Counting
+      the visited segments stops the recursion if the outlets form a loop.
+    */
+    void SegmentTopology::appendFlowOrder(std::size_t segment_index, std::size_t& visited) {
+        const auto branch = this->m_branch_numbers[segment_index];
+        std::vector<std::size_t> current_branch { segment_index };
+
+        auto current = segment_index;
+        while (true) {
+            if (++visited > this->size())
+                throw std::logic_error("Loop detected in branch/segment structure");
+
+            const auto inlets = this->inlets(current);
+
+            bool end_of_branch = true;
+            for (const auto inlet : inlets) {
+                if (this->m_branch_numbers[inlet] == branch)
+                    end_of_branch = false;
+            }
+
+            auto next = current;
+            for (const auto inlet : inlets) {
+                if (this->m_branch_numbers[inlet] == branch) {
+                    current_branch.push_back(inlet);
+                    next = inlet;
+                }
+                else
+                    this->appendFlowOrder(inlet, visited);
+            }
+
+            if (end_of_branch)
+                break;
+
+            current = next;
+        }
+
+        this->m_flow_order.insert(this->m_flow_order.end(), current_branch.rbegin(), current_branch.rend());
+    }
+
+    std::size_t SegmentTopology::size() const {
+        return this->m_outlet.size();
+    }
+
+    std::size_t SegmentTopology::index(int segment_number) const {
+        if (segment_number < 0 || static_cast<std::size_t>(segment_number) >= this->m_index.size())
+            return npos;
+
+        return this->m_index[segment_number];
+    }
+
+    std::size_t SegmentTopology::outlet(std::size_t segment_index) const {
+        return this->m_outlet[segment_index];
+    }
+
+    SegmentTopology::Range SegmentTopology::inlets(std::size_t segment_index) const {
+        const auto* first = this->m_inlets.data();
+        return { first + this->m_inlet_offset[segment_index], first + this->m_inlet_offset[segment_index + 1] };
+    }
+
+    const std::vector<int>& SegmentTopology::branches() const {
+        return this->m_branches;
+    }
+
+    SegmentTopology::Range SegmentTopology::branchSegments(int branch) const {
+        if (branch < 0 || static_cast<std::size_t>(branch) >= this->m_branch_position.size())
+            return {};
+
+        const auto position = this->m_branch_position[branch];
+        if (position == npos)
+            return {};
+
+        const auto* first = this->m_branch_segments.data();
+        return { first + this->m_branch_offset[position], first + this->m_branch_offset[position + 1] };
+    }
+
+    const std::vector<std::size_t>& SegmentTopology::flowOrder() const {
+        return this->m_flow_order;
+    }
+
+    std::size_t SegmentTopology::flowPosition(std::size_t segment_index) const {
+        return this->m_flow_position[segment_index];
+    }
+
+    const std::vector<std::size_t>& SegmentTopology::depthOrder() const {
+        return this->m_depth_order;
+    }
+}
@@ -0,0 +1,109 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SEGMENT_TOPOLOGY_HH
+#define SEGMENT_TOPOLOGY_HH
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Ewoms {
+
+    class WellSegments;
+
+    /*
+      Immutable compiled topology of a WellSegments object. All segments
+      are identified by their storage index in the WellSegments object, and
+      all orderings are computed once, when the topology is built:
+
+        - the outlet of every segment and the inlets of every segment, the
+          latter in one compressed (CSR) array in increasing index order,
+        - the segments of every branch, in increasing index order,
+        - the flow order, from the toe of every branch to the top segment,
+          which visits the inlets of a segment before the segment itself,
+        - the segments sorted by depth.
+
+      Use WellSegments::topology() to get the shared instance of a segment
+      set rather than building one per use.
+    */
+    class SegmentTopology {
+    public:
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        class Range {
+        public:
+            using const_iterator = const std::size_t*;
+
+            Range() = default;
+            Range(const_iterator first, const_iterator last)
+                : first_(first), last_(last)
+            {}
+
+            const_iterator begin() const { return this->first_; }
+            const_iterator end() const { return this->last_; }
+            std::size_t size() const { return this->last_ - this->first_; }
+            bool empty() const { return this->first_ == this->last_; }
+            std::size_t operator[](std::size_t i) const { return this->first_[i]; }
+
+        private:
+            const_iterator first_ = nullptr;
+            const_iterator last_ = nullptr;
+        };
+
+        explicit SegmentTopology(const WellSegments& segments);
+
+        std::size_t size() const;
+
+        // Storage index of a segment number, npos if there is no such segment.
+        std::size_t index(int segment_number) const;
+
+        // npos for the top segment.
+        std::size_t outlet(std::size_t segment_index) const;
+        Range inlets(std::size_t segment_index) const;
+
+        // Branch numbers in the order of their first segment.
+        const std::vector<int>& branches() const;
+        Range branchSegments(int branch) const;
+
+        const std::vector<std::size_t>& flowOrder() const;
+        // Position of a segment in flowOrder(), npos if the segment is not
+        // connected to the top segment.
+        std::size_t flowPosition(std::size_t segment_index) const;
+
+        const std::vector<std::size_t>& depthOrder() const;
+
+    private:
+        void appendFlowOrder(std::size_t segment_index, std::size_t& visited);
+
+        std::vector<int> m_branch_numbers;
+        std::vector<std::size_t> m_index;
+        std::vector<std::size_t> m_outlet;
+        std::vector<std::size_t> m_inlet_offset;
+        std::vector<std::size_t> m_inlets;
+        std::vector<int> m_branches;
+        std::vector<std::size_t> m_branch_position;
+        std::vector<std::size_t> m_branch_offset;
+        std::vector<std::size_t> m_branch_segments;
+        std::vector<std::size_t> m_flow_order;
+        std::vector<std::size_t> m_flow_position;
+        std::vector<std::size_t> m_depth_order;
+    };
+}
+
+#endif
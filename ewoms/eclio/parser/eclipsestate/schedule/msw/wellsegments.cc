@@ -22,8 +22,10 @@
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <iterator>
 #include <unordered_set>
+#include <utility>
 
 #ifdef _WIN32
 #define _USE_MATH_DEFINES
@@ -37,6 +39,7 @@
 #include <ewoms/eclio/parser/deck/deckrecord.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wellconnections.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/segment.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/msw/segmenttopology.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/sicd.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/valve.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/wellsegments.hh>
@@ -111,6 +114,8 @@ namespace Ewoms {
     }
 
     void WellSegments::addSegment( const Segment& new_segment ) {
+       m_topology.reset();
+
        // decide whether to push_back or insert
        const int segment_number = new_segment.segmentNumber();
 
@@ -374,6 +379,8 @@ namespace Ewoms {
     }
 
     void WellSegments::orderSegments() {
+        m_topology.reset();
+
         // re-ordering the segments to make later use easier.
         // two principles
         // 1. the index of the outlet segment will be stored in the lower index than the segment.
@@ -467,6 +474,22 @@ namespace Ewoms {
         return segment.depth() - outlet_segment.depth();
     }
 
+    const SegmentTopology& WellSegments::topology() const {
+        // The atomic access lets copies sharing the topology build and read
+        // it from different threads.  If several threads build it at the
+        // same time, the first one to publish its topology wins and the
+        // others return that one, so no caller is left with a reference to
+        // an object the member no longer owns.
+        auto topology = std::atomic_load(&m_topology);
+        if (!topology) {
+            auto built = std::make_shared<const SegmentTopology>(*this);
+            if (std::atomic_compare_exchange_strong(&m_topology, &topology, built))
+                topology = std::move(built);
+        }
+
+        return *topology;
+    }
+
     std::set<int> WellSegments::branches() const {
         std::set<int> bset;
         for (const auto& segment : this->m_segments)
@@ -633,6 +656,7 @@ WellSegments::MultiPhaseModel WellSegments::MultiPhaseModelFromString(const std:
 }
 
 void WellSegments::updatePerfLength(const WellConnections& connections) {
+    m_topology.reset();
     for (auto& segment : this->m_segments) {
         auto perf_length = connections.segment_perf_length( segment.segmentNumber() );
         segment.updatePerfLength(perf_length);
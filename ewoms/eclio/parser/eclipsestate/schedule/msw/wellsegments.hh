@@ -20,6 +20,7 @@
 #define SEGMENTSET_HH_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -30,6 +31,7 @@ namespace Ewoms {
     class AutoICD;
     class Valve;
     class WellConnections;
+    class SegmentTopology;
 }
 
 namespace Ewoms {
@@ -91,6 +93,11 @@ namespace Ewoms {
         std::vector<Segment> branchSegments(int branch) const;
         std::set<int> branches() const;
 
+        // Compiled topology of the current segments.  It is built on first
+        // use and shared by all copies of this object until they are
+        // modified.
+        const SegmentTopology& topology() const;
+
         // it returns true if there is no error encountered during the update
         bool updateWSEGSICD(const std::vector<std::pair<int, SICD> >& sicd_pairs);
 
@@ -105,6 +112,7 @@ namespace Ewoms {
             serializer(m_comp_pressure_drop);
             serializer.vector(m_segments);
             serializer(segment_number_to_index);
+            m_topology.reset();
         }
 
     private:
@@ -127,6 +135,8 @@ namespace Ewoms {
         // the mapping from the segment number to the
         // storage index in the vector
         std::map<int, int> segment_number_to_index;
+
+        mutable std::shared_ptr<const SegmentTopology> m_topology;
     };
 }
 
@@ -155,5 +155,21 @@ std::vector<std::string> ExtNetwork::node_names() const
 
     return nodes;
 }
+
+const std::vector<Branch>& ExtNetwork::branches() const
+{
+    return this->m_branches;
+}
+
+TreeTopology ExtNetwork::topology() const
+{
+    auto edges = std::vector<std::pair<std::string, std::string>>{};
+    edges.reserve(this->m_branches.size());
+
+    for (const auto& branch : this->m_branches)
+        edges.emplace_back(branch.uptree_node(), branch.downtree_node());
+
+    return { this->node_names(), edges };
+}
 }
 }
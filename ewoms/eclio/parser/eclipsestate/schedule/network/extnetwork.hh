@@ -27,6 +27,7 @@
 
 #include <ewoms/eclio/parser/eclipsestate/schedule/network/branch.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/network/node.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/treetopology.hh>
 
 namespace Ewoms {
 namespace Network {
@@ -44,6 +45,13 @@ public:
     std::vector<Branch> downtree_branches(const std::string& node) const;
     Ewoms::optional<Branch> uptree_branch(const std::string& node) const;
     std::vector<std::string> node_names() const;
+    const std::vector<Branch>& branches() const;
+
+    /*
+      Compiled network: the edges are the branches, so parent_edge(id) is
+      the index of the uptree branch of node id in branches().
+    */
+    TreeTopology topology() const;
 
     bool operator==(const ExtNetwork& other) const;
     static ExtNetwork serializeObject();
@@ -20,9 +20,10 @@
 
 #include <algorithm>
 #include <ctime>
-#include <fnmatch.h>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -64,6 +65,7 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/timemap.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/tuning.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/network/node.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlist.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlistmanager.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wellfoamproperties.hh>
@@ -86,26 +88,111 @@ namespace Ewoms {
 
 namespace {
 
-    bool name_match(const std::string& pattern, const std::string& name) {
-        int flags = 0;
-        return (fnmatch(pattern.c_str(), name.c_str(), flags) == 0);
-    }
-
     std::pair<std::time_t, std::size_t> restart_info(const RestartIO::RstState * rst) {
         if (!rst)
             return std::make_pair(std::time_t{0}, std::size_t{0});
         else
             return rst->header.restart_info();
     }
+
+class ScheduleLogger {
+public:
+    explicit ScheduleLogger(bool restart_skip)
+    {
+        if (restart_skip)
+            this->log_function = &OpmLog::note;
+        else
+            this->log_function = &OpmLog::info;
+    }
+
+    void operator()(const std::string& msg) {
+        this->log_function(msg);
+    }
+
+    void info(const std::string& msg) {
+        OpmLog::info(msg);
+    }
+
+    void complete_step(const std::string& msg) {
+        this->step_count += 1;
+        if (this->step_count == this->max_print) {
+            this->log_function(msg);
+            OpmLog::info("Report limit reached, see PRT-file for remaining Schedule initialization.\n");
+            this->log_function = &OpmLog::note;
+        } else
+            this->log_function( msg + "\n");
+    };
+
+    void restart() {
+        this->step_count = 0;
+        this->log_function = &OpmLog::info;
+    }
+
+private:
+    std::size_t step_count = 0;
+    std::size_t max_print  = 5;
+    void (*log_function)(const std::string&);
+};
+
 }
 
+    /*
+      The state of the loop over the SCHEDULE section keywords. For normal
+      construction the loop runs to completion in the constructor, for
+      incremental construction the state is kept until the whole section has
+      been processed.
+    */
+    struct Schedule::SectionState {
+        SectionState(const std::string& input_path_arg,
+                     const ParseContext& parseContext_arg,
+                     ErrorGuard& errors_arg,
+                     const SCHEDULESection& section_arg,
+                     const EclipseGrid& grid_arg,
+                     const FieldPropsManager& fp_arg,
+                     bool restart_skip_arg) :
+            input_path(input_path_arg),
+            parseContext(&parseContext_arg),
+            errors(&errors_arg),
+            section(section_arg),
+            grid(&grid_arg),
+            fp(&fp_arg),
+            restart_skip(restart_skip_arg),
+            logger(restart_skip_arg)
+        {}
+
+        std::string input_path;
+        const ParseContext* parseContext;
+        ErrorGuard* errors;
+        SCHEDULESection section;
+        const EclipseGrid* grid;
+        const FieldPropsManager* fp;
+
+        std::size_t keywordIdx = 0;
+        std::size_t currentStep = 0;
+        bool restart_skip;
+        std::string current_file;
+        ScheduleLogger logger;
+        std::vector<std::pair< const DeckKeyword* , std::size_t> > rftProperties;
+    };
+
+    Schedule::Schedule( const Deck& deck,
+                        const EclipseGrid& grid,
+                        const FieldPropsManager& fp,
+                        const Runspec &runspec,
+                        const ParseContext& parseContext,
+                        ErrorGuard& errors,
+                        const RestartIO::RstState * rst) :
+        Schedule(deck, grid, fp, runspec, parseContext, errors, rst, std::numeric_limits<std::size_t>::max())
+    {}
+
     Schedule::Schedule( const Deck& deck,
                         const EclipseGrid& grid,
                         const FieldPropsManager& fp,
                         const Runspec &runspec,
                         const ParseContext& parseContext,
                         ErrorGuard& errors,
-                        const RestartIO::RstState * rst)
+                        const RestartIO::RstState * rst,
+                        std::size_t last_report_step)
     try :
         m_timeMap( deck , restart_info( rst )),
         m_oilvaporizationproperties( this->m_timeMap, OilVaporizationProperties(runspec.tabdims().getNumPVTTables()) ),
@@ -150,8 +237,11 @@ namespace {
                 applyMESSAGES(keyword, 0);
         }
 
-        if (DeckSection::hasSCHEDULE(deck))
-            iterateScheduleSection( deck.getInputPath(), parseContext, errors, SCHEDULESection( deck ), grid, fp);
+        if (DeckSection::hasSCHEDULE(deck)) {
+            const bool restart_skip = this->m_timeMap.restart_offset() > 0;
+            this->m_section_state = std::make_shared<SectionState>(deck.getInputPath(), parseContext, errors, SCHEDULESection( deck ), grid, fp, restart_skip);
+            iterateScheduleSection( last_report_step );
+        }
     }
     catch (const OpmInputError& opm_error) {
         throw;
@@ -206,6 +296,17 @@ namespace {
         Schedule(deck, es, ParseContext(), ErrorGuard(), rst)
     {}
 
+    Schedule Schedule::incremental(const Deck& deck, const EclipseState& es, const ParseContext& parse_context, ErrorGuard& errors, std::size_t report_step, const RestartIO::RstState * rst) {
+        return Schedule(deck,
+                        es.getInputGrid(),
+                        es.fieldProps(),
+                        es.runspec(),
+                        parse_context,
+                        errors,
+                        rst,
+                        report_step);
+    }
+
     /*
       In general the serializeObject() instances are used as targets for
       deserialization, i.e. the serialized buffer is unpacked into this
@@ -293,57 +394,23 @@ namespace {
             rftProperties.push_back( std::make_pair( &keyword , currentStep ));
     }
 
-namespace {
-
-class ScheduleLogger {
-public:
-    explicit ScheduleLogger(bool restart_skip)
-    {
-        if (restart_skip)
-            this->log_function = &OpmLog::note;
-        else
-            this->log_function = &OpmLog::info;
-    }
-
-    void operator()(const std::string& msg) {
-        this->log_function(msg);
-    }
-
-    void info(const std::string& msg) {
-        OpmLog::info(msg);
-    }
+    void Schedule::iterateScheduleSection(std::size_t last_report_step) {
+        auto& state = *this->m_section_state;
+        const auto& input_path = state.input_path;
+        const auto& parseContext = *state.parseContext;
+        auto& errors = *state.errors;
+        const auto& section = state.section;
+        const auto& grid = *state.grid;
+        const auto& fp = *state.fp;
+        auto& rftProperties = state.rftProperties;
+        auto& keywordIdx = state.keywordIdx;
+        auto& currentStep = state.currentStep;
+        auto& restart_skip = state.restart_skip;
+        auto& current_file = state.current_file;
+        auto& logger = state.logger;
 
-    void complete_step(const std::string& msg) {
-        this->step_count += 1;
-        if (this->step_count == this->max_print) {
-            this->log_function(msg);
-            OpmLog::info("Report limit reached, see PRT-file for remaining Schedule initialization.\n");
-            this->log_function = &OpmLog::note;
-        } else
-            this->log_function( msg + "\n");
-    };
-
-    void restart() {
-        this->step_count = 0;
-        this->log_function = &OpmLog::info;
-    }
-
-private:
-    std::size_t step_count = 0;
-    std::size_t max_print  = 5;
-    void (*log_function)(const std::string&);
-};
-
-}
-
-    void Schedule::iterateScheduleSection(const std::string& input_path, const ParseContext& parseContext , ErrorGuard& errors, const SCHEDULESection& section , const EclipseGrid& grid,
-                                          const FieldPropsManager& fp) {
-
-        std::vector<std::pair< const DeckKeyword* , std::size_t> > rftProperties;
         std::string time_unit = this->unit_system.name(UnitSystem::measure::time);
         auto convert_time = [this](double seconds) { return this->unit_system.from_si(UnitSystem::measure::time, seconds); };
-        std::size_t keywordIdx = 0;
-        std::string current_file;
         const auto& time_map = this->m_timeMap;
         /*
           The keywords in the skiprest_whitelist set are loaded from the
@@ -352,7 +419,6 @@ private:
           all.
         */
         std::unordered_set<std::string> skiprest_whitelist = {"VFPPROD", "VFPINJ", "RPTSCHED", "RPTRST", "TUNING", "MESSAGES"};
-        std::size_t currentStep = 0;
         /*
           The behavior of variable restart_skip is more lenient than the
           SKIPREST keyword. If this is a restarted[1] run the loop iterating
@@ -368,10 +434,7 @@ private:
           [2]: With the exception of the keywords in the skiprest_whitelist;
                these keywords will be assigned to report step 0.
         */
-
-        auto restart_skip = currentStep < this->m_timeMap.restart_offset();
-        ScheduleLogger logger(restart_skip);
-        {
+        if (keywordIdx == 0) {
             const auto& schedule_keyword = section.getKeyword<ParserKeywords::SCHEDULE>();
             const auto& location = schedule_keyword.location();
             current_file = location.filename;
@@ -391,6 +454,19 @@ private:
             if (keywordIdx == section.size())
                 break;
 
+            if (currentStep > last_report_step) {
+                /*
+                  The WRFT and WRFTPLT keywords are normally applied when the
+                  whole section has been processed; when stopping early the
+                  ones from the completed report steps are applied now.
+                */
+                auto pending = std::stable_partition(rftProperties.begin(), rftProperties.end(),
+                                                     [currentStep](const auto& rftPair) { return rftPair.second < currentStep; });
+                this->applyRFTKeywords(rftProperties.begin(), pending);
+                rftProperties.erase(rftProperties.begin(), pending);
+                return;
+            }
+
             const auto& keyword = section.getKeyword(keywordIdx);
             const auto& location = keyword.location();
             if (location.filename != current_file) {
@@ -491,8 +567,13 @@ private:
             keywordIdx++;
         }
         checkIfAllConnectionsIsShut(currentStep);
+        this->applyRFTKeywords(rftProperties.begin(), rftProperties.end());
+        checkUnhandledKeywords(section);
+        this->m_section_state.reset();
+    }
 
-        for (auto rftPair = rftProperties.begin(); rftPair != rftProperties.end(); ++rftPair) {
+    void Schedule::applyRFTKeywords(RFTKeywordIterator begin, RFTKeywordIterator end) {
+        for (auto rftPair = begin; rftPair != end; ++rftPair) {
             const DeckKeyword& keyword = *rftPair->first;
             std::size_t timeStep = rftPair->second;
             if (keyword.name() == "WRFT")
@@ -501,10 +582,37 @@ private:
             if (keyword.name() == "WRFTPLT")
                 applyWRFTPLT(keyword, timeStep);
         }
+    }
 
-        checkUnhandledKeywords(section);
+    bool Schedule::complete() const {
+        return !this->m_section_state;
+    }
+
+    std::size_t Schedule::processedSteps() const {
+        if (this->complete())
+            return this->size();
+
+        return std::min(this->m_section_state->currentStep, this->size());
     }
 
+    void Schedule::advance(std::size_t report_step) {
+        if (this->complete() || report_step < this->processedSteps())
+            return;
+
+        // Copies of an incomplete schedule share the section state until one
+        // of them advances.
+        if (this->m_section_state.use_count() > 1)
+            this->m_section_state = std::make_shared<SectionState>(*this->m_section_state);
+
+        this->clearWellMatchers();
+        this->iterateScheduleSection(report_step);
+    }
+
+    void Schedule::advance() {
+        this->advance(this->processedSteps());
+    }
+
+
     void Schedule::addACTIONX(const Action::ActionX& action, std::size_t currentStep) {
         auto new_actions = std::make_shared<Action::Actions>( this->actions(currentStep) );
         new_actions->add(action);
@@ -855,6 +963,7 @@ private:
         this->wellgroup_events.insert( std::make_pair(wname, Events(this->m_timeMap)));
         this->addWellGroupEvent(wname, ScheduleEvents::NEW_WELL, report_step);
 
+        this->clearWellMatchers();
         well.setInsertIndex(this->wells_static.size());
         this->wells_static.insert( std::make_pair(wname, DynamicState<std::shared_ptr<Well>>(m_timeMap, nullptr)));
         auto& dynamic_well_state = this->wells_static.at(wname);
@@ -1064,18 +1173,45 @@ private:
         if (pattern == "?")
             return { matching_wells.begin(), matching_wells.end() };
 
-        auto wm = this->wellMatcher(timeStep);
-        return wm.wells(pattern);
+        return this->sharedWellMatcher(timeStep)->wells(pattern);
     }
 
     WellMatcher Schedule::wellMatcher(std::size_t report_step) const {
+        return *this->sharedWellMatcher(report_step);
+    }
+
+    std::shared_ptr<const WellMatcher> Schedule::sharedWellMatcher(std::size_t report_step) const {
+        {
+            std::lock_guard<std::mutex> lock(this->well_matchers->mutex);
+            auto wm = this->well_matchers->matchers.find(report_step);
+            if (wm != this->well_matchers->matchers.end())
+                return wm->second;
+        }
+
         std::vector<std::string> wnames;
         for (const auto& well_pair : this->wells_static) {
             const auto& dynamic_state = well_pair.second;
             if (dynamic_state.get(report_step))
                 wnames.push_back(well_pair.first);
         }
-        return WellMatcher(wnames, this->getWListManager(report_step));
+        auto wm = std::make_shared<const WellMatcher>(wnames, this->getWListManager(report_step));
+
+        // Only a handful of report steps are queried at any time, keep the
+        // cache from growing with the length of the schedule.  Callers keep
+        // their matchers alive through the shared pointers.
+        const std::size_t max_cached_steps = 8;
+        std::lock_guard<std::mutex> lock(this->well_matchers->mutex);
+        auto& matchers = this->well_matchers->matchers;
+        if (matchers.size() >= max_cached_steps && matchers.count(report_step) == 0)
+            matchers.clear();
+
+        // If another thread got here first, use its matcher.
+        return matchers.emplace(report_step, std::move(wm)).first->second;
+    }
+
+    void Schedule::clearWellMatchers() {
+        std::lock_guard<std::mutex> lock(this->well_matchers->mutex);
+        this->well_matchers->matchers.clear();
     }
 
     std::vector<std::string> Schedule::wellNames(const std::string& pattern) const {
@@ -1109,9 +1245,10 @@ private:
         // Normal pattern matching
         auto star_pos = pattern.find('*');
         if (star_pos != std::string::npos) {
+            const NamePattern group_pattern(pattern);
             std::vector<std::string> names;
             for (const auto& group_pair : this->groups) {
-                if (name_match(pattern, group_pair.first)) {
+                if (group_pattern.match(group_pair.first)) {
                     const auto& dynamic_state = group_pair.second;
                     const auto& group_ptr = dynamic_state.get(timeStep);
                     if (group_ptr)
@@ -1149,10 +1286,10 @@ private:
         // Normal pattern matching
         auto star_pos = pattern.find('*');
         if (star_pos != std::string::npos) {
-            int flags = 0;
+            const NamePattern group_pattern(pattern);
             std::vector<std::string> names;
             for (const auto& group_pair : this->groups) {
-                if (fnmatch(pattern.c_str(), group_pair.first.c_str(), flags) == 0)
+                if (group_pattern.match(group_pair.first))
                     names.push_back(group_pair.first);
             }
             return names;
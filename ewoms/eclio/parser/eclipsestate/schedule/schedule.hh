@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ewoms/common/optional.hh>
 #include <unordered_set>
 
@@ -52,6 +53,7 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/action/actions.hh>
 
 #include <ewoms/eclio/utility/activegridcells.hh>
+#include <ewoms/eclio/utility/resetoncopy.hh>
 #include <ewoms/eclio/io/rst/state.hh>
 
 #include <ewoms/common/optional.hh>
@@ -163,6 +165,30 @@ namespace Ewoms
                  const EclipseState& es,
                  const RestartIO::RstState* rst = nullptr);
 
+        /*
+          Create a schedule where only the SCHEDULE section keywords up to and
+          including report step report_step have been processed; the remaining
+          report steps are processed on demand with advance(). Until the
+          schedule is complete() the deck, the EclipseState, the ParseContext
+          and the ErrorGuard must outlive the schedule, and only the state of
+          the report steps before processedSteps() is valid. Keywords are
+          always processed as a whole, so a DATES keyword with several
+          records can take processedSteps() past report_step + 1.
+        */
+        static Schedule incremental(const Deck& deck,
+                                    const EclipseState& es,
+                                    const ParseContext& parseContext,
+                                    ErrorGuard& errors,
+                                    std::size_t report_step = 0,
+                                    const RestartIO::RstState* rst = nullptr);
+
+        /// Process the keywords of the next report step.
+        void advance();
+        /// Process the keywords up to and including report step report_step.
+        void advance(std::size_t report_step);
+        bool complete() const;
+        std::size_t processedSteps() const;
+
         static Schedule serializeObject();
 
         /*
@@ -186,6 +212,7 @@ namespace Ewoms
         bool hasWell(const std::string& wellName, std::size_t timeStep) const;
 
         WellMatcher wellMatcher(std::size_t report_step) const;
+        std::shared_ptr<const WellMatcher> sharedWellMatcher(std::size_t report_step) const;
         std::vector<std::string> wellNames(const std::string& pattern, std::size_t timeStep, const std::vector<std::string>& matching_wells = {}) const;
         std::vector<std::string> wellNames(const std::string& pattern) const;
         std::vector<std::string> wellNames(std::size_t timeStep) const;
@@ -325,6 +352,7 @@ namespace Ewoms
                 reconstructDynMap(splitGroups.first, splitGroups.second, groups);
                 reconstructDynMap<Map2>(splitvfpprod.first, splitvfpprod.second, vfpprod_tables);
                 reconstructDynMap<Map2>(splitvfpinj.first, splitvfpinj.second, vfpinj_tables);
+                clearWellMatchers();
             }
             unit_system.serializeOp(serializer);
         }
@@ -361,6 +389,33 @@ namespace Ewoms
         Ewoms::optional<int> exit_status;
 
         std::map<std::string,Events> wellgroup_events;
+
+        // The well matchers are not part of the state; they are cached per
+        // report step and discarded whenever a well or a well list is added.
+        // The cache is shared by concurrent readers of a const schedule.
+        struct WellMatcherCache {
+            std::mutex mutex;
+            std::map<std::size_t, std::shared_ptr<const WellMatcher>> matchers;
+        };
+
+        // A copied or assigned schedule starts out with an empty cache.
+        ResetOnCopy<WellMatcherCache> well_matchers;
+        void clearWellMatchers();
+
+        // Progress through the SCHEDULE section; only set while an
+        // incrementally created schedule is incomplete.
+        struct SectionState;
+        std::shared_ptr<SectionState> m_section_state;
+
+        Schedule(const Deck& deck,
+                 const EclipseGrid& grid,
+                 const FieldPropsManager& fp,
+                 const Runspec &runspec,
+                 const ParseContext& parseContext,
+                 ErrorGuard& errors,
+                 const RestartIO::RstState* rst,
+                 std::size_t last_report_step);
+
         void load_rst(const RestartIO::RstState& rst,
                       const EclipseGrid& grid,
                       const FieldPropsManager& fp);
@@ -390,8 +445,9 @@ namespace Ewoms
         void updateUDQActive( std::size_t timeStep, std::shared_ptr<UDQActive> udq );
         bool updateWellStatus( const std::string& well, std::size_t reportStep, bool runtime, Well::Status status, Ewoms::optional<KeywordLocation> = {});
         void addWellToGroup( const std::string& group_name, const std::string& well_name , std::size_t timeStep);
-        void iterateScheduleSection(const std::string& input_path, const ParseContext& parseContext ,  ErrorGuard& errors, const SCHEDULESection& , const EclipseGrid& grid,
-                                    const FieldPropsManager& fp);
+        void iterateScheduleSection(std::size_t last_report_step);
+        using RFTKeywordIterator = std::vector<std::pair<const DeckKeyword*, std::size_t>>::iterator;
+        void applyRFTKeywords(RFTKeywordIterator begin, RFTKeywordIterator end);
         void addACTIONX(const Action::ActionX& action, std::size_t currentStep);
         void addGroupToGroup( const std::string& parent_group, const std::string& child_group, std::size_t timeStep);
         void addGroupToGroup( const std::string& parent_group, const Group& child_group, std::size_t timeStep);
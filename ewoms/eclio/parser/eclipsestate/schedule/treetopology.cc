@@ -0,0 +1,129 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <stdexcept>
+
+#include <ewoms/eclio/parser/eclipsestate/schedule/treetopology.hh>
+
+namespace Ewoms {
+
+TreeTopology::TreeTopology(const std::vector<std::string>& names,
+                           const std::vector<std::pair<std::string, std::string>>& edges)
+{
+    for (const auto& name : names)
+        this->intern(name);
+
+    std::vector<std::pair<std::size_t, std::size_t>> id_edges;
+    id_edges.reserve(edges.size());
+    for (const auto& edge : edges) {
+        const auto parent = this->intern(edge.first);
+        id_edges.emplace_back(parent, this->intern(edge.second));
+    }
+
+    const auto num_nodes = this->m_names.size();
+    this->m_parent.assign(num_nodes, npos);
+    this->m_parent_edge.assign(num_nodes, npos);
+    this->m_child_offset.assign(num_nodes + 1, 0);
+
+    for (std::size_t e = 0; e < id_edges.size(); e++) {
+        const auto& edge = id_edges[e];
+        if (this->m_parent[edge.second] != npos)
+            throw std::invalid_argument("Node: " + this->m_names[edge.second] + " has more than one uptree node");
+
+        this->m_parent[edge.second] = edge.first;
+        this->m_parent_edge[edge.second] = e;
+        this->m_child_offset[edge.first + 1] += 1;
+    }
+
+    for (std::size_t node = 0; node < num_nodes; node++)
+        this->m_child_offset[node + 1] += this->m_child_offset[node];
+
+    auto fill = std::vector<std::size_t>(this->m_child_offset.begin(), this->m_child_offset.end() - 1);
+    this->m_children.resize(id_edges.size());
+    for (const auto& edge : id_edges)
+        this->m_children[fill[edge.first]++] = edge.second;
+
+    for (std::size_t node = 0; node < num_nodes; node++) {
+        if (this->m_parent[node] == npos)
+            this->m_roots.push_back(node);
+    }
+
+    // Breadth first from the roots; nodes on a cycle are never reached.
+    this->m_order.reserve(num_nodes);
+    this->m_order.insert(this->m_order.end(), this->m_roots.begin(), this->m_roots.end());
+    for (std::size_t pos = 0; pos < this->m_order.size(); pos++) {
+        const auto children = this->children(this->m_order[pos]);
+        this->m_order.insert(this->m_order.end(), children.begin(), children.end());
+    }
+
+    if (this->m_order.size() != num_nodes)
+        throw std::invalid_argument("The tree structure contains a cycle");
+}
+
+std::size_t TreeTopology::intern(const std::string& name) {
+    const auto result = this->m_ids.emplace(name, this->m_names.size());
+    if (result.second)
+        this->m_names.push_back(name);
+
+    return result.first->second;
+}
+
+std::size_t TreeTopology::size() const {
+    return this->m_names.size();
+}
+
+bool TreeTopology::has(const std::string& name) const {
+    return this->m_ids.count(name) > 0;
+}
+
+std::size_t TreeTopology::id(const std::string& name) const {
+    const auto iter = this->m_ids.find(name);
+    if (iter == this->m_ids.end())
+        throw std::out_of_range("No such node: " + name);
+
+    return iter->second;
+}
+
+const std::string& TreeTopology::name(std::size_t id) const {
+    return this->m_names[id];
+}
+
+std::size_t TreeTopology::parent(std::size_t id) const {
+    return this->m_parent[id];
+}
+
+std::size_t TreeTopology::parent_edge(std::size_t id) const {
+    return this->m_parent_edge[id];
+}
+
+TreeTopology::Children TreeTopology::children(std::size_t id) const {
+    const auto* first = this->m_children.data();
+    return { first + this->m_child_offset[id], first + this->m_child_offset[id + 1] };
+}
+
+const std::vector<std::size_t>& TreeTopology::roots() const {
+    return this->m_roots;
+}
+
+const std::vector<std::size_t>& TreeTopology::order() const {
+    return this->m_order;
+}
+
+}
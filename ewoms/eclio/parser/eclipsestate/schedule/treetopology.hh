@@ -0,0 +1,106 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TREE_TOPOLOGY_H
+#define TREE_TOPOLOGY_H
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Ewoms {
+
+/*
+  Compiled form of a tree of named nodes, i.e. the extended network or the
+  group tree. The node names are interned to the dense ids 0 .. size()-1,
+  the children of every node are stored in one compressed (CSR) array and
+  the nodes are sorted in topological order up front. A sweep over the
+  whole tree is then a loop over order() - or over its reverse for a
+  bottom-up sweep - with all per node data in arrays indexed by id.
+*/
+
+class TreeTopology {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    class Children {
+    public:
+        using const_iterator = const std::size_t*;
+
+        Children() = default;
+        Children(const_iterator first, const_iterator last)
+            : first_(first), last_(last)
+        {}
+
+        const_iterator begin() const { return this->first_; }
+        const_iterator end() const { return this->last_; }
+        std::size_t size() const { return this->last_ - this->first_; }
+        bool empty() const { return this->first_ == this->last_; }
+        std::size_t operator[](std::size_t i) const { return this->first_[i]; }
+
+    private:
+        const_iterator first_ = nullptr;
+        const_iterator last_ = nullptr;
+    };
+
+    TreeTopology() = default;
+
+    /*
+      The nodes are given by names and by the (parent, child) pairs of
+      edges; a name only used in the edges is added after the names. The
+      ids follow the order in which the names are first seen and the
+      children of a node are in edge order. Throws std::invalid_argument if
+      a node has more than one parent or the edges contain a cycle.
+    */
+    TreeTopology(const std::vector<std::string>& names,
+                 const std::vector<std::pair<std::string, std::string>>& edges);
+
+    std::size_t size() const;
+    bool has(const std::string& name) const;
+    std::size_t id(const std::string& name) const;
+    const std::string& name(std::size_t id) const;
+
+    // npos for the roots.
+    std::size_t parent(std::size_t id) const;
+    // Index of the edge from the parent in the constructor argument, npos
+    // for the roots.
+    std::size_t parent_edge(std::size_t id) const;
+    Children children(std::size_t id) const;
+
+    const std::vector<std::size_t>& roots() const;
+    // Every node comes after its parent.
+    const std::vector<std::size_t>& order() const;
+
+private:
+    std::size_t intern(const std::string& name);
+
+    std::unordered_map<std::string, std::size_t> m_ids;
+    std::vector<std::string> m_names;
+    std::vector<std::size_t> m_parent;
+    std::vector<std::size_t> m_parent_edge;
+    std::vector<std::size_t> m_child_offset;
+    std::vector<std::size_t> m_children;
+    std::vector<std::size_t> m_roots;
+    std::vector<std::size_t> m_order;
+};
+
+}
+#endif
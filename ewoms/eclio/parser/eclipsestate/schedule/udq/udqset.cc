@@ -18,12 +18,12 @@
 */
 #include "config.h"
 
-#include <fnmatch.h>
 #include <algorithm>
 #include <cmath>
 #include <ewoms/common/fmt/format.h>
 
 #include <ewoms/eclio/parser/eclipsestate/schedule/udq/udqset.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 
 namespace Ewoms {
 
@@ -247,9 +247,9 @@ std::size_t UDQSet::size() const {
 
 void UDQSet::assign(const std::string& wgname, double value) {
     bool assigned = false;
+    const NamePattern pattern(wgname);
     for (auto& udq_value : this->values) {
-        int flags = 0;
-        if (fnmatch(wgname.c_str(), udq_value.wgname().c_str(), flags) == 0) {
+        if (pattern.match(udq_value.wgname())) {
             udq_value.assign( value );
             assigned = true;
         }
@@ -260,9 +260,9 @@ void UDQSet::assign(const std::string& wgname, double value) {
 
 void UDQSet::assign(const std::string& wgname, const Ewoms::optional<double>& value) {
     bool assigned = false;
+    const NamePattern pattern(wgname);
     for (auto& udq_value : this->values) {
-        int flags = 0;
-        if (fnmatch(wgname.c_str(), udq_value.wgname().c_str(), flags) == 0) {
+        if (pattern.match(udq_value.wgname())) {
             udq_value.assign( value );
             assigned = true;
         }
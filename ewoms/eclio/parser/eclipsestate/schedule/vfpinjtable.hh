@@ -42,6 +42,12 @@ public:
 
     VFPInjTable();
     VFPInjTable(const DeckKeyword& table, const UnitSystem& deck_unit_system);
+    VFPInjTable(int table_num,
+                double datum_depth,
+                FLO_TYPE flo_type,
+                const std::vector<double>& flo_data,
+                const std::vector<double>& thp_data,
+                const array_type& data);
 
     static VFPInjTable serializeObject();
 
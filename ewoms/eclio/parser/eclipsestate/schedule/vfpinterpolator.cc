@@ -0,0 +1,296 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <ewoms/eclio/parser/eclipsestate/schedule/vfpinjtable.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/vfpprodtable.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/vfpinterpolator.hh>
+
+namespace Ewoms {
+
+namespace {
+
+template <std::size_t N>
+struct Blend {
+    double value;
+    std::array<double, N> derivative;
+};
+
+/*
+  Multilinear blend of the 2^N corner values of a hypercube. Bit k of the
+  corner index selects the upper node of dimension N-1-k, so the last
+  dimension is collapsed first by combining neighbouring entries. Each
+  step halves the number of values and produces the derivative along the
+  collapsed dimension; the derivatives of the dimensions collapsed earlier
+  are blended like the values. All loops have fixed trip counts and no
+  branches.
+*/
+template <std::size_t N>
+Blend<N> blendCorners(std::array<double, std::size_t{1} << N>& values,
+                      const std::array<VFPAxis::Bracket, N>& brackets)
+{
+    std::array<std::array<double, (std::size_t{1} << N) / 2>, N> derivatives{};
+
+    auto count = std::size_t{1} << N;
+    for (std::size_t level = 0; level < N; ++level) {
+        const auto dim = N - 1 - level;
+        const auto t = brackets[dim].factor;
+        const auto invWidth = brackets[dim].invWidth;
+
+        count /= 2;
+        for (std::size_t e = dim + 1; e < N; ++e) {
+            auto& d = derivatives[e];
+            for (std::size_t i = 0; i < count; ++i)
+                d[i] = (1.0 - t)*d[2*i] + t*d[2*i + 1];
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto lo = values[2*i];
+            const auto hi = values[2*i + 1];
+
+            derivatives[dim][i] = (hi - lo)*invWidth;
+            values[i] = (1.0 - t)*lo + t*hi;
+        }
+    }
+
+    Blend<N> result;
+    result.value = values[0];
+    for (std::size_t d = 0; d < N; ++d)
+        result.derivative[d] = derivatives[d][0];
+
+    return result;
+}
+
+/*
+  Solve f(x) = target for the piecewise linear function with values f[i]
+  at the nodes of axis. Uses the first interval containing the target, or
+  extrapolates the end interval whose end value is closer to it.
+*/
+double invertPiecewiseLinear(const VFPAxis& axis, const std::vector<double>& f, double target)
+{
+    const auto n = f.size();
+    if (n == 1)
+        return axis[0];
+
+    auto interval = n - 1;
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        if (std::min(f[i], f[i + 1]) <= target && target <= std::max(f[i], f[i + 1])) {
+            interval = i;
+            break;
+        }
+    }
+
+    if (interval == n - 1)
+        interval = (std::abs(f[0] - target) <= std::abs(f[n - 1] - target)) ? 0 : n - 2;
+
+    const auto slope = f[interval + 1] - f[interval];
+    if (slope == 0.0)
+        return axis[interval];
+
+    return axis[interval] + (target - f[interval]) / slope * (axis[interval + 1] - axis[interval]);
+}
+
+void checkDataSize(const std::vector<double>& data, std::size_t expected, const std::string& keyword)
+{
+    if (data.size() != expected)
+        throw std::invalid_argument(keyword + " table has " + std::to_string(data.size())
+                                    + " values, its axes need " + std::to_string(expected));
+}
+
+} // Anonymous namespace
+
+VFPAxis::VFPAxis(const std::vector<double>& values)
+    : m_values(values)
+{
+    if (m_values.empty())
+        throw std::invalid_argument("VFP table axis must have at least one value");
+
+    m_invWidths.reserve(m_values.size() - 1);
+    for (std::size_t i = 0; i + 1 < m_values.size(); ++i) {
+        if (!(m_values[i] < m_values[i + 1]))
+            throw std::invalid_argument("VFP table axis values must be strictly increasing");
+
+        m_invWidths.push_back(1.0 / (m_values[i + 1] - m_values[i]));
+    }
+}
+
+VFPAxis::Bracket VFPAxis::bracket(double x) const {
+    Bracket result;
+    if (m_values.size() == 1)
+        return result;
+
+    const auto pos = std::upper_bound(m_values.begin() + 1, m_values.end() - 1, x);
+    result.lower = std::distance(m_values.begin(), pos) - 1;
+    result.upper = result.lower + 1;
+    result.invWidth = m_invWidths[result.lower];
+    result.factor = (x - m_values[result.lower]) * result.invWidth;
+
+    return result;
+}
+
+VFPProdInterpolator::VFPProdInterpolator(const VFPProdTable& table)
+    : m_axes{{ VFPAxis(table.getTHPAxis()),
+               VFPAxis(table.getWFRAxis()),
+               VFPAxis(table.getGFRAxis()),
+               VFPAxis(table.getALQAxis()),
+               VFPAxis(table.getFloAxis()) }}
+    , m_data(&table.getTable())
+{
+    std::size_t stride = 1;
+    for (std::size_t d = m_axes.size(); d-- > 0; ) {
+        m_strides[d] = stride;
+        stride *= m_axes[d].size();
+    }
+
+    checkDataSize(*m_data, stride, "VFPPROD");
+}
+
+VFPEvaluation VFPProdInterpolator::bhp(const Point& point) const {
+    const std::array<VFPAxis::Bracket, 5> brackets {{
+        m_axes[0].bracket(point.thp),
+        m_axes[1].bracket(point.wfr),
+        m_axes[2].bracket(point.gfr),
+        m_axes[3].bracket(point.alq),
+        m_axes[4].bracket(point.flo)
+    }};
+
+    std::array<std::array<std::size_t, 2>, 5> offsets;
+    for (std::size_t d = 0; d < 5; ++d)
+        offsets[d] = {{ brackets[d].lower * m_strides[d], brackets[d].upper * m_strides[d] }};
+
+    const auto& data = *m_data;
+    std::array<double, 32> corners;
+    for (std::size_t c = 0; c < corners.size(); ++c) {
+        corners[c] = data[offsets[0][(c >> 4) & 1] + offsets[1][(c >> 3) & 1] + offsets[2][(c >> 2) & 1]
+                          + offsets[3][(c >> 1) & 1] + offsets[4][c & 1]];
+    }
+
+    const auto blend = blendCorners<5>(corners, brackets);
+
+    VFPEvaluation result;
+    result.value = blend.value;
+    result.dthp = blend.derivative[0];
+    result.dwfr = blend.derivative[1];
+    result.dgfr = blend.derivative[2];
+    result.dalq = blend.derivative[3];
+    result.dflo = blend.derivative[4];
+
+    return result;
+}
+
+void VFPProdInterpolator::bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& result) const {
+    result.resize(points.size());
+    std::transform(points.begin(), points.end(), result.begin(),
+                   [this](const Point& point) { return this->bhp(point); });
+}
+
+double VFPProdInterpolator::thp(double bhp, double flo, double wfr, double gfr, double alq) const {
+    const std::array<VFPAxis::Bracket, 4> brackets {{
+        m_axes[1].bracket(wfr),
+        m_axes[2].bracket(gfr),
+        m_axes[3].bracket(alq),
+        m_axes[4].bracket(flo)
+    }};
+
+    std::array<std::array<std::size_t, 2>, 4> offsets;
+    for (std::size_t d = 0; d < 4; ++d)
+        offsets[d] = {{ brackets[d].lower * m_strides[d + 1], brackets[d].upper * m_strides[d + 1] }};
+
+    // Within a THP interval the interpolated pressure is linear in THP, so
+    // the pressure at the THP nodes determines the inverse completely.
+    const auto& data = *m_data;
+    std::vector<double> nodeBhp(m_axes[0].size());
+    for (std::size_t t = 0; t < nodeBhp.size(); ++t) {
+        const auto base = t * m_strides[0];
+
+        std::array<double, 16> corners;
+        for (std::size_t c = 0; c < corners.size(); ++c) {
+            corners[c] = data[base + offsets[0][(c >> 3) & 1] + offsets[1][(c >> 2) & 1]
+                              + offsets[2][(c >> 1) & 1] + offsets[3][c & 1]];
+        }
+
+        nodeBhp[t] = blendCorners<4>(corners, brackets).value;
+    }
+
+    return invertPiecewiseLinear(m_axes[0], nodeBhp, bhp);
+}
+
+VFPInjInterpolator::VFPInjInterpolator(const VFPInjTable& table)
+    : m_thpAxis(table.getTHPAxis())
+    , m_floAxis(table.getFloAxis())
+    , m_data(&table.getTable())
+{
+    checkDataSize(*m_data, m_thpAxis.size() * m_floAxis.size(), "VFPINJ");
+}
+
+VFPEvaluation VFPInjInterpolator::bhp(double flo, double thp) const {
+    const std::array<VFPAxis::Bracket, 2> brackets {{
+        m_thpAxis.bracket(thp),
+        m_floAxis.bracket(flo)
+    }};
+
+    const auto& data = *m_data;
+    const auto nf = m_floAxis.size();
+    std::array<double, 4> corners {{
+        data[brackets[0].lower*nf + brackets[1].lower],
+        data[brackets[0].lower*nf + brackets[1].upper],
+        data[brackets[0].upper*nf + brackets[1].lower],
+        data[brackets[0].upper*nf + brackets[1].upper]
+    }};
+
+    const auto blend = blendCorners<2>(corners, brackets);
+
+    VFPEvaluation result;
+    result.value = blend.value;
+    result.dthp = blend.derivative[0];
+    result.dflo = blend.derivative[1];
+
+    return result;
+}
+
+void VFPInjInterpolator::bhp(const std::vector<double>& flo, const std::vector<double>& thp,
+                             std::vector<VFPEvaluation>& result) const {
+    if (flo.size() != thp.size())
+        throw std::invalid_argument("Flow rates and tubing head pressures must have the same size");
+
+    result.resize(flo.size());
+    for (std::size_t i = 0; i < flo.size(); ++i)
+        result[i] = this->bhp(flo[i], thp[i]);
+}
+
+double VFPInjInterpolator::thp(double bhp, double flo) const {
+    const std::array<VFPAxis::Bracket, 1> brackets {{ m_floAxis.bracket(flo) }};
+
+    const auto& data = *m_data;
+    const auto nf = m_floAxis.size();
+    std::vector<double> nodeBhp(m_thpAxis.size());
+    for (std::size_t t = 0; t < nodeBhp.size(); ++t) {
+        std::array<double, 2> corners {{ data[t*nf + brackets[0].lower], data[t*nf + brackets[0].upper] }};
+        nodeBhp[t] = blendCorners<1>(corners, brackets).value;
+    }
+
+    return invertPiecewiseLinear(m_thpAxis, nodeBhp, bhp);
+}
+
+}
@@ -0,0 +1,148 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_PARSER_ECLIPSE_ECLIPSESTATE_SCHEDULE_VFPINTERPOLATOR_HH_
+#define EWOMS_PARSER_ECLIPSE_ECLIPSESTATE_SCHEDULE_VFPINTERPOLATOR_HH_
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Ewoms {
+
+    class VFPInjTable;
+    class VFPProdTable;
+
+/**
+ * One axis of a VFP table. The axis values must be strictly increasing;
+ * the inverse widths of all intervals are computed up front so that
+ * bracketing a coordinate is a binary search and a multiplication.
+ */
+class VFPAxis {
+public:
+    /**
+     * Position of a coordinate on the axis: the interval [lower, upper]
+     * and the fractional position in it. Coordinates outside the axis
+     * use the first or last interval, giving a factor below zero or above
+     * one, i.e. linear extrapolation. Axes with a single value have
+     * lower == upper and a factor and inverse width of zero.
+     */
+    struct Bracket {
+        std::size_t lower = 0;
+        std::size_t upper = 0;
+        double factor = 0.0;
+        double invWidth = 0.0;
+    };
+
+    VFPAxis() = default;
+    explicit VFPAxis(const std::vector<double>& values);
+
+    std::size_t size() const {
+        return m_values.size();
+    }
+
+    double operator[](std::size_t index) const {
+        return m_values[index];
+    }
+
+    Bracket bracket(double x) const;
+
+private:
+    std::vector<double> m_values;
+    std::vector<double> m_invWidths;
+};
+
+/**
+ * Interpolated value of a VFP table and its partial derivatives with
+ * respect to the table coordinates. Derivatives with respect to
+ * coordinates the table does not have are zero.
+ */
+struct VFPEvaluation {
+    double value = 0.0;
+    double dthp = 0.0;
+    double dwfr = 0.0;
+    double dgfr = 0.0;
+    double dalq = 0.0;
+    double dflo = 0.0;
+};
+
+/**
+ * Multilinear interpolation in a VFPPROD table.
+ *
+ * All coordinates are in the units and definitions of the table, i.e. FLO,
+ * WFR, GFR and ALQ are the quantities named by the table's type fields;
+ * converting phase rates to them is up to the caller. Coordinates outside
+ * the table are extrapolated linearly. The interpolator refers to the data
+ * of the table, which must outlive it.
+ */
+class VFPProdInterpolator {
+public:
+    struct Point {
+        double flo = 0.0;
+        double thp = 0.0;
+        double wfr = 0.0;
+        double gfr = 0.0;
+        double alq = 0.0;
+    };
+
+    explicit VFPProdInterpolator(const VFPProdTable& table);
+
+    /// Bottom hole pressure and its derivatives at \p point.
+    VFPEvaluation bhp(const Point& point) const;
+
+    /// Bottom hole pressures of a batch of wells, result[i] is the
+    /// evaluation at points[i].
+    void bhp(const std::vector<Point>& points, std::vector<VFPEvaluation>& result) const;
+
+    /// Tubing head pressure for which the interpolated bottom hole
+    /// pressure at the other coordinates is \p bhp. Within the table this
+    /// is the exact inverse of bhp(); outside it the first and last THP
+    /// intervals are extrapolated. If the pressure is not monotone in THP
+    /// the smallest solution is returned.
+    double thp(double bhp, double flo, double wfr, double gfr, double alq) const;
+
+private:
+    // Axes in the storage order of the table: THP, WFR, GFR, ALQ, FLO.
+    std::array<VFPAxis, 5> m_axes;
+    std::array<std::size_t, 5> m_strides;
+    const std::vector<double>* m_data;
+};
+
+/**
+ * Linear interpolation in a VFPINJ table, see VFPProdInterpolator.
+ */
+class VFPInjInterpolator {
+public:
+    explicit VFPInjInterpolator(const VFPInjTable& table);
+
+    VFPEvaluation bhp(double flo, double thp) const;
+
+    void bhp(const std::vector<double>& flo, const std::vector<double>& thp,
+             std::vector<VFPEvaluation>& result) const;
+
+    double thp(double bhp, double flo) const;
+
+private:
+    VFPAxis m_thpAxis;
+    VFPAxis m_floAxis;
+    const std::vector<double>* m_data;
+};
+
+}
+
+#endif
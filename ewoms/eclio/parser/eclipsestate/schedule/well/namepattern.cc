@@ -0,0 +1,98 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <algorithm>
+
+#include <fnmatch.h>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
+
+namespace Ewoms {
+
+namespace {
+
+    bool is_special(char c) {
+        return c == '*' || c == '?' || c == '[' || c == '\\';
+    }
+
+    bool ends_with(const std::string& name, const std::string& suffix) {
+        return name.size() >= suffix.size()
+            && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+}
+
+NamePattern::NamePattern(const std::string& pattern) :
+    m_pattern(pattern),
+    m_kind(Kind::Generic)
+{
+    const auto num_special = std::count_if(pattern.begin(), pattern.end(), is_special);
+    const auto num_star = std::count(pattern.begin(), pattern.end(), '*');
+
+    if (num_special == 0) {
+        this->m_kind = Kind::Exact;
+        this->m_fixed = pattern;
+    } else if (num_special == num_star) {
+        if (pattern.find_first_not_of('*') == std::string::npos)
+            this->m_kind = Kind::All;
+        else if (num_star == 1 && pattern.back() == '*') {
+            this->m_kind = Kind::Prefix;
+            this->m_fixed = pattern.substr(0, pattern.size() - 1);
+        } else if (num_star == 1 && pattern.front() == '*') {
+            this->m_kind = Kind::Suffix;
+            this->m_fixed = pattern.substr(1);
+        }
+    }
+}
+
+bool NamePattern::match(const std::string& name) const {
+    switch (this->m_kind) {
+    case Kind::Exact:
+        return name == this->m_fixed;
+    case Kind::Prefix:
+        return name.compare(0, this->m_fixed.size(), this->m_fixed) == 0;
+    case Kind::Suffix:
+        return ends_with(name, this->m_fixed);
+    case Kind::All:
+        return true;
+    default:
+        return fnmatch(this->m_pattern.c_str(), name.c_str(), 0) == 0;
+    }
+}
+
+std::vector<std::string> NamePattern::filter(const std::vector<std::string>& names) const {
+    std::vector<std::string> matches;
+    std::copy_if(names.begin(), names.end(), std::back_inserter(matches),
+                 [this](const std::string& name) { return this->match(name); });
+    return matches;
+}
+
+bool NamePattern::hasWildcard() const {
+    return this->m_kind != Kind::Exact;
+}
+
+const std::string& NamePattern::pattern() const {
+    return this->m_pattern;
+}
+
+bool NamePattern::hasWildcard(const std::string& pattern) {
+    return std::any_of(pattern.begin(), pattern.end(), is_special);
+}
+
+}
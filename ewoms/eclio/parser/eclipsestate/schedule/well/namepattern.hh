@@ -0,0 +1,64 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef NAME_PATTERN_H
+#define NAME_PATTERN_H
+
+#include <string>
+#include <vector>
+
+namespace Ewoms {
+
+/*
+  Shell wildcard pattern for well, group and well list names. The pattern
+  is analyzed once when it is constructed; the common forms 'W1', 'W*',
+  '*1' and '*' are then matched with plain string comparisons, and only
+  patterns using '?', '[...]', escapes or several '*' fall back to
+  fnmatch().
+*/
+class NamePattern {
+public:
+    explicit NamePattern(const std::string& pattern);
+
+    bool match(const std::string& name) const;
+
+    // All the names from the input which match the pattern, in input order.
+    std::vector<std::string> filter(const std::vector<std::string>& names) const;
+
+    // True if the pattern contains any shell wildcard characters.
+    bool hasWildcard() const;
+    const std::string& pattern() const;
+
+    static bool hasWildcard(const std::string& pattern);
+
+private:
+    enum class Kind {
+        Exact,
+        Prefix,
+        Suffix,
+        All,
+        Generic
+    };
+
+    std::string m_pattern;
+    std::string m_fixed;
+    Kind m_kind;
+};
+
+}
+#endif
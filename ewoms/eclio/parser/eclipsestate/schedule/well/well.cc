@@ -26,6 +26,7 @@
 #include <ewoms/eclio/output/vectoritems/well.hh>
 #include <ewoms/eclio/parser/parserkeywords/w.hh>
 #include <ewoms/eclio/parser/eclipsestate/runspec.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/well.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/udq/udqactive.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wellinjectionproperties.hh>
@@ -34,7 +35,6 @@
 
 #include "../msw/compsegs.hh"
 
-#include <fnmatch.h>
 #include <cmath>
 #include <ostream>
 #include <stdexcept>
@@ -1386,11 +1386,7 @@ double Well::injection_rate(const SummaryState& st, Phase phase_arg) const {
 }
 
 bool Well::wellNameInWellNamePattern(const std::string& wellName, const std::string& wellNamePattern) {
-    bool wellNameInPattern = false;
-    if (fnmatch( wellNamePattern.c_str() , wellName.c_str() , 0 ) == 0) {
-        wellNameInPattern = true;
-    }
-    return wellNameInPattern;
+    return NamePattern(wellNamePattern).match(wellName);
 }
 
 Well::ProductionControls Well::productionControls(const SummaryState& st) const {
@@ -19,8 +19,9 @@
 #include "config.h"
 
 #include <algorithm>
+#include <utility>
 
-#include <fnmatch.h>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wellmatcher.hh>
 
 namespace Ewoms {
@@ -39,6 +40,20 @@ const std::vector<std::string>& WellMatcher::wells() const {
 }
 
 std::vector<std::string> WellMatcher::wells(const std::string& pattern) const {
+    {
+        std::lock_guard<std::mutex> lock(this->m_matches->mutex);
+        auto match_iter = this->m_matches->matches.find(pattern);
+        if (match_iter != this->m_matches->matches.end())
+            return match_iter->second;
+    }
+
+    auto matches = this->match(pattern);
+
+    std::lock_guard<std::mutex> lock(this->m_matches->mutex);
+    return this->m_matches->matches.emplace(pattern, std::move(matches)).first->second;
+}
+
+std::vector<std::string> WellMatcher::match(const std::string& pattern) const {
     if (pattern.size() == 0)
         return {};
 
@@ -48,15 +63,8 @@ std::vector<std::string> WellMatcher::wells(const std::string& pattern) const {
 
     // Normal pattern matching
     auto star_pos = pattern.find('*');
-    if (star_pos != std::string::npos) {
-        std::vector<std::string> names;
-        for (const auto& wname : this->m_wells) {
-            int flags = 0;
-            if (fnmatch(pattern.c_str(), wname.c_str(), flags) == 0)
-                names.push_back(wname);
-        }
-        return names;
-    }
+    if (star_pos != std::string::npos)
+        return NamePattern(pattern).filter(this->m_wells);
 
     auto name_iter = std::find(this->m_wells.begin(), this->m_wells.end(), pattern);
     if (name_iter != this->m_wells.end())
@@ -19,13 +19,23 @@
 #ifndef WELL_MATCHER_H
 #define WELL_MATCHER_H
 
-#include <vector>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlistmanager.hh>
+#include <ewoms/eclio/utility/resetoncopy.hh>
 
 namespace Ewoms {
 
+/*
+  Resolves well name patterns against the wells present at one report
+  step. The result for each pattern is computed once and cached, since the
+  same pattern is typically used by many keywords of one report step. The
+  cache is guarded by a mutex, so a const matcher can be shared between
+  threads.
+*/
 class WellMatcher {
 public:
     WellMatcher() = default;
@@ -35,8 +45,18 @@ public:
     std::vector<std::string> wells(const std::string& pattern) const;
 
 private:
+    std::vector<std::string> match(const std::string& pattern) const;
+
     std::vector<std::string> m_wells;
     WListManager m_wlm;
+
+    struct MatchCache {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::vector<std::string>> matches;
+    };
+
+    // A copied or assigned matcher starts out with an empty cache.
+    ResetOnCopy<MatchCache> m_matches;
 };
 
 }
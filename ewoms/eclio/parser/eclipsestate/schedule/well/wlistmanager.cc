@@ -18,10 +18,9 @@
 */
 #include "config.h"
 
-#include <fnmatch.h>
-
 #include <unordered_set>
 
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlist.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlistmanager.hh>
 namespace Ewoms {
@@ -69,13 +68,11 @@ namespace Ewoms {
             return { wlist.begin(), wlist.end() };
         } else {
             std::unordered_set<std::string> well_set;
-            auto pattern = wlist_pattern.substr(1);
+            const NamePattern pattern(wlist_pattern.substr(1));
             for (const auto& wlistItem : this->wlists) {
                 const auto& name = wlistItem.first;
                 const auto& wlist = wlistItem.second;
-                auto wlist_name = name.substr(1);
-                int flags = 0;
-                if (fnmatch(pattern.c_str(), wlist_name.c_str(), flags) == 0)
+                if (pattern.match(name.substr(1)))
                     well_set.insert(wlist.begin(), wlist.end());
             }
             return { well_set.begin(), well_set.end() };
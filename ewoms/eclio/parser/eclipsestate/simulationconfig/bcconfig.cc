@@ -109,8 +109,8 @@ bool BCConfig::BCFace::operator==(const BCConfig::BCFace& other) const {
 }
 
 BCConfig::BCConfig(const Deck& deck) {
-    for (const auto& kw: deck.getKeywordList<ParserKeywords::BC>()) {
-        for (const auto& record : *kw)
+    for (const auto& kw: deck.keywords<ParserKeywords::BC>()) {
+        for (const auto& record : kw)
             this->m_faces.emplace_back( record );
     }
 }
@@ -46,6 +46,7 @@ namespace Ewoms {
         result.m_values = {1.0, 2.0};
         result.m_default = {false, true};
         result.m_defaultCount = 2;
+        result.updateExtrema();
 
         return result;
     }
@@ -92,6 +93,7 @@ namespace Ewoms {
         assertUpdate( m_values.size() , value );
         m_values.push_back( value );
         m_default.push_back( false );
+        updateExtrema( m_values.size() - 1 );
     }
 
     void TableColumn::addDefault() {
@@ -110,11 +112,54 @@ namespace Ewoms {
 
     void TableColumn::updateValue(  size_t index , double value ) {
         assertUpdate( index , value );
+        const bool wasExtremum = !m_default[index] && ((index == m_minIndex) || (index == m_maxIndex));
+
         m_values[index] = value;
         if (m_default[index]) {
             m_default[index] = false;
             m_defaultCount -= 1;
         }
+
+        if (wasExtremum)
+            updateExtrema();
+        else
+            updateExtrema( index );
+    }
+
+    void TableColumn::updateExtrema() {
+        bool first = true;
+        for (size_t index = 0; index < m_values.size(); ++index) {
+            if (m_default[index])
+                continue;
+
+            if (first) {
+                m_minIndex = m_maxIndex = index;
+                first = false;
+            } else {
+                if (m_values[index] < m_values[m_minIndex])
+                    m_minIndex = index;
+
+                if (m_values[index] > m_values[m_maxIndex])
+                    m_maxIndex = index;
+            }
+        }
+    }
+
+    void TableColumn::updateExtrema(size_t index) {
+        // Only the value at index has been set; ties go to the first
+        // position, as with std::min_element() and std::max_element().
+        const double value = m_values[index];
+
+        if (m_values.size() - m_defaultCount == 1) {
+            m_minIndex = m_maxIndex = index;
+            return;
+        }
+
+        if ((value < m_values[m_minIndex]) || ((value == m_values[m_minIndex]) && (index < m_minIndex)))
+            m_minIndex = index;
+
+        if ((value > m_values[m_maxIndex]) || ((value == m_values[m_maxIndex]) && (index < m_maxIndex)))
+            m_maxIndex = index;
     }
 
     bool TableColumn::defaultApplied(size_t index) const {
@@ -146,7 +191,7 @@ namespace Ewoms {
         if (hasDefault())
             throw std::invalid_argument("Can not lookup elements in a column with defaulted values.");
         if (m_values.size() > 0)
-            return *std::max_element( m_values.begin() , m_values.end());
+            return m_values[m_maxIndex];
         else
             throw std::invalid_argument("Can not find max in empty column");
     }
@@ -155,7 +200,7 @@ namespace Ewoms {
         if (hasDefault())
             throw std::invalid_argument("Can not lookup elements in a column with defaulted values.");
         if (m_values.size() > 0)
-            return *std::min_element( m_values.begin() , m_values.end());
+            return m_values[m_minIndex];
         else
             throw std::invalid_argument("Can not find max in empty column");
     }
@@ -174,7 +219,7 @@ namespace Ewoms {
             throw std::invalid_argument("Minimum size 2 ");
     }
 
-    TableIndex TableColumn::lookup( double argValue ) const {
+    void TableColumn::assertLookup() const {
         if (!m_schema.lookupValid( ))
             throw std::invalid_argument("Must have an ordered column to perform table argument lookup.");
 
@@ -183,25 +228,34 @@ namespace Ewoms {
 
         if (hasDefault())
             throw std::invalid_argument("Can not lookup elements in a column with defaulted values.");
+    }
 
-        if (argValue >= max()) {
-            const auto max_iter = std::max_element( m_values.begin() , m_values.end());
-            const size_t max_index = max_iter - m_values.begin();
-            return TableIndex( max_index , 1.0 );
-        }
+    bool TableColumn::inInterval(size_t interval, double argValue) const {
+        if (m_schema.isDecreasing( ))
+            return (m_values[interval] >= argValue) && (argValue > m_values[interval + 1]);
+        else
+            return (m_values[interval] < argValue) && (argValue <= m_values[interval + 1]);
+    }
 
-        if (argValue <= min()) {
-            const auto min_iter = std::min_element( m_values.begin() , m_values.end());
-            const size_t min_index = min_iter - m_values.begin();
-            return TableIndex( min_index , 1.0 );
-        }
+    TableIndex TableColumn::interpolate(size_t interval, double argValue) const {
+        double weight1 = 1 - (argValue - m_values[interval])/(m_values[interval + 1] - m_values[interval]);
+        return TableIndex( interval , weight1 );
+    }
+
+    TableIndex TableColumn::lookup( double argValue ) const {
+        assertLookup();
+
+        if (argValue >= m_values[m_maxIndex])
+            return TableIndex( m_maxIndex , 1.0 );
+
+        if (argValue <= m_values[m_minIndex])
+            return TableIndex( m_minIndex , 1.0 );
 
         {
             bool isDescending = m_schema.isDecreasing( );
             size_t lowIntervalIdx = 0;
             size_t intervalIdx = (size() - 1)/2;
             size_t highIntervalIdx = size() - 1;
-            double weight1;
 
             while (lowIntervalIdx + 1 < highIntervalIdx) {
                 if (isDescending) {
@@ -220,10 +274,61 @@ namespace Ewoms {
                 intervalIdx = (highIntervalIdx + lowIntervalIdx)/2;
             }
 
-            weight1 = 1 - (argValue - m_values[intervalIdx])/(m_values[intervalIdx + 1] - m_values[intervalIdx]);
+            return interpolate( intervalIdx , argValue );
+        }
+    }
+
+    TableColumn::LookupCursor TableColumn::cursor() const {
+        return LookupCursor( *this );
+    }
+
+    TableColumn::LookupCursor::LookupCursor(const TableColumn& column) :
+        column_( &column ),
+        interval_( 0 )
+    {
+    }
+
+    TableIndex TableColumn::LookupCursor::lookup( double argValue ) {
+        // Intervals tried on either side of the previous one before
+        // falling back to a binary search.
+        const int maxSteps = 8;
+
+        const auto& column = *column_;
+        column.assertLookup();
+
+        if (argValue >= column.m_values[column.m_maxIndex])
+            return TableIndex( column.m_maxIndex , 1.0 );
+
+        if (argValue <= column.m_values[column.m_minIndex])
+            return TableIndex( column.m_minIndex , 1.0 );
+
+        if (column.size() >= 2) {
+            const bool isDescending = column.m_schema.isDecreasing( );
+            const size_t lastInterval = column.size() - 2;
+            size_t interval = std::min( interval_ , lastInterval );
 
-            return TableIndex( intervalIdx , weight1 );
+            for (int step = 0; step < maxSteps; ++step) {
+                if (column.inInterval( interval , argValue )) {
+                    interval_ = interval;
+                    return column.interpolate( interval , argValue );
+                }
+
+                const bool forward = isDescending
+                    ? (argValue <= column.m_values[interval + 1])
+                    : (argValue > column.m_values[interval + 1]);
+
+                if (forward && (interval < lastInterval))
+                    ++interval;
+                else if (!forward && (interval > 0))
+                    --interval;
+                else
+                    break;
+            }
         }
+
+        const auto index = column.lookup( argValue );
+        interval_ = index.getIndex1();
+        return index;
     }
 
     std::vector<double>::const_iterator TableColumn::begin() const {
@@ -259,6 +364,8 @@ namespace Ewoms {
             m_values = other.m_values;
             m_default = other.m_default;
             m_defaultCount = other.m_defaultCount;
+            m_minIndex = other.m_minIndex;
+            m_maxIndex = other.m_maxIndex;
         }
         return *this;
     }
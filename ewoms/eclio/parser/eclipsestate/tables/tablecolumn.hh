@@ -56,6 +56,31 @@ namespace Ewoms {
            is out of range.
         */
         TableIndex lookup(double argValue) const;
+
+        /*
+          Lookup for a sequence of arguments which are close to each
+          other, e.g. sorted cell values or successive time steps.  The
+          cursor remembers the interval of the previous lookup and starts
+          searching from there, falling back to the binary search of
+          TableColumn::lookup() if the argument is not in a nearby
+          interval.  The results are identical to TableColumn::lookup().
+
+          A cursor refers to its column, which must not be changed or
+          destroyed while the cursor is in use.
+        */
+        class LookupCursor {
+        public:
+            explicit LookupCursor(const TableColumn& column);
+
+            TableIndex lookup(double argValue);
+
+        private:
+            const TableColumn* column_;
+            size_t interval_;
+        };
+
+        LookupCursor cursor() const;
+
         double eval( const TableIndex& index) const;
         void applyDefaults( const TableColumn& argColumn );
         void assertUnitRange() const;
@@ -75,18 +100,31 @@ namespace Ewoms {
             serializer(m_values);
             serializer(m_default);
             serializer(m_defaultCount);
+            if (!serializer.isSerializing())
+                updateExtrema();
         }
 
     private:
         void assertUpdate(size_t index, double value) const;
         void assertPrevious(size_t index , double value) const;
         void assertNext(size_t index , double value) const;
+        void assertLookup() const;
+        bool inInterval(size_t interval, double argValue) const;
+        TableIndex interpolate(size_t interval, double argValue) const;
+
+        void updateExtrema();
+        void updateExtrema(size_t index);
 
         ColumnSchema m_schema;
         std::string m_name;
         std::vector<double> m_values;
         std::vector<bool> m_default;
         size_t m_defaultCount;
+
+        // Position of the first smallest and first largest non-defaulted
+        // value, kept up to date on every change.
+        size_t m_minIndex = 0;
+        size_t m_maxIndex = 0;
     };
 
 }
@@ -677,9 +677,9 @@ namespace Ewoms {
         }
 
         const size_t num_tables = deck.count("PLYMWINJ");
-        const auto& keywords = deck.getKeywordList<ParserKeywords::PLYMWINJ>();
+        const auto keywords = deck.keywords<ParserKeywords::PLYMWINJ>();
         for (size_t i = 0; i < num_tables; ++i) {
-            const DeckKeyword &keyword = *keywords[i];
+            const DeckKeyword &keyword = keywords[i];
 
             // not const for std::move
             PlymwinjTable table(keyword);
@@ -707,9 +707,9 @@ namespace Ewoms {
         }
 
         const size_t num_tables = deck.count("SKPRWAT");
-        const auto& keywords = deck.getKeywordList<ParserKeywords::SKPRWAT>();
+        const auto keywords = deck.keywords<ParserKeywords::SKPRWAT>();
         for (size_t i = 0; i < num_tables; ++i) {
-            const DeckKeyword &keyword = *keywords[i];
+            const DeckKeyword &keyword = keywords[i];
 
             // not const for std::move
             SkprwatTable table(keyword);
@@ -737,9 +737,9 @@ namespace Ewoms {
         }
 
         const size_t num_tables = deck.count("SKPRPOLY");
-        const auto& keywords = deck.getKeywordList<ParserKeywords::SKPRPOLY>();
+        const auto keywords = deck.keywords<ParserKeywords::SKPRPOLY>();
         for (size_t i = 0; i < num_tables; ++i) {
-            const DeckKeyword &keyword = *keywords[i];
+            const DeckKeyword &keyword = keywords[i];
 
             // not const for std::move
             SkprpolyTable table(keyword);
@@ -1200,10 +1200,9 @@ namespace Ewoms {
 
     void TableManager::complainAboutAmbiguousKeyword(const Deck& deck, const std::string& keywordName) {
         OpmLog::error("The " + keywordName + " keyword must be unique in the deck. Ignoring all!");
-        const auto& keywords = deck.getKeywordList(keywordName);
-        for (size_t i = 0; i < keywords.size(); ++i) {
+        for (const auto& keyword : deck.keywords(keywordName)) {
             std::string msg = "Ambiguous keyword "+keywordName+" defined here";
-            OpmLog::error(Log::fileMessage(keywords[i]->location(), msg));
+            OpmLog::error(Log::fileMessage(keyword.location(), msg));
         }
     }
 
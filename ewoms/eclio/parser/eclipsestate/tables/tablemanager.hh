@@ -69,10 +69,12 @@ namespace Ewoms {
         TableManager() = default;
 
         TableManager(const TableManager& t2) { *this = t2; }
+        TableManager(TableManager&& t2) = default;
 
         static TableManager serializeObject();
 
         TableManager& operator=(const TableManager& data);
+        TableManager& operator=(TableManager&& data) = default;
 
         const TableContainer& getTables( const std::string& tableName ) const;
         const TableContainer& operator[](const std::string& tableName) const;
@@ -0,0 +1,85 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/parser/units/conversionkernels.hh>
+
+#include <ewoms/eclio/utility/taskgraph.hh>
+
+#include <algorithm>
+
+namespace {
+
+    void scaleShiftRange(const double* src, double* dst, const std::size_t size,
+                         const double factor, const double offset)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = factor*src[i] + offset;
+    }
+
+    void shiftScaleRange(const double* src, double* dst, const std::size_t size,
+                         const double offset, const double factor)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            dst[i] = factor*(src[i] - offset);
+    }
+
+    template <typename Kernel>
+    void runChunked(const double* src, double* dst, const std::size_t size, Kernel&& kernel)
+    {
+        const auto numThreads = Ewoms::TaskGraph::hardwareThreads();
+        if ((size <= Ewoms::ConversionKernels::parallelConversionThreshold) || (numThreads <= 1)) {
+            kernel(src, dst, size);
+            return;
+        }
+
+        const auto chunkSize = (size + numThreads - 1) / numThreads;
+
+        Ewoms::TaskGraph tasks;
+        for (std::size_t begin = 0; begin < size; begin += chunkSize) {
+            const auto n = std::min(chunkSize, size - begin);
+            tasks.addTask([=, &kernel]() { kernel(src + begin, dst + begin, n); });
+        }
+
+        tasks.run(numThreads);
+    }
+
+}
+
+namespace Ewoms { namespace ConversionKernels {
+
+    void scaleShift(const double* src, double* dst, const std::size_t size,
+                    const double factor, const double offset)
+    {
+        runChunked(src, dst, size, [factor, offset](const double* s, double* d, const std::size_t n)
+        {
+            scaleShiftRange(s, d, n, factor, offset);
+        });
+    }
+
+    void shiftScale(const double* src, double* dst, const std::size_t size,
+                    const double offset, const double factor)
+    {
+        runChunked(src, dst, size, [offset, factor](const double* s, double* d, const std::size_t n)
+        {
+            shiftScaleRange(s, d, n, offset, factor);
+        });
+    }
+
+}}
@@ -0,0 +1,52 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_CONVERSIONKERNELS_H
+#define EWOMS_CONVERSIONKERNELS_H
+
+#include <cstddef>
+
+namespace Ewoms {
+
+    /*
+      Linear unit conversion of whole arrays.  The loops carry no per
+      element dispatch and are written for the compiler to vectorize; the
+      arithmetic is the same as in the scalar conversions of UnitSystem and
+      Dimension, so the results are identical to converting element by
+      element.  Arrays of more than parallelConversionThreshold elements
+      are split between the hardware threads.
+
+      The source and destination may be the same array, but must not
+      otherwise overlap.
+    */
+    namespace ConversionKernels {
+
+        constexpr std::size_t parallelConversionThreshold = std::size_t{1} << 20;
+
+        /// dst[i] = factor*src[i] + offset
+        void scaleShift(const double* src, double* dst, std::size_t size,
+                        double factor, double offset);
+
+        /// dst[i] = factor*(src[i] - offset)
+        void shiftScale(const double* src, double* dst, std::size_t size,
+                        double offset, double factor);
+
+    }
+}
+
+#endif
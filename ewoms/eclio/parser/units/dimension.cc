@@ -19,6 +19,7 @@
 #include "config.h"
 
 #include <ewoms/eclio/parser/units/dimension.hh>
+#include <ewoms/eclio/parser/units/conversionkernels.hh>
 
 #include <string>
 #include <stdexcept>
@@ -64,6 +65,17 @@ namespace Ewoms {
         return rawValue*m_SIfactor + m_SIoffset;
     }
 
+    void Dimension::convertRawToSi(const double* rawValues, double* siValues, std::size_t size) const {
+        if (size == 0)
+            return;
+
+        if (!std::isfinite(m_SIfactor))
+            throw std::logic_error("The DeckItem contains a field with a context dependent unit. "
+                                   "Use getData< double >() and convert the returned value manually!");
+
+        ConversionKernels::scaleShift(rawValues, siValues, size, m_SIfactor, m_SIoffset);
+    }
+
     double Dimension::convertSiToRaw(double siValue) const {
         if (!std::isfinite(m_SIfactor))
             throw std::logic_error("The DeckItem contains a field with a context dependent unit. "
@@ -19,6 +19,7 @@
 #ifndef DIMENSION_H
 #define DIMENSION_H
 
+#include <cstddef>
 #include <string>
 
 namespace Ewoms {
@@ -37,6 +38,10 @@ namespace Ewoms {
         double convertRawToSi(double rawValue) const;
         double convertSiToRaw(double siValue) const;
 
+        /// Convert \p size raw values to SI; \p rawValues and \p siValues
+        /// may be the same array.
+        void convertRawToSi(const double* rawValues, double* siValues, std::size_t size) const;
+
         bool equal(const Dimension& other) const;
         bool isCompositable() const;
 
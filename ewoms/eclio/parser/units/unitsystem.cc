@@ -21,6 +21,7 @@
 #include <ewoms/eclio/parser/units/unitsystem.hh>
 
 #include <ewoms/common/string.hh>
+#include <ewoms/eclio/parser/units/conversionkernels.hh>
 #include <ewoms/eclio/parser/units/dimension.hh>
 #include <ewoms/eclio/parser/units/units.hh>
 
@@ -955,6 +956,32 @@ namespace {
         init();
     }
 
+    UnitSystem::UnitSystem(const UnitSystem& other) :
+        m_name( other.m_name ),
+        m_unittype( other.m_unittype ),
+        m_dimensions( other.m_dimensions ),
+        measure_table_to_si_offset( other.measure_table_to_si_offset ),
+        measure_table_from_si( other.measure_table_from_si ),
+        measure_table_to_si( other.measure_table_to_si ),
+        unit_name_table( other.unit_name_table ),
+        conversions( other.conversions ),
+        m_use_count( other.m_use_count.load() )
+    {
+    }
+
+    UnitSystem& UnitSystem::operator=(const UnitSystem& other) {
+        this->m_name = other.m_name;
+        this->m_unittype = other.m_unittype;
+        this->m_dimensions = other.m_dimensions;
+        this->measure_table_to_si_offset = other.measure_table_to_si_offset;
+        this->measure_table_from_si = other.measure_table_from_si;
+        this->measure_table_to_si = other.measure_table_to_si;
+        this->unit_name_table = other.unit_name_table;
+        this->conversions = other.conversions;
+        this->m_use_count = other.m_use_count.load();
+        return *this;
+    }
+
     UnitSystem UnitSystem::serializeObject()
     {
         return UnitSystem(UnitType::UNIT_TYPE_METRIC);
@@ -1330,30 +1357,28 @@ namespace {
         return !( *this == rhs );
     }
 
-    double UnitSystem::from_si( measure m, double val ) const {
-        return
-            this->measure_table_from_si[ static_cast< int >( m ) ]
-            * (val - this->measure_table_to_si_offset[ static_cast< int >( m ) ]);
+    void UnitSystem::Conversion::to_si(const double* src, double* dst, std::size_t size) const {
+        ConversionKernels::scaleShift(src, dst, size, this->to_si_factor, this->offset);
     }
 
-    double UnitSystem::to_si( measure m, double val ) const {
-        return
-            this->measure_table_to_si[ static_cast< int >( m ) ]*val
-            + this->measure_table_to_si_offset[ static_cast< int >( m ) ];
+    void UnitSystem::Conversion::from_si(const double* src, double* dst, std::size_t size) const {
+        ConversionKernels::shiftScale(src, dst, size, this->offset, this->from_si_factor);
     }
 
     void UnitSystem::from_si( measure m, std::vector<double>& data ) const {
-        double factor = this->measure_table_from_si[ static_cast< int >( m ) ];
-        double offset = this->measure_table_to_si_offset[ static_cast< int >( m ) ];
-        auto scale = [=](double x) { return (x - offset) * factor; };
-        std::transform( data.begin() , data.end() , data.begin() , scale);
+        this->from_si( m, data.data(), data.size() );
     }
 
     void UnitSystem::to_si( measure m, std::vector<double>& data) const {
-        double factor = this->measure_table_to_si[ static_cast< int >( m ) ];
-        double offset = this->measure_table_to_si_offset[ static_cast< int >( m ) ];
-        auto scale = [=](double x) { return x * factor + offset; };
-        std::transform( data.begin() , data.end() , data.begin() , scale);
+        this->to_si( m, data.data(), data.size() );
+    }
+
+    void UnitSystem::from_si( measure m, double* data, std::size_t size ) const {
+        this->conversion( m ).from_si( data, data, size );
+    }
+
+    void UnitSystem::to_si( measure m, double* data, std::size_t size ) const {
+        this->conversion( m ).to_si( data, data, size );
     }
 
     const char* UnitSystem::name( measure m ) const {
@@ -1412,6 +1437,12 @@ namespace {
                 throw std::runtime_error("Tried to construct UnitSystem with unknown unit family.");
                 break;
         };
+
+        for (std::size_t m = 0; m < this->conversions.size(); ++m) {
+            this->conversions[m].to_si_factor = this->measure_table_to_si[m];
+            this->conversions[m].from_si_factor = this->measure_table_from_si[m];
+            this->conversions[m].offset = this->measure_table_to_si_offset[m];
+        }
     }
 
 }
@@ -19,6 +19,9 @@
 #ifndef UNITSYSTEM_H
 #define UNITSYSTEM_H
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <string>
 #include <map>
 #include <vector>
@@ -79,9 +82,28 @@ namespace Ewoms {
             _count // New entries must be added *before* this
         };
 
+        /*
+          Factor and offset of one measure.  Callers converting many values
+          of the same measure capture this once from conversion() instead
+          of looking up the measure for every value.
+        */
+        struct Conversion {
+            double to_si_factor = 1.0;
+            double from_si_factor = 1.0;
+            double offset = 0.0;
+
+            double to_si(double value) const { return this->to_si_factor*value + this->offset; }
+            double from_si(double value) const { return this->from_si_factor*(value - this->offset); }
+
+            void to_si(const double* src, double* dst, std::size_t size) const;
+            void from_si(const double* src, double* dst, std::size_t size) const;
+        };
+
         explicit UnitSystem(int ecl_id);
         explicit UnitSystem(UnitType unit = UnitType::UNIT_TYPE_METRIC);
         explicit UnitSystem(const std::string& deck_name);
+        UnitSystem(const UnitSystem& other);
+        UnitSystem& operator=(const UnitSystem& other);
 
         static UnitSystem serializeObject();
 
@@ -103,10 +125,14 @@ namespace Ewoms {
 
         Dimension parse(const std::string& dimension) const;
 
-        double from_si( measure, double ) const;
-        double to_si( measure, double ) const;
+        double from_si( measure m, double val ) const { return this->conversion( m ).from_si( val ); }
+        double to_si( measure m, double val ) const { return this->conversion( m ).to_si( val ); }
         void from_si( measure, std::vector<double>& ) const;
         void to_si( measure, std::vector<double>& ) const;
+        void from_si( measure, double* data, std::size_t size ) const;
+        void to_si( measure, double* data, std::size_t size ) const;
+
+        const Conversion& conversion( measure m ) const { return this->conversions[ static_cast< int >( m ) ]; }
         const char* name( measure ) const;
         std::string deck_name() const;
         std::size_t use_count() const;
@@ -124,9 +150,14 @@ namespace Ewoms {
             serializer(m_name);
             serializer(m_unittype);
             serializer.map(m_dimensions);
-            serializer(m_use_count);
-            if (!serializer.isSerializing())
+            if (serializer.isSerializing())
+                serializer(m_use_count.load());
+            else {
+                std::size_t use_count = 0;
+                serializer(use_count);
+                m_use_count = use_count;
                 init();
+            }
         }
 
     private:
@@ -146,6 +177,9 @@ namespace Ewoms {
         const double* measure_table_to_si;
         const char* const*  unit_name_table;
 
+        // Built from the measure tables above by init().
+        std::array<Conversion, static_cast<std::size_t>(measure::_count)> conversions;
+
         /*
           The active unit system is determined runtime, to be certain that we do
           not end up in a situation where we first use the default unit system,
@@ -157,8 +191,10 @@ namespace Ewoms {
              if (current.use_count() > 0)
                   throw std::logic_error("Sorry - can not change unit system halways");
 
+          The count is updated from const member functions, which may be
+          called concurrently, hence the atomic.
         */
-        mutable std::size_t m_use_count = 0;
+        mutable std::atomic<std::size_t> m_use_count{0};
     };
 }
 
@@ -0,0 +1,50 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_RESET_ON_COPY_H
+#define EWOMS_RESET_ON_COPY_H
+
+#include <memory>
+
+namespace Ewoms {
+
+    /*
+      Holds a cache which is not part of the state of its owner, e.g. one
+      which carries a mutex. The cache type itself need not be copyable:
+      copying or assigning the holder gives the target a new, default
+      constructed cache, so the owner can keep its implicit copy semantics.
+    */
+    template <typename Cache>
+    class ResetOnCopy {
+    public:
+        ResetOnCopy() : m_cache(std::make_unique<Cache>()) {}
+        ResetOnCopy(const ResetOnCopy&) : ResetOnCopy() {}
+        ResetOnCopy& operator=(const ResetOnCopy&) {
+            this->m_cache = std::make_unique<Cache>();
+            return *this;
+        }
+
+        Cache& operator*() const { return *this->m_cache; }
+        Cache* operator->() const { return this->m_cache.get(); }
+
+    private:
+        std::unique_ptr<Cache> m_cache;
+    };
+}
+
+#endif
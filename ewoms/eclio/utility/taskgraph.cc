@@ -0,0 +1,129 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/utility/taskgraph.hh>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace Ewoms {
+
+    TaskGraph::TaskId TaskGraph::addTask(std::function<void()> work, const std::vector<TaskId>& dependencies) {
+        const TaskId id = this->m_tasks.size();
+        for (const auto& dep : dependencies) {
+            if (dep >= id)
+                throw std::invalid_argument("A task can only depend on previously added tasks");
+        }
+
+        Task task;
+        task.work = std::move(work);
+        task.num_dependencies = dependencies.size();
+        this->m_tasks.push_back(std::move(task));
+
+        for (const auto& dep : dependencies)
+            this->m_tasks[dep].dependents.push_back(id);
+
+        return id;
+    }
+
+    std::size_t TaskGraph::size() const {
+        return this->m_tasks.size();
+    }
+
+    std::size_t TaskGraph::hardwareThreads() {
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    void TaskGraph::run(std::size_t num_threads) {
+        num_threads = std::min(num_threads, this->m_tasks.size());
+        if (num_threads <= 1) {
+            for (auto& task : this->m_tasks)
+                task.work();
+            return;
+        }
+
+        std::vector<std::size_t> remaining;
+        std::deque<TaskId> ready;
+        for (TaskId id = 0; id < this->m_tasks.size(); id++) {
+            remaining.push_back(this->m_tasks[id].num_dependencies);
+            if (remaining.back() == 0)
+                ready.push_back(id);
+        }
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::size_t running = 0;
+        std::exception_ptr error;
+
+        auto worker = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                cond.wait(lock, [&]() { return !ready.empty() || running == 0; });
+                if (ready.empty())
+                    return;
+
+                const TaskId id = ready.front();
+                ready.pop_front();
+                running += 1;
+
+                lock.unlock();
+                std::exception_ptr task_error;
+                try {
+                    this->m_tasks[id].work();
+                }
+                catch (...) {
+                    task_error = std::current_exception();
+                }
+                lock.lock();
+
+                running -= 1;
+                if (task_error) {
+                    if (!error)
+                        error = task_error;
+                    ready.clear();
+                }
+                else if (!error) {
+                    for (const auto& dependent : this->m_tasks[id].dependents) {
+                        remaining[dependent] -= 1;
+                        if (remaining[dependent] == 0)
+                            ready.push_back(dependent);
+                    }
+                }
+                cond.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 1; thread < num_threads; thread++)
+            threads.emplace_back(worker);
+
+        worker();
+        for (auto& thread : threads)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,65 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EWOMS_TASKGRAPH_H
+#define EWOMS_TASKGRAPH_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Ewoms {
+
+    /*
+      A set of tasks with dependencies between them. When the graph is run
+      every task is started as soon as all the tasks it depends on have
+      completed, using a fixed number of threads. A task can only depend on
+      tasks which have been added before it, so the graph is always acyclic
+      and insertion order is a valid sequential execution order.
+
+      If a task throws, no further tasks are started; the tasks already
+      running are completed and the first exception is rethrown from run().
+    */
+    class TaskGraph {
+    public:
+        using TaskId = std::size_t;
+
+        TaskId addTask(std::function<void()> task, const std::vector<TaskId>& dependencies = {});
+        std::size_t size() const;
+
+        /*
+          Run all tasks; with num_threads <= 1 the tasks are run on the
+          calling thread in the order they were added.
+        */
+        void run(std::size_t num_threads);
+
+        /// The number of threads supported by the hardware, at least one.
+        static std::size_t hardwareThreads();
+
+    private:
+        struct Task {
+            std::function<void()> work;
+            std::vector<TaskId> dependents;
+            std::size_t num_dependencies = 0;
+        };
+
+        std::vector<Task> m_tasks;
+    };
+}
+
+#endif
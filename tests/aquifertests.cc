@@ -27,6 +27,13 @@
 #include <ewoms/eclio/parser/eclipsestate/aquifetp.hh>
 #include <ewoms/eclio/parser/eclipsestate/aquiferconfig.hh>
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
 using namespace Ewoms;
 
 EclipseGrid makeGrid() {
@@ -376,6 +383,176 @@ BOOST_AUTO_TEST_CASE(AquanconTest_ALLOW_AQUIFER_INSIDE_OR_NOT) {
     BOOST_CHECK_EQUAL(cells2.size() , 1U);
 }
 
+namespace {
+
+/*
+  Connections computed cell by cell through a map on global index, like
+  Aquancon did originally. Cells of every aquifer are sorted on global index.
+*/
+std::map<int, std::vector<Aquancon::AquancCell>> referenceAquancon(const EclipseGrid& grid, const Deck& deck) {
+    auto neighbourActive = [&grid](int i, int j, int k, FaceDir::DirEnum faceDir) {
+        switch (faceDir) {
+        case FaceDir::XMinus: --i; break;
+        case FaceDir::XPlus:  ++i; break;
+        case FaceDir::YMinus: --j; break;
+        case FaceDir::YPlus:  ++j; break;
+        case FaceDir::ZMinus: --k; break;
+        case FaceDir::ZPlus:  ++k; break;
+        }
+
+        if (i < 0 || j < 0 || k < 0 || std::size_t(i) >= grid.getNX()
+            || std::size_t(j) >= grid.getNY() || std::size_t(k) >= grid.getNZ())
+            return false;
+
+        return grid.cellActive(i, j, k);
+    };
+
+    std::map<std::size_t, Aquancon::AquancCell> work;
+    for (const auto* keyword : deck.getKeywordList("AQUANCON")) {
+        for (const auto& record : *keyword) {
+            const int aquiferID = record.getItem("AQUIFER_ID").get<int>(0);
+            const auto faceDir = FaceDir::FromString(record.getItem("FACE").getTrimmedString(0));
+            const bool inside = DeckItem::to_bool(record.getItem("CONNECT_ADJOINING_ACTIVE_CELL").getTrimmedString(0));
+            const double influx_mult = record.getItem("INFLUX_MULT").getSIDouble(0);
+
+            auto influx_coeff = std::make_pair(false, 0.0);
+            if (record.getItem("INFLUX_COEFF").hasValue(0))
+                influx_coeff = std::make_pair(true, record.getItem("INFLUX_COEFF").getSIDouble(0));
+
+            for (int k = record.getItem("K1").get<int>(0) - 1; k < record.getItem("K2").get<int>(0); k++) {
+                for (int j = record.getItem("J1").get<int>(0) - 1; j < record.getItem("J2").get<int>(0); j++) {
+                    for (int i = record.getItem("I1").get<int>(0) - 1; i < record.getItem("I2").get<int>(0); i++) {
+                        if (!grid.cellActive(i, j, k) || (!inside && neighbourActive(i, j, k, faceDir)))
+                            continue;
+
+                        const auto global_index = grid.getGlobalIndex(i, j, k);
+                        auto pos = work.find(global_index);
+                        if (pos == work.end()) {
+                            work.emplace(global_index, Aquancon::AquancCell(aquiferID, global_index, influx_coeff, influx_mult, faceDir));
+                            continue;
+                        }
+
+                        auto& prev = pos->second;
+                        if (prev.aquiferID != aquiferID)
+                            continue;
+
+                        BOOST_REQUIRE(prev.influx_coeff.first == influx_coeff.first);
+                        if (prev.influx_coeff.first) {
+                            if (influx_coeff.second == 0)
+                                prev.influx_coeff.second = 0;
+                            else
+                                prev.influx_coeff.second += influx_coeff.second;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::map<int, std::vector<Aquancon::AquancCell>> cells;
+    for (const auto& gi_cell : work)
+        cells[gi_cell.second.aquiferID].push_back(gi_cell.second);
+
+    return cells;
+}
+
+void checkAgainstReference(const EclipseGrid& grid, const Deck& deck) {
+    const Aquancon aquancon(grid, deck);
+    const auto expected = referenceAquancon(grid, deck);
+
+    BOOST_CHECK_EQUAL(aquancon.data().size(), expected.size());
+    for (const auto& aq_cells : expected) {
+        const auto& cells = aquancon[aq_cells.first];
+        BOOST_CHECK(std::is_sorted(cells.begin(), cells.end(),
+                                   [](const Aquancon::AquancCell& c1, const Aquancon::AquancCell& c2)
+                                   { return c1.global_index < c2.global_index; }));
+        BOOST_CHECK(cells == aq_cells.second);
+    }
+}
+
+/*
+  Overlapping boxes on all faces of a 12x10x6 grid with some inactive
+  cells, connected to three aquifers.
+*/
+Deck createOverlappingAQUANCONDeck() {
+    std::ostringstream input;
+    input << "SOLUTION\nAQUANCON\n";
+
+    const char* faces[] = { "I-", "I+", "J-", "J+", "K-", "K+" };
+    unsigned long state = 4711;
+    auto next = [&state](const int n) {
+        state = (state * 1103515245 + 12345) % 2147483648UL;
+        return static_cast<int>((state / 65536) % n);
+    };
+
+    for (int r = 0; r < 60; r++) {
+        const int i1 = 1 + next(12), j1 = 1 + next(10), k1 = 1 + next(6);
+        const int i2 = std::min(12, i1 + next(6));
+        const int j2 = std::min(10, j1 + next(5));
+        const int k2 = std::min(6, k1 + next(3));
+        const auto coeff = (next(5) == 0) ? 0.0 : 0.5 + next(10);
+        input << 1 + next(3) << ' ' << i1 << ' ' << i2 << ' ' << j1 << ' ' << j2 << ' ' << k1 << ' ' << k2
+              << ' ' << faces[next(6)] << ' ' << coeff << ' ' << 1.0 + 0.25*next(4) << ' '
+              << ((next(2) == 0) ? "NO" : "YES") << " /\n";
+    }
+    input << "/\n";
+
+    return Parser{}.parseString(input.str());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(AquanconTest_Reference) {
+    const auto grid = makeGrid();
+    checkAgainstReference(grid, createAQUANCONDeck());
+    checkAgainstReference(grid, createAQUANCONDeck_DEFAULT_INFLUX1());
+    checkAgainstReference(grid, createAQUANCONDeck_DEFAULT_ILLEGAL());
+    checkAgainstReference(grid, createAQUANCONDeck_ALLOW_INSIDE_AQUAN_OR_NOT());
+
+    EclipseGrid grid2(12, 10, 6);
+    std::vector<int> actnum(12*10*6, 1);
+    for (std::size_t g = 0; g < actnum.size(); g += 7)
+        actnum[g] = 0;
+    grid2.resetACTNUM(actnum);
+
+    checkAgainstReference(grid2, createOverlappingAQUANCONDeck());
+}
+
+BOOST_AUTO_TEST_CASE(AquanconTest_LargeFaces) {
+    using Clock = std::chrono::steady_clock;
+
+    const std::size_t nx = 200, ny = 200, nz = 10;
+    const EclipseGrid grid(nx, ny, nz);
+
+    // The full bottom and west faces, with the corner column given twice.
+    const auto deck = Parser{}.parseString(R"(
+SOLUTION
+AQUANCON
+   1   1  200   1  200  10  10  K+  1.0 1.0 NO /
+   2   1    1   1  200   1  10  I-  1.0 1.0 NO /
+   2   1    1   1   20   1  10  I-  0.5 1.0 NO /
+/
+)");
+
+    const auto t0 = Clock::now();
+    const Aquancon aquancon(grid, deck);
+    const auto t1 = Clock::now();
+    const auto expected = referenceAquancon(grid, deck);
+    const auto t2 = Clock::now();
+
+    const auto builder = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const auto reference = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    BOOST_TEST_MESSAGE("AQUANCON with " << aquancon[1].size() + aquancon[2].size() << " cells: "
+                       << builder << " ms, cell by cell " << reference << " ms");
+
+    // The corner column is connected to aquifer 1, which names it first.
+    BOOST_CHECK_EQUAL(aquancon[1].size(), nx*ny);
+    BOOST_CHECK_EQUAL(aquancon[2].size(), ny*nz - ny);
+    BOOST_CHECK(aquancon[1] == expected.at(1));
+    BOOST_CHECK(aquancon[2] == expected.at(2));
+    BOOST_CHECK_EQUAL(aquancon[2].front().influx_coeff.second, 1.5);
+}
+
 inline Deck createAquifetpDeck() {
   const char *deckData =
   "DIMENS\n"
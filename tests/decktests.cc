@@ -18,8 +18,11 @@
 */
 #include "config.h"
 
+#include <atomic>
 #include <stdexcept>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #define BOOST_TEST_MODULE DeckTests
 
@@ -137,6 +140,34 @@ BOOST_AUTO_TEST_CASE(keywordList_getbyindex_correctkeywordreturned) {
     BOOST_CHECK_EQUAL("INIT", deck.getKeyword(2).name());
 }
 
+BOOST_AUTO_TEST_CASE(keywords_range) {
+    Deck deck;
+    Parser parser;
+    BOOST_CHECK( deck.keywords("GRID").empty() );
+
+    deck.addKeyword( DeckKeyword( parser.getKeyword("GRID")));
+    deck.addKeyword( DeckKeyword( parser.getKeyword("INIT")));
+    deck.addKeyword( DeckKeyword( parser.getKeyword("GRID")));
+
+    const auto grid = deck.keywords("GRID");
+    BOOST_CHECK_EQUAL( 2U , grid.size() );
+    BOOST_CHECK_EQUAL( &deck.getKeyword(0), &grid[0] );
+    BOOST_CHECK_EQUAL( &deck.getKeyword(2), &grid.back() );
+
+    const auto keywordList = deck.getKeywordList("GRID");
+    std::size_t index = 0;
+    for (const auto& keyword : grid) {
+        BOOST_CHECK_EQUAL( keywordList[index], &keyword );
+        index++;
+    }
+    BOOST_CHECK_EQUAL( index, keywordList.size() );
+
+    deck.addKeyword( DeckKeyword( parser.getKeyword("GRID")));
+    BOOST_CHECK_EQUAL( 3U , deck.keywords("GRID").size() );
+    BOOST_CHECK_EQUAL( 1U , deck.keywords("INIT").size() );
+    BOOST_CHECK( deck.keywords("TRULS").empty() );
+}
+
 BOOST_AUTO_TEST_CASE(set_and_get_data_file) {
     Deck deck;
     BOOST_CHECK_EQUAL("", deck.getDataFile());
@@ -321,6 +352,55 @@ BOOST_AUTO_TEST_CASE(GetSIMultipleDim) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(GetRawAndSIData) {
+    Dimension dim{ 100 };
+    DeckItem item( "HEI", double(), { dim }, { dim } );
+    item.push_back( 1.0, 10 );
+
+    const auto& raw = item.getData< double >();
+    const auto& si = item.getSIDoubleData();
+    for (size_t i = 0; i < 10; i++) {
+        BOOST_CHECK_EQUAL( raw[i], 1.0 );
+        BOOST_CHECK_EQUAL( si[i], 100 );
+        BOOST_CHECK_EQUAL( item.get< double >(i), 1.0 );
+    }
+
+    BOOST_CHECK_THROW( item.getSIDouble(10), std::out_of_range );
+
+    item.push_back( 2.0 );
+    BOOST_CHECK_EQUAL( item.getSIDoubleData().size(), 11U );
+    BOOST_CHECK_EQUAL( item.getSIDouble(10), 200 );
+
+    const DeckItem copy = item;
+    BOOST_CHECK( copy.getSIDoubleData() == item.getSIDoubleData() );
+    BOOST_CHECK( copy == item );
+}
+
+BOOST_AUTO_TEST_CASE(GetSIDataConcurrent) {
+    Dimension dim{ 100 };
+    DeckItem item( "HEI", double(), { dim }, { dim } );
+    item.push_back( 1.0, 100000 );
+
+    const DeckItem& const_item = item;
+    std::vector<std::thread> readers;
+    std::atomic<int> errors{0};
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&const_item, &errors]() {
+            for (int iter = 0; iter < 20; iter++) {
+                const auto& si = const_item.getSIDoubleData();
+                const auto& raw = const_item.getData< double >();
+                if (si.back() != 100 || raw.back() != 1.0 || const_item.getSIDouble(17) != 100)
+                    errors++;
+            }
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    BOOST_CHECK_EQUAL( errors.load(), 0 );
+}
+
 BOOST_AUTO_TEST_CASE(HasValue) {
     DeckItem deckIntItem( "TEST", int() );
     BOOST_CHECK_EQUAL( false , deckIntItem.hasValue(0) );
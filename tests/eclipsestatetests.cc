@@ -196,6 +196,82 @@ const char *deckData =
     return parser.parseString( deckData );
 }
 
+static Deck createDeckWithTables() {
+const char *deckData =
+"RUNSPEC\n"
+"\n"
+"DIMENS\n"
+" 10 10 10 /\n"
+"OIL\n"
+"\n"
+"WATER\n"
+"\n"
+"TABDIMS\n"
+"/\n"
+"GRID\n"
+"DX\n"
+"1000*0.25 /\n"
+"DY\n"
+"1000*0.25 /\n"
+"DZ\n"
+"1000*0.25 /\n"
+"TOPS\n"
+"100*0.25 /\n"
+"PORO\n"
+"  1000*0.15 /\n"
+"NNC\n"
+"  1 1 1  2 1 1  0.50 /\n"
+"  1 1 1  1 2 1  1.00 /\n"
+"/\n"
+"PROPS\n"
+"SWOF\n"
+"  0.10 0.00 1.00 0.00\n"
+"  1.00 1.00 0.00 0.00 /\n"
+"PVTW\n"
+"  250 1.0 4.0E-05 0.5 0.0 /\n"
+"DENSITY\n"
+"  850 1000 1.0 /\n"
+"ROCK\n"
+"  250 4.0E-05 /\n"
+"\n";
+
+    Parser parser;
+    return parser.parseString( deckData );
+}
+
+BOOST_AUTO_TEST_CASE(ParallelConstruction) {
+    auto deck = createDeck();
+    EclipseState state(deck);
+    EclipseState parallel_state(deck, 4);
+
+    BOOST_CHECK( parallel_state.getTableManager() == state.getTableManager() );
+    BOOST_CHECK( parallel_state.getInputGrid().equal( state.getInputGrid() ));
+    BOOST_CHECK( parallel_state.getInputNNC() == state.getInputNNC() );
+    BOOST_CHECK( parallel_state.getFaults() == state.getFaults() );
+    BOOST_CHECK( parallel_state.getTransMult() == state.getTransMult() );
+    BOOST_CHECK( parallel_state.fieldProps().get_double("PORO") == state.fieldProps().get_double("PORO") );
+    BOOST_CHECK_EQUAL( parallel_state.getTitle(), state.getTitle() );
+}
+
+/*
+  The tables, the grid and the NNCs all read the deck and its unit system
+  concurrently here; run under ThreadSanitizer to check that the const
+  accessors they use are race free.
+*/
+BOOST_AUTO_TEST_CASE(ParallelConstructionWithTables) {
+    const auto deck = createDeckWithTables();
+    const EclipseState state(deck);
+
+    for (const std::size_t num_threads : {2, 4}) {
+        const EclipseState parallel_state(deck, num_threads);
+
+        BOOST_CHECK( parallel_state.getTableManager() == state.getTableManager() );
+        BOOST_CHECK( parallel_state.getInputGrid().equal( state.getInputGrid() ));
+        BOOST_CHECK( parallel_state.getInputNNC() == state.getInputNNC() );
+        BOOST_CHECK_EQUAL( parallel_state.getInputNNC().input().size(), 2U );
+    }
+}
+
 BOOST_AUTO_TEST_CASE(CreateSchedule) {
     auto deck = createDeck();
     EclipseState state(deck);
@@ -49,6 +49,7 @@
 #include <ewoms/eclio/utility/opminputerror.hh>
 
 #include "ewoms/eclio/parser/eclipsestate/grid/fieldprops.hh"
+#include "ewoms/eclio/parser/eclipsestate/grid/statusvector.hh"
 
 using namespace Ewoms;
 
@@ -2515,3 +2516,56 @@ COPYREG
     BOOST_CHECK(permx == fp.get_double("PERMR"));
     BOOST_CHECK(permy == fp.get_double("PERMTHT"));
 }
+
+BOOST_AUTO_TEST_CASE(STATUS_VECTOR) {
+    using Fieldprops::StatusVector;
+    const std::size_t size = 100;
+    StatusVector status(size, value::status::uninitialized);
+    std::vector<value::status> reference(size, value::status::uninitialized);
+
+    BOOST_CHECK( status.uniform() );
+    BOOST_CHECK( status.all(value::status::uninitialized) );
+    BOOST_CHECK( !status.allHaveValue() );
+
+    status.fill(value::status::deck_value);
+    std::fill(reference.begin(), reference.end(), value::status::deck_value);
+    BOOST_CHECK( status.allHaveValue() );
+
+    status.set(size - 1, value::status::empty_default);
+    reference[size - 1] = value::status::empty_default;
+    BOOST_CHECK( !status.uniform() );
+    BOOST_CHECK( !status.allHaveValue() );
+    BOOST_CHECK( status.data() == reference );
+
+    status.set(size - 1, value::status::valid_default);
+    reference[size - 1] = value::status::valid_default;
+    BOOST_CHECK( status.allHaveValue() );
+    BOOST_CHECK( !status.all(value::status::deck_value) );
+
+    for (std::size_t i = 0; i < size; i += 7) {
+        const auto st = static_cast<value::status>(i % 4);
+        status.set(i, st);
+        reference[i] = st;
+    }
+    for (std::size_t i = 0; i < size; i++)
+        BOOST_CHECK( status[i] == reference[i] );
+
+    std::vector<bool> active_map(size);
+    std::vector<value::status> active_reference;
+    for (std::size_t i = 0; i < size; i++) {
+        active_map[i] = (i % 3 != 0);
+        if (active_map[i])
+            active_reference.push_back(reference[i]);
+    }
+    status.compress(active_map);
+    BOOST_CHECK_EQUAL( status.size(), active_reference.size() );
+    BOOST_CHECK( status.data() == active_reference );
+
+    for (std::size_t i = 0; i < status.size(); i++)
+        status.set(i, value::status::valid_default);
+    BOOST_CHECK( !status.uniform() );
+    status.compact();
+    BOOST_CHECK( status.uniform() );
+    BOOST_CHECK( status.all(value::status::valid_default) );
+    BOOST_CHECK( status == StatusVector(active_reference.size(), value::status::valid_default) );
+}
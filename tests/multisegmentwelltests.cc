@@ -18,10 +18,13 @@
 */
 #include "config.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <set>
+#include <thread>
+#include <vector>
 
 #define BOOST_TEST_MODULE WellConnectionsTests
 #include <boost/test/unit_test.hpp>
@@ -40,6 +43,7 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/connection.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wellconnections.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/msw/compsegs.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/msw/segmenttopology.hh>
 
 #include <ewoms/eclio/parser/parser.hh>
 #include <ewoms/eclio/parser/errorguard.hh>
@@ -651,3 +655,108 @@ BOOST_AUTO_TEST_CASE(Branches) {
     std::set<int> expected = {1,2,3,4,5};
     BOOST_CHECK( expected == segments.branches() );
 }
+
+BOOST_AUTO_TEST_CASE(SegmentTopology) {
+    const auto& sched = make_schedule("MSW.DATA");
+    const auto& well = sched.getWell("PROD01", 0);
+    const auto& segments = well.getSegments();
+    const auto& topology = segments.topology();
+
+    BOOST_CHECK_EQUAL(topology.size(), segments.size());
+    BOOST_CHECK_EQUAL(topology.index(100), Ewoms::SegmentTopology::npos);
+    BOOST_CHECK_EQUAL(topology.outlet(0), Ewoms::SegmentTopology::npos);
+
+    for (std::size_t index = 0; index < segments.size(); index++) {
+        const auto& segment = segments[index];
+        BOOST_CHECK_EQUAL(topology.index(segment.segmentNumber()), index);
+        BOOST_CHECK_EQUAL(static_cast<int>(topology.index(segment.segmentNumber())),
+                          segments.segmentNumberToIndex(segment.segmentNumber()));
+
+        if (index > 0)
+            BOOST_CHECK_EQUAL(segments[topology.outlet(index)].segmentNumber(), segment.outletSegment());
+
+        std::vector<std::size_t> expected_inlets;
+        for (std::size_t inlet = 0; inlet < segments.size(); inlet++) {
+            if (segments[inlet].outletSegment() == segment.segmentNumber())
+                expected_inlets.push_back(inlet);
+        }
+        const auto inlets = topology.inlets(index);
+        BOOST_CHECK_EQUAL_COLLECTIONS(inlets.begin(), inlets.end(), expected_inlets.begin(), expected_inlets.end());
+    }
+
+    const auto& branches = topology.branches();
+    BOOST_CHECK_EQUAL(branches.size(), 5U);
+    BOOST_CHECK_EQUAL(branches[0], 1);
+    BOOST_CHECK(std::set<int>(branches.begin(), branches.end()) == segments.branches());
+    BOOST_CHECK(topology.branchSegments(100).empty());
+    for (const auto branch : branches) {
+        const auto branch_segments = topology.branchSegments(branch);
+        const auto expected = segments.branchSegments(branch);
+        BOOST_CHECK_EQUAL(branch_segments.size(), expected.size());
+        BOOST_CHECK(std::is_sorted(branch_segments.begin(), branch_segments.end()));
+        for (const auto index : branch_segments)
+            BOOST_CHECK_EQUAL(segments[index].branchNumber(), branch);
+    }
+
+    // The flow order visits every segment after all its inlets and ends at
+    // the top segment.
+    const auto& order = topology.flowOrder();
+    BOOST_CHECK_EQUAL(order.size(), segments.size());
+    BOOST_CHECK_EQUAL(order.back(), 0U);
+    for (std::size_t pos = 0; pos < order.size(); pos++) {
+        BOOST_CHECK_EQUAL(topology.flowPosition(order[pos]), pos);
+        for (const auto inlet : topology.inlets(order[pos]))
+            BOOST_CHECK(topology.flowPosition(inlet) < pos);
+    }
+
+    const auto& depth_order = topology.depthOrder();
+    BOOST_CHECK_EQUAL(depth_order.size(), segments.size());
+    for (std::size_t pos = 1; pos < depth_order.size(); pos++)
+        BOOST_CHECK(segments[depth_order[pos - 1]].depth() <= segments[depth_order[pos]].depth());
+
+    // Copies share the topology until they are modified.
+    auto copy = segments;
+    BOOST_CHECK(&copy.topology() == &topology);
+    copy.updatePerfLength(well.getConnections());
+    BOOST_CHECK(&copy.topology() != &topology);
+    BOOST_CHECK_EQUAL(copy.topology().flowOrder().size(), order.size());
+
+    // Threads building the topology at the same time all end up with the
+    // published one.
+    copy.updatePerfLength(well.getConnections());
+    std::vector<const Ewoms::SegmentTopology*> built(4, nullptr);
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < built.size(); ++i)
+        readers.emplace_back([&copy, &built, i]() { built[i] = &copy.topology(); });
+    for (auto& reader : readers)
+        reader.join();
+    for (const auto* t : built)
+        BOOST_CHECK(t == &copy.topology());
+}
+
+BOOST_AUTO_TEST_CASE(SegmentTopologyLoop) {
+    const auto segment = [](int number, int branch, int outlet) {
+        return Ewoms::Segment(number, branch, outlet, 1.0, 1.0, 0.1, 1.0e-4, 0.01, 0.01, true);
+    };
+
+    const auto loop = Ewoms::WellSegments(Ewoms::WellSegments::CompPressureDrop::HFA,
+                                        { segment(1, 1, 2), segment(2, 1, 1) });
+    BOOST_CHECK_THROW(loop.topology(), std::logic_error);
+
+    const auto missing_outlet = Ewoms::WellSegments(Ewoms::WellSegments::CompPressureDrop::HFA,
+                                                  { segment(1, 1, 0), segment(2, 1, 7) });
+    BOOST_CHECK_THROW(missing_outlet.topology(), std::logic_error);
+
+    // Branch 3 joins branch 2, which joins branch 1 at the top segment.
+    // Each branch comes after the branches joining it and is ordered from
+    // its toe to its head.
+    const auto lateral = Ewoms::WellSegments(Ewoms::WellSegments::CompPressureDrop::HFA,
+                                           { segment(1, 1, 0), segment(2, 1, 1), segment(3, 2, 1),
+                                             segment(4, 2, 3), segment(5, 3, 3) });
+    const auto& topology = lateral.topology();
+    const auto expected = std::vector<std::size_t> { 4, 3, 2, 1, 0 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(topology.flowOrder().begin(), topology.flowOrder().end(),
+                                  expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(topology.branches().size(), 3U);
+    BOOST_CHECK_EQUAL(topology.branchSegments(2).size(), 2U);
+}
@@ -28,6 +28,7 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/network/node.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/network/branch.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/treetopology.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/eclipsegrid.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/fieldpropsmanager.hh>
 #include <ewoms/eclio/parser/parser.hh>
@@ -305,3 +306,104 @@ BRANPROP
 
     BOOST_CHECK_EQUAL_COLLECTIONS(nodes.begin(), nodes.end(), expect.begin(), expect.end());
 }
+
+BOOST_AUTO_TEST_CASE(Topology) {
+    using Edges = std::vector<std::pair<std::string, std::string>>;
+
+    const auto tree = TreeTopology({ "A" }, Edges {
+        { "B", "D" }, { "A", "B" }, { "A", "C" }, { "B", "E" }, { "C", "F" }
+    });
+
+    BOOST_CHECK_EQUAL(tree.size(), 6U);
+    BOOST_CHECK_EQUAL(tree.id("A"), 0U);
+    BOOST_CHECK_EQUAL(tree.id("B"), 1U);
+    BOOST_CHECK_EQUAL(tree.id("D"), 2U);
+    BOOST_CHECK_EQUAL(tree.name(tree.id("F")), "F");
+    BOOST_CHECK(!tree.has("G"));
+    BOOST_CHECK_THROW(tree.id("G"), std::out_of_range);
+
+    BOOST_CHECK_EQUAL(tree.roots().size(), 1U);
+    BOOST_CHECK_EQUAL(tree.roots()[0], tree.id("A"));
+    BOOST_CHECK_EQUAL(tree.parent(tree.id("A")), TreeTopology::npos);
+    BOOST_CHECK_EQUAL(tree.parent(tree.id("D")), tree.id("B"));
+    BOOST_CHECK_EQUAL(tree.parent_edge(tree.id("D")), 0U);
+    BOOST_CHECK_EQUAL(tree.parent_edge(tree.id("F")), 4U);
+
+    const auto children = tree.children(tree.id("B"));
+    BOOST_CHECK_EQUAL(children.size(), 2U);
+    BOOST_CHECK_EQUAL(children[0], tree.id("D"));
+    BOOST_CHECK_EQUAL(children[1], tree.id("E"));
+    BOOST_CHECK(tree.children(tree.id("F")).empty());
+
+    const auto& order = tree.order();
+    BOOST_CHECK_EQUAL(order.size(), tree.size());
+    auto position = std::vector<std::size_t>(tree.size());
+    for (std::size_t pos = 0; pos < order.size(); pos++)
+        position[order[pos]] = pos;
+
+    for (std::size_t node = 0; node < tree.size(); node++) {
+        if (tree.parent(node) != TreeTopology::npos)
+            BOOST_CHECK(position[tree.parent(node)] < position[node]);
+    }
+
+    BOOST_CHECK_THROW(TreeTopology({}, Edges{ { "A", "B" }, { "C", "B" } }), std::invalid_argument);
+    BOOST_CHECK_THROW(TreeTopology({ "R" }, Edges{ { "A", "B" }, { "B", "A" } }), std::invalid_argument);
+    BOOST_CHECK_EQUAL(TreeTopology().size(), 0U);
+    BOOST_CHECK(TreeTopology().order().empty());
+}
+
+BOOST_AUTO_TEST_CASE(NetworkTopology) {
+    const auto sched = make_schedule(R"(
+SCHEDULE
+
+GRUPTREE
+ 'PROD'    'FIELD' /
+
+ 'M5S'    'PLAT-A'  /
+ 'M5N'    'PLAT-A'  /
+
+ 'C1'     'M5N'  /
+ 'F1'     'M5N'  /
+ 'B1'     'M5S'  /
+ 'G1'     'M5S'  /
+/
+
+BRANPROP
+--  Downtree  Uptree   #VFP    ALQ
+    B1         PLAT-A    9999      1*      /
+    C1         PLAT-A    9999      1*      /
+/
+
+NODEPROP
+--  Node_name Pr    autoChock?      addGasLift?     Group_name
+     PLAT-A 21.0   NO     NO    1*  /
+     B1    1*  YES      NO    1*  /
+     C1    1*  YES     NO     'GROUP' /
+/
+)");
+
+    const auto& network = sched.network(0);
+    const auto topology = network.topology();
+
+    BOOST_CHECK_EQUAL(topology.size(), 3U);
+    BOOST_CHECK_EQUAL(topology.roots().size(), 1U);
+    BOOST_CHECK_EQUAL(topology.name(topology.roots()[0]), network.root().name());
+
+    for (const auto& name : network.node_names()) {
+        const auto id = topology.id(name);
+        const auto uptree = network.uptree_branch(name);
+
+        BOOST_CHECK_EQUAL(static_cast<bool>(uptree), topology.parent(id) != TreeTopology::npos);
+        if (uptree) {
+            const auto& branch = network.branches()[topology.parent_edge(id)];
+            BOOST_CHECK_EQUAL(branch.downtree_node(), name);
+            BOOST_CHECK_EQUAL(topology.name(topology.parent(id)), uptree->uptree_node());
+        }
+
+        const auto downtree = network.downtree_branches(name);
+        const auto children = topology.children(id);
+        BOOST_CHECK_EQUAL(children.size(), downtree.size());
+        for (std::size_t c = 0; c < children.size(); c++)
+            BOOST_CHECK_EQUAL(topology.name(children[c]), downtree[c].downtree_node());
+    }
+}
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 
 #define BOOST_TEST_MODULE ScheduleTests
 
@@ -3243,6 +3244,39 @@ BOOST_AUTO_TEST_CASE(WellNames) {
     BOOST_CHECK( has(l2, "I2"));
 }
 
+BOOST_AUTO_TEST_CASE(WellMatcherCache) {
+    const auto schedule = make_schedule(createDeckWTEST());
+
+    auto wm = schedule.sharedWellMatcher(4);
+    BOOST_CHECK( wm == schedule.sharedWellMatcher(4) );
+
+    // A copy of the schedule does not share the cached matchers.
+    const auto copy = schedule;
+    auto wm_copy = copy.sharedWellMatcher(4);
+    BOOST_CHECK( wm_copy != wm );
+    BOOST_CHECK( wm_copy->wells() == wm->wells() );
+    BOOST_CHECK( wm_copy->wells("*ILIST") == wm->wells("*ILIST") );
+
+    // Concurrent readers of a const schedule.
+    std::vector<std::vector<std::string>> names(4);
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        readers.emplace_back([&schedule, &names, i]()
+        {
+            for (std::size_t report_step = 0; report_step < schedule.size(); ++report_step) {
+                schedule.wellNames("W*", report_step);
+                names[i] = schedule.wellNames("*ILIST", report_step);
+            }
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    for (const auto& n : names)
+        BOOST_CHECK( n == schedule.wellNames("*ILIST", schedule.size() - 1) );
+}
+
 BOOST_AUTO_TEST_CASE(RFT_CONFIG) {
     std::vector<std::time_t> tp = { asTimeT( TimeStampUTC(2010, 1, 1)),
                                     asTimeT( TimeStampUTC(2010, 1, 2)),
@@ -4324,3 +4358,38 @@ END
     //sched.open_well("P1", 2);
 }
 
+
+BOOST_AUTO_TEST_CASE(INCREMENTAL_SCHEDULE) {
+    Parser parser;
+    auto deck = parser.parseFile("0A4_GRCTRL_LRAT_LRAT_GGR_BASE_MODEL2_MSW_ALL.DATA");
+    EclipseState es{ deck };
+    ParseContext parseContext;
+    ErrorGuard errors;
+    const auto sched = Schedule{ deck, es };
+    auto inc_sched = Schedule::incremental(deck, es, parseContext, errors);
+
+    BOOST_CHECK( !inc_sched.complete() );
+    BOOST_CHECK_EQUAL( inc_sched.processedSteps(), 1U );
+    BOOST_CHECK_EQUAL( inc_sched.size(), sched.size() );
+
+    for (std::size_t report_step = 0; report_step < sched.size(); report_step++) {
+        BOOST_CHECK( inc_sched.processedSteps() > report_step );
+
+        BOOST_CHECK( inc_sched.wellNames(report_step) == sched.wellNames(report_step) );
+        BOOST_CHECK( inc_sched.groupNames(report_step) == sched.groupNames(report_step) );
+        for (const auto& wname : sched.wellNames(report_step))
+            BOOST_CHECK( inc_sched.getWell(wname, report_step) == sched.getWell(wname, report_step) );
+
+        inc_sched.advance();
+    }
+
+    BOOST_CHECK( inc_sched.complete() );
+    BOOST_CHECK_EQUAL( inc_sched.processedSteps(), sched.size() );
+    BOOST_CHECK( inc_sched == sched );
+
+    auto partial_sched = Schedule::incremental(deck, es, parseContext, errors, 2);
+    BOOST_CHECK( partial_sched.processedSteps() >= 3U );
+    partial_sched.advance(sched.size());
+    BOOST_CHECK( partial_sched.complete() );
+    BOOST_CHECK( partial_sched == sched );
+}
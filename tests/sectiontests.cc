@@ -58,6 +58,35 @@ BOOST_AUTO_TEST_CASE(SectionTest) {
     BOOST_CHECK(!gridSection.hasKeyword("WELLDIMS"));
 }
 
+BOOST_AUTO_TEST_CASE(SectionKeywordIndex) {
+    Deck deck;
+    Parser parser;
+    deck.addKeyword( DeckKeyword(parser.getKeyword("RUNSPEC")));
+    deck.addKeyword( DeckKeyword(parser.getKeyword("WELLDIMS")));
+    deck.addKeyword( DeckKeyword(parser.getKeyword("GRID")));
+    deck.addKeyword( DeckKeyword(parser.getKeyword("PORO")));
+    deck.addKeyword( DeckKeyword(parser.getKeyword("PORO")));
+
+    {
+        GRIDSection gridSection(deck);
+        GRIDSection otherSection(deck);
+        BOOST_CHECK_EQUAL( 2U, gridSection.keywords("PORO").size() );
+        BOOST_CHECK_EQUAL( &gridSection.keywords("PORO")[1], &otherSection.keywords("PORO")[1] );
+        BOOST_CHECK( gridSection.keywords("WELLDIMS").empty() );
+    }
+
+    // Adding keywords must not leave a stale section index behind.
+    deck.addKeyword( DeckKeyword(parser.getKeyword("PORO")));
+    {
+        GRIDSection gridSection(deck);
+        BOOST_CHECK_EQUAL( 3U, gridSection.keywords("PORO").size() );
+        BOOST_CHECK_EQUAL( &deck.getKeyword(5), &gridSection.keywords("PORO").back() );
+    }
+
+    deck.addKeyword( DeckKeyword(parser.getKeyword("GRID")));
+    BOOST_CHECK_THROW( GRIDSection{deck}, std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_CASE(IteratorTest) {
     Deck deck;
     Parser parser;
@@ -26,8 +26,47 @@
 #include <ewoms/eclio/parser/eclipsestate/tables/tablecolumn.hh>
 #include <ewoms/eclio/parser/eclipsestate/tables/columnschema.hh>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 using namespace Ewoms;
 
+namespace {
+
+    // TableColumn::lookup() as it was before the extrema were cached.
+    TableIndex referenceLookup(const std::vector<double>& values, bool isDescending, double argValue) {
+        const auto max_iter = std::max_element( values.begin() , values.end());
+        if (argValue >= *max_iter)
+            return TableIndex( max_iter - values.begin() , 1.0 );
+
+        const auto min_iter = std::min_element( values.begin() , values.end());
+        if (argValue <= *min_iter)
+            return TableIndex( min_iter - values.begin() , 1.0 );
+
+        size_t lowIntervalIdx = 0;
+        size_t intervalIdx = (values.size() - 1)/2;
+        size_t highIntervalIdx = values.size() - 1;
+
+        while (lowIntervalIdx + 1 < highIntervalIdx) {
+            if ((values[intervalIdx] < argValue) != isDescending)
+                lowIntervalIdx = intervalIdx;
+            else
+                highIntervalIdx = intervalIdx;
+
+            intervalIdx = (highIntervalIdx + lowIntervalIdx)/2;
+        }
+
+        return TableIndex( intervalIdx , 1 - (argValue - values[intervalIdx])/(values[intervalIdx + 1] - values[intervalIdx]) );
+    }
+
+    void checkSameIndex(const TableIndex& index, const TableIndex& expected) {
+        BOOST_CHECK_EQUAL( index.getIndex1() , expected.getIndex1() );
+        BOOST_CHECK_EQUAL( index.getWeight1() , expected.getWeight1() );
+    }
+
+}
+
 BOOST_AUTO_TEST_CASE( CreateTest ) {
     ColumnSchema schema("COLUMN" , Table::STRICTLY_INCREASING , Table::DEFAULT_LINEAR );
     TableColumn column( schema );
@@ -301,3 +340,82 @@ BOOST_AUTO_TEST_CASE( Test_LINEAR_DEFAULT ) {
     BOOST_CHECK_CLOSE( valueColumn[3] , 1.00 , 1e-6);
     BOOST_CHECK_CLOSE( valueColumn[5] , 0.25 , 1e-6);
 }
+
+BOOST_AUTO_TEST_CASE( Test_LOOKUP_PROPERTIES ) {
+    std::mt19937 gen( 1729 );
+    std::uniform_real_distribution<double> step( 0.0 , 2.0 );
+    std::uniform_int_distribution<int> repeat( 0 , 3 );
+
+    for (const auto order : { Table::INCREASING , Table::STRICTLY_INCREASING ,
+                              Table::DECREASING , Table::STRICTLY_DECREASING }) {
+        const bool strict = (order == Table::STRICTLY_INCREASING) || (order == Table::STRICTLY_DECREASING);
+        const bool descending = (order == Table::DECREASING) || (order == Table::STRICTLY_DECREASING);
+
+        for (const size_t size : { 1 , 2 , 3 , 17 , 200 }) {
+            ColumnSchema schema("COLUMN" , order , Table::DEFAULT_NONE);
+            TableColumn column( schema );
+
+            double value = 0.0;
+            while (column.size() < size) {
+                // Non-strict columns get runs of equal values.
+                const int copies = strict ? 0 : repeat( gen );
+                for (int c = 0; c <= copies && column.size() < size; ++c)
+                    column.addValue( value );
+
+                value += (descending ? -1.0 : 1.0) * (0.01 + step( gen ));
+            }
+
+            const auto values = column.vectorCopy();
+            BOOST_CHECK_EQUAL( column.min() , *std::min_element( values.begin() , values.end() ));
+            BOOST_CHECK_EQUAL( column.max() , *std::max_element( values.begin() , values.end() ));
+
+            // Queries at the nodes, between them and outside the column.
+            std::vector<double> args( values.begin() , values.end() );
+            std::uniform_real_distribution<double> arg( column.min() - 1.0 , column.max() + 1.0 );
+            for (int i = 0; i < 500; ++i)
+                args.push_back( arg( gen ) );
+
+            std::vector<double> sorted = args;
+            std::sort( sorted.begin() , sorted.end() );
+            std::vector<double> reversed( sorted.rbegin() , sorted.rend() );
+
+            for (const auto& sequence : { args , sorted , reversed }) {
+                auto cursor = column.cursor();
+                for (const double x : sequence) {
+                    const auto expected = referenceLookup( values , descending , x );
+                    checkSameIndex( column.lookup( x ) , expected );
+                    checkSameIndex( cursor.lookup( x ) , expected );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Test_EXTREMA_UPDATES ) {
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution<int> pick( -5 , 5 );
+
+    ColumnSchema schema("COLUMN" , Table::RANDOM , Table::DEFAULT_LINEAR);
+    TableColumn column( schema );
+
+    for (int i = 0; i < 20; ++i) {
+        if (i % 4 == 1)
+            column.addDefault();
+        else
+            column.addValue( pick( gen ) );
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        column.updateValue( static_cast<size_t>( i ) % column.size() , pick( gen ) );
+
+        if (!column.hasDefault()) {
+            const auto values = column.vectorCopy();
+            BOOST_CHECK_EQUAL( column.min() , *std::min_element( values.begin() , values.end() ));
+            BOOST_CHECK_EQUAL( column.max() , *std::max_element( values.begin() , values.end() ));
+        }
+    }
+
+    TableColumn copy( column );
+    BOOST_CHECK_EQUAL( copy.min() , column.min() );
+    BOOST_CHECK_EQUAL( copy.max() , column.max() );
+}
@@ -26,7 +26,9 @@
 #include <ewoms/eclio/output/aggregatewelldata.hh>
 
 #include <ewoms/eclio/output/vectoritems/intehead.hh>
+#include <ewoms/eclio/output/vectoritems/msw.hh>
 #include <ewoms/eclio/output/vectoritems/well.hh>
+#include <ewoms/eclio/output/writerestarthelpers.hh>
 
 #include <ewoms/eclio/output/data/wells.hh>
 
@@ -37,7 +39,12 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/summarystate.hh>
 
+#include <algorithm>
+#include <chrono>
 #include <exception>
+#include <map>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -578,6 +585,113 @@ END
     }
 }
 
+namespace {
+    /*
+      One multi-segment well with a main branch and numBranches - 1
+      laterals of segsPerBranch segments each.  Every other lateral joins
+      the middle of the previous lateral rather than the main branch.  The
+      well is connected to one cell per main branch segment.
+    */
+    Ewoms::Deck many_segments_sim(const int numBranches, const int segsPerBranch)
+    {
+        const auto numSegments = 1 + numBranches*segsPerBranch;
+
+        std::ostringstream input;
+        input << R"~(
+RUNSPEC
+OIL
+WATER
+DIMENS
+2 2 )~" << segsPerBranch << R"~( /
+TABDIMS
+/
+WELLDIMS
+1 )~" << segsPerBranch << R"~( 1 1 /
+WSEGDIMS
+1 )~" << numSegments << ' ' << numBranches << R"~( /
+METRIC
+
+GRID
+DX
+)~" << 4*segsPerBranch << R"~(*100 /
+DY
+)~" << 4*segsPerBranch << R"~(*100 /
+DZ
+)~" << 4*segsPerBranch << R"~(*10 /
+TOPS
+4*2000 /
+PORO
+)~" << 4*segsPerBranch << R"~(*0.2 /
+PERMX
+)~" << 4*segsPerBranch << R"~(*100 /
+PERMY
+)~" << 4*segsPerBranch << R"~(*100 /
+PERMZ
+)~" << 4*segsPerBranch << R"~(*10 /
+
+PROPS
+SWOF
+0.2 0 1 0
+1.0 1 0 0 /
+PVDO
+100 1.0 1.0
+500 0.9 1.0 /
+PVTW
+200 1.0 4.0E-5 0.5 0 /
+DENSITY
+800 1000 1 /
+ROCK
+200 1.0E-5 /
+
+SCHEDULE
+WELSPECS
+'PROD' 'G1' 1 1 1* OIL /
+/
+COMPDAT
+'PROD' 1 1 1 )~" << segsPerBranch << R"~( OPEN 1* 100 /
+/
+WELSEGS
+'PROD' 2000 0 1* 'ABS' 'HFA' /
+)~";
+
+        // Length and depth of every segment, ABS input gives them for the
+        // last segment of a range and interpolates the others.
+        std::map<int, std::pair<double, double>> node { { 1, { 0.0, 2000.0 } } };
+
+        auto addBranch = [&input, &node, segsPerBranch]
+            (const int branch, const int first, const int outlet, const double depthInc)
+        {
+            const auto& out = node.at(outlet);
+            for (int i = 0; i < segsPerBranch; ++i) {
+                node[first + i] = { out.first + 10.0*(i + 1), out.second + depthInc*(i + 1) };
+            }
+
+            const auto& last = node.at(first + segsPerBranch - 1);
+            input << first << ' ' << first + segsPerBranch - 1 << ' ' << branch << ' ' << outlet << ' '
+                  << last.first << ' ' << last.second << " 0.1 1.0E-5 /\n";
+        };
+
+        addBranch(1, 2, 1, 10.0);
+        for (int branch = 2; branch <= numBranches; ++branch) {
+            const auto first = 2 + (branch - 1)*segsPerBranch;
+            const auto outlet = ((branch % 2) == 1)
+                ? first - segsPerBranch + segsPerBranch/2
+                : 2 + ((branch - 2)*7) % segsPerBranch;
+
+            addBranch(branch, first, outlet, 0.0);
+        }
+
+        input << "/\nCOMPSEGS\n'PROD' /\n";
+        for (int k = 1; k <= segsPerBranch; ++k) {
+            input << "1 1 " << k << " 1 " << 10.0*(k - 1) << ' ' << 10.0*k << " /\n";
+        }
+
+        input << "/\nWCONPROD\n'PROD' OPEN ORAT 100 /\n/\nTSTEP\n10 /\n";
+
+        return Ewoms::Parser{}.parseString(input.str());
+    }
+}
+
 struct SimulationCase
 {
     explicit SimulationCase(const Ewoms::Deck& deck)
@@ -838,4 +952,89 @@ BOOST_AUTO_TEST_CASE(MSW_RST) {
     auto segment = Ewoms::RestartIO::RstSegment(simCase.es.getUnits(), 1, iseg.data(), rseg.data());
 }
 
+BOOST_AUTO_TEST_CASE(Many_Segments)
+{
+    using Clock = std::chrono::steady_clock;
+    using Ix = ::Ewoms::RestartIO::Helpers::VectorItems::ISeg::index;
+    using IxR = ::Ewoms::RestartIO::Helpers::VectorItems::RSeg::index;
+    using o = ::Ewoms::data::Rates::opt;
+
+    const auto numBranches = 20;
+    const auto segsPerBranch = 50;
+    const auto numSegments = 1 + numBranches*segsPerBranch;
+
+    const auto simCase = SimulationCase{ many_segments_sim(numBranches, segsPerBranch) };
+    const auto rptStep = std::size_t{1};
+    const auto ih = Ewoms::RestartIO::Helpers::createInteHead(simCase.es, simCase.grid, simCase.sched,
+                                                              0, rptStep, rptStep, rptStep);
+
+    const auto& segSet = simCase.sched.getWell("PROD", rptStep).getSegments();
+    BOOST_CHECK_EQUAL(segSet.size(), static_cast<std::size_t>(numSegments));
+
+    auto xw = Ewoms::data::WellRates{};
+    auto& prod = xw["PROD"];
+    for (int k = 0; k < segsPerBranch; ++k) {
+        prod.connections.emplace_back();
+        auto& c = prod.connections.back();
+
+        c.rates.set(o::oil, -1.0e-3)
+               .set(o::wat, -2.0e-3)
+               .set(o::gas, -1.0e-1);
+        c.index = 4*k;
+    }
+
+    const auto smry = Ewoms::SummaryState{ std::chrono::system_clock::now() };
+    auto amswd = Ewoms::RestartIO::Helpers::AggregateMSWData{ ih };
+
+    const auto t0 = Clock::now();
+    amswd.captureDeclaredMSWData(simCase.sched, rptStep, simCase.es.getUnits(),
+                                 ih, simCase.grid, smry, xw);
+    const auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    BOOST_TEST_MESSAGE(numSegments << " segments in " << numBranches << " branches: ISEG/RSEG/ILBS/ILBR "
+                       << elapsed << " ms");
+
+    const auto nisegz = static_cast<std::size_t>(ih[Ewoms::RestartIO::Helpers::VectorItems::intehead::NISEGZ]);
+    const auto nrsegz = static_cast<std::size_t>(ih[Ewoms::RestartIO::Helpers::VectorItems::intehead::NRSEGZ]);
+    const auto nilbrz = static_cast<std::size_t>(ih[Ewoms::RestartIO::Helpers::VectorItems::intehead::NILBRZ]);
+    const auto& iSeg = amswd.getISeg();
+    const auto& rSeg = amswd.getRSeg();
+    const auto& iLBr = amswd.getILBr();
+
+    auto segNo = std::vector<int>{};
+    auto position = std::vector<int>{};
+    auto numConn = 0;
+    for (int seg = 1; seg <= numSegments; ++seg) {
+        const auto iS = (seg - 1)*nisegz;
+        const auto& segment = segSet.getFromSegmentNumber(seg);
+
+        BOOST_CHECK_EQUAL(iSeg[iS + Ix::OutSeg], segment.outletSegment());
+        BOOST_CHECK_EQUAL(iSeg[iS + Ix::BranchNo], segment.branchNumber());
+
+        segNo.push_back(iSeg[iS + Ix::SegNo]);
+        position.push_back(iSeg[iS + 8]);
+        numConn += iSeg[iS + 6];
+    }
+
+    // The flow order and the positions in it are permutations of all
+    // segments.
+    auto all = std::vector<int>(numSegments);
+    std::iota(all.begin(), all.end(), 1);
+    std::sort(segNo.begin(), segNo.end());
+    std::sort(position.begin(), position.end());
+    BOOST_CHECK(segNo == all);
+    BOOST_CHECK(position == all);
+    BOOST_CHECK_EQUAL(numConn, segsPerBranch);
+
+    for (int branch = 1; branch <= numBranches; ++branch) {
+        const auto iB = (branch - 1)*nilbrz;
+        BOOST_CHECK_EQUAL(iLBr[iB + 1], (branch == 1) ? segsPerBranch + 1 : segsPerBranch);
+        BOOST_CHECK_EQUAL(iLBr[iB + 4], branch - 1);
+    }
+
+    // All connection rates end up in the top segment.
+    const auto expect = segsPerBranch * (1.0e-3 + 2.0e-3*0.1 + 1.0e-1*0.001) * 86400.0;
+    BOOST_CHECK_CLOSE(rSeg[0*nrsegz + IxR::TotFlowRate], expect, 1.0e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
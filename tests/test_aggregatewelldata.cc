@@ -24,6 +24,7 @@
 
 #include <ewoms/eclio/output/aggregatewelldata.hh>
 #include <ewoms/eclio/output/aggregateconnectiondata.hh>
+#include <ewoms/eclio/output/aggregationindex.hh>
 
 #include <ewoms/eclio/parser/eclipsestate/schedule/action/state.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/summarystate.hh>
@@ -34,6 +35,7 @@
 #include <ewoms/eclio/io/rst/well.hh>
 #include <ewoms/eclio/io/rst/header.hh>
 
+#include <ewoms/eclio/output/data/wellresults.hh>
 #include <ewoms/eclio/output/data/wells.hh>
 
 #include <ewoms/eclio/parser/deck/deck.hh>
@@ -42,8 +44,12 @@
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/action/state.hh>
 
+#include <chrono>
+#include <cstring>
 #include <exception>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -551,6 +557,130 @@ TSTEP            -- 9
         return xw;
     }
 
+    Ewoms::Deck many_wells_sim(const int nx, const int ny)
+    {
+        std::ostringstream input;
+
+        input << R"~(
+RUNSPEC
+OIL
+WATER
+DIMENS
+)~" << nx << ' ' << ny << R"~( 1 /
+WELLDIMS
+)~" << nx*ny << R"~( 1 1 )~" << nx*ny << R"~( /
+TABDIMS
+/
+METRIC
+
+GRID
+DX
+)~" << nx*ny << R"~(*100 /
+DY
+)~" << nx*ny << R"~(*100 /
+DZ
+)~" << nx*ny << R"~(*10 /
+TOPS
+)~" << nx*ny << R"~(*2000 /
+PORO
+)~" << nx*ny << R"~(*0.2 /
+PERMX
+)~" << nx*ny << R"~(*100 /
+PERMY
+)~" << nx*ny << R"~(*100 /
+PERMZ
+)~" << nx*ny << R"~(*10 /
+
+PROPS
+SWOF
+0.2 0 1 0
+1.0 1 0 0 /
+PVDO
+100 1.0 1.0
+500 0.9 1.0 /
+PVTW
+200 1.0 4.0E-5 0.5 0 /
+DENSITY
+800 1000 1 /
+ROCK
+200 1.0E-5 /
+
+SCHEDULE
+WELSPECS
+)~";
+        for (int j = 1; j <= ny; ++j)
+            for (int i = 1; i <= nx; ++i)
+                input << "'W_" << i << '_' << j << "' 'G1' " << i << ' ' << j << " 1* OIL /\n";
+
+        input << "/\nCOMPDAT\n";
+        for (int j = 1; j <= ny; ++j)
+            for (int i = 1; i <= nx; ++i)
+                input << "'W_" << i << '_' << j << "' " << i << ' ' << j << " 1 1 OPEN 1* 100 /\n";
+
+        input << "/\nWCONPROD\n'W*' OPEN ORAT 100 /\n/\nTSTEP\n10 /\n";
+
+        return Ewoms::Parser{}.parseString(input.str());
+    }
+
+    template <typename T>
+    bool sameBytes(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return (a.size() == b.size())
+            && (std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+    }
+
+    bool sameStrings(const std::vector<Ewoms::EclIO::PaddedOutputString<8>>& a,
+                     const std::vector<Ewoms::EclIO::PaddedOutputString<8>>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (std::string{ a[i].c_str() } != std::string{ b[i].c_str() })
+                return false;
+        }
+
+        return true;
+    }
+
+    void checkFusedAggregation(const Ewoms::EclipseState&      es,
+                               const Ewoms::EclipseGrid&       grid,
+                               const Ewoms::Schedule&          sched,
+                               const std::size_t             sim_step,
+                               const Ewoms::data::WellRates&   xw,
+                               const Ewoms::SummaryState&      smry)
+    {
+        const auto& units = es.getUnits();
+        const auto action_state = Ewoms::Action::State{};
+        const auto ih = Ewoms::RestartIO::Helpers::createInteHead(es, grid, sched, 0,
+                                                                  sim_step, sim_step, sim_step);
+
+        auto separate = Ewoms::RestartIO::Helpers::AggregateWellData{ ih };
+        separate.captureDeclaredWellData(sched, units, sim_step, action_state, smry, ih);
+        separate.captureDynamicWellData(sched, sim_step, xw, smry);
+
+        const auto results = Ewoms::data::WellResults{ xw };
+        const auto index = Ewoms::RestartIO::Helpers::AggregationIndex{ sched, sim_step, results };
+
+        auto fused = Ewoms::RestartIO::Helpers::AggregateWellData{ ih };
+        fused.captureWellData(index, sched, units, action_state, smry, ih);
+
+        BOOST_CHECK(sameBytes(fused.getIWell(), separate.getIWell()));
+        BOOST_CHECK(sameBytes(fused.getSWell(), separate.getSWell()));
+        BOOST_CHECK(sameBytes(fused.getXWell(), separate.getXWell()));
+        BOOST_CHECK(sameStrings(fused.getZWell(), separate.getZWell()));
+
+        auto connByName = Ewoms::RestartIO::Helpers::AggregateConnectionData{ ih };
+        connByName.captureDeclaredConnData(sched, grid, units, xw, sim_step);
+
+        auto connIndexed = Ewoms::RestartIO::Helpers::AggregateConnectionData{ ih };
+        connIndexed.captureDeclaredConnData(index, grid, units);
+
+        BOOST_CHECK(sameBytes(connIndexed.getIConn(), connByName.getIConn()));
+        BOOST_CHECK(sameBytes(connIndexed.getSConn(), connByName.getSConn()));
+        BOOST_CHECK(sameBytes(connIndexed.getXConn(), connByName.getXConn()));
+    }
+
 } // namespace
 
 struct SimulationCase
@@ -1229,4 +1359,74 @@ BOOST_AUTO_TEST_CASE(WELL_POD) {
     BOOST_CHECK_EQUAL(conn1.ijk[2], 1);
 }
 
+BOOST_AUTO_TEST_CASE(Fused_Well_Data)
+{
+    {
+        const auto simCase = SimulationCase{first_sim()};
+        const auto smry = sim_state();
+
+        checkFusedAggregation(simCase.es, simCase.grid, simCase.sched, 1, well_rates_1(), smry);
+        checkFusedAggregation(simCase.es, simCase.grid, simCase.sched, 1, well_rates_2(), smry);
+        checkFusedAggregation(simCase.es, simCase.grid, simCase.sched, 2, well_rates_2(), smry);
+        checkFusedAggregation(simCase.es, simCase.grid, simCase.sched, 2, {}, smry);
+    }
+
+    {
+        const auto simCase = SimulationCase{msw_sim("0A4_GRCTRL_LRAT_LRAT_GGR_BASE_MODEL2_MSW_ALL.DATA")};
+
+        checkFusedAggregation(simCase.es, simCase.grid, simCase.sched, 1, {}, sim_state());
+    }
+}
+
+// Micro-benchmark of the fused, windowed pass against the separate
+// per-array passes on a model with 10,000 wells.
+BOOST_AUTO_TEST_CASE(Fused_Well_Data_10k_Wells)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto simCase = SimulationCase{ many_wells_sim(100, 100) };
+    const auto& units = simCase.es.getUnits();
+    const auto sim_step = std::size_t{1};
+    const auto action_state = Ewoms::Action::State{};
+    const auto smry = Ewoms::SummaryState{ std::chrono::system_clock::now() };
+    const auto ih = Ewoms::RestartIO::Helpers::createInteHead(simCase.es, simCase.grid, simCase.sched,
+                                                              0, sim_step, sim_step, sim_step);
+
+    auto xw = Ewoms::data::WellRates{};
+    for (const auto& wname : simCase.sched.wellNames(sim_step)) {
+        auto& well = xw[wname];
+        well.rates.set(Ewoms::data::Rates::opt::oil, 1.0);
+        well.bhp = 150.0;
+        well.thp = 0.0;
+        well.temperature = 0.0;
+        well.control = 0;
+    }
+
+    BOOST_CHECK_EQUAL(ih[Ewoms::RestartIO::Helpers::VectorItems::intehead::NWELLS], 10000);
+
+    const auto t0 = Clock::now();
+
+    auto separate = Ewoms::RestartIO::Helpers::AggregateWellData{ ih };
+    separate.captureDeclaredWellData(simCase.sched, units, sim_step, action_state, smry, ih);
+    separate.captureDynamicWellData(simCase.sched, sim_step, xw, smry);
+
+    const auto t1 = Clock::now();
+
+    const auto results = Ewoms::data::WellResults{ xw };
+    const auto index = Ewoms::RestartIO::Helpers::AggregationIndex{ simCase.sched, sim_step, results };
+    auto fused = Ewoms::RestartIO::Helpers::AggregateWellData{ ih };
+    fused.captureWellData(index, simCase.sched, units, action_state, smry, ih);
+
+    const auto t2 = Clock::now();
+
+    using ms = std::chrono::duration<double, std::milli>;
+    BOOST_TEST_MESSAGE("10k wells: separate passes " << ms(t1 - t0).count()
+                       << " ms, fused pass " << ms(t2 - t1).count() << " ms");
+
+    BOOST_CHECK(sameBytes(fused.getIWell(), separate.getIWell()));
+    BOOST_CHECK(sameBytes(fused.getSWell(), separate.getSWell()));
+    BOOST_CHECK(sameBytes(fused.getXWell(), separate.getXWell()));
+    BOOST_CHECK(sameStrings(fused.getZWell(), separate.getZWell()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,265 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/io/eclcompress.hh>
+#include <ewoms/eclio/io/eclconverter.hh>
+#include <ewoms/eclio/io/eclfile.hh>
+#include <ewoms/eclio/io/ecloutput.hh>
+#include <ewoms/eclio/io/erst.hh>
+#include <ewoms/eclio/io/esmry.hh>
+#include <ewoms/eclio/io/outputstream.hh>
+
+#define BOOST_TEST_MODULE Test EclCompress
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <ewoms/common/filesystem.hh>
+
+#include "workarea.cc"
+
+using namespace Ewoms::EclIO;
+
+namespace {
+
+    std::string file_content(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    std::vector<CompressionCodec> available_codecs()
+    {
+        std::vector<CompressionCodec> codecs;
+        for (auto codec : { CompressionCodec::None, CompressionCodec::Lz,
+                            CompressionCodec::LZ4, CompressionCodec::Zstd })
+            if (compressionCodecAvailable(codec))
+                codecs.push_back(codec);
+
+        return codecs;
+    }
+
+    void write_arrays(EclOutput& output)
+    {
+        std::vector<int> inte(25000);
+        std::vector<float> real(3000);
+        std::vector<double> doub(1500);
+        std::vector<bool> logi(2001);
+        for (std::size_t i = 0; i < inte.size(); i++)
+            inte[i] = static_cast<int>(i % 113) - 50;
+        for (std::size_t i = 0; i < real.size(); i++)
+            real[i] = 0.25f * i;
+        for (std::size_t i = 0; i < doub.size(); i++)
+            doub[i] = 1.0e5 + 3.0 * i;
+        for (std::size_t i = 0; i < logi.size(); i++)
+            logi[i] = (i % 3) == 0;
+
+        output.write("SEQNUM", std::vector<int>{ 1 });
+        output.write("INTE", inte);
+        output.write("REAL", real);
+        output.write("DOUB", doub);
+        output.write("LOGI", logi);
+        output.write("CHAR", std::vector<std::string>{ "PROD", "INJ", "" });
+        output.write("C0NN", std::vector<std::string>{ "A LONG WELL NAME", "W" }, 20);
+        output.write("EMPTY", std::vector<double>{});
+        output.message("ENDSOL");
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip) {
+    WorkArea work;
+
+    {
+        EclOutput output("PLAIN.UNRST", false);
+        write_arrays(output);
+    }
+
+    EclFile plain("PLAIN.UNRST");
+    const auto plainList = plain.getList();
+
+    for (auto codec : available_codecs()) {
+        for (unsigned numThreads : { 0u, 3u }) {
+            CompressionOptions options;
+            options.codec = codec;
+            options.numThreads = numThreads;
+
+            {
+                EclOutput output("PACKED.UNRST", false, std::ios::out, options);
+                BOOST_CHECK(output.compressedOutput());
+                write_arrays(output);
+            }
+
+            BOOST_CHECK(isCompressedEclFile("PACKED.UNRST"));
+            BOOST_CHECK(!isCompressedEclFile("PLAIN.UNRST"));
+
+            EclFile packed("PACKED.UNRST");
+            BOOST_CHECK(packed.compressedInput());
+            BOOST_CHECK(packed.getList() == plainList);
+            BOOST_CHECK(packed.getElementSizeList() == plain.getElementSizeList());
+
+            BOOST_CHECK(packed.get<int>("INTE") == plain.get<int>("INTE"));
+            BOOST_CHECK(packed.get<float>("REAL") == plain.get<float>("REAL"));
+            BOOST_CHECK(packed.get<double>("DOUB") == plain.get<double>("DOUB"));
+            BOOST_CHECK(packed.get<bool>("LOGI") == plain.get<bool>("LOGI"));
+            BOOST_CHECK(packed.get<std::string>("CHAR") == plain.get<std::string>("CHAR"));
+            BOOST_CHECK(packed.get<std::string>("C0NN") == plain.get<std::string>("C0NN"));
+            BOOST_CHECK(packed.get<double>("EMPTY").empty());
+
+            // Decompressing all arrays gives the original binary file.
+            {
+                EclConverter converter("PACKED.UNRST");
+                EclOutput output("UNPACKED.UNRST", false);
+                converter.convert(output);
+            }
+
+            BOOST_CHECK(file_content("UNPACKED.UNRST") == file_content("PLAIN.UNRST"));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Frames) {
+    WorkArea work;
+
+    {
+        EclOutput output("PLAIN.UNRST", false);
+        write_arrays(output);
+    }
+
+    {
+        CompressionOptions options;
+        options.codec = CompressionCodec::Lz;
+        EclOutput output("PACKED.UNRST", false, std::ios::out, options);
+        write_arrays(output);
+    }
+
+    std::ifstream input("PACKED.UNRST", std::ios::binary);
+    const auto index = readCompressedIndex(input);
+    BOOST_CHECK_EQUAL(index.size(), 9U);
+
+    // The frames hold the complete binary records of the arrays.
+    std::string records;
+    for (const auto& entry : index) {
+        const auto data = readCompressedArray(input, entry);
+        BOOST_CHECK_EQUAL(data.size(), entry.rawSize);
+        records.append(data.begin(), data.end());
+    }
+
+    BOOST_CHECK(records == file_content("PLAIN.UNRST"));
+
+    const auto plainSize = file_content("PLAIN.UNRST").size();
+    BOOST_CHECK(file_content("PACKED.UNRST").size() < plainSize / 2);
+}
+
+BOOST_AUTO_TEST_CASE(Damaged) {
+    WorkArea work;
+
+    {
+        CompressionOptions options;
+        options.codec = CompressionCodec::Lz;
+        EclOutput output("PACKED.UNRST", false, std::ios::out, options);
+        write_arrays(output);
+    }
+
+    const auto content = file_content("PACKED.UNRST");
+    {
+        std::ofstream output("CUT.UNRST", std::ios::binary);
+        output.write(content.data(), content.size() - 3);
+    }
+
+    BOOST_CHECK(isCompressedEclFile("CUT.UNRST"));
+    BOOST_CHECK_THROW(EclFile("CUT.UNRST"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(RestartStream) {
+    WorkArea work;
+
+    const auto rset = OutputStream::ResultSet { work.currentWorkingDirectory(), "CASE" };
+    const auto fmt = OutputStream::Formatted { false };
+    const auto unif = OutputStream::Unified { true };
+    const auto comp = OutputStream::Compressed { true };
+
+    for (int seqnum : { 1, 2, 3 }) {
+        OutputStream::Restart rst(rset, seqnum, fmt, unif, comp);
+        rst.write("STEP", std::vector<int>(1000, seqnum));
+        rst.write("PRESSURE", std::vector<double>(500, 100.0 * seqnum));
+    }
+
+    BOOST_CHECK(isCompressedEclFile("CASE.UNRST"));
+
+    {
+        ERst rst("CASE.UNRST");
+        BOOST_CHECK(rst.listOfReportStepNumbers() == (std::vector<int>{ 1, 2, 3 }));
+
+        rst.loadReportStepNumber(2);
+        BOOST_CHECK(rst.getRestartData<int>("STEP", 2) == std::vector<int>(1000, 2));
+        BOOST_CHECK(rst.getRestartData<double>("PRESSURE", 3) == std::vector<double>(500, 300.0));
+        BOOST_CHECK(rst.readRestartDataAsDouble("PRESSURE", 1, 2.0, 1.0) == std::vector<double>(500, 201.0));
+    }
+
+    // Rewriting step 2 drops steps 2 and 3, even if compression is not
+    // requested for the new step.
+    {
+        OutputStream::Restart rst(rset, 2, fmt, unif);
+        rst.write("STEP", std::vector<int>(10, 20));
+    }
+
+    {
+        ERst rst("CASE.UNRST");
+        BOOST_CHECK(rst.compressedInput());
+        BOOST_CHECK(rst.listOfReportStepNumbers() == (std::vector<int>{ 1, 2 }));
+        BOOST_CHECK(rst.getRestartData<int>("STEP", 1) == std::vector<int>(1000, 1));
+        BOOST_CHECK(rst.getRestartData<int>("STEP", 2) == std::vector<int>(10, 20));
+        BOOST_CHECK_EQUAL(rst.getList().size(), 5U);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Summary) {
+    WorkArea work;
+    work.copyIn("SPE1CASE1.SMSPEC");
+    work.copyIn("SPE1CASE1.UNSMRY");
+
+    work.makeSubDir("packed");
+    Ewoms::filesystem::copy_file("SPE1CASE1.SMSPEC", "packed/SPE1CASE1.SMSPEC");
+
+    {
+        EclConverter converter("SPE1CASE1.UNSMRY");
+        EclOutput output("packed/SPE1CASE1.UNSMRY", false, std::ios::out, CompressionOptions{});
+        converter.convert(output);
+    }
+
+    BOOST_CHECK(isCompressedEclFile("packed/SPE1CASE1.UNSMRY"));
+
+    const ESmry plain("SPE1CASE1.SMSPEC");
+    const ESmry packed("packed/SPE1CASE1.SMSPEC");
+
+    BOOST_CHECK_EQUAL(packed.numberOfTimeSteps(), plain.numberOfTimeSteps());
+    BOOST_CHECK(packed.keywordList() == plain.keywordList());
+
+    // Loading a single vector and loading all vectors.
+    BOOST_CHECK(packed.get("FOPR") == plain.get("FOPR"));
+
+    packed.LoadData();
+    for (const auto& key : plain.keywordList())
+        BOOST_CHECK_MESSAGE(packed.get(key) == plain.get(key), "Vector " + key);
+}
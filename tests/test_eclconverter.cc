@@ -0,0 +1,185 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#include <ewoms/eclio/io/eclconverter.hh>
+#include <ewoms/eclio/io/eclfile.hh>
+#include <ewoms/eclio/io/ecloutput.hh>
+#include <ewoms/eclio/io/erst.hh>
+
+#define BOOST_TEST_MODULE Test EclConverter
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace Ewoms::EclIO;
+
+namespace {
+
+    bool compare_files(const std::string& filename1, const std::string& filename2)
+    {
+        std::ifstream file1(filename1, std::ios::binary);
+        std::ifstream file2(filename2, std::ios::binary);
+
+        const std::string content1((std::istreambuf_iterator<char>(file1)), std::istreambuf_iterator<char>());
+        const std::string content2((std::istreambuf_iterator<char>(file2)), std::istreambuf_iterator<char>());
+
+        return !content1.empty() && (content1 == content2);
+    }
+
+    // Conversion by loading the complete arrays, as done by earlier
+    // versions of convert_ecl.
+    void write_reference(const std::string& inputFile, const std::string& outputFile)
+    {
+        EclFile file1(inputFile);
+        file1.loadData();
+
+        EclOutput outFile(outputFile, !file1.formattedInput());
+        if (file1.is_ix())
+            outFile.set_ix();
+
+        const auto arrayList = file1.getList();
+        const auto& elementSizeList = file1.getElementSizeList();
+
+        for (std::size_t index = 0; index < arrayList.size(); index++) {
+            const std::string& name = std::get<0>(arrayList[index]);
+
+            switch (std::get<1>(arrayList[index])) {
+            case INTE:
+                outFile.write(name, file1.get<int>(index));
+                break;
+            case REAL:
+                outFile.write(name, file1.get<float>(index));
+                break;
+            case DOUB:
+                outFile.write(name, file1.get<double>(index));
+                break;
+            case LOGI:
+                outFile.write(name, file1.get<bool>(index));
+                break;
+            case CHAR:
+                outFile.write(name, file1.get<std::string>(index));
+                break;
+            case C0NN:
+                outFile.write(name, file1.get<std::string>(index), elementSizeList[index]);
+                break;
+            case MESS:
+                outFile.message(name);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void convert(const std::string& inputFile, const std::string& outputFile, std::size_t chunkSize)
+    {
+        EclConverter converter(inputFile);
+        converter.setChunkSize(chunkSize);
+
+        EclOutput outFile(outputFile, !converter.formattedInput());
+        if (converter.is_ix())
+            outFile.set_ix();
+
+        converter.convert(outFile);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToFormatted) {
+    for (const std::string inputFile : {"SPE1_TESTCASE.UNRST", "MODEL1_IX.INIT", "ECLFILE.INIT"}) {
+        write_reference(inputFile, "REFERENCE.FOUT");
+
+        for (std::size_t chunkSize : {1, 3, 256}) {
+            convert(inputFile, "TEST.FOUT", chunkSize);
+            BOOST_CHECK_MESSAGE(compare_files("REFERENCE.FOUT", "TEST.FOUT"),
+                                "Converting " << inputFile << " with chunk size " << chunkSize);
+        }
+    }
+
+    remove("REFERENCE.FOUT");
+    remove("TEST.FOUT");
+}
+
+BOOST_AUTO_TEST_CASE(ConvertToBinary) {
+    for (const std::string inputFile : {"SPE1_TESTCASE.FUNRST", "ECLFILE.FINIT"}) {
+        write_reference(inputFile, "REFERENCE.OUT");
+
+        for (std::size_t chunkSize : {1, 3, 256}) {
+            convert(inputFile, "TEST.OUT", chunkSize);
+            BOOST_CHECK_MESSAGE(compare_files("REFERENCE.OUT", "TEST.OUT"),
+                                "Converting " << inputFile << " with chunk size " << chunkSize);
+        }
+    }
+
+    remove("REFERENCE.OUT");
+    remove("TEST.OUT");
+}
+
+BOOST_AUTO_TEST_CASE(SelectReportSteps) {
+    EclConverter converter("SPE1_TESTCASE.UNRST");
+    converter.selectReportSteps({25, 1});
+
+    {
+        EclOutput outFile("TEST.FUNRST", true);
+        converter.convert(outFile);
+    }
+
+    ERst rst1("SPE1_TESTCASE.UNRST");
+    ERst rst2("TEST.FUNRST");
+
+    BOOST_CHECK(rst2.listOfReportStepNumbers() == std::vector<int>({1, 25}));
+    BOOST_CHECK_EQUAL(converter.selectedArrays().size(),
+                      rst1.listOfRstArrays(1).size() + rst1.listOfRstArrays(25).size());
+
+    for (int reportStep : {1, 25}) {
+        BOOST_CHECK(rst1.listOfRstArrays(reportStep) == rst2.listOfRstArrays(reportStep));
+        BOOST_CHECK(rst1.getRestartData<float>("PRESSURE", reportStep) == rst2.getRestartData<float>("PRESSURE", reportStep));
+        BOOST_CHECK(rst1.getRestartData<int>("INTEHEAD", reportStep) == rst2.getRestartData<int>("INTEHEAD", reportStep));
+    }
+
+    remove("TEST.FUNRST");
+
+    EclConverter init("ECLFILE.INIT");
+    BOOST_CHECK_THROW(init.selectReportSteps({1}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(SelectArrays) {
+    EclConverter converter("SPE1_TESTCASE.UNRST");
+    converter.selectArrays({"SEQNUM", "PRESSURE"});
+    converter.selectReportSteps({25});
+
+    {
+        EclOutput outFile("TEST.FUNRST", true);
+        converter.convert(outFile);
+    }
+
+    EclFile file1("TEST.FUNRST");
+    BOOST_CHECK(file1.arrayNames() == std::vector<std::string>({"SEQNUM", "PRESSURE"}));
+    BOOST_CHECK_EQUAL(file1.get<int>("SEQNUM")[0], 25);
+
+    ERst rst1("SPE1_TESTCASE.UNRST");
+    BOOST_CHECK(file1.get<float>("PRESSURE") == rst1.getRestartData<float>("PRESSURE", 25));
+
+    remove("TEST.FUNRST");
+}
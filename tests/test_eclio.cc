@@ -28,6 +28,8 @@
 #include <tuple>
 #include <cmath>
 #include <numeric>
+#include <sstream>
+#include <cstdint>
 
 #include <ewoms/eclio/io/eclfile.hh>
 #include <ewoms/eclio/io/eclutil.hh>
@@ -293,6 +295,56 @@ BOOST_AUTO_TEST_CASE(TestEcl_Write_binary) {
     };
 }
 
+BOOST_AUTO_TEST_CASE(TestEcl_Write_binary_buffer_size) {
+
+    // arrays spanning many records, written with staging buffers smaller
+    // than, equal to and larger than a single record, must give identical
+    // files.
+
+    std::vector<int> inte(10007);
+    std::vector<float> real(4321);
+    std::vector<double> doub(12345);
+    std::vector<bool> logi(2500);
+
+    std::iota(inte.begin(), inte.end(), -500);
+    for (size_t n = 0; n < real.size(); n++)
+        real[n] = 0.25f * n - 100.0f;
+    for (size_t n = 0; n < doub.size(); n++)
+        doub[n] = 1.0e-3 * n * n - 12.5;
+    for (size_t n = 0; n < logi.size(); n++)
+        logi[n] = (n % 3 == 0);
+
+    const std::vector<std::string> testFiles = {"TEST1.DAT", "TEST2.DAT", "TEST3.DAT"};
+    const std::vector<std::size_t> bufferSizes = {0, 8008, 1 << 22};
+
+    for (size_t f = 0; f < testFiles.size(); f++) {
+        EclOutput eclTest(testFiles[f], false);
+        eclTest.setWriteBufferSize(bufferSizes[f]);
+
+        eclTest.write("INTE", inte);
+        eclTest.write("REAL", real);
+        eclTest.write("DOUB", doub);
+        eclTest.write("LOGI", logi);
+    }
+
+    BOOST_CHECK_EQUAL(compare_files(testFiles[0], testFiles[1]), true);
+    BOOST_CHECK_EQUAL(compare_files(testFiles[0], testFiles[2]), true);
+
+    {
+        EclFile file1(testFiles[0]);
+        BOOST_CHECK(file1.get<int>("INTE") == inte);
+        BOOST_CHECK(file1.get<float>("REAL") == real);
+        BOOST_CHECK(file1.get<double>("DOUB") == doub);
+        BOOST_CHECK(file1.get<bool>("LOGI") == logi);
+    }
+
+    for (const auto& testFile : testFiles) {
+        if (remove(testFile.c_str())==-1) {
+            std::cout << " > Warning! temporary file was not deleted" << std::endl;
+        };
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted) {
 
     std::string inputFile="ECLFILE.FINIT";
@@ -350,6 +402,177 @@ BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_not_finite) {
     BOOST_CHECK_EQUAL(file1.size(), 2U);
 }
 
+namespace {
+
+    // Formatting of REAL and DOUB values as done by earlier versions of
+    // EclOutput, used as reference for the current implementation.
+
+    std::string reference_real_ecl(float value)
+    {
+        char buffer [15];
+        std::sprintf (buffer, "%10.7E", value);
+
+        if (value == 0.0)
+            return "0.00000000E+00";
+
+        std::string tmpstr(buffer);
+        int exp =  value < 0.0 ? std::stoi(tmpstr.substr(11, 3)) :  std::stoi(tmpstr.substr(10, 3));
+
+        if (value < 0.0)
+            tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 7) + "E";
+        else
+            tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 7) +"E";
+
+        std::sprintf (buffer, "%+03i", exp+1);
+        return tmpstr + buffer;
+    }
+
+    std::string reference_doub_ecl(double value)
+    {
+        char buffer [21 + 1];
+        std::snprintf (buffer, sizeof buffer, "%19.13E", value);
+
+        if (value == 0.0)
+            return "0.00000000000000D+00";
+
+        std::string tmpstr(buffer);
+        int exp = value < 0.0 ? std::stoi(tmpstr.substr(17, 4)) : std::stoi(tmpstr.substr(16, 4));
+        const bool use_exp_char = (exp >= -100) && (exp < 99);
+
+        if (value < 0.0)
+            tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13);
+        else
+            tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13);
+
+        if (use_exp_char)
+            tmpstr += "D";
+
+        std::snprintf(buffer, sizeof buffer, "%+03i", exp + 1);
+        return tmpstr + buffer;
+    }
+
+    std::string reference_ix(double value, int precision)
+    {
+        char buffer [32];
+        std::snprintf (buffer, sizeof buffer, "%.*E", precision, value);
+        return buffer;
+    }
+
+    std::vector<double> codec_test_values()
+    {
+        std::vector<double> values = {1.0, -1.0, 0.1, 9.99999995, 9.9999999999999995, 0.5, 1.5e-7,
+                                      12345678901234.5, 12345678901235.5, 1.25, 2.5e10,
+                                      1.0e-99, 9.99999999999999e-100, 1.0e-100, 1.0e99, 9.99999999999999e98,
+                                      1.0e100, 1.0e-300, 1.0e300, std::numeric_limits<double>::max(),
+                                      std::numeric_limits<float>::max(), std::numeric_limits<float>::min()};
+
+        // Deterministic pseudo random values spread over the full exponent range.
+        std::uint64_t state = 12345;
+        for (int i = 0; i < 20000; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const double mantissa = static_cast<double>(state >> 11) / static_cast<double>(1ULL << 53);
+            const int exponent = static_cast<int>((state >> 3) % 600) - 300;
+            values.push_back(std::ldexp(mantissa, exponent) * 1.0e1);
+            values.push_back(-mantissa * std::pow(10.0, (exponent % 40)));
+        }
+
+        return values;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestEcl_Formatted_codec) {
+    char buffer[maxFormattedValueLength];
+
+    for (const double value : codec_test_values()) {
+        const float fvalue = static_cast<float>(value);
+
+        if (std::isfinite(fvalue)) {
+            BOOST_CHECK_EQUAL(std::string(buffer, formatRealEcl(fvalue, buffer)), reference_real_ecl(fvalue));
+
+            if (fvalue != 0.0)
+                BOOST_CHECK_EQUAL(std::string(buffer, formatRealIx(fvalue, buffer)), reference_ix(fvalue, 7));
+
+            const std::string str = reference_real_ecl(fvalue);
+            BOOST_CHECK_EQUAL(static_cast<float>(parseFormattedDouble(str.data(), str.data() + str.size())),
+                              static_cast<float>(std::stod(str)));
+        }
+
+        BOOST_CHECK_EQUAL(std::string(buffer, formatDoubEcl(value, buffer)), reference_doub_ecl(value));
+        BOOST_CHECK_EQUAL(std::string(buffer, formatDoubIx(value, buffer)), reference_ix(value, 13));
+
+        std::string str = reference_doub_ecl(value);
+        const double parsed = parseFormattedDouble(str.data(), str.data() + str.size());
+        std::replace(str.begin(), str.end(), 'D', 'E');
+        if (str.find('E') == std::string::npos)
+            str.insert(str.find_first_of("+-", 1), "E");
+
+        BOOST_CHECK_EQUAL(parsed, std::stod(str));
+    }
+
+    const std::string three_digit_exponent = "-0.12345678901234-101";
+    BOOST_CHECK_EQUAL(parseFormattedDouble(three_digit_exponent.data(), three_digit_exponent.data() + three_digit_exponent.size()),
+                      -0.12345678901234e-101);
+
+    const std::string invalid = "ABC";
+    BOOST_CHECK_THROW(parseFormattedDouble(invalid.data(), invalid.data() + invalid.size()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_large) {
+    WorkArea wa;
+
+    // Large enough to be formatted in several chunks.
+    const auto values = codec_test_values();
+    std::vector<double> doub(values.begin(), values.begin() + 30001);
+    std::vector<double> doub_large;
+    while (doub_large.size() < 150001)
+        doub_large.insert(doub_large.end(), doub.begin(), doub.end());
+
+    std::vector<float> real;
+    for (int i = 0; i < 70001; i++)
+        real.push_back(static_cast<float>(std::sin(i) * std::pow(10.0, i % 60 - 30)));
+
+    {
+        EclOutput testfile("TEST.FINIT", true);
+        testfile.write("DOUB", doub_large);
+        testfile.write("REAL", real);
+    }
+
+    std::ostringstream expected;
+    expected << " 'DOUB    ' " << std::setw(11) << doub_large.size() << " 'DOUB'\n";
+    for (std::size_t i = 0; i < doub_large.size(); i++) {
+        expected << std::setw(23) << reference_doub_ecl(doub_large[i]);
+        if (((i % 1000) + 1) % 3 == 0 || (i % 1000) + 1 == 1000)
+            expected << '\n';
+    }
+    if ((doub_large.size() % 1000) % 3 != 0)
+        expected << '\n';
+
+    expected << " 'REAL    ' " << std::setw(11) << real.size() << " 'REAL'\n";
+    for (std::size_t i = 0; i < real.size(); i++) {
+        expected << std::setw(17) << reference_real_ecl(real[i]);
+        if (((i % 1000) + 1) % 4 == 0 || (i % 1000) + 1 == 1000)
+            expected << '\n';
+    }
+    if ((real.size() % 1000) % 4 != 0)
+        expected << '\n';
+
+    std::ifstream file("TEST.FINIT");
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    BOOST_CHECK(content == expected.str());
+
+    EclFile file1("TEST.FINIT");
+    const auto& doub_read = file1.get<double>("DOUB");
+    BOOST_REQUIRE_EQUAL(doub_read.size(), doub_large.size());
+    for (std::size_t i = 0; i < doub_large.size(); i++) {
+        std::string str = reference_doub_ecl(doub_large[i]);
+        std::replace(str.begin(), str.end(), 'D', 'E');
+        if (str.find('E') == std::string::npos)
+            str.insert(str.find_first_of("+-", 1), "E");
+
+        BOOST_CHECK_EQUAL(doub_read[i], std::stod(str));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TestEcl_getList) {
 
     std::string inputFile="ECLFILE.INIT";
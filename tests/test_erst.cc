@@ -24,6 +24,7 @@
 #define BOOST_TEST_MODULE Test EclIO
 #include <boost/test/unit_test.hpp>
 
+#include <ewoms/eclio/io/eclseekindex.hh>
 #include <ewoms/eclio/io/ecloutput.hh>
 #include <ewoms/eclio/io/outputstream.hh>
 
@@ -306,6 +307,35 @@ BOOST_AUTO_TEST_CASE(TestERst_4) {
     BOOST_CHECK_EQUAL(pres1==pres3, true);
 }
 
+BOOST_AUTO_TEST_CASE(TestERst_ReadAsDouble) {
+
+    for (const auto* fname : { "SPE1_TESTCASE.UNRST", "SPE1_TESTCASE.FUNRST" }) {
+        ERst rst1(fname);
+        ERst rst2(fname);
+
+        // Decoded straight from the file.
+        const auto pres = rst1.readRestartDataAsDouble("PRESSURE", 25);
+        const auto pres_si = rst1.readRestartDataAsDouble("PRESSURE", 25, 1.0e5, 0.0);
+        const auto doubhead = rst1.readRestartDataAsDouble("DOUBHEAD", 25);
+
+        // Converted from the loaded arrays.
+        const auto& pres_ref = rst2.getRestartData<float>("PRESSURE", 25);
+        const auto& doubhead_ref = rst2.getRestartData<double>("DOUBHEAD", 25);
+
+        BOOST_CHECK_EQUAL(pres.size(), pres_ref.size());
+        BOOST_CHECK(std::equal(pres.begin(), pres.end(), pres_ref.begin(), pres_ref.end()));
+        BOOST_CHECK(doubhead == doubhead_ref);
+
+        for (std::size_t i = 0; i < pres_ref.size(); ++i)
+            BOOST_CHECK_EQUAL(pres_si[i], static_cast<double>(pres_ref[i]) * 1.0e5);
+
+        BOOST_CHECK(rst2.readRestartDataAsDouble("PRESSURE", 25, 1.0e5, 0.0) == pres_si);
+
+        BOOST_CHECK_THROW(rst1.readRestartDataAsDouble("INTEHEAD", 25), std::runtime_error);
+        BOOST_CHECK_THROW(rst1.readRestartDataAsDouble("PRESSURE", 26), std::invalid_argument);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TestERst_5a) {
 
     std::string testRstFile = "LGR_TESTMOD.X0002";
@@ -1170,3 +1200,203 @@ BOOST_AUTO_TEST_CASE(Formatted)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(Lazy)
+
+BOOST_AUTO_TEST_CASE(ReportStepSubset)
+{
+    ERst full("LGR_TESTMOD.UNRST");
+    ERst lazy("LGR_TESTMOD.UNRST", std::vector<int>{ 2 });
+
+    BOOST_CHECK(lazy.listOfReportStepNumbers() == std::vector<int>{ 2 });
+    BOOST_CHECK_EQUAL(lazy.hasReportStepNumber(1), false);
+    BOOST_CHECK_EQUAL(lazy.hasLGR("LGR1", 2), true);
+
+    const auto arrays = full.listOfRstArrays(2);
+    BOOST_CHECK(lazy.listOfRstArrays(2) == arrays);
+    BOOST_CHECK(lazy.listOfRstArrays(2, "LGR2") == full.listOfRstArrays(2, "LGR2"));
+
+    BOOST_CHECK(lazy.getRestartData<float>("PRESSURE", 2) == full.getRestartData<float>("PRESSURE", 2));
+    BOOST_CHECK(lazy.getRestartData<int>("ICON", 2) == full.getRestartData<int>("ICON", 2));
+    BOOST_CHECK(lazy.getRestartData<float>("SWAT", 2, "LGR1") == full.getRestartData<float>("SWAT", 2, "LGR1"));
+
+    ERst none("LGR_TESTMOD.UNRST", std::vector<int>{ 7 });
+    BOOST_CHECK(none.listOfReportStepNumbers().empty());
+
+    // Separate restart files are opened completely.
+    ERst separate("LGR_TESTMOD.X0002", std::vector<int>{ 2 });
+    BOOST_CHECK_EQUAL(separate.hasReportStepNumber(2), true);
+
+    BOOST_CHECK_THROW(ERst("LGR_TESTMOD.UNRST", std::vector<int>{}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// ==========================================================================
+
+BOOST_AUTO_TEST_SUITE(SeekIndexFile)
+
+namespace {
+    void writeSteps(const ::Ewoms::EclIO::OutputStream::ResultSet& rset,
+                    const int first, const int last, const int offset)
+    {
+        const auto fmt  = ::Ewoms::EclIO::OutputStream::Formatted{ false };
+        const auto unif = ::Ewoms::EclIO::OutputStream::Unified  { true };
+
+        for (int seqnum = first; seqnum <= last; ++seqnum) {
+            auto rst = ::Ewoms::EclIO::OutputStream::Restart {
+                rset, seqnum, fmt, unif
+            };
+
+            rst.write("I", std::vector<int>(10 * seqnum, seqnum + offset));
+            rst.write("D", std::vector<double>(5, 0.5 * seqnum));
+            rst.message("ENDSOL");
+        }
+    }
+
+    std::string fileContents(const std::string& fname)
+    {
+        std::ifstream input(fname, std::ios::binary);
+        return { std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Unified)
+{
+    const auto rset  = RSet("CASE");
+    const auto fname = ::Ewoms::EclIO::OutputStream::outputFileName(rset, "UNRST");
+
+    writeSteps(rset, 1, 4, 0);
+
+    BOOST_CHECK(Ewoms::filesystem::exists(SeekIndex::fileName(fname)));
+
+    {
+        const auto index = SeekIndex::load(fname);
+        BOOST_REQUIRE(index.has_value());
+        BOOST_CHECK_EQUAL(index->reportSteps().size(), 4U);
+        BOOST_CHECK_EQUAL(index->arrays().size(), 16U);
+
+        // Same content as the index built from the array headers.
+        const auto built = SeekIndex::build(fname);
+        BOOST_REQUIRE_EQUAL(built.arrays().size(), index->arrays().size());
+        for (std::size_t i = 0; i < built.arrays().size(); ++i) {
+            BOOST_CHECK_EQUAL(built.arrays()[i].name, index->arrays()[i].name);
+            BOOST_CHECK_EQUAL(built.arrays()[i].position, index->arrays()[i].position);
+        }
+    }
+
+    {
+        ERst rst(fname);
+        BOOST_CHECK(rst.listOfReportStepNumbers() == (std::vector<int>{ 1, 2, 3, 4 }));
+        BOOST_CHECK(rst.getRestartData<int>("I", 3) == std::vector<int>(30, 3));
+    }
+
+    {
+        ERst rst(fname, std::vector<int>{ 2, 4 });
+        BOOST_CHECK(rst.listOfReportStepNumbers() == (std::vector<int>{ 2, 4 }));
+        BOOST_CHECK_EQUAL(rst.getList().size(), 8U);
+        BOOST_CHECK(rst.getRestartData<int>("I", 4) == std::vector<int>(40, 4));
+        BOOST_CHECK(rst.getRestartData<double>("D", 2) == std::vector<double>(5, 1.0));
+    }
+
+    // Rewriting from step 3 cuts the index along with the file.
+    writeSteps(rset, 3, 3, 100);
+
+    {
+        const auto index = SeekIndex::load(fname);
+        BOOST_REQUIRE(index.has_value());
+        BOOST_CHECK_EQUAL(index->reportSteps().size(), 3U);
+        BOOST_CHECK_EQUAL(index->reportSteps().back().seqnum, 3);
+        BOOST_CHECK_EQUAL(index->reportSteps().back().firstArray, 8U);
+
+        ERst rst(fname, std::vector<int>{ 3 });
+        BOOST_CHECK(rst.getRestartData<int>("I", 3) == std::vector<int>(30, 103));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AppendReportStep)
+{
+    const auto rset  = RSet("CASE");
+    const auto fname = ::Ewoms::EclIO::OutputStream::outputFileName(rset, "UNRST");
+
+    writeSteps(rset, 1, 2, 0);
+    BOOST_CHECK(SeekIndex::isCurrent(fname));
+
+    const auto before = fileContents(SeekIndex::fileName(fname));
+
+    // The next report step only appends its own records: one for the
+    // step and one for each of SEQNUM, I, D and ENDSOL.
+    writeSteps(rset, 3, 3, 0);
+    BOOST_CHECK(SeekIndex::isCurrent(fname));
+
+    const auto after = fileContents(SeekIndex::fileName(fname));
+    BOOST_CHECK_EQUAL(after.size(), before.size() + 5 * 32);
+    BOOST_CHECK(after.compare(0, before.size(), before) == 0);
+
+    const auto index = SeekIndex::load(fname);
+    BOOST_REQUIRE(index.has_value());
+    BOOST_CHECK_EQUAL(index->reportSteps().size(), 3U);
+    BOOST_CHECK_EQUAL(index->reportSteps().back().seqnum, 3);
+    BOOST_CHECK_EQUAL(index->reportSteps().back().firstArray, 8U);
+    BOOST_CHECK_EQUAL(index->arrays().size(), 12U);
+
+    ERst rst(fname, std::vector<int>{ 3 });
+    BOOST_CHECK(rst.getRestartData<int>("I", 3) == std::vector<int>(30, 3));
+}
+
+BOOST_AUTO_TEST_CASE(Stale)
+{
+    const auto rset  = RSet("CASE");
+    const auto fname = ::Ewoms::EclIO::OutputStream::outputFileName(rset, "UNRST");
+
+    writeSteps(rset, 1, 2, 0);
+
+    // Appending without the restart stream leaves the index behind.
+    {
+        EclOutput output(fname, false, std::ios::app);
+        output.write("SEQNUM", std::vector<int>{ 3 });
+        output.write("I", std::vector<int>(3, 3));
+    }
+
+    BOOST_CHECK(Ewoms::filesystem::exists(SeekIndex::fileName(fname)));
+    BOOST_CHECK(! SeekIndex::load(fname).has_value());
+    BOOST_CHECK(! SeekIndex::isCurrent(fname));
+
+    {
+        ERst rst(fname);
+        BOOST_CHECK(rst.listOfReportStepNumbers() == (std::vector<int>{ 1, 2, 3 }));
+
+        ERst lazy(fname, std::vector<int>{ 3 });
+        BOOST_CHECK(lazy.getRestartData<int>("I", 3) == std::vector<int>(3, 3));
+    }
+
+    // Stale indices are dropped when the restart stream continues the file.
+    writeSteps(rset, 4, 4, 0);
+
+    BOOST_CHECK(! Ewoms::filesystem::exists(SeekIndex::fileName(fname)));
+
+    {
+        ERst rst(fname);
+        BOOST_CHECK(rst.listOfReportStepNumbers() == (std::vector<int>{ 1, 2, 3, 4 }));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RftFile)
+{
+    const auto rset  = RSet("CASE");
+    const auto fname = ::Ewoms::EclIO::OutputStream::outputFileName(rset, "RFT");
+
+    Ewoms::filesystem::copy_file("SPE1CASE1.RFT", fname);
+
+    SeekIndex::build(fname).save(fname);
+    BOOST_CHECK(SeekIndex::load(fname).has_value());
+
+    EclFile indexed(fname);
+    EclFile plain("SPE1CASE1.RFT");
+
+    BOOST_CHECK(indexed.getList() == plain.getList());
+    BOOST_CHECK(indexed.get<float>("PRESSURE") == plain.get<float>("PRESSURE"));
+    BOOST_CHECK(indexed.get<std::string>("WELLETC") == plain.get<std::string>("WELLETC"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
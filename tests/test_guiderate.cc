@@ -38,8 +38,10 @@
 #include <ewoms/eclio/parser/units/units.hh>
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <stddef.h>
 
@@ -521,4 +523,51 @@ BOOST_AUTO_TEST_CASE(P_Third_df09)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Tree_Sweep)
+{
+    auto cse = case_10x10x10_model4();
+    auto by_name = Ewoms::GuideRate { cse.sched };
+
+    const auto rpt  = size_t{1};
+    const auto tree = cse.sched.groupTree(rpt).topology();
+    const auto index = cse.gr.index(tree);
+
+    BOOST_CHECK(tree.has("P1"));
+    BOOST_CHECK(tree.has("I1"));
+    BOOST_CHECK_EQUAL(tree.name(tree.parent(tree.id("P1"))), "P");
+
+    auto potentials = std::vector<Ewoms::GuideRate::RateVector>(tree.size());
+    for (std::size_t node = 0; node < tree.size(); ++node) {
+        potentials[node] = { 1.0 + node, 5.0, 0.1*(node + 1) };
+    }
+
+    for (const auto stm : { 0.0, 10.0*86400.0 }) {
+        for (const auto node : tree.order()) {
+            const auto& pot = potentials[node];
+            cse.gr.compute(index[node], rpt, stm, pot.oil_rat, pot.gas_rat, pot.wat_rat);
+            by_name.compute(tree.name(node), rpt, stm, pot.oil_rat, pot.gas_rat, pot.wat_rat);
+        }
+    }
+
+    const auto rates = Ewoms::GuideRate::RateVector { 2.0, 4.0, 1.0 };
+    for (std::size_t node = 0; node < tree.size(); ++node) {
+        const auto& name = tree.name(node);
+
+        BOOST_CHECK_EQUAL(cse.gr.name(index[node]), name);
+        BOOST_CHECK_EQUAL(cse.gr.has(index[node]), by_name.has(name));
+        BOOST_CHECK_EQUAL(cse.gr.has(name), by_name.has(name));
+        BOOST_CHECK_CLOSE(cse.gr.get(index[node], Ewoms::GuideRateModel::Target::OIL, rates),
+                          by_name.get(name, Ewoms::GuideRateModel::Target::OIL, rates), 1.0e-10);
+    }
+
+    // GUIDERAT does not apply to injectors, I1 falls back to its potentials
+    BOOST_CHECK(cse.gr.has("P1"));
+    BOOST_CHECK(!cse.gr.has("I1"));
+    BOOST_CHECK_CLOSE(cse.gr.get("I1", Ewoms::Well::GuideRateTarget::OIL, rates),
+                      potentials[tree.id("I1")].oil_rat, 1.0e-10);
+
+    BOOST_CHECK(!cse.gr.has("NO_SUCH_WELL"));
+    BOOST_CHECK_THROW(cse.gr.get("NO_SUCH_WELL", Ewoms::Well::GuideRateTarget::OIL, rates), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // GuideRate_Calculations
@@ -21,10 +21,79 @@
 #define BOOST_TEST_MODULE Inplace
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <map>
+#include <random>
+#include <unordered_map>
+
 #include <ewoms/eclio/output/inplace.hh>
 
 using namespace Ewoms;
 
+namespace {
+
+    // The map based storage Inplace used to have.
+    struct ReferenceInplace {
+        std::unordered_map<std::string, std::map<Inplace::Phase, std::unordered_map<std::size_t, double>>> phase_values;
+
+        void add(const std::string& region, Inplace::Phase phase, std::size_t region_id, double value) {
+            this->phase_values[region][phase][region_id] = value;
+        }
+
+        void add(const std::string& region, Inplace::Phase phase, const std::vector<int>& cell_regions,
+                 const std::vector<double>& cell_values) {
+            const auto max_id = *std::max_element(cell_regions.begin(), cell_regions.end());
+            for (int region_id = 1; region_id <= max_id; ++region_id)
+                this->phase_values[region][phase][region_id] = 0.0;
+
+            for (std::size_t cell = 0; cell < cell_regions.size(); ++cell) {
+                if (cell_regions[cell] > 0)
+                    this->phase_values[region][phase][cell_regions[cell]] += cell_values[cell];
+            }
+        }
+    };
+
+    std::vector<Inplace::Phase> allPhases() {
+        auto phases = Inplace::phases();
+        phases.push_back(Inplace::Phase::PressurePV);
+        phases.push_back(Inplace::Phase::HydroCarbonPV);
+        phases.push_back(Inplace::Phase::PressureHydroCarbonPV);
+        return phases;
+    }
+
+    void checkSame(const Inplace& oip, const ReferenceInplace& ref, double tolerance) {
+        std::size_t max_region = 0;
+        for (const auto& region_pair : ref.phase_values) {
+            const auto& region = region_pair.first;
+
+            std::size_t region_max = 0;
+            for (const auto& phase_pair : region_pair.second)
+                for (const auto& value_pair : phase_pair.second)
+                    region_max = std::max(region_max, value_pair.first);
+
+            BOOST_CHECK_EQUAL(oip.max_region(region), region_max);
+            max_region = std::max(max_region, region_max);
+
+            for (const auto phase : allPhases()) {
+                const auto phase_iter = region_pair.second.find(phase);
+                for (std::size_t region_id = 0; region_id <= region_max + 1; ++region_id) {
+                    const bool expected = (phase_iter != region_pair.second.end())
+                        && (phase_iter->second.count(region_id) > 0);
+
+                    BOOST_CHECK_EQUAL(oip.has(region, phase, region_id), expected);
+                    if (expected)
+                        BOOST_CHECK_CLOSE(oip.get(region, phase, region_id), phase_iter->second.at(region_id), tolerance);
+                    else
+                        BOOST_CHECK_THROW(oip.get(region, phase, region_id), std::logic_error);
+                }
+            }
+        }
+
+        BOOST_CHECK_EQUAL(oip.max_region(), max_region);
+    }
+
+}
+
 bool contains(const std::vector<Inplace::Phase>& phases, Inplace::Phase phase) {
     auto find_iter = std::find(phases.begin(), phases.end(), phase);
     return find_iter != phases.end();
@@ -66,3 +135,79 @@ BOOST_AUTO_TEST_CASE(TESTInplace) {
     BOOST_CHECK( v1 == e1 );
 
 }
+
+BOOST_AUTO_TEST_CASE(SameAsMap) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<std::size_t> region_id(0, 40);
+    std::uniform_int_distribution<std::size_t> phase_index(0, 10);
+    std::uniform_int_distribution<int> region_name(0, 2);
+    std::uniform_real_distribution<double> value(-1.0e3, 1.0e3);
+
+    const std::vector<std::string> names = { "FIPNUM", "FIPABC", "FIELD" };
+
+    Inplace oip;
+    ReferenceInplace ref;
+    for (int i = 0; i < 2000; ++i) {
+        const auto& name = names[region_name(gen)];
+        const auto phase = static_cast<Inplace::Phase>(phase_index(gen));
+        const auto id = region_id(gen) * (i + 1) / 2000;
+        const auto v = value(gen);
+
+        oip.add(name, phase, id, v);
+        ref.add(name, phase, id, v);
+    }
+
+    checkSame(oip, ref, 0.0);
+
+    for (const auto& name : names) {
+        const auto v = oip.get_vector(name, Inplace::Phase::OIL);
+        BOOST_CHECK_EQUAL(v.size(), oip.max_region(name));
+        for (std::size_t id = 1; id <= v.size(); ++id) {
+            const auto expected = oip.has(name, Inplace::Phase::OIL, id) ? oip.get(name, Inplace::Phase::OIL, id) : 0.0;
+            BOOST_CHECK_EQUAL(v[id - 1], expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(RegionReduction) {
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<double> value(0.0, 1.0e4);
+
+    // More cells than one reduction chunk, so that partial sums are used.
+    const std::size_t num_cells = 300000;
+    std::vector<int> fipnum(num_cells), fipabc(num_cells);
+    std::vector<double> oil(num_cells), pv(num_cells);
+    for (std::size_t cell = 0; cell < num_cells; ++cell) {
+        fipnum[cell] = static_cast<int>(1 + (cell * 7919) % 500);
+        fipabc[cell] = static_cast<int>(cell % 5) - 1;       // some cells in no region
+        oil[cell] = value(gen);
+        pv[cell] = value(gen);
+    }
+
+    Inplace oip;
+    ReferenceInplace ref;
+
+    oip.add("FIPNUM", Inplace::Phase::OIL, fipnum, oil);
+    ref.add("FIPNUM", Inplace::Phase::OIL, fipnum, oil);
+    oip.add("FIPNUM", Inplace::Phase::PoreVolume, fipnum, pv);
+    ref.add("FIPNUM", Inplace::Phase::PoreVolume, fipnum, pv);
+    oip.add("FIPABC", Inplace::Phase::OIL, fipabc, oil);
+    ref.add("FIPABC", Inplace::Phase::OIL, fipabc, oil);
+
+    // Single values added after a bulk add grow the block.
+    oip.add("FIPNUM", Inplace::Phase::GAS, 600, 17.0);
+    ref.add("FIPNUM", Inplace::Phase::GAS, 600, 17.0);
+    oip.add(Inplace::Phase::OIL, 1.0);
+    ref.add("FIELD", Inplace::Phase::OIL, 0, 1.0);
+
+    checkSame(oip, ref, 1.0e-10);
+
+    // The chunked sums do not depend on the thread count, so repeated
+    // reductions give identical values.
+    Inplace again;
+    again.add("FIPNUM", Inplace::Phase::OIL, fipnum, oil);
+    for (std::size_t id = 1; id <= 500; ++id)
+        BOOST_CHECK_EQUAL(again.get("FIPNUM", Inplace::Phase::OIL, id), oip.get("FIPNUM", Inplace::Phase::OIL, id));
+
+    BOOST_CHECK_THROW(oip.add("FIPNUM", Inplace::Phase::OIL, fipnum, std::vector<double>(10)), std::invalid_argument);
+}
@@ -25,9 +25,12 @@
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <ewoms/eclio/opmlog/opmlog.hh>
 #include <ewoms/eclio/opmlog/logbackend.hh>
+#include <ewoms/eclio/opmlog/asynclog.hh>
 #include <ewoms/eclio/opmlog/counterlog.hh>
 #include <ewoms/eclio/opmlog/timerlog.hh>
 #include <ewoms/eclio/opmlog/streamlog.hh>
@@ -393,3 +396,75 @@ BOOST_AUTO_TEST_CASE(TestFormat)
     BOOST_CHECK_EQUAL(log_stream2.str(), expected2);
     BOOST_CHECK_EQUAL(log_stream3.str(), expected3);
 }
+
+BOOST_AUTO_TEST_CASE(TestAsyncLog)
+{
+    std::ostringstream log_stream;
+    auto streamLog = std::make_shared<StreamLog>(log_stream, Log::DefaultMessageTypes);
+    streamLog->setMessageFormatter(std::make_shared<SimpleMessageFormatter>(true, false));
+    streamLog->setMessageLimiter(std::make_shared<MessageLimiter>(2));
+    {
+        Logger logger;
+        auto asyncLog = std::make_shared<AsyncLog>(streamLog, 8);
+        logger.addBackend("ASYNC", asyncLog);
+        BOOST_CHECK_EQUAL(asyncLog->getMask(), Log::DefaultMessageTypes);
+
+        logger.addMessage(Log::MessageType::Info, "Info");
+        for (int i = 0; i < 4; i++)
+            logger.addTaggedMessage(Log::MessageType::Warning, "TAG", "Warning");
+
+        // Errors are flushed before the call returns.
+        logger.addMessage(Log::MessageType::Error, "Error");
+        const std::string expected = "Info: Info\n"
+            "Warning: Warning\n"
+            "Warning: Warning\n"
+            "Warning: Message limit reached for message tag: TAG\n"
+            "Error: Error\n";
+        BOOST_CHECK_EQUAL(log_stream.str(), expected);
+
+        logger.addMessage(Log::MessageType::Note, "Note");
+    }
+    // The destructor processes all pending messages.
+    BOOST_CHECK(log_stream.str().find("Note: Note\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(TestAsyncLogThreads)
+{
+    const int numThreads = 8;
+    const int numMessages = 1000;
+
+    {
+        auto counter = std::make_shared<CounterLog>();
+        AsyncLog asyncLog(counter, 16, AsyncLog::OverflowPolicy::Block);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+            threads.emplace_back([&asyncLog]() {
+                                     for (int i = 0; i < numMessages; i++)
+                                         asyncLog.addMessage(Log::MessageType::Info, "Info");
+                                 });
+        for (auto& thread : threads)
+            thread.join();
+
+        asyncLog.flush();
+        BOOST_CHECK_EQUAL(counter->numMessages(Log::MessageType::Info), std::size_t(numThreads * numMessages));
+        BOOST_CHECK_EQUAL(asyncLog.numDropped(), 0U);
+    }
+
+    {
+        auto counter = std::make_shared<CounterLog>(Log::MessageType::Info + Log::MessageType::Error);
+        AsyncLog asyncLog(counter, 16, AsyncLog::OverflowPolicy::Drop);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+            threads.emplace_back([&asyncLog]() {
+                                     for (int i = 0; i < numMessages; i++)
+                                         asyncLog.addMessage(Log::MessageType::Info, "Info");
+                                     asyncLog.addMessage(Log::MessageType::Error, "Error");
+                                 });
+        for (auto& thread : threads)
+            thread.join();
+
+        asyncLog.flush();
+        BOOST_CHECK_EQUAL(counter->numMessages(Log::MessageType::Info) + asyncLog.numDropped(), std::size_t(numThreads * numMessages));
+        BOOST_CHECK_EQUAL(counter->numMessages(Log::MessageType::Error), std::size_t(numThreads));
+    }
+}
@@ -21,11 +21,15 @@
 #define BOOST_TEST_MODULE RegionCache
 #include <boost/test/unit_test.hpp>
 
+#include <chrono>
+#include <map>
+#include <sstream>
 #include <stdexcept>
 #include <unordered_set>
 
 #include <ewoms/eclio/parser/deck/deck.hh>
 #include <ewoms/eclio/parser/eclipsestate/eclipsestate.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/events.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
 #include <ewoms/eclio/output/regioncache.hh>
 #include <ewoms/eclio/parser/parsecontext.hh>
@@ -43,6 +47,101 @@ bool cmp_list(const std::vector<std::string>& l1, const std::vector<std::string>
     return s1 == s2;
 }
 
+namespace {
+
+    using ConnectionList = std::vector<std::pair<std::string, std::size_t>>;
+    using RegionKey = std::pair<std::string, int>;
+
+    // The map based cache RegionCache used to be.
+    struct ReferenceCache {
+        std::map<RegionKey, ConnectionList> connection_map;
+        std::map<RegionKey, std::vector<std::string>> well_map;
+
+        ReferenceCache(const std::set<std::string>& fip_regions, const FieldPropsManager& fp,
+                       const EclipseGrid& grid, const std::vector<Well>& wells)
+        {
+            for (const auto& fip_name : fip_regions) {
+                const auto& fip_region = fp.get_int(fip_name);
+
+                for (const auto& well : wells) {
+                    const auto& connections = well.getConnections();
+                    if (connections.empty())
+                        continue;
+
+                    for (const auto& c : connections) {
+                        if (grid.cellActive(c.getI(), c.getJ(), c.getK())) {
+                            const auto active_index = grid.activeIndex(c.getI(), c.getJ(), c.getK());
+                            this->connection_map[{ fip_name, fip_region[active_index] }]
+                                .push_back({ well.name(), active_index });
+                        }
+                    }
+
+                    const auto region_id = fip_region[grid.activeIndex(connections[0].global_index())];
+                    this->well_map[{ fip_name, region_id }].push_back(well.name());
+                }
+            }
+        }
+    };
+
+    bool sameConnections(const out::RegionCache::ConnectionRange& range, const ConnectionList& expected)
+    {
+        return (range.size() == expected.size())
+            && std::equal(range.begin(), range.end(), expected.begin());
+    }
+
+    void checkEqual(const out::RegionCache& rc, const ReferenceCache& ref, int max_region)
+    {
+        for (const auto& entry : ref.connection_map)
+            BOOST_CHECK(sameConnections(rc.connections(entry.first.first, entry.first.second), entry.second));
+
+        for (const auto& entry : ref.well_map)
+            BOOST_CHECK(rc.wells(entry.first.first, entry.first.second) == entry.second);
+
+        for (int region = -1; region <= max_region + 1; ++region) {
+            const auto key = std::make_pair(std::string{"FIPNUM"}, region);
+            if (ref.connection_map.count(key) == 0)
+                BOOST_CHECK(rc.connections("FIPNUM", region).empty());
+
+            if (ref.well_map.count(key) == 0)
+                BOOST_CHECK(rc.wells("FIPNUM", region).empty());
+        }
+    }
+
+    // 1000 wells with 100 connections each in 500 regions of 200 cells.
+    Deck manyConnections()
+    {
+        const int nx = 20, ny = 50, nz = 100;
+        std::ostringstream input;
+
+        input << "RUNSPEC\nOIL\nWATER\nDIMENS\n" << nx << ' ' << ny << ' ' << nz << " /\n"
+              << "WELLDIMS\n" << nx*ny << ' ' << nz << " 1 " << nx*ny << " /\n"
+              << "REGDIMS\n500 /\nMETRIC\n"
+              << "GRID\nDX\n" << nx*ny*nz << "*100 /\nDY\n" << nx*ny*nz << "*100 /\n"
+              << "DZ\n" << nx*ny*nz << "*1 /\nTOPS\n" << nx*ny << "*2000 /\n"
+              << "PORO\n" << nx*ny*nz << "*0.2 /\nPERMX\n" << nx*ny*nz << "*100 /\n"
+              << "PERMY\n" << nx*ny*nz << "*100 /\nPERMZ\n" << nx*ny*nz << "*10 /\n"
+              << "REGIONS\nFIPNUM\n";
+
+        for (int region = 1; region <= 500; ++region)
+            input << "200*" << region << (region % 10 == 0 ? "\n" : " ");
+
+        input << "/\nSCHEDULE\nWELSPECS\n";
+        for (int j = 1; j <= ny; ++j)
+            for (int i = 1; i <= nx; ++i)
+                input << "'W_" << i << '_' << j << "' 'G1' " << i << ' ' << j << " 1* OIL /\n";
+
+        input << "/\nCOMPDAT\n";
+        for (int j = 1; j <= ny; ++j)
+            for (int i = 1; i <= nx; ++i)
+                input << "'W_" << i << '_' << j << "' " << i << ' ' << j << " 1 " << nz << " OPEN 1* 100 /\n";
+
+        input << "/\nTSTEP\n10 /\n";
+
+        return Parser{}.parseString(input.str());
+    }
+
+}
+
 BOOST_AUTO_TEST_CASE(create) {
     Parser parser;
     Deck deck( parser.parseFile( path ));
@@ -71,3 +170,100 @@ BOOST_AUTO_TEST_CASE(create) {
     BOOST_CHECK( cmp_list(rc.wells("FIPNUM", 1),  {"W_1", "W_2", "W_3", "W_4"}));
     BOOST_CHECK( cmp_list(rc.wells("FIPNUM", 11), {"W_6"}));
 }
+
+BOOST_AUTO_TEST_CASE(same_as_map) {
+    Parser parser;
+    Deck deck( parser.parseFile( path ));
+    EclipseState es(deck);
+    const EclipseGrid& grid = es.getInputGrid();
+    Schedule schedule( deck, es);
+
+    const out::RegionCache rc({"FIPNUM"}, es.fieldProps(), grid, schedule);
+    const ReferenceCache ref({"FIPNUM"}, es.fieldProps(), grid, schedule.getWellsatEnd());
+
+    BOOST_CHECK_EQUAL(rc.regionSetID("FIPNUM"), 0U);
+    BOOST_CHECK(!rc.hasRegionSet("FIPXYZ"));
+    BOOST_CHECK_THROW(rc.regionSetID("FIPXYZ"), std::invalid_argument);
+
+    checkEqual(rc, ref, 20);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_update) {
+    Parser parser;
+    Deck deck( parser.parseFile( path ));
+    EclipseState es(deck);
+    const EclipseGrid& grid = es.getInputGrid();
+    Schedule schedule( deck, es);
+
+    out::RegionCache rc({"FIPNUM"}, es.fieldProps(), grid, schedule, 0);
+
+    std::size_t num_changes = 0;
+    for (std::size_t step = 0; step < schedule.size(); ++step) {
+        const auto changed = rc.update(grid, schedule, step);
+        num_changes += changed;
+
+        // Without connection events the content must stay the same.
+        if (!schedule.getEvents().hasEvent(ScheduleEvents::NEW_WELL | ScheduleEvents::COMPLETION_CHANGE |
+                                           ScheduleEvents::WELL_WELSPECS_UPDATE, step))
+            BOOST_CHECK(!changed);
+
+        const ReferenceCache ref({"FIPNUM"}, es.fieldProps(), grid, schedule.getWells(step));
+        checkEqual(rc, ref, 20);
+    }
+
+    BOOST_CHECK(num_changes > 0);
+
+    // Going back rebuilds the cache for the earlier step.
+    BOOST_CHECK(rc.update(grid, schedule, 0));
+    checkEqual(rc, ReferenceCache({"FIPNUM"}, es.fieldProps(), grid, schedule.getWells(0)), 20);
+}
+
+BOOST_AUTO_TEST_CASE(many_connections) {
+    using Clock = std::chrono::steady_clock;
+    using ms = std::chrono::duration<double, std::milli>;
+
+    const auto deck = manyConnections();
+    EclipseState es(deck);
+    const EclipseGrid& grid = es.getInputGrid();
+    Schedule schedule( deck, es);
+
+    const auto wells = schedule.getWellsatEnd();
+
+    const auto t0 = Clock::now();
+    const ReferenceCache ref({"FIPNUM"}, es.fieldProps(), grid, wells);
+    const auto t1 = Clock::now();
+    const out::RegionCache rc({"FIPNUM"}, es.fieldProps(), grid, schedule);
+    const auto t2 = Clock::now();
+
+    BOOST_CHECK_EQUAL(ref.connection_map.size(), 500U);
+    checkEqual(rc, ref, 500);
+
+    // Region evaluation: all regions, as for a few region keywords.
+    const int repeat = 20;
+    std::size_t ref_sum = 0, sum = 0;
+
+    const auto t3 = Clock::now();
+    for (int n = 0; n < repeat; ++n) {
+        for (int region = 1; region <= 500; ++region) {
+            const auto iter = ref.connection_map.find({ "FIPNUM", region });
+            for (const auto& conn : iter->second)
+                ref_sum += conn.second;
+        }
+    }
+
+    const auto t4 = Clock::now();
+    const auto fipnum = rc.regionSetID("FIPNUM");
+    for (int n = 0; n < repeat; ++n) {
+        for (int region = 1; region <= 500; ++region) {
+            for (const auto& conn : rc.connections(fipnum, region))
+                sum += conn.second;
+        }
+    }
+    const auto t5 = Clock::now();
+
+    BOOST_CHECK_EQUAL(sum, ref_sum);
+
+    BOOST_TEST_MESSAGE("100k connections, 500 regions: build " << ms(t1 - t0).count()
+                       << " ms (map) vs " << ms(t2 - t1).count() << " ms (dense), lookups "
+                       << ms(t4 - t3).count() << " ms (map) vs " << ms(t5 - t4).count() << " ms (dense)");
+}
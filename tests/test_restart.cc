@@ -27,6 +27,8 @@
 #include <ewoms/eclio/output/restartio.hh>
 #include <ewoms/eclio/output/restartvalue.hh>
 #include <ewoms/eclio/output/data/cells.hh>
+#include <ewoms/eclio/output/data/solutionbuffer.hh>
+#include <ewoms/eclio/output/data/wellbuffer.hh>
 #include <ewoms/eclio/output/data/wells.hh>
 #include <ewoms/eclio/output/data/groups.hh>
 
@@ -48,6 +50,8 @@
 #include <ewoms/eclio/io/ecliodata.hh>
 #include <ewoms/eclio/io/erst.hh>
 
+#include <fstream>
+#include <iterator>
 #include <tuple>
 
 #include <ewoms/eclio/utility/timeservice.hh>
@@ -619,6 +623,92 @@ BOOST_AUTO_TEST_CASE(WriteWrongSOlutionSize) {
     }
 }
 
+namespace {
+    data::SolutionBuffer mkSolutionBuffer(const data::Solution& sol, const std::size_t numCells)
+    {
+        auto buffer = data::SolutionBuffer{ numCells };
+
+        for (const auto& field : sol) {
+            const auto slot = buffer.addField(field.first, field.second.dim, field.second.target);
+            std::copy(field.second.data.begin(), field.second.data.end(), buffer.data(slot));
+        }
+
+        return buffer;
+    }
+
+    std::string fileContents(const std::string& fname)
+    {
+        std::ifstream is(fname, std::ios::binary);
+
+        return { std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SaveFromBuffers) {
+    namespace OS = ::Ewoms::EclIO::OutputStream;
+
+    WorkArea test_area("test_Restart");
+    test_area.copyIn("BASE_SIM.DATA");
+    Setup setup("BASE_SIM.DATA");
+
+    const auto num_cells = setup.grid.getNumActive( );
+    const auto cells = mkSolution( num_cells );
+    const auto wells = mkWells();
+    auto sumState = sim_state();
+    Ewoms::Action::State action_state;
+    Ewoms::UDQState udq_state(19);
+
+    RestartValue restart_value(cells, wells, mkGroups());
+    restart_value.addExtra("EXTRA", UnitSystem::measure::pressure, {10,1,2,3});
+    restart_value.addExtra("OPMEXTRA", std::vector<double>(1, 0.5));
+
+    const auto outputDir = test_area.currentWorkingDirectory();
+    const auto seqnum = 1;
+
+    {
+        auto rstFile = OS::Restart {
+            OS::ResultSet { outputDir, "VALUE" }, seqnum,
+            OS::Formatted { false }, OS::Unified { true }
+        };
+
+        RestartIO::save(rstFile, seqnum, 100, restart_value,
+                        setup.es, setup.grid, setup.schedule,
+                        action_state, sumState, udq_state);
+    }
+
+    {
+        auto rstFile = OS::Restart {
+            OS::ResultSet { outputDir, "BUFFER" }, seqnum,
+            OS::Formatted { false }, OS::Unified { true }
+        };
+
+        RestartIO::save(rstFile, seqnum, 100,
+                        mkSolutionBuffer(cells, num_cells),
+                        data::WellBuffer{ wells }, restart_value.extra,
+                        setup.es, setup.grid, setup.schedule,
+                        action_state, sumState, udq_state);
+    }
+
+    const auto value_file  = OS::outputFileName({ outputDir, "VALUE" }, "UNRST");
+    const auto buffer_file = OS::outputFileName({ outputDir, "BUFFER" }, "UNRST");
+
+    BOOST_CHECK(!fileContents(value_file).empty());
+    BOOST_CHECK(fileContents(value_file) == fileContents(buffer_file));
+
+    // Buffers with the wrong number of cells are rejected.
+    auto rstFile = OS::Restart {
+        OS::ResultSet { outputDir, "WRONG" }, seqnum,
+        OS::Formatted { false }, OS::Unified { true }
+    };
+
+    BOOST_CHECK_THROW( RestartIO::save(rstFile, seqnum, 100,
+                                       mkSolutionBuffer(mkSolution(num_cells + 1), num_cells + 1),
+                                       data::WellBuffer{ wells }, {},
+                                       setup.es, setup.grid, setup.schedule,
+                                       action_state, sumState, udq_state),
+                       std::runtime_error );
+}
+
 BOOST_AUTO_TEST_CASE(ExtraData_KEYS) {
     Setup setup("BASE_SIM.DATA");
     auto num_cells = setup.grid.getNumActive( );
@@ -46,6 +46,7 @@
 #include <ewoms/eclio/parser/units/units.hh>
 #include <ewoms/eclio/parser/units/unitsystem.hh>
 
+#include <algorithm>
 #include <cstddef>
 #include <ctime>
 #include <map>
@@ -2433,4 +2434,92 @@ BOOST_AUTO_TEST_CASE(PVT_M_Units)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Output_Plan)
+{
+    using RftDate = ::Ewoms::EclIO::ERft::RftDate;
+
+    const auto model = Setup{ "testrft.DATA" };
+    const auto& grid = model.es.getInputGrid();
+
+    BOOST_CHECK(::Ewoms::RftIO::Plan(0, grid, model.sched).empty());
+
+    const auto reportStep = 2;
+    const auto plan = ::Ewoms::RftIO::Plan { reportStep, grid, model.sched };
+
+    BOOST_CHECK_EQUAL(plan.reportStep(), reportStep);
+    BOOST_REQUIRE_EQUAL(plan.numWells(), std::size_t{2});
+    BOOST_CHECK_EQUAL(plan.well(0), "OP_1");
+    BOOST_CHECK_EQUAL(plan.well(1), "OP_2");
+    BOOST_CHECK_EQUAL(plan.connEnd(0) - plan.connBegin(0), std::size_t{9});
+    BOOST_CHECK_EQUAL(plan.connEnd(1) - plan.connBegin(1), std::size_t{6});
+    BOOST_CHECK_EQUAL(plan.connBegin(1), plan.connEnd(0));
+    BOOST_CHECK_EQUAL(plan.maxConnections(), std::size_t{9});
+
+    for (auto c = plan.connBegin(1); c < plan.connEnd(1); ++c) {
+        const auto k = static_cast<int>(c - plan.connBegin(1)) + 4;
+
+        BOOST_CHECK_EQUAL(plan.conI(c), 4);
+        BOOST_CHECK_EQUAL(plan.conJ(c), 4);
+        BOOST_CHECK_EQUAL(plan.conK(c), k);
+        BOOST_CHECK_EQUAL(plan.cell(c), grid.getGlobalIndex(3, 3, k - 1));
+        BOOST_CHECK_CLOSE(plan.depth(c), grid.getCellDepth(plan.cell(c)), 1.0e-10);
+    }
+
+    // OP_2 reports RFT data until WRFTPLT turns it off at step 4.
+    {
+        const auto plan3 = ::Ewoms::RftIO::Plan { 3, grid, model.sched };
+        BOOST_REQUIRE_EQUAL(plan3.numWells(), std::size_t{1});
+        BOOST_CHECK_EQUAL(plan3.well(0), "OP_2");
+    }
+
+    // Connection results need not be in the order of the schedule.
+    auto xw = wellSol(grid);
+    {
+        auto& xcon = xw["OP_1"].connections;
+        std::reverse(xcon.begin(), xcon.end());
+    }
+
+    const auto rset = RSet { "TESTRFT" };
+    {
+        auto rftFile = ::Ewoms::EclIO::OutputStream::RFT {
+            rset, ::Ewoms::EclIO::OutputStream::Formatted  { false },
+            ::Ewoms::EclIO::OutputStream::RFT::OpenExisting{ false }
+        };
+
+        ::Ewoms::RftIO::write(plan, model.sched.seconds(reportStep),
+                              model.es.getUnits(), xw, rftFile);
+    }
+
+    const auto rft = ::Ewoms::EclIO::ERft {
+        ::Ewoms::EclIO::OutputStream::outputFileName(rset, "RFT")
+    };
+
+    {
+        const auto xRFT = RFTRresults {
+            rft, "OP_1", RftDate{ 2008, 10, 10 }
+        };
+
+        BOOST_CHECK_CLOSE(xRFT.pressure(9, 9, 1), 120.0f, 1.0e-10f);
+        BOOST_CHECK_CLOSE(xRFT.pressure(9, 9, 9), 200.0f, 1.0e-10f);
+        BOOST_CHECK_CLOSE(xRFT.swat(9, 9, 1), 0.3f, 1.0e-10f);
+        BOOST_CHECK_CLOSE(xRFT.swat(9, 9, 9), 0.7f, 1.0e-10f);
+        BOOST_CHECK_CLOSE(xRFT.depth(9, 9, 5), 5*0.25f + 0.25f/2.0f, 1.0e-10f);
+
+        const auto& K = rft.getRft<int>("CONKPOS", "OP_1", RftDate{ 2008, 10, 10 });
+        BOOST_CHECK_EQUAL(K.size(), std::size_t{9});
+        BOOST_CHECK_EQUAL(K.front(), 1);
+        BOOST_CHECK_EQUAL(K.back(), 9);
+    }
+
+    {
+        const auto xRFT = RFTRresults {
+            rft, "OP_2", RftDate{ 2008, 10, 10 }
+        };
+
+        BOOST_CHECK_CLOSE(xRFT.pressure(4, 4, 4), 150.0f, 1.0e-10f);
+        BOOST_CHECK_CLOSE(xRFT.pressure(4, 4, 9), 200.0f, 1.0e-10f);
+        BOOST_CHECK_CLOSE(xRFT.sgas(4, 4, 9), 0.6f - 8/20.0f, 1.0e-5f);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Using_Direct_Write
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include <ewoms/eclio/output/data/solution.hh>
+#include <ewoms/eclio/output/data/solutionbuffer.hh>
 #include <ewoms/eclio/parser/units/unitsystem.hh>
 
 using namespace Ewoms;
@@ -89,3 +90,41 @@ BOOST_AUTO_TEST_CASE(UNITS) {
     BOOST_CHECK_EQUAL( si0 , c.data("NAME")[0] );
 }
 
+
+BOOST_AUTO_TEST_CASE(Buffer) {
+    data::SolutionBuffer buffer(4);
+    const auto pressure = buffer.addField("PRESSURE", UnitSystem::measure::pressure, data::TargetType::RESTART_SOLUTION);
+    const auto swat = buffer.addField("SWAT", UnitSystem::measure::identity, data::TargetType::RESTART_SOLUTION);
+
+    BOOST_CHECK_EQUAL( buffer.numFields() , 2U );
+    BOOST_CHECK_EQUAL( buffer.slot("SWAT") , swat );
+    BOOST_CHECK( !buffer.has("SGAS") );
+    BOOST_CHECK_THROW( buffer.slot("SGAS") , std::invalid_argument );
+    BOOST_CHECK_THROW( buffer.addField("SWAT", UnitSystem::measure::identity, data::TargetType::RESTART_SOLUTION) , std::invalid_argument );
+
+    for (std::size_t c = 0; c < buffer.numCells(); ++c) {
+        buffer.data(pressure)[c] = 100.0 + c;
+        buffer.data(swat)[c] = 0.25;
+    }
+
+    data::Solution sol;
+    sol.insert("RS", UnitSystem::measure::gas_oil_ratio, std::vector<double>(4, 1.0), data::TargetType::RESTART_SOLUTION);
+    buffer.exportTo(sol);
+
+    // Fields not in the buffer are removed.
+    BOOST_CHECK_EQUAL( sol.size() , 2U );
+    BOOST_CHECK( !sol.has("RS") );
+    BOOST_CHECK( sol.at("PRESSURE").dim == UnitSystem::measure::pressure );
+    BOOST_CHECK_EQUAL( sol.data("PRESSURE")[3] , 103.0 );
+    BOOST_CHECK_EQUAL( sol.data("SWAT")[0] , 0.25 );
+    BOOST_CHECK( buffer.name(swat) == "SWAT" );
+    BOOST_CHECK( buffer.dim(pressure) == UnitSystem::measure::pressure );
+
+    // Exporting again overwrites the existing vectors in place.
+    const auto* storage = sol.data("PRESSURE").data();
+    buffer.data(pressure)[3] = 200.0;
+    buffer.exportTo(sol);
+
+    BOOST_CHECK_EQUAL( sol.data("PRESSURE").data() , storage );
+    BOOST_CHECK_EQUAL( sol.data("PRESSURE")[3] , 200.0 );
+}
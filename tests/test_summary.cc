@@ -32,6 +32,7 @@
 
 #include <ewoms/eclio/output/data/groups.hh>
 #include <ewoms/eclio/output/data/guideratevalue.hh>
+#include <ewoms/eclio/output/data/wellbuffer.hh>
 #include <ewoms/eclio/output/data/wells.hh>
 #include <ewoms/eclio/output/summary.hh>
 
@@ -715,6 +716,26 @@ BOOST_AUTO_TEST_CASE(well_keywords) {
     BOOST_CHECK_CLOSE( 2.2, ecl_sum_get_well_var( resp, 1, "W_3", "WTHPH" ), 1e-5 );
 }
 
+BOOST_AUTO_TEST_CASE(eval_from_buffer) {
+    setup cfg( "test_summary_buffer" );
+
+    out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule , cfg.name );
+    const auto start = std::chrono::system_clock::now();
+    SummaryState st_wells(start);
+    SummaryState st_buffer(start);
+
+    const auto buffer = data::WellBuffer{ cfg.wells };
+    for (int report_step = 0; report_step < 3; ++report_step) {
+        writer.eval( st_wells, report_step, report_step * day, cfg.wells , cfg.grp_nwrk, {}, {}, {}, {});
+        writer.eval( st_buffer, report_step, report_step * day, buffer , cfg.grp_nwrk, {}, {}, {}, {});
+    }
+
+    BOOST_CHECK( st_buffer.has_well_var("W_1", "WOPR") );
+    BOOST_CHECK( st_buffer.has("COPR:W_1:1") );
+    BOOST_CHECK_CLOSE( st_buffer.get_well_var("W_1", "WBHP"), st_wells.get_well_var("W_1", "WBHP"), 1e-10 );
+    BOOST_CHECK( st_buffer == st_wells );
+}
+
 BOOST_AUTO_TEST_CASE(udq_keywords) {
     setup cfg( "test_summary_udq" );
 
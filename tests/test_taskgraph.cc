@@ -0,0 +1,88 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE TaskGraphTests
+
+#include <boost/test/unit_test.hpp>
+
+#include <ewoms/eclio/utility/taskgraph.hh>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Ewoms;
+
+BOOST_AUTO_TEST_CASE(InvalidDependency) {
+    TaskGraph tasks;
+    BOOST_CHECK_THROW( tasks.addTask([]() {}, {0}), std::invalid_argument );
+
+    auto first = tasks.addTask([]() {});
+    BOOST_CHECK_NO_THROW( tasks.addTask([]() {}, {first}) );
+    BOOST_CHECK_THROW( tasks.addTask([]() {}, {5}), std::invalid_argument );
+    BOOST_CHECK_EQUAL( tasks.size(), 2U );
+}
+
+BOOST_AUTO_TEST_CASE(DependenciesRespected) {
+    for (std::size_t num_threads : {1, 2, 8}) {
+        const std::size_t layers = 10;
+        const std::size_t width = 16;
+        std::atomic<std::size_t> counter(0);
+        std::vector<std::size_t> completed(layers * width, 0);
+        std::vector<std::vector<TaskGraph::TaskId>> dependencies;
+        TaskGraph tasks;
+
+        for (std::size_t layer = 0; layer < layers; layer++) {
+            for (std::size_t i = 0; i < width; i++) {
+                std::vector<TaskGraph::TaskId> deps;
+                if (layer > 0) {
+                    deps.push_back((layer - 1) * width + i);
+                    deps.push_back((layer - 1) * width + (i + 1) % width);
+                }
+
+                auto id = tasks.addTask([&counter, &completed, layer, i]() {
+                    completed[layer * width + i] = ++counter;
+                }, deps);
+                BOOST_CHECK_EQUAL( id, layer * width + i );
+                dependencies.push_back(deps);
+            }
+        }
+
+        tasks.run(num_threads);
+        BOOST_CHECK_EQUAL( counter.load(), layers * width );
+        for (std::size_t id = 0; id < completed.size(); id++) {
+            for (const auto& dep : dependencies[id])
+                BOOST_CHECK( completed[dep] < completed[id] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ExceptionPropagated) {
+    for (std::size_t num_threads : {1, 4}) {
+        std::atomic<int> count(0);
+        TaskGraph tasks;
+        auto failing = tasks.addTask([]() { throw std::logic_error("Task failed"); });
+        tasks.addTask([&count]() { count += 1; }, {failing});
+        tasks.addTask([&count]() { count += 1; }, {failing});
+
+        BOOST_CHECK_THROW( tasks.run(num_threads), std::logic_error );
+        BOOST_CHECK_EQUAL( count.load(), 0 );
+    }
+}
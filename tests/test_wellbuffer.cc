@@ -0,0 +1,364 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE WellBuffer
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+
+#include <ewoms/eclio/output/data/wellbuffer.hh>
+#include <ewoms/eclio/output/data/wellresults.hh>
+
+using namespace Ewoms;
+using rt = data::Rates::opt;
+
+namespace {
+
+    data::WellBuffer makeBuffer()
+    {
+        return data::WellBuffer {{
+            { "OP_1", { 88, 288 }, {} },
+            { "INJ",  {},          {} },
+            { "OP_2", { 188 },     { 1, 2, 5 } },
+        }};
+    }
+
+    // Same values as fillBuffer(), through the map based containers.
+    data::Wells expectedWells(const double scale)
+    {
+        data::Wells wells;
+
+        {
+            auto& w = wells["OP_1"];
+            w.rates.set(rt::wat, 1.0 * scale).set(rt::oil, 2.0 * scale);
+            w.bhp = 100.0 * scale;
+            w.thp = 50.0 * scale;
+            w.temperature = 20.0;
+            w.control = 1;
+            w.current_control.prod = Well::ProducerCMode::ORAT;
+
+            data::Rates r1, r2;
+            r1.set(rt::oil, 0.5 * scale);
+            r2.set(rt::oil, 1.5 * scale).set(rt::gas, 3.0);
+
+            w.connections.push_back({ 88, r1, 90.0, 0.1, 95.0, 0.2, 0.3, 17.29, 0.1729 });
+            w.connections.push_back({ 288, r2, 91.0, 0.2, 96.0, 0.25, 0.35, 1.0, 0.5 });
+        }
+
+        {
+            auto& w = wells["INJ"];
+            w.rates.set(rt::wat, -10.0 * scale);
+            w.bhp = 300.0;
+            w.thp = 0.0;
+            w.temperature = 0.0;
+            w.control = 0;
+            w.current_control.isProducer = false;
+            w.current_control.inj = Well::InjectorCMode::RATE;
+        }
+
+        {
+            auto& w = wells["OP_2"];
+            w.rates.set(rt::gas, 7.0 * scale);
+            w.bhp = 120.0;
+            w.thp = 0.0;
+            w.temperature = 0.0;
+            w.control = 0;
+            w.guide_rates.set(data::GuideRateValue::Item::Gas, 4.0);
+
+            data::Rates r;
+            r.set(rt::gas, 7.0 * scale);
+            w.connections.push_back({ 188, r, 80.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+
+            for (const std::size_t segNumber : { 1, 2, 5 }) {
+                auto& seg = w.segments[segNumber];
+                seg.segNumber = segNumber;
+                seg.rates.set(rt::gas, segNumber * scale);
+                seg.pressures = data::SegmentPressures{};
+                seg.pressures[data::SegmentPressures::Value::Pressure] = 70.0 + segNumber;
+            }
+        }
+
+        return wells;
+    }
+
+    void fillBuffer(data::WellBuffer& buffer, const double scale)
+    {
+        buffer.reset();
+
+        {
+            const auto w = buffer.wellIndex("OP_1");
+            buffer.setRate(w, rt::wat, 1.0 * scale);
+            buffer.setRate(w, rt::oil, 2.0 * scale);
+            buffer.bhp(w) = 100.0 * scale;
+            buffer.thp(w) = 50.0 * scale;
+            buffer.temperature(w) = 20.0;
+            buffer.control(w) = 1;
+            buffer.currentControl(w).prod = Well::ProducerCMode::ORAT;
+
+            buffer.setConnectionRate(w, 0, rt::oil, 0.5 * scale);
+            buffer.connectionPressure(w, 0) = 90.0;
+            buffer.connectionReservoirRate(w, 0) = 0.1;
+            buffer.connectionCellPressure(w, 0) = 95.0;
+            buffer.connectionCellSaturationWater(w, 0) = 0.2;
+            buffer.connectionCellSaturationGas(w, 0) = 0.3;
+            buffer.connectionEffectiveKh(w, 0) = 17.29;
+            buffer.connectionTransFactor(w, 0) = 0.1729;
+
+            buffer.setConnectionRate(w, 1, rt::oil, 1.5 * scale);
+            buffer.setConnectionRate(w, 1, rt::gas, 3.0);
+            buffer.connectionPressure(w, 1) = 91.0;
+            buffer.connectionReservoirRate(w, 1) = 0.2;
+            buffer.connectionCellPressure(w, 1) = 96.0;
+            buffer.connectionCellSaturationWater(w, 1) = 0.25;
+            buffer.connectionCellSaturationGas(w, 1) = 0.35;
+            buffer.connectionEffectiveKh(w, 1) = 1.0;
+            buffer.connectionTransFactor(w, 1) = 0.5;
+        }
+
+        {
+            const auto w = buffer.wellIndex("INJ");
+            buffer.setRate(w, rt::wat, -10.0 * scale);
+            buffer.bhp(w) = 300.0;
+            buffer.currentControl(w).isProducer = false;
+            buffer.currentControl(w).inj = Well::InjectorCMode::RATE;
+        }
+
+        {
+            const auto w = buffer.wellIndex("OP_2");
+            buffer.setRate(w, rt::gas, 7.0 * scale);
+            buffer.bhp(w) = 120.0;
+            buffer.guideRates(w).set(data::GuideRateValue::Item::Gas, 4.0);
+
+            buffer.setConnectionRate(w, 0, rt::gas, 7.0 * scale);
+            buffer.connectionPressure(w, 0) = 80.0;
+
+            const std::size_t segNumbers[] = { 1, 2, 5 };
+            for (std::size_t s = 0; s < 3; ++s) {
+                buffer.setSegmentRate(w, s, rt::gas, segNumbers[s] * scale);
+                buffer.segmentPressures(w, s)[data::SegmentPressures::Value::Pressure] = 70.0 + segNumbers[s];
+            }
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(Layout)
+{
+    const auto buffer = makeBuffer();
+
+    BOOST_CHECK_EQUAL(buffer.numWells(), 3U);
+    BOOST_CHECK_EQUAL(buffer.wellIndex("OP_2"), 2U);
+    BOOST_CHECK_EQUAL(buffer.wellName(1), "INJ");
+    BOOST_CHECK_EQUAL(buffer.numConnections(0), 2U);
+    BOOST_CHECK_EQUAL(buffer.numConnections(1), 0U);
+    BOOST_CHECK_EQUAL(buffer.numSegments(2), 3U);
+
+    BOOST_CHECK_THROW(buffer.wellIndex("NO_SUCH_WELL"), std::invalid_argument);
+    BOOST_CHECK_THROW(data::WellBuffer({ { "W", {}, {} }, { "W", {}, {} } }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Rates)
+{
+    auto buffer = makeBuffer();
+
+    buffer.setRate(0, rt::oil, 2.5);
+    buffer.setRate(0, rt::alq, 0.5);
+
+    BOOST_CHECK(buffer.hasRate(0, rt::oil));
+    BOOST_CHECK(!buffer.hasRate(0, rt::gas));
+    BOOST_CHECK(!buffer.hasRate(1, rt::oil));
+    BOOST_CHECK_EQUAL(buffer.rate(0, rt::oil), 2.5);
+    BOOST_CHECK_EQUAL(buffer.rate(0, rt::alq), 0.5);
+    BOOST_CHECK_EQUAL(buffer.rate(0, rt::gas, -1.0), -1.0);
+
+    buffer.setConnectionRate(2, 0, rt::wat, 3.0);
+    BOOST_CHECK(buffer.hasConnectionRate(2, 0, rt::wat));
+    BOOST_CHECK(!buffer.hasConnectionRate(0, 0, rt::wat));
+    BOOST_CHECK_EQUAL(buffer.connectionRate(2, 0, rt::wat), 3.0);
+
+    BOOST_CHECK_THROW(buffer.setRate(0, static_cast<rt>(3), 1.0), std::invalid_argument);
+
+    buffer.reset();
+    BOOST_CHECK(!buffer.hasRate(0, rt::oil));
+    BOOST_CHECK(!buffer.hasConnectionRate(2, 0, rt::wat));
+}
+
+BOOST_AUTO_TEST_CASE(Export)
+{
+    auto buffer = makeBuffer();
+    data::Wells wells;
+
+    fillBuffer(buffer, 1.0);
+    buffer.exportTo(wells);
+
+    BOOST_CHECK(wells == expectedWells(1.0));
+    BOOST_CHECK_EQUAL(wells.get("OP_1", 288, rt::gas), 3.0);
+
+    // The next time step reuses the map nodes and connection storage.
+    const auto* op1 = &wells.at("OP_1");
+    const auto* connections = wells.at("OP_1").connections.data();
+
+    fillBuffer(buffer, 2.0);
+    buffer.exportTo(wells);
+
+    BOOST_CHECK(wells == expectedWells(2.0));
+    BOOST_CHECK_EQUAL(&wells.at("OP_1"), op1);
+    BOOST_CHECK_EQUAL(wells.at("OP_1").connections.data(), connections);
+
+    // Wells which are no longer in the buffer are removed.
+    wells["OLD"].connections.resize(4);
+    wells.at("OP_2").segments[17].segNumber = 17;
+
+    buffer.exportTo(wells);
+    BOOST_CHECK(wells == expectedWells(2.0));
+}
+
+BOOST_AUTO_TEST_CASE(Import)
+{
+    const auto expected = expectedWells(1.0);
+    const auto buffer = data::WellBuffer{ expected };
+
+    // Wells in map order, segments by increasing segment number.
+    BOOST_CHECK_EQUAL(buffer.numWells(), 3U);
+    BOOST_CHECK_EQUAL(buffer.wellName(0), "INJ");
+    BOOST_CHECK_EQUAL(buffer.numConnections(buffer.wellIndex("OP_1")), 2U);
+    BOOST_CHECK_EQUAL(buffer.numSegments(buffer.wellIndex("OP_2")), 3U);
+
+    data::Wells wells;
+    buffer.exportTo(wells);
+    BOOST_CHECK(wells == expected);
+
+    const auto empty = data::WellBuffer{};
+    BOOST_CHECK_EQUAL(empty.numWells(), 0U);
+    BOOST_CHECK_EQUAL(empty.findWell("OP_1"), data::WellBuffer::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Lookup)
+{
+    auto buffer = makeBuffer();
+    fillBuffer(buffer, 1.0);
+
+    const auto& results = buffer;
+
+    const auto op1 = results.findWell("OP_1");
+    const auto op2 = results.findWell("OP_2");
+    BOOST_CHECK_EQUAL(op1, 0U);
+    BOOST_CHECK_EQUAL(results.findWell("NO_SUCH_WELL"), data::WellBuffer::npos);
+
+    BOOST_CHECK_EQUAL(results.findConnection(op1, 288), 1U);
+    BOOST_CHECK_EQUAL(results.findConnection(op1, 188), data::WellBuffer::npos);
+    BOOST_CHECK_EQUAL(results.connectionCell(op1, 1), 288U);
+    BOOST_CHECK_EQUAL(results.connectionCellPressure(op1, 1), 96.0);
+    BOOST_CHECK_EQUAL(results.connectionRate(op1, 1, rt::gas), 3.0);
+    BOOST_CHECK_THROW(results.connectionRate(op1, 0, rt::gas), std::invalid_argument);
+    BOOST_CHECK_EQUAL(results.connectionRate(op1, 0, rt::gas, 0.0), 0.0);
+
+    BOOST_CHECK_EQUAL(results.findSegment(op2, 5), 2U);
+    BOOST_CHECK_EQUAL(results.findSegment(op2, 3), data::WellBuffer::npos);
+    BOOST_CHECK_EQUAL(results.segmentNumber(op2, 1), 2U);
+    BOOST_CHECK(results.hasSegmentRate(op2, 2, rt::gas));
+    BOOST_CHECK_EQUAL(results.segmentRate(op2, 2, rt::gas, 0.0), 5.0);
+    BOOST_CHECK_EQUAL(results.segmentPressures(op2, 2)[data::SegmentPressures::Value::Pressure], 75.0);
+
+    BOOST_CHECK_EQUAL(results.bhp(op2), 120.0);
+    BOOST_CHECK(results.currentControl(op1).prod == Well::ProducerCMode::ORAT);
+    BOOST_CHECK_EQUAL(results.guideRates(op2).get(data::GuideRateValue::Item::Gas), 4.0);
+    BOOST_CHECK_THROW(results.rate(op2, rt::oil), std::invalid_argument);
+
+    // Flowing checks the surface rates only, like data::Rates::flowing().
+    BOOST_CHECK(results.flowing(op1));
+    BOOST_CHECK(results.connectionFlowing(op1, 0));
+
+    buffer.reset();
+    buffer.setRate(op1, rt::reservoir_oil, 1.0);
+    BOOST_CHECK(!results.flowing(op1));
+    BOOST_CHECK(!results.connectionFlowing(op1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(Results)
+{
+    const auto wells = expectedWells(1.0);
+    const auto buffer = data::WellBuffer{ wells };
+
+    const auto fromWells = data::WellResults{ wells };
+    const auto fromBuffer = data::WellResults{ buffer };
+
+    BOOST_CHECK_EQUAL(fromWells.numWells(), 3U);
+    BOOST_CHECK_EQUAL(fromWells.findWell("NO_SUCH_WELL"), data::WellResults::npos);
+    BOOST_CHECK_EQUAL(fromBuffer.findWell("NO_SUCH_WELL"), data::WellResults::npos);
+    BOOST_CHECK_EQUAL(fromWells.findWell("AAA"), data::WellResults::npos);
+    BOOST_CHECK_EQUAL(fromWells.findWell("ZZZ"), data::WellResults::npos);
+
+    // Both views give the same answers, only segment handles may differ.
+    for (const auto* name : { "INJ", "OP_1", "OP_2" }) {
+        const auto w1 = fromWells.findWell(name);
+        const auto w2 = fromBuffer.findWell(name);
+        BOOST_REQUIRE(w1 != data::WellResults::npos);
+        BOOST_REQUIRE(w2 != data::WellResults::npos);
+
+        BOOST_CHECK_EQUAL(fromWells.wellName(w1), name);
+        BOOST_CHECK_EQUAL(fromWells.numConnections(w1), fromBuffer.numConnections(w2));
+        BOOST_CHECK_EQUAL(fromWells.numSegments(w1), fromBuffer.numSegments(w2));
+        BOOST_CHECK_EQUAL(fromWells.flowing(w1), fromBuffer.flowing(w2));
+        BOOST_CHECK_EQUAL(fromWells.bhp(w1), fromBuffer.bhp(w2));
+        BOOST_CHECK_EQUAL(fromWells.thp(w1), fromBuffer.thp(w2));
+        BOOST_CHECK_EQUAL(fromWells.control(w1), fromBuffer.control(w2));
+        BOOST_CHECK(fromWells.currentControl(w1) == fromBuffer.currentControl(w2));
+
+        for (const auto m : { rt::wat, rt::oil, rt::gas }) {
+            BOOST_CHECK_EQUAL(fromWells.hasRate(w1, m), fromBuffer.hasRate(w2, m));
+            BOOST_CHECK_EQUAL(fromWells.rate(w1, m, -1.0), fromBuffer.rate(w2, m, -1.0));
+        }
+
+        for (std::size_t c = 0; c < fromWells.numConnections(w1); ++c) {
+            const auto cell = fromWells.connectionCell(w1, c);
+            BOOST_CHECK_EQUAL(fromWells.findConnection(w1, cell), c);
+            BOOST_CHECK_EQUAL(fromBuffer.findConnection(w2, cell), c);
+            BOOST_CHECK_EQUAL(fromWells.connectionRate(w1, c, rt::oil, 0.0),
+                              fromBuffer.connectionRate(w2, c, rt::oil, 0.0));
+            BOOST_CHECK_EQUAL(fromWells.connectionCellPressure(w1, c),
+                              fromBuffer.connectionCellPressure(w2, c));
+            BOOST_CHECK_EQUAL(fromWells.connectionTransFactor(w1, c),
+                              fromBuffer.connectionTransFactor(w2, c));
+        }
+        BOOST_CHECK_EQUAL(fromWells.findConnection(w1, 1), data::WellResults::npos);
+
+        for (const std::size_t segNumber : { 1, 2, 3, 5 }) {
+            const auto s1 = fromWells.findSegment(w1, segNumber);
+            const auto s2 = fromBuffer.findSegment(w2, segNumber);
+            BOOST_REQUIRE_EQUAL(s1 == data::WellResults::npos, s2 == data::WellResults::npos);
+            if (s1 == data::WellResults::npos)
+                continue;
+
+            BOOST_CHECK_EQUAL(fromWells.segmentRate(w1, s1, rt::gas, 0.0),
+                              fromBuffer.segmentRate(w2, s2, rt::gas, 0.0));
+            BOOST_CHECK_EQUAL(fromWells.segmentPressures(w1, s1)[data::SegmentPressures::Value::Pressure],
+                              fromBuffer.segmentPressures(w2, s2)[data::SegmentPressures::Value::Pressure]);
+        }
+    }
+
+    const auto op1 = fromWells.findWell("OP_1");
+    BOOST_CHECK_THROW(fromWells.rate(op1, rt::gas), std::invalid_argument);
+    BOOST_CHECK_EQUAL(fromWells.connectionRate(op1, 1, rt::gas), 3.0);
+
+    const auto empty = data::WellResults{};
+    BOOST_CHECK_EQUAL(empty.numWells(), 0U);
+    BOOST_CHECK_EQUAL(empty.findWell("OP_1"), data::WellResults::npos);
+}
@@ -20,6 +20,9 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
+#include <sstream>
+#include <string>
 
 #define BOOST_TEST_MODULE EclipseGridTests
 #include <boost/test/unit_test.hpp>
@@ -29,6 +32,9 @@
 #include <ewoms/eclio/parser/parser.hh>
 #include <ewoms/eclio/parser/eclipsestate/tables/tablemanager.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/fieldpropsmanager.hh>
+#include <ewoms/eclio/parser/deck/decksection.hh>
+#include <ewoms/eclio/parser/eclipsestate/grid/faultcollection.hh>
+#include <ewoms/eclio/parser/eclipsestate/grid/faultface.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/transmult.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/transmult.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/griddims.hh>
@@ -75,3 +81,91 @@ MULTZ
     transMult.applyMULT(fp.get_global_double("MULTZ"), Ewoms::FaceDir::ZPlus);
     BOOST_CHECK_EQUAL( transMult.getMultiplier(0,0,0 , Ewoms::FaceDir::ZPlus) , 4.0 );
 }
+
+BOOST_AUTO_TEST_CASE(ManyFaults) {
+    const std::size_t nx = 40, ny = 40, nz = 6;
+    const std::size_t numFaults = 3000;
+
+    // Deterministic pseudo random faces, faults overlap and have one to
+    // three faces each.
+    unsigned long state = 12345;
+    auto next = [&state](const std::size_t n) {
+        state = (state * 1103515245 + 12345) % 2147483648UL;
+        return static_cast<std::size_t>(state / 65536) % n;
+    };
+
+    std::ostringstream input;
+    input << "RUNSPEC\nDIMENS\n " << nx << ' ' << ny << ' ' << nz << " /\nGRID\nFAULTS\n";
+    const char* dirs[] = { "X", "X-", "Y", "Y-", "Z", "Z-" };
+    for (std::size_t f = 0; f < numFaults; ++f) {
+        for (std::size_t face = 0, nface = 1 + next(3); face < nface; ++face) {
+            const auto dir = next(6);
+            auto i1 = next(nx), j1 = next(ny), k1 = next(nz);
+            auto i2 = std::min(nx - 1, i1 + next(4));
+            auto j2 = std::min(ny - 1, j1 + next(4));
+            auto k2 = std::min(nz - 1, k1 + next(3));
+            if (dir < 2) i2 = i1;
+            else if (dir < 4) j2 = j1;
+            else k2 = k1;
+
+            input << " 'F" << f << "' " << i1 + 1 << ' ' << i2 + 1 << ' ' << j1 + 1 << ' ' << j2 + 1
+                  << ' ' << k1 + 1 << ' ' << k2 + 1 << " '" << dirs[dir] << "' /\n";
+        }
+    }
+    input << "/\n";
+
+    Ewoms::Parser parser;
+    Ewoms::Deck deck = parser.parseString(input.str());
+    Ewoms::TableManager tables(deck);
+    Ewoms::EclipseGrid grid(nx, ny, nz);
+    Ewoms::FieldPropsManager fp(deck, Ewoms::Phases{true, true, true}, grid, tables);
+
+    Ewoms::FaultCollection faults(Ewoms::GRIDSection(deck), grid);
+    BOOST_REQUIRE_EQUAL(faults.size(), numFaults);
+    for (std::size_t f = 0; f < numFaults; ++f)
+        faults.getFault(f).setTransMult(0.5 + 0.001*f);
+
+    const Ewoms::TransMult::FaultFaceIndex faces(faults);
+    BOOST_CHECK_EQUAL(faces.numFaults, numFaults);
+
+    std::size_t numEntries = 0;
+    for (std::size_t f = 0; f < numFaults; ++f) {
+        for (const auto& face : faults.getFault(f))
+            numEntries += std::distance(face.begin(), face.end());
+    }
+
+    std::size_t indexEntries = 0;
+    for (std::size_t d = 0; d < Ewoms::TransMult::numDirections; ++d) {
+        BOOST_CHECK(std::is_sorted(faces.cells[d].begin(), faces.cells[d].end()));
+        BOOST_CHECK_EQUAL(faces.cells[d].size(), faces.faults[d].size());
+        indexEntries += faces.cells[d].size();
+    }
+    BOOST_CHECK_EQUAL(indexEntries, numEntries);
+
+    // Reference: one fault at a time.
+    Ewoms::TransMult expected(grid, deck, fp);
+    for (std::size_t f = 0; f < numFaults; ++f)
+        expected.applyMULTFLT(faults.getFault(f));
+
+    Ewoms::TransMult transMult(grid, deck, fp);
+    transMult.applyMULTFLT(faults);
+    BOOST_CHECK(transMult == expected);
+
+    Ewoms::TransMult compiled(grid, deck, fp);
+    compiled.applyMULTFLT(faces, faults);
+    BOOST_CHECK(compiled == expected);
+
+    const auto& face = *faults.getFault(numFaults - 1).begin();
+    BOOST_CHECK(compiled.getMultiplier(*face.begin(), face.getDir()) <= 0.5 + 0.001*(numFaults - 1));
+
+    Ewoms::FaultCollection other;
+    BOOST_CHECK_THROW(compiled.applyMULTFLT(faces, other), std::invalid_argument);
+
+    // Directional multipliers combine with the fault multipliers.
+    std::vector<double> multx(nx*ny*nz, 2.0);
+    compiled.applyMULT(multx, Ewoms::FaceDir::XPlus);
+    expected.applyMULT(multx, Ewoms::FaceDir::XPlus);
+    BOOST_CHECK(compiled == expected);
+    BOOST_CHECK_THROW(compiled.applyMULT(std::vector<double>(nx*ny*nz + 1, 1.0), Ewoms::FaceDir::XPlus),
+                      std::invalid_argument);
+}
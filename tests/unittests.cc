@@ -21,13 +21,18 @@
 #define BOOST_TEST_MODULE UnitTests
 
 #include <ewoms/eclio/parser/units/unitsystem.hh>
+#include <ewoms/eclio/parser/units/conversionkernels.hh>
 #include <ewoms/eclio/parser/units/dimension.hh>
 #include <ewoms/eclio/parser/units/units.hh>
 
 #include <boost/test/unit_test.hpp>
 
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <ostream>
+#include <thread>
+#include <vector>
 
 using namespace Ewoms;
 
@@ -603,6 +608,67 @@ BOOST_AUTO_TEST_CASE(TemperatureConversions)
     BOOST_CHECK_CLOSE(field.from_si(Meas::temperature , (459.67 + 1.0)*5.0/9.0), 1.0, 1.0e-10);
 }
 
+BOOST_AUTO_TEST_CASE(BulkConversions)
+{
+    using Meas = UnitSystem::measure;
+
+    std::vector<double> values;
+    for (int i = -50; i < 50; ++i)
+        values.push_back(i * 12.345);
+    values.push_back(-0.0);
+
+    for (const auto& usys : { UnitSystem::newMETRIC(), UnitSystem::newFIELD(), UnitSystem::newLAB(),
+                              UnitSystem::newPVT_M(), UnitSystem::newINPUT() }) {
+        for (int m = 0; m < static_cast<int>(Meas::_count); ++m) {
+            const auto meas = static_cast<Meas>(m);
+            const auto& conv = usys.conversion(meas);
+
+            BOOST_CHECK_EQUAL(conv.to_si_factor, usys.getDimension(meas).getSIScaling());
+            BOOST_CHECK_EQUAL(conv.offset, usys.getDimension(meas).getSIOffset());
+
+            auto si = values;
+            usys.to_si(meas, si);
+
+            auto output = values;
+            usys.from_si(meas, output);
+
+            std::vector<double> out_of_place(values.size());
+            conv.to_si(values.data(), out_of_place.data(), values.size());
+
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                BOOST_CHECK_EQUAL(si[i], usys.to_si(meas, values[i]));
+                BOOST_CHECK_EQUAL(output[i], usys.from_si(meas, values[i]));
+                BOOST_CHECK_EQUAL(out_of_place[i], si[i]);
+            }
+        }
+    }
+
+    // Large arrays are converted in parallel.
+    const auto field = UnitSystem::newFIELD();
+    std::vector<double> large(ConversionKernels::parallelConversionThreshold + 17);
+    for (std::size_t i = 0; i < large.size(); ++i)
+        large[i] = static_cast<double>(i % 1000) - 100.0;
+
+    auto converted = large;
+    field.from_si(Meas::temperature, converted);
+
+    std::size_t mismatch = 0;
+    for (std::size_t i = 0; i < large.size(); ++i)
+        mismatch += converted[i] != field.from_si(Meas::temperature, large[i]);
+
+    BOOST_CHECK_EQUAL(mismatch, 0U);
+
+    const Dimension dim(2.5, 10.0);
+    std::vector<double> raw = { 1.0, -2.0, 0.5 };
+    dim.convertRawToSi(raw.data(), raw.data(), raw.size());
+    BOOST_CHECK_EQUAL(raw[0], dim.convertRawToSi(1.0));
+    BOOST_CHECK_EQUAL(raw[1], dim.convertRawToSi(-2.0));
+    BOOST_CHECK_EQUAL(raw[2], dim.convertRawToSi(0.5));
+
+    const Dimension contextDependent(std::numeric_limits<double>::quiet_NaN());
+    BOOST_CHECK_THROW(contextDependent.convertRawToSi(raw.data(), raw.data(), raw.size()), std::logic_error);
+}
+
 BOOST_AUTO_TEST_CASE(EclipseID) {
     BOOST_CHECK_THROW(UnitSystem(0), std::invalid_argument);
     BOOST_CHECK_THROW(UnitSystem(5), std::invalid_argument);
@@ -626,3 +692,25 @@ BOOST_AUTO_TEST_CASE(DECK_NAMES) {
     UnitSystem us("METRIC");
     BOOST_CHECK_EQUAL( us.deck_name(), "METRIC");
 }
+
+BOOST_AUTO_TEST_CASE(ConcurrentUseCount) {
+    const UnitSystem metric(UnitSystem::UnitType::UNIT_TYPE_METRIC);
+
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < 4; ++i) {
+        readers.emplace_back([&metric]()
+        {
+            for (std::size_t n = 0; n < 1000; ++n)
+                metric.getDimension("Length");
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    BOOST_CHECK_EQUAL( metric.use_count(), 4000U );
+
+    const UnitSystem copy(metric);
+    BOOST_CHECK_EQUAL( copy.use_count(), 4000U );
+    BOOST_CHECK( copy == metric );
+}
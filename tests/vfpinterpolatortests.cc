@@ -0,0 +1,337 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the eWoms project.
+
+  eWoms is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  eWoms is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with eWoms.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "config.h"
+
+#define BOOST_TEST_MODULE VFPInterpolatorTests
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <ewoms/eclio/parser/eclipsestate/schedule/vfpinjtable.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/vfpinterpolator.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/vfpprodtable.hh>
+
+using namespace Ewoms;
+
+namespace {
+
+std::vector<double> randomAxis(std::mt19937& gen, std::size_t size, double start)
+{
+    std::uniform_real_distribution<double> step(0.1, 10.0);
+
+    std::vector<double> axis { start };
+    while (axis.size() < size)
+        axis.push_back(axis.back() + step(gen));
+
+    return axis;
+}
+
+double randomCoordinate(std::mt19937& gen, const std::vector<double>& axis)
+{
+    // Mostly inside the axis, sometimes extrapolated, sometimes on a node.
+    if (std::uniform_int_distribution<int>(0, 4)(gen) == 0)
+        return axis[std::uniform_int_distribution<std::size_t>(0, axis.size() - 1)(gen)];
+
+    const auto margin = 0.2*(axis.back() - axis.front()) + 1.0;
+    return std::uniform_real_distribution<double>(axis.front() - margin, axis.back() + margin)(gen);
+}
+
+// Bottom hole pressure increasing in THP, otherwise random.
+std::vector<double> randomData(std::mt19937& gen, const std::vector<std::size_t>& shape)
+{
+    std::size_t inner = 1;
+    for (std::size_t d = 1; d < shape.size(); ++d)
+        inner *= shape[d];
+
+    std::uniform_real_distribution<double> value(-50.0, 50.0);
+    std::uniform_real_distribution<double> increment(0.5, 20.0);
+
+    std::vector<double> data(shape[0] * inner);
+    for (std::size_t i = 0; i < inner; ++i) {
+        data[i] = value(gen);
+        for (std::size_t t = 1; t < shape[0]; ++t)
+            data[t*inner + i] = data[(t - 1)*inner + i] + increment(gen);
+    }
+
+    return data;
+}
+
+/*
+  Reference multilinear interpolation: a linear search for the interval on
+  every axis and an explicit sum over all corners of the hypercube. The
+  derivative along an axis differentiates the weight of each corner.
+*/
+std::vector<double> referenceEvaluation(const std::vector<std::vector<double>>& axes,
+                                        const std::vector<double>& data,
+                                        const std::vector<double>& x)
+{
+    const auto n = axes.size();
+    std::vector<std::size_t> lower(n), upper(n);
+    std::vector<double> t(n), inv(n);
+    for (std::size_t d = 0; d < n; ++d) {
+        const auto& axis = axes[d];
+        if (axis.size() == 1) {
+            lower[d] = upper[d] = 0;
+            t[d] = inv[d] = 0.0;
+            continue;
+        }
+
+        std::size_t i = 0;
+        while (i + 2 < axis.size() && x[d] >= axis[i + 1])
+            ++i;
+
+        lower[d] = i;
+        upper[d] = i + 1;
+        t[d] = (x[d] - axis[i]) / (axis[i + 1] - axis[i]);
+        inv[d] = 1.0 / (axis[i + 1] - axis[i]);
+    }
+
+    std::vector<double> result(n + 1, 0.0);
+    for (std::size_t c = 0; c < (std::size_t{1} << n); ++c) {
+        std::size_t index = 0;
+        double weight = 1.0;
+        std::vector<double> dweight(n, 1.0);
+        for (std::size_t d = 0; d < n; ++d) {
+            const bool up = ((c >> (n - 1 - d)) & 1) != 0;
+            index = index*axes[d].size() + (up ? upper[d] : lower[d]);
+
+            const auto w = up ? t[d] : 1.0 - t[d];
+            const auto dw = up ? inv[d] : -inv[d];
+            weight *= w;
+            for (std::size_t e = 0; e < n; ++e)
+                dweight[e] *= (e == d) ? dw : w;
+        }
+
+        result[0] += weight * data[index];
+        for (std::size_t e = 0; e < n; ++e)
+            result[e + 1] += dweight[e] * data[index];
+    }
+
+    return result;
+}
+
+double clampToAxis(double x, const std::vector<double>& axis)
+{
+    return std::min(std::max(x, axis.front()), axis.back());
+}
+
+bool close(double value, double expected)
+{
+    return std::abs(value - expected) <= 1.0e-9 * (1.0 + std::abs(expected));
+}
+
+VFPProdTable randomProdTable(std::mt19937& gen, std::vector<std::vector<double>>& axes)
+{
+    std::uniform_int_distribution<std::size_t> size(1, 5);
+
+    axes.clear();
+    std::vector<std::size_t> shape;
+    for (std::size_t d = 0; d < 5; ++d) {
+        axes.push_back(randomAxis(gen, size(gen), 10.0*d));
+        shape.push_back(axes.back().size());
+    }
+
+    // Keep the THP axis at two nodes or more for the inverse lookups.
+    if (axes[0].size() == 1) {
+        axes[0] = randomAxis(gen, 2, 0.0);
+        shape[0] = 2;
+    }
+
+    return VFPProdTable(1, 1000.0, VFPProdTable::FLO_OIL, VFPProdTable::WFR_WCT,
+                        VFPProdTable::GFR_GOR, VFPProdTable::ALQ_GRAT,
+                        axes[4], axes[0], axes[1], axes[2], axes[3],
+                        randomData(gen, shape));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(Axis_Bracket) {
+    const VFPAxis axis({ 1.0, 2.0, 4.0 });
+
+    auto b = axis.bracket(3.0);
+    BOOST_CHECK_EQUAL(b.lower, 1U);
+    BOOST_CHECK_EQUAL(b.upper, 2U);
+    BOOST_CHECK_CLOSE(b.factor, 0.5, 1.0e-12);
+    BOOST_CHECK_CLOSE(b.invWidth, 0.5, 1.0e-12);
+
+    b = axis.bracket(0.0);
+    BOOST_CHECK_EQUAL(b.lower, 0U);
+    BOOST_CHECK_CLOSE(b.factor, -1.0, 1.0e-12);
+
+    b = axis.bracket(6.0);
+    BOOST_CHECK_EQUAL(b.lower, 1U);
+    BOOST_CHECK_CLOSE(b.factor, 2.0, 1.0e-12);
+
+    b = axis.bracket(2.0);
+    BOOST_CHECK_EQUAL(b.lower, 1U);
+    BOOST_CHECK_EQUAL(b.factor, 0.0);
+
+    b = VFPAxis({ 5.0 }).bracket(7.0);
+    BOOST_CHECK_EQUAL(b.lower, 0U);
+    BOOST_CHECK_EQUAL(b.upper, 0U);
+    BOOST_CHECK_EQUAL(b.factor, 0.0);
+
+    BOOST_CHECK_THROW(VFPAxis(std::vector<double>{}), std::invalid_argument);
+    BOOST_CHECK_THROW(VFPAxis({ 1.0, 1.0 }), std::invalid_argument);
+    BOOST_CHECK_THROW(VFPAxis({ 2.0, 1.0 }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Prod_Table_Nodes) {
+    std::mt19937 gen(1729);
+    std::vector<std::vector<double>> axes;
+    const auto table = randomProdTable(gen, axes);
+    const VFPProdInterpolator interp(table);
+
+    const auto shape = table.shape();
+    for (std::size_t t = 0; t < shape[0]; ++t)
+        for (std::size_t w = 0; w < shape[1]; ++w)
+            for (std::size_t g = 0; g < shape[2]; ++g)
+                for (std::size_t a = 0; a < shape[3]; ++a)
+                    for (std::size_t f = 0; f < shape[4]; ++f) {
+                        VFPProdInterpolator::Point p;
+                        p.thp = axes[0][t];
+                        p.wfr = axes[1][w];
+                        p.gfr = axes[2][g];
+                        p.alq = axes[3][a];
+                        p.flo = axes[4][f];
+                        BOOST_CHECK_EQUAL(interp.bhp(p).value, table(t, w, g, a, f));
+                    }
+}
+
+BOOST_AUTO_TEST_CASE(Prod_Table_Random) {
+    std::mt19937 gen(42);
+
+    for (int tableCount = 0; tableCount < 50; ++tableCount) {
+        std::vector<std::vector<double>> axes;
+        const auto table = randomProdTable(gen, axes);
+        const VFPProdInterpolator interp(table);
+
+        std::vector<VFPProdInterpolator::Point> points(40);
+        for (auto& p : points) {
+            p.thp = randomCoordinate(gen, axes[0]);
+            p.wfr = randomCoordinate(gen, axes[1]);
+            p.gfr = randomCoordinate(gen, axes[2]);
+            p.alq = randomCoordinate(gen, axes[3]);
+            p.flo = randomCoordinate(gen, axes[4]);
+        }
+
+        std::vector<VFPEvaluation> batch;
+        interp.bhp(points, batch);
+        BOOST_REQUIRE_EQUAL(batch.size(), points.size());
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const auto& p = points[i];
+            const auto expected = referenceEvaluation(axes, table.getTable(),
+                                                      { p.thp, p.wfr, p.gfr, p.alq, p.flo });
+            const auto single = interp.bhp(p);
+
+            BOOST_CHECK(close(single.value, expected[0]));
+            BOOST_CHECK(close(single.dthp, expected[1]));
+            BOOST_CHECK(close(single.dwfr, expected[2]));
+            BOOST_CHECK(close(single.dgfr, expected[3]));
+            BOOST_CHECK(close(single.dalq, expected[4]));
+            BOOST_CHECK(close(single.dflo, expected[5]));
+
+            BOOST_CHECK_EQUAL(batch[i].value, single.value);
+            BOOST_CHECK_EQUAL(batch[i].dflo, single.dflo);
+
+            // The pressure at every node is increasing in THP, and so is
+            // any interpolation between nodes: the inverse is unique. This
+            // does not hold when extrapolating in the other coordinates.
+            auto inside = p;
+            inside.wfr = clampToAxis(p.wfr, axes[1]);
+            inside.gfr = clampToAxis(p.gfr, axes[2]);
+            inside.alq = clampToAxis(p.alq, axes[3]);
+            inside.flo = clampToAxis(p.flo, axes[4]);
+
+            const auto bhp = interp.bhp(inside).value;
+            const auto thp = interp.thp(bhp, inside.flo, inside.wfr, inside.gfr, inside.alq);
+            BOOST_CHECK_MESSAGE(close(thp, p.thp), "THP " << thp << " != " << p.thp);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Prod_Table_Shape_Mismatch) {
+    const VFPProdTable table(1, 1000.0, VFPProdTable::FLO_OIL, VFPProdTable::WFR_WCT,
+                             VFPProdTable::GFR_GOR, VFPProdTable::ALQ_GRAT,
+                             { 1.0, 2.0 }, { 1.0 }, { 1.0 }, { 1.0 }, { 1.0 },
+                             { 1.0, 2.0, 3.0 });
+
+    BOOST_CHECK_THROW(VFPProdInterpolator{table}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Inj_Table_Random) {
+    std::mt19937 gen(2718);
+    std::uniform_int_distribution<std::size_t> size(2, 8);
+
+    for (int tableCount = 0; tableCount < 50; ++tableCount) {
+        const std::vector<std::vector<double>> axes {
+            randomAxis(gen, size(gen), 0.0),
+            randomAxis(gen, size(gen), 5.0)
+        };
+
+        const VFPInjTable table(1, 1000.0, VFPInjTable::FLO_WAT, axes[1], axes[0],
+                                randomData(gen, { axes[0].size(), axes[1].size() }));
+        const VFPInjInterpolator interp(table);
+
+        std::vector<double> flo, thp;
+        for (int i = 0; i < 40; ++i) {
+            thp.push_back(randomCoordinate(gen, axes[0]));
+            flo.push_back(randomCoordinate(gen, axes[1]));
+        }
+
+        std::vector<VFPEvaluation> batch;
+        interp.bhp(flo, thp, batch);
+        BOOST_REQUIRE_EQUAL(batch.size(), flo.size());
+
+        for (std::size_t i = 0; i < flo.size(); ++i) {
+            const auto expected = referenceEvaluation(axes, table.getTable(), { thp[i], flo[i] });
+
+            BOOST_CHECK(close(batch[i].value, expected[0]));
+            BOOST_CHECK(close(batch[i].dthp, expected[1]));
+            BOOST_CHECK(close(batch[i].dflo, expected[2]));
+            BOOST_CHECK_EQUAL(batch[i].dwfr, 0.0);
+
+            const auto inside = clampToAxis(flo[i], axes[1]);
+            const auto inverse = interp.thp(interp.bhp(inside, thp[i]).value, inside);
+            BOOST_CHECK_MESSAGE(close(inverse, thp[i]), "THP " << inverse << " != " << thp[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Inverse_Not_Monotone) {
+    // Pressure falls and rises again with THP, the smallest THP is used.
+    const VFPInjTable table(1, 1000.0, VFPInjTable::FLO_WAT, { 1.0 }, { 0.0, 10.0, 20.0 },
+                            { 100.0, 50.0, 150.0 });
+    const VFPInjInterpolator interp(table);
+
+    BOOST_CHECK_CLOSE(interp.thp(75.0, 1.0), 5.0, 1.0e-12);
+    BOOST_CHECK_CLOSE(interp.thp(100.0, 1.0), 0.0, 1.0e-12);
+    BOOST_CHECK_CLOSE(interp.thp(150.0, 1.0), 20.0, 1.0e-12);
+
+    // Beyond all values: extrapolate the closer end.
+    BOOST_CHECK_CLOSE(interp.thp(250.0, 1.0), 30.0, 1.0e-12);
+    BOOST_CHECK_CLOSE(interp.thp(-100.0, 1.0), 40.0, 1.0e-12);
+}
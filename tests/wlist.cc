@@ -21,6 +21,8 @@
 #include <stdexcept>
 #include <algorithm>
 
+#include <fnmatch.h>
+
 #define BOOST_TEST_MODULE WLIST_TEST
 
 #include <boost/test/unit_test.hpp>
@@ -28,6 +30,7 @@
 #include <ewoms/eclio/parser/eclipsestate/grid/fieldpropsmanager.hh>
 #include <ewoms/eclio/parser/eclipsestate/grid/eclipsegrid.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/schedule.hh>
+#include <ewoms/eclio/parser/eclipsestate/schedule/well/namepattern.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlist.hh>
 #include <ewoms/eclio/parser/eclipsestate/schedule/well/wlistmanager.hh>
 
@@ -290,3 +293,41 @@ BOOST_AUTO_TEST_CASE(WlistPattern) {
   BOOST_CHECK( vector_equal(wlm.wells("*LIST*"), {"W1", "W2", "W3"}));
   BOOST_CHECK( vector_equal(wlm.wells("**OLL*"), {"C1", "C2"}));
 }
+
+BOOST_AUTO_TEST_CASE(NamePatternFnmatch) {
+    const std::vector<std::string> names = {"W1", "W10", "W2", "P1", "PW1", "OP_1", "W", "", "*W", "W?1", "w1"};
+    const std::vector<std::string> patterns = {"W1", "W*", "*1", "*", "**", "W?", "*W*", "P*1", "[PW]1", "W\\?1", "w*", ""};
+
+    for (const auto& pattern : patterns) {
+        const NamePattern name_pattern(pattern);
+        for (const auto& name : names)
+            BOOST_CHECK_MESSAGE(name_pattern.match(name) == (fnmatch(pattern.c_str(), name.c_str(), 0) == 0),
+                                "Pattern: '" + pattern + "' name: '" + name + "'");
+    }
+
+    BOOST_CHECK(!NamePattern("W1").hasWildcard());
+    BOOST_CHECK(NamePattern("W*").hasWildcard());
+    BOOST_CHECK(NamePattern::hasWildcard("W?"));
+
+    const auto matches = NamePattern("W*").filter(names);
+    BOOST_CHECK(matches == std::vector<std::string>({"W1", "W10", "W2", "W", "W?1"}));
+}
+
+BOOST_AUTO_TEST_CASE(WellNamesAfterWLIST) {
+  std::string deck_string = WELSPECS() +
+      "WLIST\n"
+      " \'*LIST1\' \'NEW\' W1 /\n"
+      "/\n"
+      "WLIST\n"
+      " \'*LIST1\' \'ADD\' W2 /\n"
+      "/\n"
+      "DATES\n"
+      "10 JLY 2007 /\n"
+      "/\n";
+
+  auto sched = createSchedule(deck_string);
+  BOOST_CHECK( vector_equal(sched.wellNames("*LIST1", 0), {"W1", "W2"}));
+  BOOST_CHECK( vector_equal(sched.wellNames("*LIST1", 1), {"W1", "W2"}));
+  BOOST_CHECK( vector_equal(sched.wellNames("W*", 1), {"W1", "W2", "W3", "W4"}));
+  BOOST_CHECK( vector_equal(sched.wellMatcher(1).wells("*LIST1"), {"W1", "W2"}));
+}
@@ -21,110 +21,35 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
-#include <tuple>
+#include <map>
+#include <string>
+#include <vector>
 #include <getopt.h>
 
-#include <ewoms/eclio/io/eclfile.hh>
+#include <ewoms/eclio/io/eclconverter.hh>
 #include <ewoms/eclio/io/erst.hh>
 #include <ewoms/eclio/io/ecloutput.hh>
 
 using namespace Ewoms::EclIO;
-using EclEntry = EclFile::EclEntry;
 
 template <typename T>
-void write(EclOutput& outFile, EclFile& file1,
-           const std::string& name, int index)
+std::vector<T> splitList(const std::string& list, T (*convert)(const std::string&))
 {
-    auto vect = file1.get<T>(index);
-    outFile.write(name, vect);
-}
-
-template<typename T>
-void write(EclOutput& outFile, ERst& file1,
-           const std::string& name, int index, int reportStepNumber)
-{
-    auto vect = file1.getRestartData<T>(index, reportStepNumber);
-    outFile.write(name, vect);
-}
-
-template<typename T>
-void write(EclOutput& outFile, ERst& file1,
-           const std::string& name, int index)
-{
-    auto vect = file1.get<T>(index);
-    outFile.write(name, vect);
-}
-
-template <typename T>
-void writeArray(std::string name, eclArrType arrType, T& file1, int index, EclOutput& outFile) {
-
-    if (arrType == INTE) {
-        write<int>(outFile, file1, name, index);
-    } else if (arrType == REAL) {
-        write<float>(outFile, file1, name,index);
-    } else if (arrType == DOUB) {
-        write<double>(outFile, file1, name, index);
-    } else if (arrType == LOGI) {
-        write<bool>(outFile, file1, name, index);
-    } else if (arrType == CHAR) {
-        write<std::string>(outFile, file1, name, index);
-    } else if (arrType == C0NN) {
-        write<std::string>(outFile, file1, name, index);
-    } else if (arrType == MESS) {
-        outFile.message(name);
-    } else {
-        std::cout << "unknown array type " << std::endl;
-        exit(1);
-    }
-}
-
-template <typename T>
-void writeArray(std::string name, eclArrType arrType, T& file1, int index, int reportStepNumber, EclOutput& outFile) {
-
-    if (arrType == INTE) {
-        write<int>(outFile, file1, name, index, reportStepNumber);
-    } else if (arrType == REAL) {
-        write<float>(outFile, file1, name, index, reportStepNumber);
-    } else if (arrType == DOUB) {
-        write<double>(outFile, file1, name, index, reportStepNumber);
-    } else if (arrType == LOGI) {
-        write<bool>(outFile, file1, name, index, reportStepNumber);
-    } else if (arrType == CHAR) {
-        write<std::string>(outFile, file1, name, index, reportStepNumber);
-    } else if (arrType == MESS) {
-        outFile.message(name);
-    } else {
-        std::cout << "unknown array type " << std::endl;
-        exit(1);
-    }
-}
-
-void writeC0nnArray(std::string name, int elementSize, EclFile& file1, int index, EclOutput& outFile)
-{
-    auto vect = file1.get<std::string>(index);
-    outFile.write(name, vect, elementSize);
-}
+    std::vector<T> values;
+    std::size_t start = 0;
 
-void writeArrayList(std::vector<EclEntry>& arrayList, std::vector<int>& elementSizeList, EclFile file1, EclOutput& outFile) {
+    while (start <= list.size()) {
+        auto end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
 
-    for (size_t index = 0; index < arrayList.size(); index++) {
-        std::string name = std::get<0>(arrayList[index]);
-        eclArrType arrType = std::get<1>(arrayList[index]);
+        if (end > start)
+            values.push_back(convert(list.substr(start, end - start)));
 
-        if (arrType == Ewoms::EclIO::C0NN){
-            writeC0nnArray(name, elementSizeList[index], file1, index, outFile);
-        } else
-            writeArray(name, arrType, file1, index, outFile);
+        start = end + 1;
     }
-}
-
-void writeArrayList(std::vector<EclEntry>& arrayList, ERst file1, int reportStepNumber, EclOutput& outFile) {
 
-    for (size_t index = 0; index < arrayList.size(); index++) {
-        std::string name = std::get<0>(arrayList[index]);
-        eclArrType arrType = std::get<1>(arrayList[index]);
-        writeArray(name, arrType, file1, index , reportStepNumber, outFile);
-    }
+    return values;
 }
 
 static void printHelp() {
@@ -134,18 +59,26 @@ static void printHelp() {
               << "-h Print help and exit.\n"
               << "-l List report step numbers in the selected restart file.\n"
               << "-i Enforce IX standard on output file.\n"
-              << "-r Extract and convert a spesific report time step number from a unified restart file. \n\n";
+              << "-r Extract and convert spesific report time step numbers from a unified restart file,\n"
+              << "   given as a comma separated list.\n"
+              << "-k Only convert arrays with the given names, given as a comma separated list.\n"
+              << "   Include SEQNUM to get a valid unified restart file.\n"
+              << "-z Write a block compressed binary file, named by the second argument.\n"
+              << "-u Write an uncompressed binary file, named by the second argument. Used to\n"
+              << "   expand block compressed files.\n\n";
 }
 
 int main(int argc, char **argv) {
 
     int c                          = 0;
-    int reportStepNumber           = -1;
-    bool specificReportStepNumber  = false;
+    std::vector<int> reportStepNumbers;
+    std::vector<std::string> arrayNames;
     bool listProperties            = false;
     bool enforce_ix_output         = false;
+    bool compressedOutput          = false;
+    bool binaryOutput              = false;
 
-    while ((c = getopt(argc, argv, "hr:li")) != -1) {
+    while ((c = getopt(argc, argv, "hr:k:lizu")) != -1) {
         switch (c) {
         case 'h':
             printHelp();
@@ -157,8 +90,16 @@ int main(int argc, char **argv) {
             enforce_ix_output=true;
             break;
         case 'r':
-            specificReportStepNumber=true;
-            reportStepNumber = atoi(optarg);
+            reportStepNumbers = splitList<int>(optarg, [](const std::string& str) { return std::stoi(str); });
+            break;
+        case 'k':
+            arrayNames = splitList<std::string>(optarg, [](const std::string& str) { return str; });
+            break;
+        case 'z':
+            compressedOutput=true;
+            break;
+        case 'u':
+            binaryOutput=true;
             break;
         default:
             return EXIT_FAILURE;
@@ -171,7 +112,7 @@ int main(int argc, char **argv) {
     auto start = std::chrono::system_clock::now();
     std::string filename = argv[argOffset];
 
-    EclFile file1(filename);
+    EclConverter file1(filename);
     bool formattedOutput = file1.formattedInput() ? false : true;
 
     int p = filename.find_last_of(".");
@@ -216,7 +157,17 @@ int main(int argc, char **argv) {
     std::map<std::string, std::string> to_binary = {{".FEGRID", ".EGRID"}, {".FINIT", ".INIT"}, {".FSMSPEC", ".SMSPEC"},
         {".FUNSMRY", ".UNSMRY"}, {".FUNRST", ".UNRST"}, {".FRFT", ".RFT"}, {".FLODSMRY", ".LODSMRY"}};
 
-    if (formattedOutput) {
+    if (compressedOutput || binaryOutput) {
+
+        if (argc <= argOffset + 1) {
+            std::cout << "\n!ERROR, options -z and -u need the name of the output file as second argument" << std::endl;
+            exit(1);
+        }
+
+        formattedOutput = false;
+        resFile = argv[argOffset + 1];
+
+    } else if (formattedOutput) {
 
         auto search = to_formatted.find(extension);
 
@@ -248,14 +199,16 @@ int main(int argc, char **argv) {
 
     std::cout << "\033[1;31m" << "\nconverting  " << argv[argOffset] << " -> " << resFile << "\033[0m\n" << std::endl;
 
-    EclOutput outFile(resFile, formattedOutput);
+    EclOutput outFile = compressedOutput
+        ? EclOutput(resFile, false, std::ios::out, CompressionOptions{})
+        : EclOutput(resFile, formattedOutput);
 
     if ((file1.is_ix()) || (enforce_ix_output)) {
         std::cout << "setting IX flag on output file \n";
         outFile.set_ix();
     }
 
-    if (specificReportStepNumber) {
+    if (!reportStepNumbers.empty()) {
 
         if (extension!=".UNRST") {
             std::cout << "\n!ERROR, option -r only can only be used with unified restart files (*.UNRST) " << std::endl;
@@ -264,24 +217,20 @@ int main(int argc, char **argv) {
 
         ERst rst1(filename);
 
-        if (!rst1.hasReportStepNumber(reportStepNumber)) {
-            std::cout << "\n!ERROR, selected unified restart file doesn't have report step number " << reportStepNumber << "\n" << std::endl;
-            exit(1);
+        for (int reportStepNumber : reportStepNumbers) {
+            if (!rst1.hasReportStepNumber(reportStepNumber)) {
+                std::cout << "\n!ERROR, selected unified restart file doesn't have report step number " << reportStepNumber << "\n" << std::endl;
+                exit(1);
+            }
         }
 
-        rst1.loadReportStepNumber(reportStepNumber);
-
-        auto arrayList = rst1.listOfRstArrays(reportStepNumber);
-
-        writeArrayList(arrayList, rst1, reportStepNumber, outFile);
+        file1.selectReportSteps(reportStepNumbers);
+    }
 
-    } else {
+    if (!arrayNames.empty())
+        file1.selectArrays(arrayNames);
 
-        file1.loadData();
-        auto arrayList = file1.getList();
-        std::vector<int> elementSizeList = file1.getElementSizeList();
-        writeArrayList(arrayList, elementSizeList, file1, outFile);
-    }
+    file1.convert(outFile);
 
     auto end = std::chrono::system_clock::now();
     std::chrono::duration<double> elapsed_seconds = end-start;